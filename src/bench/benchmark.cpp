@@ -0,0 +1,506 @@
+/**
+ * DICOM Viewer - Benchmarks do Caminho de Carregamento
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/DicomCodecs.h"
+#include "core/FrameDecoder.h"
+#include "core/MedicalImage.h"
+#include "core/ProcessMemory.h"
+#include "corpus.h"
+
+#if defined(DICOM_VIEWER_BENCH_HAS_QT)
+#include "ui/windows/utils.h"
+#endif
+
+using namespace dicom_viewer_core;
+using namespace dicom_viewer_bench;
+
+namespace {
+
+/**
+ * @struct Options
+ * @brief Parâmetros da linha de comando.
+ */
+struct Options {
+    std::string command;
+    std::string corpus;
+    std::string jsonPath;                             ///< Resultados em JSON (vazio = não grava)
+    std::string baselinePath;                         ///< Resultados anteriores para comparação
+    std::string label;                                ///< Identificação livre da execução (ex.: commit)
+    std::string filter;                               ///< Executa apenas casos cujo nome contém o texto
+    int iterations = 10;
+    int warmup = 1;
+    double threshold = 10.0;                          ///< Piora percentual da mediana considerada regressão
+    bool force = false;
+};
+
+/**
+ * @struct StageResult
+ * @brief Medições de um estágio em um caso do corpus.
+ */
+struct StageResult {
+    std::string caseName;
+    std::string syntax;
+    std::string stage;
+    bool ok = false;
+    int iterations = 0;
+    std::uintmax_t fileBytes = 0;
+    std::size_t decodedBytes = 0;                     ///< Bytes de pixels produzidos por iteração (estágios de decodificação)
+    double minMs = 0.0;
+    double medianMs = 0.0;
+    double p95Ms = 0.0;
+    double meanMs = 0.0;
+    double mbPerSec = 0.0;
+    double decodedMbPerSec = 0.0;                     ///< Vazão de pixels decodificados pela mediana
+    double peakRssMb = 0.0;                           ///< Pico de RSS acima do início do estágio
+    std::map<std::string, double> breakdown;          ///< Medianas das etapas internas (LoadStats)
+};
+
+/**
+ * @class RssSampler
+ * @brief Amostra a memória residente em segundo plano e guarda o pico acima da linha de base.
+ *
+ * O pico do processo (peakResidentBytes) só cresce e seria dominado pelo
+ * maior caso já executado; amostrar o RSS atual isola cada estágio.
+ */
+class RssSampler {
+public:
+    RssSampler() : baseline(currentResidentBytes()), peak(baseline) {
+        worker = std::thread([this]() {
+            while (!stopping.load()) {
+                sample();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+    ~RssSampler() { stop(); }
+
+    /**
+     * @brief Encerra a amostragem e retorna o pico acima da linha de base, em bytes.
+     */
+    std::size_t stop() {
+        if (worker.joinable()) {
+            stopping.store(true);
+            worker.join();
+            sample();
+        }
+        const std::size_t highest = peak.load();
+        return highest > baseline ? highest - baseline : 0;
+    }
+
+private:
+    void sample() {
+        const std::size_t current = currentResidentBytes();
+        std::size_t previous = peak.load();
+        while (current > previous && !peak.compare_exchange_weak(previous, current)) {
+        }
+    }
+
+    std::size_t baseline;
+    std::atomic<std::size_t> peak;
+    std::atomic<bool> stopping{false};
+    std::thread worker;
+};
+
+double percentile(std::vector<double> values, double fraction) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    const std::size_t index = static_cast<std::size_t>(std::ceil(fraction * values.size())) - 1;
+    return values[std::min(index, values.size() - 1)];
+}
+
+/**
+ * @brief Executa body (aquecimento + iterações) e preenche as estatísticas do estágio.
+ *
+ * body retorna false em caso de falha; stats recebe as etapas internas de cada iteração.
+ */
+void measure(const Options& options, StageResult& result,
+             const std::function<bool(std::map<std::string, double>& stats)>& body) {
+    std::map<std::string, double> stats;
+    for (int i = 0; i < options.warmup; ++i) {
+        if (!body(stats)) {
+            result.ok = false;
+            return;
+        }
+    }
+
+    std::vector<double> times;
+    std::map<std::string, std::vector<double>> stages;
+    RssSampler sampler;
+    for (int i = 0; i < options.iterations; ++i) {
+        stats.clear();
+        const auto start = std::chrono::steady_clock::now();
+        const bool ok = body(stats);
+        times.push_back(elapsedMs(start));
+        if (!ok) {
+            result.ok = false;
+            return;
+        }
+        for (const auto& [name, value] : stats) {
+            stages[name].push_back(value);
+        }
+    }
+    result.peakRssMb = sampler.stop() / (1024.0 * 1024.0);
+
+    double total = 0.0;
+    for (const double value : times) {
+        total += value;
+    }
+    result.ok = true;
+    result.iterations = options.iterations;
+    result.minMs = *std::min_element(times.begin(), times.end());
+    result.medianMs = percentile(times, 0.5);
+    result.p95Ms = percentile(times, 0.95);
+    result.meanMs = total / times.size();
+    result.mbPerSec = result.medianMs > 0.0 ? (result.fileBytes / (1024.0 * 1024.0)) / (result.medianMs / 1000.0) : 0.0;
+    result.decodedMbPerSec =
+        result.medianMs > 0.0 ? (result.decodedBytes / (1024.0 * 1024.0)) / (result.medianMs / 1000.0) : 0.0;
+    for (const auto& [name, values] : stages) {
+        result.breakdown[name] = percentile(values, 0.5);
+    }
+}
+
+void recordLoadStats(const LoadStats& stats, std::map<std::string, double>& output) {
+    output["parseMs"] = stats.parseMs;
+    output["decompressMs"] = stats.decompressMs;
+    output["imageMs"] = stats.imageMs;
+    output["outputMs"] = stats.outputMs;
+}
+
+/**
+ * @brief Mede os estágios de um caso: carregamento em 8 e 16 bits, todos os quadros
+ * (multi-frame), metadados e conversão para QImage.
+ */
+std::vector<StageResult> runCase(const Options& options, const CorpusCase& corpusCase) {
+    const std::string path = corpusPath(options.corpus, corpusCase);
+    std::error_code error;
+    StageResult base;
+    base.caseName = corpusCase.name;
+    base.syntax = syntaxName(corpusCase.syntax);
+    base.fileBytes = std::filesystem::file_size(path, error);
+
+    std::vector<StageResult> results;
+    for (const bool want16Bit : {false, true}) {
+        StageResult result = base;
+        result.stage = want16Bit ? "load16" : "load8";
+        measure(options, result, [&](std::map<std::string, double>& stats) {
+            LoadStats timings;
+            const MedicalImage image = loadDicomRaw(path, want16Bit, &timings);
+            recordLoadStats(timings, stats);
+            result.decodedBytes = image.buffer.size();
+            return image.isValid();
+        });
+        results.push_back(result);
+    }
+
+    // Multi-frame: todos os quadros, decodificados em paralelo
+    if (corpusCase.frames > 1 && corpusCase.samplesPerPixel == 1) {
+        StageResult frames = base;
+        frames.stage = "frames";
+        measure(options, frames, [&](std::map<std::string, double>& stats) {
+            FrameDecodeStats decodeStats;
+            const Volume volume = loadDicomFrames(path, &decodeStats);
+            stats["headerMs"] = decodeStats.headerMs;
+            stats["decodeMs"] = decodeStats.decodeMs;
+            stats["threads"] = decodeStats.threads;
+            frames.decodedBytes = decodeStats.decodedBytes;
+            return volume.isValid() && volume.depth == corpusCase.frames;
+        });
+        results.push_back(frames);
+    }
+
+    const MedicalImage image = loadDicomRaw(path, true);
+    StageResult metadata = base;
+    metadata.stage = "metadata";
+    measure(options, metadata, [&](std::map<std::string, double>&) {
+        return image.isValid() && !getDicomMetadata(image).empty();
+    });
+    results.push_back(metadata);
+
+#if defined(DICOM_VIEWER_BENCH_HAS_QT)
+    StageResult convert = base;
+    convert.stage = "convert";
+    measure(options, convert, [&](std::map<std::string, double>&) {
+        return image.isValid() && !dicom_viewer_windows::convertMedicalImage(image).isNull();
+    });
+    results.push_back(convert);
+#endif
+    return results;
+}
+
+std::string resultJson(const StageResult& result) {
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3);
+    json << "{\"case\":\"" << result.caseName << "\",\"syntax\":\"" << result.syntax << "\",\"stage\":\""
+         << result.stage << "\",\"ok\":" << (result.ok ? "true" : "false") << ",\"iterations\":" << result.iterations
+         << ",\"fileBytes\":" << result.fileBytes << ",\"minMs\":" << result.minMs << ",\"medianMs\":"
+         << result.medianMs << ",\"p95Ms\":" << result.p95Ms << ",\"meanMs\":" << result.meanMs << ",\"mbPerSec\":"
+         << result.mbPerSec << ",\"decodedBytes\":" << result.decodedBytes << ",\"decodedMbPerSec\":"
+         << result.decodedMbPerSec << ",\"peakRssMb\":" << result.peakRssMb;
+    for (const auto& [name, value] : result.breakdown) {
+        json << ",\"" << name << "\":" << value;
+    }
+    json << "}";
+    return json.str();
+}
+
+/**
+ * @brief Imprime a vazão de decodificação agregada por sintaxe de transferência.
+ *
+ * Soma os bytes decodificados e as medianas dos estágios load16 (um quadro)
+ * e frames (todos os quadros), de modo que arquivos maiores pesam mais.
+ */
+void printSyntaxThroughput(const std::vector<StageResult>& results) {
+    struct Totals {
+        double bytes = 0.0;
+        double ms = 0.0;
+        int cases = 0;
+    };
+    std::map<std::string, std::map<std::string, Totals>> bySyntax;
+    for (const StageResult& result : results) {
+        if (!result.ok || (result.stage != "load16" && result.stage != "frames")) {
+            continue;
+        }
+        Totals& totals = bySyntax[result.syntax][result.stage];
+        totals.bytes += result.decodedBytes;
+        totals.ms += result.medianMs;
+        ++totals.cases;
+    }
+    if (bySyntax.empty()) {
+        return;
+    }
+    std::cout << "\nDecode throughput by transfer syntax (decoded MB/s)\n";
+    std::cout << std::left << std::setw(16) << "syntax" << std::right << std::setw(12) << "load16" << std::setw(12)
+              << "frames" << "\n";
+    for (const auto& [syntax, stages] : bySyntax) {
+        std::cout << std::left << std::setw(16) << syntax << std::right;
+        for (const char* stage : {"load16", "frames"}) {
+            const auto found = stages.find(stage);
+            if (found == stages.end() || found->second.ms <= 0.0) {
+                std::cout << std::setw(12) << "-";
+            } else {
+                std::cout << std::setw(12) << (found->second.bytes / (1024.0 * 1024.0)) / (found->second.ms / 1000.0);
+            }
+        }
+        std::cout << "\n";
+    }
+}
+
+/**
+ * @brief Grava os resultados, um por linha, para facilitar a comparação e o diff entre commits.
+ */
+bool writeJson(const Options& options, const std::vector<StageResult>& results) {
+    std::ofstream stream(options.jsonPath, std::ios::trunc);
+    if (!stream) {
+        std::cerr << "Error: cannot write " << options.jsonPath << std::endl;
+        return false;
+    }
+    stream << "{\"schema\":\"dicom-viewer-bench/1\",\"label\":\"" << options.label << "\",\"hardwareThreads\":"
+           << std::thread::hardware_concurrency() << ",\"iterations\":" << options.iterations << ",\"results\":[\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        stream << "  " << resultJson(results[i]) << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    stream << "]}\n";
+    return static_cast<bool>(stream);
+}
+
+/**
+ * @brief Valor de um campo em uma linha de resultado gravada por writeJson.
+ */
+std::string fieldValue(const std::string& line, const std::string& name) {
+    const std::string key = "\"" + name + "\":";
+    const std::size_t position = line.find(key);
+    if (position == std::string::npos) {
+        return std::string();
+    }
+    std::size_t begin = position + key.size();
+    if (begin < line.size() && line[begin] == '"') {
+        const std::size_t end = line.find('"', begin + 1);
+        return line.substr(begin + 1, end == std::string::npos ? std::string::npos : end - begin - 1);
+    }
+    const std::size_t end = line.find_first_of(",}", begin);
+    return line.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+}
+
+/**
+ * @brief Compara as medianas com uma execução anterior.
+ * @return Número de regressões (mediana pior que o limite, ou estágio que deixou de funcionar).
+ */
+int compareWithBaseline(const Options& options, const std::vector<StageResult>& results) {
+    std::ifstream stream(options.baselinePath);
+    if (!stream) {
+        std::cerr << "Error: cannot read baseline " << options.baselinePath << std::endl;
+        return 0;
+    }
+    std::map<std::string, std::pair<bool, double>> baseline;
+    std::string line;
+    while (std::getline(stream, line)) {
+        const std::string caseName = fieldValue(line, "case");
+        if (caseName.empty()) {
+            continue;
+        }
+        baseline[caseName + "/" + fieldValue(line, "stage")] = {fieldValue(line, "ok") == "true",
+                                                                std::atof(fieldValue(line, "medianMs").c_str())};
+    }
+
+    int regressions = 0;
+    std::cout << "\nComparison with " << options.baselinePath << " (threshold " << options.threshold << "%)\n";
+    for (const StageResult& result : results) {
+        const auto found = baseline.find(result.caseName + "/" + result.stage);
+        if (found == baseline.end()) {
+            continue;
+        }
+        const auto [wasOk, previousMs] = found->second;
+        if (wasOk && !result.ok) {
+            std::cout << "  REGRESSION " << result.caseName << " " << result.stage << ": now failing\n";
+            ++regressions;
+            continue;
+        }
+        if (!wasOk || !result.ok || previousMs <= 0.0) {
+            continue;
+        }
+        const double change = 100.0 * (result.medianMs - previousMs) / previousMs;
+        if (change > options.threshold) {
+            std::cout << "  REGRESSION ";
+            ++regressions;
+        } else if (change < -options.threshold) {
+            std::cout << "  improved   ";
+        } else {
+            continue;
+        }
+        std::cout << result.caseName << " " << result.stage << ": " << previousMs << " -> " << result.medianMs
+                  << " ms (" << std::showpos << change << std::noshowpos << "%)\n";
+    }
+    if (regressions == 0) {
+        std::cout << "  no regressions\n";
+    }
+    return regressions;
+}
+
+void printUsage() {
+    std::cerr << "Usage: dicom-bench generate <corpus-dir> [--force]\n"
+                 "       dicom-bench run <corpus-dir> [options]\n"
+                 "\n"
+                 "run generates any missing corpus files, then measures each case.\n"
+                 "Files are read from the OS cache after warm-up (warm latency).\n"
+                 "\n"
+                 "Options:\n"
+                 "  --iterations N     measured iterations per stage (default: 10)\n"
+                 "  --warmup N         unmeasured iterations per stage (default: 1)\n"
+                 "  --filter TEXT      only cases whose name contains TEXT\n"
+                 "  --json FILE        write machine-readable results\n"
+                 "  --label TEXT       label stored in the JSON (e.g. a commit hash)\n"
+                 "  --baseline FILE    compare medians with a previous --json output\n"
+                 "  --threshold PCT    median slowdown reported as a regression (default: 10)\n";
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (argument == "--iterations" && hasValue) {
+            options.iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (argument == "--warmup" && hasValue) {
+            options.warmup = std::max(0, std::atoi(argv[++i]));
+        } else if (argument == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (argument == "--json" && hasValue) {
+            options.jsonPath = argv[++i];
+        } else if (argument == "--label" && hasValue) {
+            options.label = argv[++i];
+        } else if (argument == "--baseline" && hasValue) {
+            options.baselinePath = argv[++i];
+        } else if (argument == "--threshold" && hasValue) {
+            options.threshold = std::max(0.0, std::atof(argv[++i]));
+        } else if (argument == "--force") {
+            options.force = true;
+        } else if (!argument.empty() && argument[0] == '-') {
+            std::cerr << "Error: unknown option '" << argument << "'" << std::endl;
+            return false;
+        } else {
+            positional.push_back(argument);
+        }
+    }
+    if (positional.size() != 2 || (positional[0] != "generate" && positional[0] != "run")) {
+        return false;
+    }
+    options.command = positional[0];
+    options.corpus = positional[1];
+    return true;
+}
+
+}
+
+/**
+ * @brief Gera o corpus sintético e mede o caminho de carregamento e conversão.
+ *
+ * Códigos de saída: 0 = sucesso, 1 = falha ao gerar ou executar, 2 = uso
+ * incorreto, 3 = regressões em relação ao baseline.
+ */
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    const int generationFailures = generateCorpus(options.corpus, options.force && options.command == "generate");
+    if (options.command == "generate") {
+        return generationFailures == 0 ? 0 : 1;
+    }
+
+    ensureCodecsRegistered();
+    std::vector<StageResult> results;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(28) << "case" << std::setw(10) << "stage" << std::right << std::setw(10)
+              << "median ms" << std::setw(10) << "p95 ms" << std::setw(10) << "MB/s" << std::setw(10) << "RSS MB"
+              << "\n";
+    for (const CorpusCase& corpusCase : standardCorpus()) {
+        if (!options.filter.empty() && corpusCase.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        for (const StageResult& result : runCase(options, corpusCase)) {
+            std::cout << std::left << std::setw(28) << result.caseName << std::setw(10) << result.stage << std::right;
+            if (result.ok) {
+                std::cout << std::setw(10) << result.medianMs << std::setw(10) << result.p95Ms << std::setw(10)
+                          << result.mbPerSec << std::setw(10) << result.peakRssMb << "\n";
+            } else {
+                std::cout << std::setw(10) << "FAILED" << "\n";
+            }
+            results.push_back(result);
+        }
+    }
+    releaseCodecs();
+    printSyntaxThroughput(results);
+
+    if (!options.jsonPath.empty() && !writeJson(options, results)) {
+        return 1;
+    }
+    if (!options.baselinePath.empty() && compareWithBaseline(options, results) > 0) {
+        return 3;
+    }
+    return 0;
+}
@@ -0,0 +1,310 @@
+/**
+ * DICOM Viewer - Corpus DICOM Sintético
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+#include <dcmtk/dcmdata/dctk.h>
+#include <dcmtk/dcmdata/dcrleerg.h>
+#include <dcmtk/dcmdata/dcrlerp.h>
+#include <dcmtk/dcmjpeg/djencode.h>
+#include <dcmtk/dcmjpeg/djrplol.h>
+#include <dcmtk/dcmjpeg/djrploss.h>
+#include <dcmtk/dcmjpls/djencode.h>
+#include <dcmtk/dcmjpls/djrparam.h>
+
+#include "corpus.h"
+
+namespace dicom_viewer_bench {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+E_TransferSyntax transferSyntax(CorpusSyntax syntax) {
+    switch (syntax) {
+    case CorpusSyntax::ImplicitLittle:
+        return EXS_LittleEndianImplicit;
+    case CorpusSyntax::ExplicitBig:
+        return EXS_BigEndianExplicit;
+    case CorpusSyntax::Rle:
+        return EXS_RLELossless;
+    case CorpusSyntax::JpegBaseline:
+        return EXS_JPEGProcess1;
+    case CorpusSyntax::JpegLossless:
+        return EXS_JPEGProcess14SV1;
+    case CorpusSyntax::JpegLsLossless:
+        return EXS_JPEGLSLossless;
+    case CorpusSyntax::ExplicitLittle:
+    default:
+        return EXS_LittleEndianExplicit;
+    }
+}
+
+/**
+ * @brief Gerador congruente linear: o mesmo ruído em qualquer plataforma.
+ */
+struct Noise {
+    uint32_t state;
+    explicit Noise(uint32_t seed) : state(seed * 2654435761u + 1u) {}
+    double next() {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) / 16777216.0 - 0.5;
+    }
+};
+
+/**
+ * @brief Intensidade normalizada (0 a 1) do fantoma no pixel (x, y) do quadro e canal informados.
+ *
+ * Gradiente de fundo, um disco grande, três discos menores que se deslocam
+ * entre quadros e ruído fraco: regiões suaves e bordas, como em imagens reais.
+ */
+double phantom(int x, int y, int columns, int rows, int frame, int channel, Noise& noise) {
+    const double u = (x + 0.5) / columns - 0.5;
+    const double v = (y + 0.5) / rows - 0.5;
+    double value = 0.15 + 0.1 * (u + v + 1.0) / 2.0;
+    if (u * u + v * v < 0.16) {
+        value = 0.45 + 0.05 * std::cos(8.0 * kPi * u);
+    }
+    for (int i = 0; i < 3; ++i) {
+        const double angle = 2.0 * kPi * (i / 3.0) + 0.1 * frame;
+        const double cu = 0.2 * std::cos(angle);
+        const double cv = 0.2 * std::sin(angle);
+        const double radius = 0.04 + 0.02 * i;
+        if ((u - cu) * (u - cu) + (v - cv) * (v - cv) < radius * radius) {
+            value = 0.7 + 0.1 * i + 0.05 * channel;
+        }
+    }
+    value += 0.02 * noise.next();
+    return std::clamp(value, 0.0, 1.0);
+}
+
+/**
+ * @brief Preenche os pixels de todos os quadros no layout definido pelo caso.
+ */
+void fillPixels(const CorpusCase& corpusCase, std::vector<uint8_t>& bytes8, std::vector<uint16_t>& words16) {
+    const std::size_t framePixels = static_cast<std::size_t>(corpusCase.rows) * corpusCase.columns;
+    const std::size_t samples = framePixels * corpusCase.samplesPerPixel * corpusCase.frames;
+    const double lowest = corpusCase.isSigned ? -std::ldexp(1.0, corpusCase.bitsStored - 1) : 0.0;
+    const double highest = corpusCase.isSigned ? std::ldexp(1.0, corpusCase.bitsStored - 1) - 1.0
+                                               : std::ldexp(1.0, corpusCase.bitsStored) - 1.0;
+    if (corpusCase.bitsAllocated == 16) {
+        words16.assign(samples, 0);
+    } else {
+        bytes8.assign(samples, 0);
+    }
+
+    Noise noise(static_cast<uint32_t>(corpusCase.rows * 31 + corpusCase.columns));
+    const int channels = corpusCase.samplesPerPixel;
+    for (int frame = 0; frame < corpusCase.frames; ++frame) {
+        const std::size_t frameBase = static_cast<std::size_t>(frame) * framePixels * channels;
+        for (int y = 0; y < corpusCase.rows; ++y) {
+            for (int x = 0; x < corpusCase.columns; ++x) {
+                const std::size_t pixel = static_cast<std::size_t>(y) * corpusCase.columns + x;
+                for (int c = 0; c < channels; ++c) {
+                    const double t = phantom(x, y, corpusCase.columns, corpusCase.rows, frame, c, noise);
+                    const long value = std::lround(lowest + t * (highest - lowest));
+                    const std::size_t index = corpusCase.planar ? frameBase + c * framePixels + pixel
+                                                                : frameBase + pixel * channels + c;
+                    if (corpusCase.bitsAllocated == 16) {
+                        words16[index] = static_cast<uint16_t>(value);
+                    } else {
+                        bytes8[index] = static_cast<uint8_t>(value);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Grava um caso do corpus; index torna os UIDs únicos e estáveis.
+ */
+bool writeCase(const CorpusCase& corpusCase, int index, const std::string& path) {
+    DcmFileFormat fileformat;
+    DcmDataset* dataset = fileformat.getDataset();
+    const std::string root = std::string(SITE_INSTANCE_UID_ROOT) + ".9011";
+    std::string modality = corpusCase.name.substr(0, corpusCase.name.find('_'));
+    std::transform(modality.begin(), modality.end(), modality.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+
+    dataset->putAndInsertString(DCM_SOPClassUID, UID_SecondaryCaptureImageStorage);
+    dataset->putAndInsertString(DCM_SOPInstanceUID, (root + ".3." + std::to_string(index)).c_str());
+    dataset->putAndInsertString(DCM_StudyInstanceUID, (root + ".1").c_str());
+    dataset->putAndInsertString(DCM_SeriesInstanceUID, (root + ".2." + std::to_string(index)).c_str());
+    dataset->putAndInsertString(DCM_PatientName, "BENCHMARK^SYNTHETIC");
+    dataset->putAndInsertString(DCM_PatientID, "BENCH0001");
+    dataset->putAndInsertString(DCM_StudyDate, "20260101");
+    dataset->putAndInsertString(DCM_Modality, modality.c_str());
+    dataset->putAndInsertString(DCM_SeriesNumber, "1");
+    dataset->putAndInsertString(DCM_InstanceNumber, std::to_string(index + 1).c_str());
+
+    dataset->putAndInsertUint16(DCM_Rows, static_cast<Uint16>(corpusCase.rows));
+    dataset->putAndInsertUint16(DCM_Columns, static_cast<Uint16>(corpusCase.columns));
+    dataset->putAndInsertUint16(DCM_SamplesPerPixel, static_cast<Uint16>(corpusCase.samplesPerPixel));
+    dataset->putAndInsertString(DCM_PhotometricInterpretation,
+                                corpusCase.samplesPerPixel == 3 ? "RGB" : "MONOCHROME2");
+    if (corpusCase.samplesPerPixel == 3) {
+        dataset->putAndInsertUint16(DCM_PlanarConfiguration, corpusCase.planar ? 1 : 0);
+    }
+    dataset->putAndInsertUint16(DCM_BitsAllocated, static_cast<Uint16>(corpusCase.bitsAllocated));
+    dataset->putAndInsertUint16(DCM_BitsStored, static_cast<Uint16>(corpusCase.bitsStored));
+    dataset->putAndInsertUint16(DCM_HighBit, static_cast<Uint16>(corpusCase.bitsStored - 1));
+    dataset->putAndInsertUint16(DCM_PixelRepresentation, corpusCase.isSigned ? 1 : 0);
+    if (corpusCase.frames > 1) {
+        dataset->putAndInsertString(DCM_NumberOfFrames, std::to_string(corpusCase.frames).c_str());
+        dataset->putAndInsertString(DCM_FrameTime, "33.3");
+    }
+    if (corpusCase.isSigned) {
+        dataset->putAndInsertString(DCM_RescaleIntercept, "0");
+        dataset->putAndInsertString(DCM_RescaleSlope, "1");
+    }
+
+    std::vector<uint8_t> bytes8;
+    std::vector<uint16_t> words16;
+    fillPixels(corpusCase, bytes8, words16);
+    const OFCondition inserted = corpusCase.bitsAllocated == 16
+        ? dataset->putAndInsertUint16Array(DCM_PixelData, words16.data(), static_cast<unsigned long>(words16.size()))
+        : dataset->putAndInsertUint8Array(DCM_PixelData, bytes8.data(), static_cast<unsigned long>(bytes8.size()));
+    if (inserted.bad()) {
+        std::cerr << "Error: cannot insert pixel data for " << corpusCase.name << " (" << inserted.text() << ")"
+                  << std::endl;
+        return false;
+    }
+
+    const E_TransferSyntax syntax = transferSyntax(corpusCase.syntax);
+    if (corpusCase.syntax == CorpusSyntax::Rle) {
+        DcmRLERepresentationParameter parameters;
+        dataset->chooseRepresentation(syntax, &parameters);
+    } else if (corpusCase.syntax == CorpusSyntax::JpegBaseline) {
+        DJ_RPLossy parameters(90);
+        dataset->chooseRepresentation(syntax, &parameters);
+    } else if (corpusCase.syntax == CorpusSyntax::JpegLossless) {
+        DJ_RPLossless parameters;
+        dataset->chooseRepresentation(syntax, &parameters);
+    } else if (corpusCase.syntax == CorpusSyntax::JpegLsLossless) {
+        DJLSRepresentationParameter parameters(0, OFTrue);
+        dataset->chooseRepresentation(syntax, &parameters);
+    }
+    if (!dataset->canWriteXfer(syntax)) {
+        std::cerr << "Error: cannot encode " << corpusCase.name << " as " << syntaxName(corpusCase.syntax) << std::endl;
+        return false;
+    }
+
+    const OFCondition saved = fileformat.saveFile(path.c_str(), syntax);
+    if (saved.bad()) {
+        std::cerr << "Error: cannot write " << path << " (" << saved.text() << ")" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+}
+
+/**
+ * @brief Casos do corpus padrão, do menor para o maior (casos mais novos no fim).
+ */
+std::vector<CorpusCase> standardCorpus() {
+    using S = CorpusSyntax;
+    // nome, linhas, colunas, bits alocados, bits armazenados, com sinal, amostras, planar, quadros, sintaxe
+    return {
+        {"mr_256_u12_explicit", 256, 256, 16, 12, false, 1, false, 1, S::ExplicitLittle},
+        {"mr_256_u12_implicit", 256, 256, 16, 12, false, 1, false, 1, S::ImplicitLittle},
+        {"ct_512_s16_explicit", 512, 512, 16, 16, true, 1, false, 1, S::ExplicitLittle},
+        {"ct_512_s16_implicit", 512, 512, 16, 16, true, 1, false, 1, S::ImplicitLittle},
+        {"ct_512_s16_bigendian", 512, 512, 16, 16, true, 1, false, 1, S::ExplicitBig},
+        {"ct_512_s16_rle", 512, 512, 16, 16, true, 1, false, 1, S::Rle},
+        {"ct_512_u12_jpegll", 512, 512, 16, 12, false, 1, false, 1, S::JpegLossless},
+        {"sc_1024_u8_explicit", 1024, 1024, 8, 8, false, 1, false, 1, S::ExplicitLittle},
+        {"us_640_rgb_explicit", 480, 640, 8, 8, false, 3, false, 1, S::ExplicitLittle},
+        {"us_640_rgbplanar_explicit", 480, 640, 8, 8, false, 3, true, 1, S::ExplicitLittle},
+        {"us_640_rgb_rle", 480, 640, 8, 8, false, 3, false, 1, S::Rle},
+        {"us_640_rgb_jpeg", 480, 640, 8, 8, false, 3, false, 1, S::JpegBaseline},
+        {"xa_512_u8_mf30_explicit", 512, 512, 8, 8, false, 1, false, 30, S::ExplicitLittle},
+        {"xa_512_u8_mf30_rle", 512, 512, 8, 8, false, 1, false, 30, S::Rle},
+        {"xa_512_u8_mf30_jpeg", 512, 512, 8, 8, false, 1, false, 30, S::JpegBaseline},
+        {"cr_2500_u12_explicit", 2500, 2048, 16, 12, false, 1, false, 1, S::ExplicitLittle},
+        {"cr_2500_u12_jpegll", 2500, 2048, 16, 12, false, 1, false, 1, S::JpegLossless},
+        {"mg_4096_u16_explicit", 4096, 3328, 16, 16, false, 1, false, 1, S::ExplicitLittle},
+        // Casos novos entram no fim: o índice faz parte dos UIDs dos arquivos já gerados
+        {"ct_512_s16_jpegls", 512, 512, 16, 16, true, 1, false, 1, S::JpegLsLossless},
+        {"cr_2500_u12_jpegls", 2500, 2048, 16, 12, false, 1, false, 1, S::JpegLsLossless},
+        {"xa_512_u8_mf30_jpegls", 512, 512, 8, 8, false, 1, false, 30, S::JpegLsLossless},
+        {"ct_512_s16_mf48_rle", 512, 512, 16, 16, true, 1, false, 48, S::Rle},
+        {"ct_512_u12_mf48_jpegll", 512, 512, 16, 12, false, 1, false, 48, S::JpegLossless},
+    };
+}
+
+/**
+ * @brief Nome curto da sintaxe de transferência.
+ */
+std::string syntaxName(CorpusSyntax syntax) {
+    switch (syntax) {
+    case CorpusSyntax::ImplicitLittle:
+        return "implicit";
+    case CorpusSyntax::ExplicitBig:
+        return "bigendian";
+    case CorpusSyntax::Rle:
+        return "rle";
+    case CorpusSyntax::JpegBaseline:
+        return "jpeg-baseline";
+    case CorpusSyntax::JpegLossless:
+        return "jpeg-lossless";
+    case CorpusSyntax::JpegLsLossless:
+        return "jpeg-ls";
+    case CorpusSyntax::ExplicitLittle:
+    default:
+        return "explicit";
+    }
+}
+
+/**
+ * @brief Caminho do arquivo de um caso dentro do diretório do corpus.
+ */
+std::string corpusPath(const std::string& directory, const CorpusCase& corpusCase) {
+    return (std::filesystem::path(directory) / (corpusCase.name + ".dcm")).string();
+}
+
+/**
+ * @brief Gera os arquivos do corpus que ainda não existem no diretório.
+ */
+int generateCorpus(const std::string& directory, bool force) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cerr << "Error: cannot create " << directory << " (" << error.message() << ")" << std::endl;
+        return static_cast<int>(standardCorpus().size());
+    }
+
+    DJEncoderRegistration::registerCodecs();
+    DJLSEncoderRegistration::registerCodecs();
+    DcmRLEEncoderRegistration::registerCodecs();
+    int failures = 0;
+    const std::vector<CorpusCase> cases = standardCorpus();
+    for (std::size_t index = 0; index < cases.size(); ++index) {
+        const std::string path = corpusPath(directory, cases[index]);
+        if (!force && std::filesystem::exists(path, error)) {
+            continue;
+        }
+        std::cout << "Generating " << cases[index].name << std::endl;
+        if (!writeCase(cases[index], static_cast<int>(index), path)) {
+            ++failures;
+        }
+    }
+    DcmRLEEncoderRegistration::cleanup();
+    DJLSEncoderRegistration::cleanup();
+    DJEncoderRegistration::cleanup();
+    return failures;
+}
+
+}
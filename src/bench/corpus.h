@@ -0,0 +1,79 @@
+/**
+ * DICOM Viewer - Corpus DICOM Sintético
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <string>
+#include <vector>
+
+#ifndef CORPUS_H
+#define CORPUS_H
+
+namespace dicom_viewer_bench {
+
+/**
+ * @brief Sintaxes de transferência geradas no corpus.
+ */
+enum class CorpusSyntax {
+    ExplicitLittle,                                   ///< Explicit VR Little Endian
+    ImplicitLittle,                                   ///< Implicit VR Little Endian
+    ExplicitBig,                                      ///< Explicit VR Big Endian (retirada, ainda encontrada em arquivos antigos)
+    Rle,                                              ///< RLE Lossless
+    JpegBaseline,                                     ///< JPEG Baseline (Process 1), 8 bits
+    JpegLossless,                                     ///< JPEG Lossless SV1 (Process 14), até 16 bits
+    JpegLsLossless                                    ///< JPEG-LS Lossless
+};
+
+/**
+ * @struct CorpusCase
+ * @brief Descrição de um arquivo do corpus sintético.
+ */
+struct CorpusCase {
+    std::string name;                                 ///< Nome estável do caso (também o nome do arquivo)
+    int rows = 0;
+    int columns = 0;
+    int bitsAllocated = 8;
+    int bitsStored = 8;
+    bool isSigned = false;
+    int samplesPerPixel = 1;
+    bool planar = false;                              ///< Planar Configuration = 1 (apenas RGB)
+    int frames = 1;
+    CorpusSyntax syntax = CorpusSyntax::ExplicitLittle;
+};
+
+/**
+ * @brief Casos do corpus padrão, do menor para o maior (casos mais novos no fim).
+ *
+ * Os nomes e o conteúdo são estáveis entre versões, para que os resultados
+ * dos benchmarks possam ser comparados entre commits.
+ */
+std::vector<CorpusCase> standardCorpus();
+
+/**
+ * @brief Nome curto da sintaxe de transferência (ex.: "explicit", "rle").
+ */
+std::string syntaxName(CorpusSyntax syntax);
+
+/**
+ * @brief Caminho do arquivo de um caso dentro do diretório do corpus.
+ */
+std::string corpusPath(const std::string& directory, const CorpusCase& corpusCase);
+
+/**
+ * @brief Gera os arquivos do corpus que ainda não existem no diretório.
+ *
+ * Os pixels são sintéticos (fantoma com gradiente, discos e ruído
+ * determinístico) e nenhum dado é baixado.
+ *
+ * @param directory Diretório de destino (criado se necessário).
+ * @param force Se true, regrava também os arquivos existentes.
+ * @return Número de casos que não puderam ser gerados.
+ */
+int generateCorpus(const std::string& directory, bool force);
+
+}
+
+#endif // CORPUS_H
@@ -0,0 +1,89 @@
+/**
+ * DICOM Viewer - Fila Limitada entre Threads
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+namespace dicom_viewer_core {
+
+/**
+ * @class BoundedQueue
+ * @brief Fila FIFO thread-safe com capacidade máxima, para ligar estágios de um pipeline.
+ *
+ * push() bloqueia enquanto a fila estiver cheia, de modo que um estágio
+ * rápido não acumula trabalho sem limite à frente de um estágio lento.
+ * Depois de close(), push() é recusado e pop() esvazia o que restou antes
+ * de sinalizar o fim.
+ */
+template <typename T>
+class BoundedQueue {
+public:
+    /**
+     * @brief Cria a fila.
+     * @param capacity Número máximo de itens na fila (mínimo 1).
+     */
+    explicit BoundedQueue(std::size_t capacity) : limit(capacity > 0 ? capacity : 1) {}
+
+    /**
+     * @brief Insere um item, aguardando espaço se necessário.
+     * @return false se a fila foi fechada (o item é descartado).
+     */
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this]() { return closed || items.size() < limit; });
+        if (closed) {
+            return false;
+        }
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Retira o item mais antigo, aguardando se a fila estiver vazia.
+     * @return false se a fila foi fechada e não há mais itens.
+     */
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this]() { return closed || !items.empty(); });
+        if (items.empty()) {
+            return false;
+        }
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Fecha a fila e acorda todas as threads em espera.
+     */
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::deque<T> items;
+    std::size_t limit;
+    bool closed = false;
+};
+
+}
+
+#endif // BOUNDEDQUEUE_H
@@ -0,0 +1,99 @@
+/**
+ * DICOM Viewer - Volume em Blocos (Bricks)
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "PixelBuffer.h"
+#include "Volume.h"
+
+#ifndef BRICKEDVOLUME_H
+#define BRICKEDVOLUME_H
+
+namespace dicom_viewer_core {
+
+class ThreadPool;
+
+/**
+ * @class BrickedVolume
+ * @brief Voxels de um Volume reorganizados em blocos de 8x8x8.
+ *
+ * No layout contíguo, percorrer uma linha coronal ou sagital salta um corte
+ * inteiro a cada passo. Em blocos, os vizinhos nos três eixos ficam a no
+ * máximo alguns KB de distância, de modo que qualquer orientação de corte
+ * acessa a memória com boa localidade. Os valores são guardados como 16 bits
+ * (valores armazenados, com extensão de sinal feita na leitura).
+ */
+class BrickedVolume {
+public:
+    static constexpr int brickShift = 3;                         ///< log2 do lado de um bloco
+    static constexpr int brickSize = 1 << brickShift;            ///< Lado de um bloco, em voxels
+    static constexpr int brickVoxels = brickSize * brickSize * brickSize;
+
+    /**
+     * @brief Reorganiza os voxels do volume em blocos, em paralelo.
+     * @param volume Volume contíguo de origem (8 ou 16 bits).
+     * @param pool Pool usado para distribuir os blocos.
+     * @return Volume em blocos, ou inválido se a origem for inválida.
+     */
+    static BrickedVolume fromVolume(const Volume& volume, ThreadPool& pool);
+
+    bool isValid() const { return !bricks.empty(); }
+    int width() const { return sizeX; }
+    int height() const { return sizeY; }
+    int depth() const { return sizeZ; }
+    double spacingX() const { return voxelSpacingX; }
+    double spacingY() const { return voxelSpacingY; }
+    double spacingZ() const { return voxelSpacingZ; }
+    bool isSigned() const { return signedValues; }
+
+    /**
+     * @brief Valor armazenado do voxel (x, y, z); as coordenadas devem estar dentro do volume.
+     */
+    int32_t voxel(int x, int y, int z) const {
+        const uint16_t raw = brickData()[offsetOf(x, y, z)];
+        return signedValues ? static_cast<int32_t>(static_cast<int16_t>(raw)) : static_cast<int32_t>(raw);
+    }
+
+    /**
+     * @brief Interpolação trilinear em coordenadas de voxel; fora do volume retorna outside.
+     */
+    float sample(float x, float y, float z, float outside) const;
+
+    /**
+     * @brief Metadados do volume de origem (rescale, janela, paciente, bits).
+     */
+    const Volume& info() const { return header; }
+
+private:
+    std::size_t offsetOf(int x, int y, int z) const {
+        const std::size_t brick = (static_cast<std::size_t>(z >> brickShift) * bricksY + (y >> brickShift)) * bricksX +
+                                  (x >> brickShift);
+        const int mask = brickSize - 1;
+        return brick * brickVoxels + (((z & mask) << brickShift | (y & mask)) << brickShift | (x & mask));
+    }
+    const uint16_t* brickData() const { return reinterpret_cast<const uint16_t*>(bricks.data()); }
+
+    PixelBuffer bricks;
+    Volume header;                                    ///< Cópia dos metadados, sem voxels
+    int sizeX = 0;
+    int sizeY = 0;
+    int sizeZ = 0;
+    std::size_t bricksX = 0;
+    std::size_t bricksY = 0;
+    std::size_t bricksZ = 0;
+    double voxelSpacingX = 1.0;
+    double voxelSpacingY = 1.0;
+    double voxelSpacingZ = 1.0;
+    bool signedValues = false;
+};
+
+}
+
+#endif // BRICKEDVOLUME_H
@@ -0,0 +1,591 @@
+/**
+ * DICOM Viewer - Conversão de Espaços de Cor
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DICOM_VIEWER_HAS_SSE2 1
+#endif
+
+#include <dcmtk/dcmdata/dctk.h>
+
+#include "ColorConversion.h"
+#include "FrameDecoder.h"
+#include "PixelBuffer.h"
+#include "ThreadPool.h"
+#include "Trace.h"
+
+namespace dicom_viewer_core {
+
+namespace {
+
+/**
+ * @brief Coeficientes YBR -> RGB em ponto fixo (13 bits de fração).
+ */
+struct YbrCoefficients {
+    int16_t luma;                                     ///< Escala de Y
+    int16_t lumaOffset;                               ///< Subtraído de Y antes da escala
+    int16_t crRed;
+    int16_t cbGreen;
+    int16_t crGreen;
+    int16_t cbBlue;
+};
+
+constexpr int kFractionBits = 13;
+
+/**
+ * @brief YBR_FULL: R = Y + 1.402 Cr', G = Y - 0.344136 Cb' - 0.714136 Cr', B = Y + 1.772 Cb'.
+ *
+ * YBR_PARTIAL: Y' = 1.164383 (Y - 16), com 1.596027, 0.391762, 0.812968 e 2.017232.
+ */
+template <bool Partial>
+constexpr YbrCoefficients ybrCoefficients() {
+    if constexpr (Partial) {
+        return YbrCoefficients{9539, 16, 13075, -3209, -6660, 16525};
+    } else {
+        return YbrCoefficients{8192, 0, 11485, -2819, -5850, 14516};
+    }
+}
+
+inline uint8_t clampByte(int value) {
+    return static_cast<uint8_t>(std::clamp(value, 0, 255));
+}
+
+/**
+ * @brief Converte um pixel YBR de 8 bits para RGB (mesma aritmética do caminho SSE2).
+ */
+template <bool Partial>
+inline void ybrPixel(int y, int cb, int cr, uint8_t* out) {
+    constexpr YbrCoefficients k = ybrCoefficients<Partial>();
+    constexpr int round = 1 << (kFractionBits - 1);
+    const int luma = (y - k.lumaOffset) * k.luma;
+    cb -= 128;
+    cr -= 128;
+    out[0] = clampByte((luma + k.crRed * cr + round) >> kFractionBits);
+    out[1] = clampByte((luma + k.cbGreen * cb + k.crGreen * cr + round) >> kFractionBits);
+    out[2] = clampByte((luma + k.cbBlue * cb + round) >> kFractionBits);
+}
+
+constexpr bool isYbr422(ColorModel model) {
+    return model == ColorModel::YbrFull422 || model == ColorModel::YbrPartial422;
+}
+
+/**
+ * @brief Três amostras do pixel x, já deslocadas para 8 bits.
+ */
+template <typename T, ColorModel Model, bool Planar>
+inline void readPixel(const T* const* rows, int x, int shift, int& c0, int& c1, int& c2) {
+    if constexpr (isYbr422(Model)) {
+        // Y0 Y1 Cb Cr: o par de pixels compartilha a crominância
+        const T* pair = rows[0] + 4 * (x >> 1);
+        c0 = pair[x & 1] >> shift;
+        c1 = pair[2] >> shift;
+        c2 = pair[3] >> shift;
+    } else if constexpr (Planar) {
+        c0 = rows[0][x] >> shift;
+        c1 = rows[1][x] >> shift;
+        c2 = rows[2][x] >> shift;
+    } else {
+        const T* pixel = rows[0] + 3 * static_cast<std::size_t>(x);
+        c0 = pixel[0] >> shift;
+        c1 = pixel[1] >> shift;
+        c2 = pixel[2] >> shift;
+    }
+}
+
+template <ColorModel Model>
+inline void writePixel(int c0, int c1, int c2, uint8_t* out) {
+    if constexpr (Model == ColorModel::Rgb) {
+        out[0] = clampByte(c0);
+        out[1] = clampByte(c1);
+        out[2] = clampByte(c2);
+    } else {
+        ybrPixel<Model == ColorModel::YbrPartial422>(c0, c1, c2, out);
+    }
+}
+
+#if defined(DICOM_VIEWER_HAS_SSE2)
+/**
+ * @brief Par de coeficientes de 16 bits para _mm_madd_epi16 (low multiplica o primeiro elemento do par).
+ */
+inline __m128i coefficientPair(int16_t low, int16_t high) {
+    return _mm_set1_epi32(static_cast<int32_t>(static_cast<uint32_t>(static_cast<uint16_t>(low)) |
+                                               (static_cast<uint32_t>(static_cast<uint16_t>(high)) << 16)));
+}
+
+/**
+ * @brief Converte 8 pixels YBR (amostras em 16 bits) para R, G e B em 16 bits, ainda não recortados.
+ */
+template <bool Partial>
+inline void ybrToRgbSse2(__m128i y, __m128i cb, __m128i cr, __m128i& r, __m128i& g, __m128i& b) {
+    constexpr YbrCoefficients k = ybrCoefficients<Partial>();
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i half = _mm_set1_epi16(128);
+    const __m128i round = _mm_set1_epi32(1 << (kFractionBits - 1));
+    y = _mm_sub_epi16(y, _mm_set1_epi16(k.lumaOffset));
+    cb = _mm_sub_epi16(cb, half);
+    cr = _mm_sub_epi16(cr, half);
+
+    const __m128i lumaScale = coefficientPair(k.luma, 0);
+    const __m128i lumaLow = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(y, zero), lumaScale), round);
+    const __m128i lumaHigh = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(y, zero), lumaScale), round);
+    // Pares (Cb', Cr') por pixel: cada canal é uma multiplicação-soma
+    const __m128i chromaLow = _mm_unpacklo_epi16(cb, cr);
+    const __m128i chromaHigh = _mm_unpackhi_epi16(cb, cr);
+    auto channel = [&](__m128i pair) {
+        const __m128i low = _mm_srai_epi32(_mm_add_epi32(lumaLow, _mm_madd_epi16(chromaLow, pair)), kFractionBits);
+        const __m128i high = _mm_srai_epi32(_mm_add_epi32(lumaHigh, _mm_madd_epi16(chromaHigh, pair)), kFractionBits);
+        return _mm_packs_epi32(low, high);
+    };
+    r = channel(coefficientPair(0, k.crRed));
+    g = channel(coefficientPair(k.cbGreen, k.crGreen));
+    b = channel(coefficientPair(k.cbBlue, 0));
+}
+
+/**
+ * @brief Grava 4 pixels RGBX (um por palavra de 32 bits) como 12 bytes RGB.
+ *
+ * Escreve 14 bytes: os 2 últimos são sobrescritos pelo grupo seguinte, por
+ * isso o chamador só usa esta função quando há ao menos mais um pixel na linha.
+ */
+inline void storeRgbx4(__m128i rgbx, uint8_t* out) {
+    const __m128i low24 = _mm_set_epi32(0, 0x00FFFFFF, 0, 0x00FFFFFF);
+    const __m128i next24 = _mm_set_epi32(0x0000FFFF, static_cast<int>(0xFF000000u), 0x0000FFFF, static_cast<int>(0xFF000000u));
+    // Em cada metade de 64 bits: p0 nos bits 0..23 e p1 deslocado para 24..47
+    const __m128i packed = _mm_or_si128(_mm_and_si128(rgbx, low24), _mm_and_si128(_mm_srli_epi64(rgbx, 8), next24));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), packed);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 6), _mm_srli_si128(packed, 8));
+}
+
+/**
+ * @brief Lê 12 bytes RGB como 4 pixels RGBX (lê 14 bytes; ver storeRgbx4).
+ */
+inline __m128i loadRgbx4(const uint8_t* in) {
+    const __m128i low24 = _mm_set_epi32(0, 0x00FFFFFF, 0, 0x00FFFFFF);
+    const __m128i high24 = _mm_set_epi32(0x00FFFFFF, 0, 0x00FFFFFF, 0);
+    const __m128i packed = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in)),
+                                              _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + 6)));
+    return _mm_or_si128(_mm_and_si128(packed, low24), _mm_and_si128(_mm_slli_epi64(packed, 8), high24));
+}
+
+/**
+ * @brief Recorta R, G e B (16 bits) para 8 bits e grava 8 pixels intercalados (24 bytes + 2 de folga).
+ */
+inline void storeRgb8(__m128i r, __m128i g, __m128i b, uint8_t* out) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i r8 = _mm_packus_epi16(r, r);
+    const __m128i g8 = _mm_packus_epi16(g, g);
+    const __m128i b8 = _mm_packus_epi16(b, b);
+    const __m128i rg = _mm_unpacklo_epi8(r8, g8);
+    const __m128i bx = _mm_unpacklo_epi8(b8, zero);
+    storeRgbx4(_mm_unpacklo_epi16(rg, bx), out);
+    storeRgbx4(_mm_unpackhi_epi16(rg, bx), out + 12);
+}
+
+/**
+ * @brief 8 amostras de 8 bits estendidas para 16 bits.
+ */
+inline __m128i load8(const uint8_t* in) {
+    return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in)), _mm_setzero_si128());
+}
+
+/**
+ * @brief Lê 8 pixels e separa as três amostras em vetores de 16 bits.
+ */
+template <ColorModel Model, bool Planar>
+inline void loadPixels8(const uint8_t* const* rows, int x, __m128i& c0, __m128i& c1, __m128i& c2) {
+    if constexpr (isYbr422(Model)) {
+        // 4 pares Y0 Y1 Cb Cr
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[0] + 2 * static_cast<std::size_t>(x)));
+        // Palavras de 32 bits (Y0Y1, CbCr, Y2Y3, CbCr) -> (Y0Y1, Y2Y3, CbCr, CbCr)
+        const __m128i low = _mm_shuffle_epi32(_mm_unpacklo_epi8(raw, zero), _MM_SHUFFLE(3, 1, 2, 0));
+        const __m128i high = _mm_shuffle_epi32(_mm_unpackhi_epi8(raw, zero), _MM_SHUFFLE(3, 1, 2, 0));
+        c0 = _mm_unpacklo_epi64(low, high);
+        const __m128i chroma = _mm_unpackhi_epi64(low, high);
+        // Cada (Cb, Cr) vale para dois pixels
+        const __m128i pairLow = _mm_unpacklo_epi32(chroma, chroma);
+        const __m128i pairHigh = _mm_unpackhi_epi32(chroma, chroma);
+        const __m128i mask = _mm_set1_epi32(0xFFFF);
+        c1 = _mm_packs_epi32(_mm_and_si128(pairLow, mask), _mm_and_si128(pairHigh, mask));
+        c2 = _mm_packs_epi32(_mm_srli_epi32(pairLow, 16), _mm_srli_epi32(pairHigh, 16));
+    } else if constexpr (Planar) {
+        c0 = load8(rows[0] + x);
+        c1 = load8(rows[1] + x);
+        c2 = load8(rows[2] + x);
+    } else {
+        const uint8_t* in = rows[0] + 3 * static_cast<std::size_t>(x);
+        const __m128i first = loadRgbx4(in);
+        const __m128i second = loadRgbx4(in + 12);
+        const __m128i mask = _mm_set1_epi32(0xFF);
+        c0 = _mm_packs_epi32(_mm_and_si128(first, mask), _mm_and_si128(second, mask));
+        c1 = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(first, 8), mask), _mm_and_si128(_mm_srli_epi32(second, 8), mask));
+        c2 = _mm_packs_epi32(_mm_srli_epi32(first, 16), _mm_srli_epi32(second, 16));
+    }
+}
+
+/**
+ * @brief Converte uma linha de 8 bits com SSE2, 8 pixels por iteração.
+ * @return Número de pixels processados; o restante fica para o laço escalar.
+ */
+template <ColorModel Model, bool Planar>
+int convertRow8Sse2(const uint8_t* const* rows, int width, uint8_t* out) {
+    int x = 0;
+    // As leituras e gravações usam 2 bytes além do grupo: sempre sobra ao menos um pixel
+    for (; x + 8 < width; x += 8) {
+        __m128i c0;
+        __m128i c1;
+        __m128i c2;
+        loadPixels8<Model, Planar>(rows, x, c0, c1, c2);
+        if constexpr (Model == ColorModel::Rgb) {
+            storeRgb8(c0, c1, c2, out + 3 * static_cast<std::size_t>(x));
+        } else {
+            __m128i r;
+            __m128i g;
+            __m128i b;
+            ybrToRgbSse2<Model == ColorModel::YbrPartial422>(c0, c1, c2, r, g, b);
+            storeRgb8(r, g, b, out + 3 * static_cast<std::size_t>(x));
+        }
+    }
+    return x;
+}
+#endif
+
+/**
+ * @brief Converte as linhas [firstRow, lastRow) de um quadro RGB ou YBR.
+ */
+template <typename T, ColorModel Model, bool Planar>
+void convertRows(const uint8_t* source, const ColorLayout& layout, int shift, uint8_t* destination,
+                 std::size_t destinationStride, std::size_t firstRow, std::size_t lastRow) {
+    const T* samples = reinterpret_cast<const T*>(source);
+    const int width = layout.width;
+    const std::size_t planeSize = static_cast<std::size_t>(width) * layout.height;
+    for (std::size_t y = firstRow; y < lastRow; ++y) {
+        const T* rows[3] = {nullptr, nullptr, nullptr};
+        if constexpr (isYbr422(Model)) {
+            rows[0] = samples + y * width * 2;
+        } else if constexpr (Planar) {
+            for (int c = 0; c < 3; ++c) {
+                rows[c] = samples + c * planeSize + y * width;
+            }
+        } else {
+            rows[0] = samples + y * width * 3;
+        }
+        uint8_t* out = destination + y * destinationStride;
+        if constexpr (Model == ColorModel::Rgb && !Planar && std::is_same_v<T, uint8_t>) {
+            std::memcpy(out, rows[0], static_cast<std::size_t>(width) * 3);
+            continue;
+        }
+
+        int x = 0;
+#if defined(DICOM_VIEWER_HAS_SSE2)
+        if constexpr (std::is_same_v<T, uint8_t>) {
+            x = convertRow8Sse2<Model, Planar>(rows, width, out);
+        }
+#endif
+        for (; x < width; ++x) {
+            int c0 = 0;
+            int c1 = 0;
+            int c2 = 0;
+            readPixel<T, Model, Planar>(rows, x, shift, c0, c1, c2);
+            writePixel<Model>(c0, c1, c2, out + 3 * static_cast<std::size_t>(x));
+        }
+    }
+}
+
+/**
+ * @brief Expande os índices das linhas [firstRow, lastRow) pela tabela de cores.
+ */
+template <typename T>
+void paletteRows(const uint8_t* source, int width, const uint8_t* table, uint8_t* destination,
+                 std::size_t destinationStride, std::size_t firstRow, std::size_t lastRow) {
+    const T* indices = reinterpret_cast<const T*>(source);
+    for (std::size_t y = firstRow; y < lastRow; ++y) {
+        const T* row = indices + y * width;
+        uint8_t* out = destination + y * destinationStride;
+        for (int x = 0; x < width; ++x) {
+            const uint8_t* entry = table + 3 * static_cast<std::size_t>(row[x]);
+            out[3 * x] = entry[0];
+            out[3 * x + 1] = entry[1];
+            out[3 * x + 2] = entry[2];
+        }
+    }
+}
+
+/**
+ * @brief Distribui as linhas pelo pool com o kernel já especializado.
+ */
+template <typename T, ColorModel Model, bool Planar>
+void runRows(const uint8_t* source, const ColorLayout& layout, int shift, uint8_t* destination,
+             std::size_t destinationStride, ThreadPool& pool) {
+    pool.parallelFor(0, static_cast<std::size_t>(layout.height), ThreadPool::rowsPerBlock(static_cast<std::size_t>(layout.width)),
+                     [&](std::size_t firstRow, std::size_t lastRow) {
+        convertRows<T, Model, Planar>(source, layout, shift, destination, destinationStride, firstRow, lastRow);
+    });
+}
+
+template <typename T, ColorModel Model>
+void runLayout(const uint8_t* source, const ColorLayout& layout, int shift, uint8_t* destination,
+               std::size_t destinationStride, ThreadPool& pool) {
+    if (layout.format.planar && !isYbr422(Model)) {
+        runRows<T, Model, true>(source, layout, shift, destination, destinationStride, pool);
+    } else {
+        runRows<T, Model, false>(source, layout, shift, destination, destinationStride, pool);
+    }
+}
+
+template <typename T>
+bool runModel(const uint8_t* source, const ColorLayout& layout, int shift, uint8_t* destination,
+              std::size_t destinationStride, ThreadPool& pool) {
+    switch (layout.model) {
+    case ColorModel::Rgb:
+        runLayout<T, ColorModel::Rgb>(source, layout, shift, destination, destinationStride, pool);
+        return true;
+    case ColorModel::YbrFull:
+        runLayout<T, ColorModel::YbrFull>(source, layout, shift, destination, destinationStride, pool);
+        return true;
+    case ColorModel::YbrFull422:
+        runLayout<T, ColorModel::YbrFull422>(source, layout, shift, destination, destinationStride, pool);
+        return true;
+    case ColorModel::YbrPartial422:
+        runLayout<T, ColorModel::YbrPartial422>(source, layout, shift, destination, destinationStride, pool);
+        return true;
+    default:
+        return false;
+    }
+}
+
+}
+
+/**
+ * @brief Modelo de cor de uma Photometric Interpretation.
+ */
+ColorModel colorModelFor(const std::string& photometricInterpretation, int samplesPerPixel) {
+    if (samplesPerPixel == 1) {
+        return photometricInterpretation == "PALETTE COLOR" ? ColorModel::Palette : ColorModel::Unsupported;
+    }
+    if (samplesPerPixel != 3) {
+        return ColorModel::Unsupported;
+    }
+    if (photometricInterpretation == "RGB") {
+        return ColorModel::Rgb;
+    }
+    if (photometricInterpretation == "YBR_FULL") {
+        return ColorModel::YbrFull;
+    }
+    if (photometricInterpretation == "YBR_FULL_422") {
+        return ColorModel::YbrFull422;
+    }
+    if (photometricInterpretation == "YBR_PARTIAL_422") {
+        return ColorModel::YbrPartial422;
+    }
+    return ColorModel::Unsupported;
+}
+
+/**
+ * @brief Lê as tabelas de cor (0028,1101..1103 e 0028,1201..1203) e as expande.
+ */
+bool readPaletteLut(DcmItem* dataset, int bitsAllocated, PaletteLut& lut) {
+    lut.rgb.clear();
+    if (bitsAllocated != 8 && bitsAllocated != 16) {
+        return false;
+    }
+    if (dataset->tagExists(DCM_SegmentedRedPaletteColorLookupTableData)) {
+        std::cerr << "Warning: segmented palette color lookup tables are not supported" << std::endl;
+        return false;
+    }
+
+    const DcmTagKey descriptors[3] = {DCM_RedPaletteColorLookupTableDescriptor,
+                                      DCM_GreenPaletteColorLookupTableDescriptor,
+                                      DCM_BluePaletteColorLookupTableDescriptor};
+    const DcmTagKey tables[3] = {DCM_RedPaletteColorLookupTableData, DCM_GreenPaletteColorLookupTableData,
+                                 DCM_BluePaletteColorLookupTableData};
+    struct Channel {
+        const Uint16* words = nullptr;
+        unsigned long wordCount = 0;
+        std::size_t entries = 0;
+        int firstValue = 0;
+        bool packed = false;                          ///< Entradas de 8 bits, duas por palavra
+
+        unsigned entry(std::size_t i) const {
+            return packed ? reinterpret_cast<const Uint8*>(words)[i] : words[i];
+        }
+    };
+    Channel channels[3];
+    unsigned maxValue = 0;
+    for (int c = 0; c < 3; ++c) {
+        Uint16 entries = 0;
+        Uint16 firstValue = 0;
+        Uint16 bits = 0;
+        if (dataset->findAndGetUint16(descriptors[c], entries, 0).bad() ||
+            dataset->findAndGetUint16(descriptors[c], firstValue, 1).bad() ||
+            dataset->findAndGetUint16(descriptors[c], bits, 2).bad() ||
+            dataset->findAndGetUint16Array(tables[c], channels[c].words, &channels[c].wordCount).bad() ||
+            channels[c].words == nullptr) {
+            return false;
+        }
+        Channel& channel = channels[c];
+        channel.entries = entries == 0 ? 65536 : entries;
+        channel.firstValue = firstValue;
+        channel.packed = bits <= 8 && channel.wordCount < channel.entries;
+        const std::size_t available = channel.packed ? channel.wordCount * 2 : channel.wordCount;
+        if (available < channel.entries) {
+            std::cerr << "Error: palette color lookup table shorter than its descriptor" << std::endl;
+            return false;
+        }
+        for (std::size_t i = 0; i < channel.entries; ++i) {
+            maxValue = std::max(maxValue, channel.entry(i));
+        }
+    }
+
+    // Tabelas de 16 bits (ou de 8 bits guardadas no byte alto) são reduzidas aos 8 bits mais altos
+    const int shift = maxValue > 255 ? 8 : 0;
+    const std::size_t domain = std::size_t(1) << bitsAllocated;
+    lut.rgb.resize(domain * 3);
+    for (std::size_t index = 0; index < domain; ++index) {
+        for (int c = 0; c < 3; ++c) {
+            const Channel& channel = channels[c];
+            const long offset = static_cast<long>(index) - channel.firstValue;
+            const std::size_t i = static_cast<std::size_t>(std::clamp<long>(offset, 0, static_cast<long>(channel.entries) - 1));
+            lut.rgb[index * 3 + c] = static_cast<uint8_t>(channel.entry(i) >> shift);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Bytes de um quadro armazenado.
+ */
+std::size_t ColorLayout::frameBytes() const {
+    const std::size_t pixels = static_cast<std::size_t>(width) * height;
+    if (isYbr422(model)) {
+        return pixels * 2 * format.bytesPerSample();
+    }
+    return pixels * format.bytesPerPixel();
+}
+
+/**
+ * @brief Descreve os quadros coloridos de um conjunto de dados não comprimido.
+ */
+bool readColorLayout(DcmItem* dataset, ColorLayout& layout) {
+    layout = ColorLayout();
+    Uint16 rows = 0;
+    Uint16 columns = 0;
+    Uint16 samples = 0;
+    Uint16 bitsAllocated = 0;
+    Uint16 bitsStored = 0;
+    Uint16 planar = 0;
+    OFString photometric;
+    dataset->findAndGetUint16(DCM_Rows, rows);
+    dataset->findAndGetUint16(DCM_Columns, columns);
+    dataset->findAndGetUint16(DCM_SamplesPerPixel, samples);
+    dataset->findAndGetUint16(DCM_BitsAllocated, bitsAllocated);
+    if (dataset->findAndGetUint16(DCM_BitsStored, bitsStored).bad()) {
+        bitsStored = bitsAllocated;
+    }
+    dataset->findAndGetUint16(DCM_PlanarConfiguration, planar);
+    dataset->findAndGetOFString(DCM_PhotometricInterpretation, photometric);
+
+    layout.model = colorModelFor(photometric.c_str(), samples);
+    if (layout.model == ColorModel::Unsupported || rows == 0 || columns == 0 ||
+        (bitsAllocated != 8 && bitsAllocated != 16)) {
+        return false;
+    }
+    // Os formatos 422 são sempre de 8 bits, intercalados e com largura par
+    if (isYbr422(layout.model) && (bitsAllocated != 8 || columns % 2 != 0)) {
+        return false;
+    }
+    layout.width = columns;
+    layout.height = rows;
+    layout.bitsStored = std::clamp<int>(bitsStored, 1, bitsAllocated);
+    layout.format.type = bitsAllocated == 16 ? PixelType::UInt16 : PixelType::UInt8;
+    layout.format.samplesPerPixel = samples;
+    layout.format.planar = planar == 1 && samples == 3 && !isYbr422(layout.model);
+    return true;
+}
+
+/**
+ * @brief Converte um quadro colorido armazenado para RGB888 intercalado.
+ *
+ * O modelo de cor, o tipo das amostras e a organização são resolvidos uma
+ * vez; cada combinação tem o seu laço especializado.
+ */
+bool convertColorFrame(const uint8_t* source, const ColorLayout& layout, const PaletteLut* palette,
+                       uint8_t* destination, std::size_t destinationStride, ThreadPool& pool) {
+    if (!source || !destination || layout.width <= 0 || layout.height <= 0 ||
+        destinationStride < static_cast<std::size_t>(layout.width) * 3) {
+        return false;
+    }
+    if (layout.model == ColorModel::Palette) {
+        if (!palette || palette->rgb.size() < (std::size_t(1) << (layout.format.bytesPerSample() * 8)) * 3) {
+            return false;
+        }
+        pool.parallelFor(0, static_cast<std::size_t>(layout.height), ThreadPool::rowsPerBlock(static_cast<std::size_t>(layout.width)),
+                         [&](std::size_t firstRow, std::size_t lastRow) {
+            if (layout.format.type == PixelType::UInt16) {
+                paletteRows<uint16_t>(source, layout.width, palette->rgb.data(), destination, destinationStride,
+                                      firstRow, lastRow);
+            } else {
+                paletteRows<uint8_t>(source, layout.width, palette->rgb.data(), destination, destinationStride,
+                                     firstRow, lastRow);
+            }
+        });
+        return true;
+    }
+    if (layout.format.type == PixelType::UInt16) {
+        const int shift = std::max(0, layout.bitsStored - 8);
+        return runModel<uint16_t>(source, layout, shift, destination, destinationStride, pool);
+    }
+    return runModel<uint8_t>(source, layout, 0, destination, destinationStride, pool);
+}
+
+/**
+ * @brief Lê um quadro colorido não comprimido e o converte para RGB888 intercalado.
+ */
+bool decodeColorFrame(DcmDataset* dataset, int frame, const ColorLayout& layout, const PaletteLut* palette,
+                      uint8_t* destination, std::size_t destinationStride, ThreadPool& pool) {
+    if (DcmXfer(dataset->getCurrentXfer()).isEncapsulated()) {
+        return false;
+    }
+    DICOM_TRACE_SCOPE(traceScope, "color");
+    const std::size_t frameBytes = layout.frameBytes();
+    DICOM_TRACE_BYTES(traceScope, frameBytes);
+
+    Sint32 frames = 1;
+    dataset->findAndGetSint32(DCM_NumberOfFrames, frames);
+    if (frames <= 1 && frame == 0) {
+        // Um quadro: os valores já carregados pelo DCMTK são convertidos no lugar
+        DcmElement* pixelData = nullptr;
+        Uint8* bytes = nullptr;
+        if (dataset->findAndGetElement(DCM_PixelData, pixelData).good() && pixelData != nullptr &&
+            pixelData->getLength() >= frameBytes && pixelData->getUint8Array(bytes).good() && bytes != nullptr) {
+            return convertColorFrame(bytes, layout, palette, destination, destinationStride, pool);
+        }
+        Uint16* words = nullptr;
+        if (pixelData != nullptr && pixelData->getLength() >= frameBytes && pixelData->getUint16Array(words).good() &&
+            words != nullptr) {
+            return convertColorFrame(reinterpret_cast<const uint8_t*>(words), layout, palette, destination,
+                                     destinationStride, pool);
+        }
+    }
+
+    // Multi-frame: apenas o quadro pedido é lido
+    PixelBuffer stored;
+    stored.allocate(frameBytes);
+    uint32_t startFragment = 0;
+    if (!decodeStoredFrame(dataset, frame, stored.data(), frameBytes, startFragment)) {
+        return false;
+    }
+    return convertColorFrame(stored.data(), layout, palette, destination, destinationStride, pool);
+}
+
+}
@@ -0,0 +1,138 @@
+/**
+ * DICOM Viewer - Conversão de Espaços de Cor
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "PixelFormat.h"
+
+#ifndef COLORCONVERSION_H
+#define COLORCONVERSION_H
+
+class DcmItem;
+class DcmDataset;
+
+namespace dicom_viewer_core {
+
+class ThreadPool;
+
+/**
+ * @brief Modelo de cor dos valores armazenados (Photometric Interpretation).
+ */
+enum class ColorModel {
+    Rgb,                                              ///< RGB
+    YbrFull,                                          ///< YBR_FULL (faixa completa)
+    YbrFull422,                                       ///< YBR_FULL_422: Y0 Y1 Cb Cr a cada par de pixels
+    YbrPartial422,                                    ///< YBR_PARTIAL_422: faixa de vídeo (Y 16..235)
+    Palette,                                          ///< PALETTE COLOR: índices em tabelas R, G e B
+    Unsupported                                       ///< Demais (monocromáticas, YBR_ICT/RCT ainda codificadas, ...)
+};
+
+/**
+ * @brief Modelo de cor de uma Photometric Interpretation.
+ * @param photometricInterpretation Valor do atributo (0028,0004).
+ * @param samplesPerPixel Amostras por pixel (3 para RGB/YBR, 1 para PALETTE COLOR).
+ */
+ColorModel colorModelFor(const std::string& photometricInterpretation, int samplesPerPixel);
+
+/**
+ * @struct PaletteLut
+ * @brief Tabela de cores expandida para todo o domínio dos índices armazenados.
+ *
+ * Cada índice possível (256 ou 65536) tem os seus três bytes RGB, já com
+ * o primeiro valor mapeado e o recorte das pontas aplicados, de modo que a
+ * conversão é uma cópia de três bytes por pixel.
+ */
+struct PaletteLut {
+    std::vector<uint8_t> rgb;                         ///< 3 bytes por índice armazenado
+
+    bool isValid() const { return !rgb.empty(); }
+};
+
+/**
+ * @brief Lê as tabelas de cor (0028,1101..1103 e 0028,1201..1203) e as expande.
+ *
+ * Tabelas segmentadas (0028,1221..1223) não são suportadas.
+ *
+ * @param dataset Conjunto de dados com as tabelas.
+ * @param bitsAllocated Bits alocados dos índices (8 ou 16).
+ * @param lut Recebe a tabela expandida.
+ * @return false se as tabelas estiverem ausentes, forem segmentadas ou inválidas.
+ */
+bool readPaletteLut(DcmItem* dataset, int bitsAllocated, PaletteLut& lut);
+
+/**
+ * @struct ColorLayout
+ * @brief Descrição dos valores armazenados de um quadro colorido.
+ */
+struct ColorLayout {
+    ColorModel model = ColorModel::Unsupported;
+    PixelFormat format;                               ///< UInt8 ou UInt16; 3 amostras (1 para paleta); planar ou intercalada
+    int width = 0;
+    int height = 0;
+    int bitsStored = 8;                               ///< Amostras de 16 bits são deslocadas para os 8 bits mais altos
+
+    /**
+     * @brief Bytes de um quadro armazenado (Y0 Y1 Cb Cr a cada dois pixels nos formatos 422).
+     */
+    std::size_t frameBytes() const;
+};
+
+/**
+ * @brief Descreve os quadros coloridos de um conjunto de dados não comprimido.
+ *
+ * @param dataset Conjunto de dados (os valores de pixel não são lidos).
+ * @param layout Recebe a descrição.
+ * @return false se o modelo de cor ou o formato não tiverem conversão direta
+ *         (o chamador deve usar o caminho genérico do DicomImage).
+ */
+bool readColorLayout(DcmItem* dataset, ColorLayout& layout);
+
+/**
+ * @brief Converte um quadro colorido armazenado para RGB888 intercalado.
+ *
+ * YBR_FULL, YBR_FULL_422 e YBR_PARTIAL_422 usam as equações de PS3.3
+ * C.7.6.3.1.2 em ponto fixo; RGB planar é intercalado; PALETTE COLOR é
+ * expandido pela tabela. Os caminhos de 8 bits usam SSE2, 8 pixels por
+ * iteração, e as linhas são distribuídas pelo pool, com o resultado
+ * escrito direto no destino.
+ *
+ * @param source Valores armazenados do quadro (layout.frameBytes() bytes).
+ * @param layout Descrição do quadro.
+ * @param palette Tabela expandida (obrigatória para PALETTE COLOR).
+ * @param destination Buffer com ao menos height * destinationStride bytes.
+ * @param destinationStride Bytes por linha do destino (>= width * 3).
+ * @param pool Pool usado para distribuir as linhas.
+ * @return false se o layout não for suportado.
+ */
+bool convertColorFrame(const uint8_t* source, const ColorLayout& layout, const PaletteLut* palette,
+                       uint8_t* destination, std::size_t destinationStride, ThreadPool& pool);
+
+/**
+ * @brief Lê um quadro colorido não comprimido e o converte para RGB888 intercalado.
+ *
+ * Em arquivos de um quadro os valores já carregados pelo DCMTK são lidos
+ * no lugar; nos multi-frame apenas o quadro pedido é lido do disco.
+ *
+ * @param dataset Conjunto de dados (sintaxe de transferência nativa).
+ * @param frame Índice do quadro.
+ * @param layout Descrição obtida com readColorLayout().
+ * @param palette Tabela expandida (obrigatória para PALETTE COLOR).
+ * @param destination Buffer com ao menos height * destinationStride bytes.
+ * @param destinationStride Bytes por linha do destino (>= width * 3).
+ * @param pool Pool usado para distribuir as linhas.
+ * @return false se os pixels estiverem comprimidos ou não puderem ser lidos.
+ */
+bool decodeColorFrame(DcmDataset* dataset, int frame, const ColorLayout& layout, const PaletteLut* palette,
+                      uint8_t* destination, std::size_t destinationStride, ThreadPool& pool);
+
+}
+
+#endif // COLORCONVERSION_H
@@ -0,0 +1,339 @@
+/**
+ * DICOM Viewer - Árvore Preguiçosa de Tags DICOM
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <iostream>
+
+#include <dcmtk/dcmdata/dctk.h>
+
+#include "DatasetTree.h"
+#include "Trace.h"
+
+namespace dicom_viewer_core {
+
+namespace {
+
+/**
+ * @brief Papel de um objeto DCMTK na árvore.
+ */
+DatasetNodeKind kindOf(DcmObject* object) {
+    switch (object->ident()) {
+    case EVR_fileFormat: return DatasetNodeKind::File;
+    case EVR_metainfo: return DatasetNodeKind::MetaHeader;
+    case EVR_dataset: return DatasetNodeKind::Dataset;
+    case EVR_SQ: return DatasetNodeKind::Sequence;
+    case EVR_item: return DatasetNodeKind::Item;
+    default: return DatasetNodeKind::Element;
+    }
+}
+
+/**
+ * @brief Número de filhos de um objeto, sem percorrê-los.
+ *
+ * Os pixels encapsulados (DcmPixelData) são folhas: os fragmentos não são expostos.
+ */
+std::size_t childCount(DcmObject* object, DatasetNodeKind kind) {
+    switch (kind) {
+    case DatasetNodeKind::File:
+    case DatasetNodeKind::Sequence:
+        return static_cast<DcmSequenceOfItems*>(object)->card();
+    case DatasetNodeKind::MetaHeader:
+    case DatasetNodeKind::Dataset:
+    case DatasetNodeKind::Item:
+        return static_cast<DcmItem*>(object)->card();
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief true para valores sem representação textual útil (exibidos em hexadecimal).
+ */
+bool isBinary(DcmEVR ident) {
+    switch (ident) {
+    case EVR_OB:
+    case EVR_OW:
+    case EVR_OF:
+    case EVR_OD:
+    case EVR_OL:
+    case EVR_UN:
+    case EVR_ox:
+    case EVR_PixelData:
+    case EVR_OverlayData:
+    case EVR_pixelItem:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Descreve um objeto; valores grandes ou binários só são lidos com fullValue.
+ */
+DatasetEntry describe(DcmObject* object, DatasetNodeKind kind, std::size_t children, bool fullValue) {
+    DatasetEntry entry;
+    entry.kind = kind;
+    entry.children = children;
+    if (kind != DatasetNodeKind::Sequence && kind != DatasetNodeKind::Element) {
+        return entry;
+    }
+
+    DcmTag tag(object->getTag());
+    char text[16];
+    std::snprintf(text, sizeof(text), "(%04X,%04X)", tag.getGTag(), tag.getETag());
+    entry.tag = text;
+    const char* name = tag.getTagName();
+    entry.name = name ? name : "";
+    entry.vr = DcmVR(object->getVR()).getVRName();
+    const Uint32 length = object->getLengthField();
+    entry.undefinedLength = length == DCM_UndefinedLength;
+    entry.length = entry.undefinedLength ? 0 : length;
+    if (kind == DatasetNodeKind::Sequence) {
+        return entry;
+    }
+    if (entry.undefinedLength) {
+        // Pixels encapsulados: os fragmentos não são lidos aqui
+        entry.deferred = true;
+        return entry;
+    }
+
+    DcmElement* element = static_cast<DcmElement*>(object);
+    if (isBinary(object->ident())) {
+        if (length > DatasetTree::kInlineBinaryBytes && !fullValue) {
+            entry.deferred = true;
+            return entry;
+        }
+        // Apenas o início do valor é lido, mesmo que ele esteja no disco
+        const Uint32 count = std::min(length, DatasetTree::kBinaryPreviewBytes);
+        std::vector<Uint8> bytes(count);
+        if (count > 0 && element->getPartialValue(bytes.data(), 0, count).bad()) {
+            entry.deferred = true;
+            return entry;
+        }
+        static const char digits[] = "0123456789ABCDEF";
+        entry.value.reserve(static_cast<std::size_t>(count) * 3);
+        for (Uint32 i = 0; i < count; ++i) {
+            if (i > 0) {
+                entry.value.push_back(' ');
+            }
+            entry.value.push_back(digits[bytes[i] >> 4]);
+            entry.value.push_back(digits[bytes[i] & 0x0F]);
+        }
+        entry.truncated = count < length;
+        return entry;
+    }
+
+    if (length > DatasetTree::kInlineValueBytes && !fullValue) {
+        entry.deferred = true;
+        return entry;
+    }
+    OFString value;
+    if (element->getOFStringArray(value).good()) {
+        entry.value.assign(value.c_str(), std::min<std::size_t>(value.length(), DatasetTree::kMaxValueChars));
+        entry.truncated = value.length() > DatasetTree::kMaxValueChars;
+    }
+    return entry;
+}
+
+/**
+ * @brief Cópia em minúsculas (ASCII) de um texto.
+ */
+std::string lowered(const std::string& text) {
+    std::string result(text);
+    std::transform(result.begin(), result.end(), result.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return result;
+}
+
+/**
+ * @brief Estado de uma busca em andamento.
+ */
+struct SearchState {
+    std::string needle;                               ///< Texto procurado, em minúsculas
+    const DatasetSearchOptions* options = nullptr;
+    const DatasetSearchCallback* callback = nullptr;
+    std::vector<DatasetMatch> batch;
+    std::vector<uint32_t> path;
+    std::size_t matches = 0;
+    std::size_t visited = 0;
+    int percent = 0;
+    bool stopped = false;
+};
+
+/**
+ * @brief Entrega o lote atual; marca a busca como encerrada se o callback cancelar.
+ */
+void flush(SearchState& state) {
+    if (!(*state.callback)(state.batch, state.percent)) {
+        state.stopped = true;
+    }
+    state.batch.clear();
+}
+
+/**
+ * @brief true se a tag, o nome ou o valor contêm o texto procurado.
+ */
+bool matches(const DatasetEntry& entry, const std::string& needle) {
+    const std::string tag = lowered(entry.tag);
+    if (tag.find(needle) != std::string::npos) {
+        return true;
+    }
+    // "(0010,0010)" -> "00100010"
+    const std::string compact = tag.substr(1, 4) + tag.substr(6, 4);
+    if (compact.find(needle) != std::string::npos || lowered(entry.name).find(needle) != std::string::npos) {
+        return true;
+    }
+    return !entry.deferred && lowered(entry.value).find(needle) != std::string::npos;
+}
+
+/**
+ * @brief Percorre recursivamente os filhos de container, em ordem.
+ */
+void searchChildren(DcmObject* container, DatasetNodeKind kind, SearchState& state) {
+    const std::size_t total = childCount(container, kind);
+    uint32_t index = 0;
+    for (DcmObject* child = container->nextInContainer(nullptr); child && !state.stopped;
+         child = container->nextInContainer(child), ++index) {
+        if (kind == DatasetNodeKind::Dataset && total > 0) {
+            state.percent = static_cast<int>(static_cast<uint64_t>(index) * 100 / total);
+        }
+        state.path.push_back(index);
+        const DatasetNodeKind childKind = kindOf(child);
+        const std::size_t grandchildren = childCount(child, childKind);
+        if (childKind == DatasetNodeKind::Sequence || childKind == DatasetNodeKind::Element) {
+            DatasetEntry entry = describe(child, childKind, grandchildren, state.options->includeLargeValues);
+            if (matches(entry, state.needle)) {
+                state.batch.push_back(DatasetMatch{state.path, std::move(entry)});
+                ++state.matches;
+                if (state.matches >= state.options->maxMatches) {
+                    state.stopped = true;
+                }
+            }
+        }
+        if (grandchildren > 0 && !state.stopped) {
+            searchChildren(child, childKind, state);
+        }
+        state.path.pop_back();
+
+        if (!state.stopped && (state.batch.size() >= state.options->batchSize || ++state.visited % 4096 == 0)) {
+            flush(state);
+        }
+    }
+}
+
+}
+
+DatasetTree::DatasetTree() = default;
+
+DatasetTree::~DatasetTree() = default;
+
+/**
+ * @brief Lê a estrutura do arquivo, deixando os valores grandes no disco.
+ */
+std::unique_ptr<DatasetTree> DatasetTree::open(const std::string& path) {
+    DICOM_TRACE_SCOPE(traceScope, "tag-tree");
+    std::unique_ptr<DatasetTree> tree(new DatasetTree());
+    tree->file = std::make_unique<DcmFileFormat>();
+    OFCondition status = tree->file->loadFile(path.c_str(), EXS_Unknown, EGL_noChange, DCM_MaxReadLength, ERM_fileOnly);
+    if (status.bad()) {
+        std::cerr << "Error: cannot read DICOM file (" << status.text() << ")" << std::endl;
+        return nullptr;
+    }
+    tree->rootNode = std::make_unique<DatasetNode>();
+    tree->rootNode->object = tree->file.get();
+    tree->rootNode->kind = DatasetNodeKind::File;
+    tree->rootNode->childTotal = childCount(tree->file.get(), DatasetNodeKind::File);
+    return tree;
+}
+
+/**
+ * @brief Materializa os filhos de node até count (recortado a childTotal).
+ *
+ * A continuação parte do último filho materializado: nextInContainer
+ * avança a partir do cursor da lista em O(1), enquanto getItem(i)
+ * recomeçaria do início a cada chamada.
+ */
+std::size_t DatasetTree::materialize(DatasetNode& node, std::size_t count) {
+    count = std::min(count, node.childTotal);
+    if (node.children.size() >= count) {
+        return node.children.size();
+    }
+    DcmObject* next = node.object->nextInContainer(node.children.empty() ? nullptr : node.children.back()->object);
+    while (next) {
+        auto child = std::make_unique<DatasetNode>();
+        child->object = next;
+        child->parent = &node;
+        child->row = node.children.size();
+        child->kind = kindOf(next);
+        child->childTotal = childCount(next, child->kind);
+        node.children.push_back(std::move(child));
+        if (node.children.size() >= count) {
+            break;
+        }
+        next = node.object->nextInContainer(next);
+    }
+    if (!next) {
+        // A lista acabou antes do esperado: o total passa a ser o que existe
+        node.childTotal = node.children.size();
+    }
+    return node.children.size();
+}
+
+/**
+ * @brief Localiza o nó de um caminho de índices a partir da raiz, materializando o trajeto.
+ */
+DatasetNode* DatasetTree::find(const std::vector<uint32_t>& path) {
+    DatasetNode* node = rootNode.get();
+    for (uint32_t row : path) {
+        if (materialize(*node, static_cast<std::size_t>(row) + 1) <= row) {
+            return nullptr;
+        }
+        node = node->children[row].get();
+    }
+    return node;
+}
+
+/**
+ * @brief Descrição do nó, calculada no primeiro acesso e guardada no nó.
+ */
+const DatasetEntry& DatasetTree::entry(DatasetNode& node) {
+    if (!node.entry) {
+        node.entry = describe(node.object, node.kind, node.childTotal, node.fullValue);
+    }
+    return *node.entry;
+}
+
+/**
+ * @brief Procura um texto na tag, no nome ou no valor de todos os elementos do arquivo.
+ */
+std::size_t searchDataset(const std::string& path, const std::string& query,
+                          const DatasetSearchOptions& options, const DatasetSearchCallback& callback) {
+    if (query.empty()) {
+        return 0;
+    }
+    std::unique_ptr<DatasetTree> tree = DatasetTree::open(path);
+    if (!tree) {
+        return 0;
+    }
+    DICOM_TRACE_SCOPE(traceScope, "tag-search");
+    SearchState state;
+    state.needle = lowered(query);
+    state.options = &options;
+    state.callback = &callback;
+    DatasetNode& root = tree->root();
+    searchChildren(root.object, root.kind, state);
+    if (!state.stopped || !state.batch.empty()) {
+        state.percent = 100;
+        (*state.callback)(state.batch, state.percent);
+    }
+    return state.matches;
+}
+
+}
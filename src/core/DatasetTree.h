@@ -0,0 +1,172 @@
+/**
+ * DICOM Viewer - Árvore Preguiçosa de Tags DICOM
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#ifndef DATASETTREE_H
+#define DATASETTREE_H
+
+class DcmObject;
+class DcmFileFormat;
+
+namespace dicom_viewer_core {
+
+/**
+ * @brief Papel de um nó na árvore do arquivo.
+ */
+enum class DatasetNodeKind {
+    File,                                             ///< Raiz: o arquivo inteiro
+    MetaHeader,                                       ///< Grupo 0002 (File Meta Information)
+    Dataset,                                          ///< Conjunto de dados principal
+    Sequence,                                         ///< Elemento SQ (filhos são itens)
+    Item,                                             ///< Item de sequência (filhos são elementos)
+    Element                                           ///< Elemento folha
+};
+
+/**
+ * @struct DatasetEntry
+ * @brief Descrição de um nó pronta para exibição.
+ */
+struct DatasetEntry {
+    DatasetNodeKind kind = DatasetNodeKind::Element;
+    std::string tag;                                  ///< "(gggg,eeee)"; vazio para itens e raízes
+    std::string name;                                 ///< Nome no dicionário ("Unknown Tag & Data" se ausente)
+    std::string vr;                                   ///< Representação de valor ("SQ", "OB", ...)
+    uint32_t length = 0;                              ///< Comprimento do valor, em bytes
+    bool undefinedLength = false;                     ///< Comprimento indefinido (sequências, pixels encapsulados)
+    std::size_t children = 0;                         ///< Itens ou elementos contidos
+    std::string value;                                ///< Valor formatado (vazio se adiado)
+    bool deferred = false;                            ///< Valor omitido por ser grande ou binário
+    bool truncated = false;                           ///< value contém apenas o início do valor
+};
+
+/**
+ * @struct DatasetNode
+ * @brief Nó materializado da árvore; os filhos são criados sob demanda.
+ */
+struct DatasetNode {
+    DcmObject* object = nullptr;                      ///< Objeto DCMTK (pertence ao DcmFileFormat da árvore)
+    DatasetNode* parent = nullptr;
+    std::size_t row = 0;                              ///< Posição no pai
+    DatasetNodeKind kind = DatasetNodeKind::Element;
+    std::size_t childTotal = 0;                       ///< Filhos no arquivo, materializados ou não
+    std::vector<std::unique_ptr<DatasetNode>> children; ///< Prefixo materializado dos filhos
+    bool fullValue = false;                           ///< Exibir o valor mesmo se grande ou binário
+    std::optional<DatasetEntry> entry;                ///< Descrição calculada no primeiro acesso
+};
+
+/**
+ * @class DatasetTree
+ * @brief Árvore completa de um arquivo DICOM, com nós materializados apenas quando pedidos.
+ *
+ * O arquivo é lido pelo DCMTK com valores acima de DCM_MaxReadLength deixados
+ * no disco, de modo que pixels e outros blocos binários não ocupam memória
+ * até serem pedidos. Sobre o DcmFileFormat, cada nó guarda apenas o prefixo
+ * de filhos já pedido: um item com centenas de milhares de filhos (RTSTRUCT,
+ * SR, grupos funcionais de multi-frame) custa memória proporcional ao que foi
+ * expandido. Os filhos são percorridos com nextInContainer, que continua da
+ * posição anterior da lista, e não com getItem/getElement, cujo custo cresce
+ * com o índice.
+ *
+ * Não é thread-safe: o DCMTK guarda o cursor das listas no próprio objeto.
+ * Buscas em segundo plano abrem o arquivo novamente (searchDataset).
+ */
+class DatasetTree {
+public:
+    static constexpr uint32_t kInlineValueBytes = 1024;          ///< Valores textuais maiores são adiados
+    static constexpr uint32_t kInlineBinaryBytes = 64;           ///< Valores binários maiores são adiados
+    static constexpr uint32_t kBinaryPreviewBytes = 256;         ///< Bytes exibidos de um binário pedido
+    static constexpr std::size_t kMaxValueChars = 65536;         ///< Limite de um valor textual pedido
+
+    /**
+     * @brief Lê a estrutura do arquivo, deixando os valores grandes no disco.
+     * @param path Caminho do arquivo DICOM.
+     * @return A árvore, ou nullptr se o arquivo não puder ser lido.
+     */
+    static std::unique_ptr<DatasetTree> open(const std::string& path);
+
+    ~DatasetTree();
+
+    DatasetNode& root() { return *rootNode; }
+
+    /**
+     * @brief Materializa os filhos de node até count (recortado a childTotal).
+     * @return Número de filhos materializados após a chamada.
+     */
+    std::size_t materialize(DatasetNode& node, std::size_t count);
+
+    /**
+     * @brief Localiza o nó de um caminho de índices a partir da raiz, materializando o trajeto.
+     * @return O nó, ou nullptr se o caminho não existir.
+     */
+    DatasetNode* find(const std::vector<uint32_t>& path);
+
+    /**
+     * @brief Descrição do nó, calculada no primeiro acesso e guardada no nó.
+     */
+    static const DatasetEntry& entry(DatasetNode& node);
+
+private:
+    DatasetTree();
+
+    std::unique_ptr<DcmFileFormat> file;
+    std::unique_ptr<DatasetNode> rootNode;
+};
+
+/**
+ * @struct DatasetSearchOptions
+ * @brief Parâmetros de searchDataset().
+ */
+struct DatasetSearchOptions {
+    bool includeLargeValues = false;                  ///< Lê do disco os valores adiados para comparar
+    std::size_t batchSize = 256;                      ///< Ocorrências por chamada do callback
+    std::size_t maxMatches = 100000;                  ///< A busca para depois de tantas ocorrências
+};
+
+/**
+ * @struct DatasetMatch
+ * @brief Ocorrência de uma busca: caminho a partir da raiz e descrição do nó.
+ */
+struct DatasetMatch {
+    std::vector<uint32_t> path;                       ///< Índices a partir da raiz (ver DatasetTree::find)
+    DatasetEntry entry;
+};
+
+/**
+ * @brief Recebe um lote de ocorrências (possivelmente vazio) e o progresso.
+ * @return false para cancelar a busca.
+ */
+using DatasetSearchCallback = std::function<bool(std::vector<DatasetMatch>& batch, int percent)>;
+
+/**
+ * @brief Procura um texto na tag, no nome ou no valor de todos os elementos do arquivo.
+ *
+ * A comparação ignora maiúsculas e aceita a tag como "(0010,0010)" ou
+ * "00100010". O arquivo é lido de novo, com uma árvore própria, para que a
+ * busca rode em outra thread sem tocar a árvore exibida. As ocorrências são
+ * entregues em lotes à medida que aparecem; o callback também é chamado a
+ * cada poucos milhares de nós, com o lote vazio, para permitir o cancelamento.
+ *
+ * @param path Caminho do arquivo DICOM.
+ * @param query Texto procurado (não vazio).
+ * @param options Parâmetros da busca.
+ * @param callback Destino dos lotes.
+ * @return Número de ocorrências entregues.
+ */
+std::size_t searchDataset(const std::string& path, const std::string& query,
+                          const DatasetSearchOptions& options, const DatasetSearchCallback& callback);
+
+}
+
+#endif // DATASETTREE_H
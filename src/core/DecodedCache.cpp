@@ -0,0 +1,430 @@
+/**
+ * DICOM Viewer - Cache em Disco de Pixels Decodificados
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "DecodedCache.h"
+#include "MappedFile.h"
+
+namespace dicom_viewer_core {
+
+namespace {
+
+constexpr char kMagic[8] = {'D', 'V', 'P', 'I', 'X', 'E', 'L', 'S'};
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kByteOrderMark = 0x01020304u;  ///< Lido diferente em outra ordem de bytes
+constexpr std::size_t kHeaderBytes = 4096;        ///< Os pixels começam alinhados à página
+constexpr const char* kEntrySuffix = ".px";
+constexpr const char* kTemporarySuffix = ".tmp";
+
+/**
+ * @struct EntryHeader
+ * @brief Início de cada entrada, gravado como está no primeiro bloco de kHeaderBytes.
+ */
+struct EntryHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t headerBytes;
+    uint64_t pixelBytes;
+    uint64_t fileSize;
+    int64_t modified;
+    char sopInstanceUid[72];
+    char photometricInterpretation[24];
+    int32_t width;
+    int32_t height;
+    int32_t bitDepth;
+    int32_t samplesPerPixel;
+    int32_t bitsAllocated;
+    int32_t bitsStored;
+    int32_t highBit;
+    int32_t pixelRepresentation;
+    int32_t planarConfiguration;
+    int32_t numberOfFrames;
+    uint8_t fullPrecision;
+    uint8_t floatingPoint;
+    uint8_t variant;
+    uint8_t reserved[5];
+    double spacingX;
+    double spacingY;
+    double windowCenter;
+    double windowWidth;
+    double rescaleSlope;
+    double rescaleIntercept;
+    double frameTimeMs;
+};
+
+static_assert(sizeof(EntryHeader) <= kHeaderBytes, "cabeçalho maior que o bloco reservado");
+
+/**
+ * @brief Hash FNV-1a de 64 bits, estável entre execuções e plataformas.
+ */
+uint64_t fnv1a(uint64_t hash, const void* data, std::size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+bool endsWith(const std::string& text, const char* suffix) {
+    const std::size_t length = std::strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+/**
+ * @brief Sufixo distinto por processo e por gravação para os arquivos temporários.
+ */
+std::string temporaryTag() {
+    static const uint64_t processTag = (static_cast<uint64_t>(std::random_device()()) << 32) ^ std::random_device()();
+    static std::atomic<uint64_t> counter{0};
+    char tag[40];
+    std::snprintf(tag, sizeof(tag), ".%016llx.%llu", static_cast<unsigned long long>(processTag),
+                  static_cast<unsigned long long>(counter.fetch_add(1)));
+    return tag;
+}
+
+std::mutex globalMutex;
+std::shared_ptr<DecodedCache> globalCache;
+
+}
+
+/**
+ * @brief Abre (criando se necessário) o diretório do cache.
+ */
+std::shared_ptr<DecodedCache> DecodedCache::open(const std::string& directory, uint64_t budgetBytes) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error || !std::filesystem::is_directory(directory, error)) {
+        std::cerr << "Error: cannot create decoded cache directory " << directory << std::endl;
+        return nullptr;
+    }
+    std::shared_ptr<DecodedCache> cache(new DecodedCache());
+    cache->directory = directory;
+    cache->budgetBytes = budgetBytes;
+    return cache;
+}
+
+/**
+ * @brief Nome do arquivo da entrada, derivado de todos os campos da chave.
+ */
+std::string DecodedCache::entryName(const DecodedKey& key) const {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    hash = fnv1a(hash, key.sopInstanceUid.data(), key.sopInstanceUid.size());
+    hash = fnv1a(hash, &key.fileSize, sizeof(key.fileSize));
+    hash = fnv1a(hash, &key.modified, sizeof(key.modified));
+    const uint8_t variant = key.fullPrecision ? 1 : 0;
+    hash = fnv1a(hash, &variant, sizeof(variant));
+    char name[24];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+    return std::string(name) + kEntrySuffix;
+}
+
+/**
+ * @brief Procura a imagem da chave e mapeia os seus pixels.
+ */
+bool DecodedCache::lookup(const DecodedKey& key, MedicalImage& image) {
+    auto miss = [this]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++misses;
+        return false;
+    };
+    if (!key.isValid()) {
+        return miss();
+    }
+    const std::string name = entryName(key);
+    const std::string path = (std::filesystem::path(directory) / name).string();
+
+    // A ausência do arquivo é o caso comum de falha: verificada sem passar pelo MappedFile
+    EntryHeader header;
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            return miss();
+        }
+    }
+    // Outra chave com o mesmo hash, outra versão do formato ou entrada truncada
+    std::error_code error;
+    const uint64_t entryBytes = static_cast<uint64_t>(std::filesystem::file_size(path, error));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.byteOrder != kByteOrderMark || header.headerBytes != kHeaderBytes ||
+        header.fileSize != key.fileSize || header.modified != key.modified ||
+        header.variant != (key.fullPrecision ? 1 : 0) ||
+        std::strncmp(header.sopInstanceUid, key.sopInstanceUid.c_str(), sizeof(header.sopInstanceUid)) != 0 ||
+        header.width <= 0 || header.height <= 0 || header.pixelBytes == 0 ||
+        error || entryBytes != kHeaderBytes + header.pixelBytes) {
+        return miss();
+    }
+
+    std::unique_ptr<MappedFile> file = MappedFile::open(path);
+    if (!file) {
+        return miss();
+    }
+    // O mapeamento continua válido depois que o arquivo é fechado. Se a entrada for removida, no POSIX o
+    // nome some e as páginas continuam acessíveis; no Windows a remoção só se completa ao desfazer o mapeamento
+    auto view = std::make_shared<MappedFile::View>(file->map(kHeaderBytes, static_cast<std::size_t>(header.pixelBytes)));
+    if (!view->isValid()) {
+        return miss();
+    }
+    const uint8_t* pixels = view->data();
+    image.buffer = PixelBuffer::wrap(std::shared_ptr<const uint8_t>(std::move(view), pixels),
+                                     static_cast<std::size_t>(header.pixelBytes));
+    image.width = header.width;
+    image.height = header.height;
+    image.bitDepth = header.bitDepth;
+    image.samplesPerPixel = header.samplesPerPixel;
+    image.bitsAllocated = header.bitsAllocated;
+    image.bitsStored = header.bitsStored;
+    image.highBit = header.highBit;
+    image.pixelRepresentation = header.pixelRepresentation;
+    image.planarConfiguration = header.planarConfiguration;
+    image.numberOfFrames = header.numberOfFrames;
+    image.fullPrecision = header.fullPrecision != 0;
+    image.floatingPoint = header.floatingPoint != 0;
+    image.spacingX = header.spacingX;
+    image.spacingY = header.spacingY;
+    image.windowCenter = header.windowCenter;
+    image.windowWidth = header.windowWidth;
+    image.rescaleSlope = header.rescaleSlope;
+    image.rescaleIntercept = header.rescaleIntercept;
+    image.frameTimeMs = header.frameTimeMs;
+    const char* photometric = header.photometricInterpretation;
+    image.photometricInterpretation.assign(photometric,
+                                           std::find(photometric, photometric + sizeof(header.photometricInterpretation), '\0'));
+
+    // A data de modificação da entrada guarda o último uso para a remoção entre execuções
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+    std::lock_guard<std::mutex> lock(mutex);
+    ++hits;
+    if (indexed) {
+        touch(name, entryBytes);
+    }
+    return true;
+}
+
+/**
+ * @brief Grava a imagem da chave, apagando entradas antigas se o limite for excedido.
+ */
+bool DecodedCache::store(const DecodedKey& key, const MedicalImage& image) {
+    if (!key.isValid() || !image.isValid()) {
+        return false;
+    }
+    const uint64_t entryBytes = kHeaderBytes + image.buffer.size();
+    if (entryBytes > budgetBytes) {
+        return false;
+    }
+
+    std::vector<char> block(kHeaderBytes, 0);
+    EntryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byteOrder = kByteOrderMark;
+    header.headerBytes = kHeaderBytes;
+    header.pixelBytes = image.buffer.size();
+    header.fileSize = key.fileSize;
+    header.modified = key.modified;
+    header.variant = key.fullPrecision ? 1 : 0;
+    std::memcpy(header.sopInstanceUid, key.sopInstanceUid.data(), key.sopInstanceUid.size());
+    std::strncpy(header.photometricInterpretation, image.photometricInterpretation.c_str(),
+                 sizeof(header.photometricInterpretation) - 1);
+    header.width = image.width;
+    header.height = image.height;
+    header.bitDepth = image.bitDepth;
+    header.samplesPerPixel = image.samplesPerPixel;
+    header.bitsAllocated = image.bitsAllocated;
+    header.bitsStored = image.bitsStored;
+    header.highBit = image.highBit;
+    header.pixelRepresentation = image.pixelRepresentation;
+    header.planarConfiguration = image.planarConfiguration;
+    header.numberOfFrames = image.numberOfFrames;
+    header.fullPrecision = image.fullPrecision ? 1 : 0;
+    header.floatingPoint = image.floatingPoint ? 1 : 0;
+    header.spacingX = image.spacingX;
+    header.spacingY = image.spacingY;
+    header.windowCenter = image.windowCenter;
+    header.windowWidth = image.windowWidth;
+    header.rescaleSlope = image.rescaleSlope;
+    header.rescaleIntercept = image.rescaleIntercept;
+    header.frameTimeMs = image.frameTimeMs;
+    std::memcpy(block.data(), &header, sizeof(header));
+
+    // Gravada por inteiro em um temporário: quem consulta vê a entrada completa ou nenhuma
+    const std::string name = entryName(key);
+    const std::filesystem::path finalPath = std::filesystem::path(directory) / name;
+    const std::filesystem::path temporaryPath = std::filesystem::path(directory) / (name + temporaryTag() + kTemporarySuffix);
+    std::error_code error;
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        file.write(block.data(), static_cast<std::streamsize>(block.size()));
+        file.write(reinterpret_cast<const char*>(image.buffer.data()), static_cast<std::streamsize>(image.buffer.size()));
+        file.close();
+        if (!file) {
+            std::cerr << "Error: cannot write decoded cache entry " << temporaryPath.string() << std::endl;
+            std::filesystem::remove(temporaryPath, error);
+            return false;
+        }
+    }
+    std::filesystem::rename(temporaryPath, finalPath, error);
+    if (error) {
+        std::cerr << "Error: cannot replace decoded cache entry " << finalPath.string() << " (" << error.message() << ")" << std::endl;
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ensureIndexed();
+    touch(name, entryBytes);
+    ++stores;
+    // Da entrada mais antiga para a mais recente, sem apagar a que acabou de ser gravada. Uma entrada
+    // que não pôde ser apagada continua contada e volta a ser tentada na próxima gravação
+    auto victim = lru.end();
+    while (totalBytes > budgetBytes && victim != std::next(lru.begin())) {
+        --victim;
+        if (!std::filesystem::remove(std::filesystem::path(directory) / *victim, error) && error) {
+            continue;
+        }
+        totalBytes -= entries[*victim].bytes;
+        entries.erase(*victim);
+        victim = lru.erase(victim);
+        ++evictions;
+    }
+    return true;
+}
+
+/**
+ * @brief Apaga todas as entradas.
+ */
+bool DecodedCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    ensureIndexed();
+    bool removedAll = true;
+    std::error_code error;
+    for (auto entry = lru.begin(); entry != lru.end();) {
+        if (!std::filesystem::remove(std::filesystem::path(directory) / *entry, error) && error) {
+            removedAll = false;
+            ++entry;
+            continue;
+        }
+        totalBytes -= entries[*entry].bytes;
+        entries.erase(*entry);
+        entry = lru.erase(entry);
+    }
+    return removedAll;
+}
+
+/**
+ * @brief Ocupação e contadores desde a abertura.
+ */
+DecodedCacheStats DecodedCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    DecodedCacheStats result;
+    result.hits = hits;
+    result.misses = misses;
+    result.stores = stores;
+    result.evictions = evictions;
+    result.bytes = totalBytes;
+    result.budgetBytes = budgetBytes;
+    return result;
+}
+
+/**
+ * @brief Monta o índice das entradas existentes, da usada mais recentemente à mais antiga.
+ *
+ * Chamado com o mutex travado. Temporários com mais de uma hora são restos
+ * de gravações interrompidas e são apagados.
+ */
+void DecodedCache::ensureIndexed() {
+    if (indexed) {
+        return;
+    }
+    indexed = true;
+
+    struct Found {
+        std::filesystem::file_time_type used;
+        std::string name;
+        uint64_t bytes;
+    };
+    std::vector<Found> found;
+    const auto staleBefore = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        std::error_code entryError;
+        if (!entry.is_regular_file(entryError)) {
+            continue;
+        }
+        const std::string name = entry.path().filename().string();
+        const auto used = entry.last_write_time(entryError);
+        if (entryError) {
+            continue;
+        }
+        if (endsWith(name, kTemporarySuffix)) {
+            if (used < staleBefore) {
+                std::filesystem::remove(entry.path(), entryError);
+            }
+        } else if (endsWith(name, kEntrySuffix)) {
+            const uint64_t bytes = static_cast<uint64_t>(entry.file_size(entryError));
+            if (!entryError) {
+                found.push_back({used, name, bytes});
+            }
+        }
+    }
+    std::sort(found.begin(), found.end(), [](const Found& a, const Found& b) { return a.used > b.used; });
+    for (const Found& entry : found) {
+        lru.push_back(entry.name);
+        entries[entry.name] = Entry{entry.bytes, std::prev(lru.end())};
+        totalBytes += entry.bytes;
+    }
+}
+
+/**
+ * @brief Registra o uso de uma entrada, colocando-a no topo da ordem de remoção.
+ *
+ * Chamado com o mutex travado.
+ */
+void DecodedCache::touch(const std::string& name, uint64_t bytes) {
+    auto found = entries.find(name);
+    if (found != entries.end()) {
+        totalBytes -= found->second.bytes;
+        lru.erase(found->second.position);
+        entries.erase(found);
+    }
+    lru.push_front(name);
+    entries[name] = Entry{bytes, lru.begin()};
+    totalBytes += bytes;
+}
+
+/**
+ * @brief Define o cache usado por loadDicomRaw() em arquivos comprimidos (nullptr desativa).
+ */
+void setDecodedCache(std::shared_ptr<DecodedCache> cache) {
+    std::lock_guard<std::mutex> lock(globalMutex);
+    globalCache = std::move(cache);
+}
+
+/**
+ * @brief Cache definido por setDecodedCache(), ou nullptr.
+ */
+std::shared_ptr<DecodedCache> decodedCache() {
+    std::lock_guard<std::mutex> lock(globalMutex);
+    return globalCache;
+}
+
+}
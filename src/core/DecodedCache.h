@@ -0,0 +1,154 @@
+/**
+ * DICOM Viewer - Cache em Disco de Pixels Decodificados
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "MedicalImage.h"
+
+#ifndef DECODEDCACHE_H
+#define DECODEDCACHE_H
+
+namespace dicom_viewer_core {
+
+/**
+ * @struct DecodedKey
+ * @brief Identifica a imagem decodificada de um arquivo DICOM.
+ *
+ * O SOP Instance UID identifica a instância; tamanho e data de modificação
+ * do arquivo invalidam a entrada quando o arquivo é regravado. A mesma
+ * instância tem entradas separadas em precisão total e em 8 bits de exibição.
+ */
+struct DecodedKey {
+    std::string sopInstanceUid;                       ///< SOP Instance UID (até 64 caracteres)
+    uint64_t fileSize = 0;                            ///< Tamanho do arquivo em bytes
+    int64_t modified = 0;                             ///< Data de modificação (unidade do sistema de arquivos)
+    bool fullPrecision = false;                       ///< Variante pedida a loadDicomRaw (want16Bit)
+
+    bool isValid() const { return !sopInstanceUid.empty() && sopInstanceUid.size() <= 64; }
+};
+
+/**
+ * @struct DecodedCacheStats
+ * @brief Ocupação e atividade do cache desde a abertura.
+ */
+struct DecodedCacheStats {
+    uint64_t hits = 0;                                ///< Imagens obtidas do cache
+    uint64_t misses = 0;                              ///< Consultas sem entrada válida
+    uint64_t stores = 0;                              ///< Entradas gravadas
+    uint64_t evictions = 0;                           ///< Entradas apagadas pelo limite de tamanho
+    uint64_t bytes = 0;                               ///< Bytes das entradas conhecidas (após a primeira gravação)
+    uint64_t budgetBytes = 0;                         ///< Limite de tamanho do cache
+};
+
+/**
+ * @class DecodedCache
+ * @brief Pixels do primeiro quadro de arquivos comprimidos, guardados já decodificados em disco.
+ *
+ * Cada entrada é um arquivo com um cabeçalho fixo de 4 KB (chave, geometria
+ * e formato dos pixels) seguido dos pixels no formato de MedicalImage::buffer,
+ * na ordem de bytes local. lookup() mapeia os pixels direto no buffer da
+ * imagem (PixelBuffer::wrap), sem cópia: reabrir um estudo já visto custa a
+ * leitura do cabeçalho e um mmap em vez da descompressão.
+ *
+ * Entradas são gravadas em um arquivo temporário e renomeadas, de modo que
+ * um leitor nunca vê uma entrada incompleta. O tamanho total é limitado por
+ * budgetBytes: as entradas usadas há mais tempo (data de modificação do
+ * arquivo, atualizada a cada acerto) são apagadas primeiro; uma entrada que
+ * não pôde ser apagada continua contada no tamanho e é tentada de novo na
+ * gravação seguinte. O índice das entradas é montado na primeira gravação,
+ * fora da thread da interface.
+ *
+ * Todos os métodos são seguros para chamadas concorrentes.
+ */
+class DecodedCache {
+public:
+    DecodedCache(const DecodedCache&) = delete;
+    DecodedCache& operator=(const DecodedCache&) = delete;
+
+    /**
+     * @brief Abre (criando se necessário) o diretório do cache.
+     * @param directory Diretório exclusivo do cache.
+     * @param budgetBytes Tamanho máximo das entradas, em bytes.
+     * @return O cache, ou nullptr se o diretório não puder ser criado.
+     */
+    static std::shared_ptr<DecodedCache> open(const std::string& directory, uint64_t budgetBytes);
+
+    /**
+     * @brief Procura a imagem da chave.
+     *
+     * Em caso de acerto, substitui geometria, formato dos pixels e buffer de
+     * image; os demais metadados (paciente, estudo, modalidade) são mantidos.
+     *
+     * @return true se a entrada existe e corresponde à chave.
+     */
+    bool lookup(const DecodedKey& key, MedicalImage& image);
+
+    /**
+     * @brief Grava a imagem da chave, apagando entradas antigas se o limite for excedido.
+     * @return false se a imagem não couber no cache ou a gravação falhar.
+     */
+    bool store(const DecodedKey& key, const MedicalImage& image);
+
+    /**
+     * @brief Apaga todas as entradas.
+     *
+     * Imagens já obtidas por lookup() continuam válidas. Gravações em
+     * andamento em outras threads podem criar entradas novas logo depois.
+     *
+     * @return false se alguma entrada não pôde ser apagada (continua contada e volta a ser tentada).
+     */
+    bool clear();
+
+    /**
+     * @brief Ocupação e contadores desde a abertura.
+     */
+    DecodedCacheStats stats() const;
+
+private:
+    DecodedCache() = default;
+    std::string entryName(const DecodedKey& key) const;
+    void ensureIndexed();
+    void touch(const std::string& name, uint64_t bytes);
+
+    std::string directory;
+    uint64_t budgetBytes = 0;
+
+    mutable std::mutex mutex;
+    bool indexed = false;
+    std::list<std::string> lru;                       ///< Entradas, da mais recente à mais antiga
+    struct Entry {
+        uint64_t bytes = 0;
+        std::list<std::string>::iterator position;
+    };
+    std::unordered_map<std::string, Entry> entries;
+    uint64_t totalBytes = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t stores = 0;
+    uint64_t evictions = 0;
+};
+
+/**
+ * @brief Define o cache usado por loadDicomRaw() em arquivos comprimidos (nullptr desativa).
+ */
+void setDecodedCache(std::shared_ptr<DecodedCache> cache);
+
+/**
+ * @brief Cache definido por setDecodedCache(), ou nullptr.
+ */
+std::shared_ptr<DecodedCache> decodedCache();
+
+}
+
+#endif // DECODEDCACHE_H
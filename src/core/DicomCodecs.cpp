@@ -0,0 +1,62 @@
+/**
+ * DICOM Viewer - Registro de Codecs DCMTK
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <mutex>
+#include <iostream>
+
+#include <dcmtk/dcmdata/dcdict.h>
+#include <dcmtk/dcmdata/dcrledrg.h>
+#include <dcmtk/dcmjpeg/djdecode.h>
+#include <dcmtk/dcmjpls/djdecode.h>
+
+#include "DicomCodecs.h"
+
+namespace dicom_viewer_core {
+
+namespace {
+std::mutex codecsMutex;
+bool codecsRegistered = false;
+}
+
+/**
+ * @brief Registra os decodificadores DCMTK uma única vez por processo.
+ *
+ * Registra JPEG (baseline, estendido e lossless), JPEG-LS e RLE. O JPEG 2000
+ * não tem codec no DCMTK livre e é tratado pelo OpenJPEG em FrameDecoder.
+ * Também força o carregamento do dicionário de dados, para que as threads de
+ * carregamento não disputem a sua inicialização preguiçosa.
+ */
+void ensureCodecsRegistered() {
+    std::lock_guard<std::mutex> lock(codecsMutex);
+    if (codecsRegistered) {
+        return;
+    }
+    if (!dcmDataDict.isDictionaryLoaded()) {
+        std::cerr << "Warning: DICOM data dictionary not loaded" << std::endl;
+    }
+    DJDecoderRegistration::registerCodecs();
+    DJLSDecoderRegistration::registerCodecs();
+    DcmRLEDecoderRegistration::registerCodecs();
+    codecsRegistered = true;
+}
+
+/**
+ * @brief Libera os decodificadores registrados por ensureCodecsRegistered().
+ */
+void releaseCodecs() {
+    std::lock_guard<std::mutex> lock(codecsMutex);
+    if (!codecsRegistered) {
+        return;
+    }
+    DcmRLEDecoderRegistration::cleanup();
+    DJLSDecoderRegistration::cleanup();
+    DJDecoderRegistration::cleanup();
+    codecsRegistered = false;
+}
+
+}
@@ -0,0 +1,34 @@
+/**
+ * DICOM Viewer - Registro de Codecs DCMTK
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#ifndef DICOMCODECS_H
+#define DICOMCODECS_H
+
+namespace dicom_viewer_core {
+
+/**
+ * @brief Registra os decodificadores DCMTK uma única vez por processo.
+ *
+ * O registro dos codecs altera o estado global do DCMTK. Esta função pode ser
+ * chamada quantas vezes for necessário e de qualquer thread: apenas a primeira
+ * chamada efetivamente registra os codecs. Os codecs permanecem registrados
+ * até releaseCodecs(), de modo que várias threads podem decodificar ao mesmo tempo.
+ */
+void ensureCodecsRegistered();
+
+/**
+ * @brief Libera os decodificadores registrados por ensureCodecsRegistered().
+ *
+ * Deve ser chamada apenas no encerramento do processo, quando nenhuma
+ * decodificação estiver em andamento.
+ */
+void releaseCodecs();
+
+}
+
+#endif // DICOMCODECS_H
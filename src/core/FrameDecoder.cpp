@@ -0,0 +1,525 @@
+/**
+ * DICOM Viewer - Decodificação Paralela de Quadros
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <dcmtk/dcmdata/dctk.h>
+#include <dcmtk/dcmdata/dcpixseq.h>
+#include <dcmtk/dcmdata/dcpxitem.h>
+
+#if defined(DICOM_VIEWER_HAS_OPENJPEG)
+#include <openjpeg.h>
+#endif
+
+#include "FrameDecoder.h"
+#include "DicomCodecs.h"
+#include "ThreadPool.h"
+#include "Trace.h"
+
+namespace dicom_viewer_core {
+
+namespace {
+
+bool isJpeg2000(E_TransferSyntax syntax) {
+    return syntax == EXS_JPEG2000LosslessOnly || syntax == EXS_JPEG2000;
+}
+
+#if defined(DICOM_VIEWER_HAS_OPENJPEG)
+
+/**
+ * @brief Fluxo de leitura do OpenJPEG sobre um buffer em memória.
+ */
+struct MemoryStream {
+    const uint8_t* data = nullptr;
+    std::size_t size = 0;
+    std::size_t offset = 0;
+};
+
+OPJ_SIZE_T readMemory(void* buffer, OPJ_SIZE_T count, void* userData) {
+    MemoryStream* stream = static_cast<MemoryStream*>(userData);
+    if (stream->offset >= stream->size) {
+        return static_cast<OPJ_SIZE_T>(-1);
+    }
+    const std::size_t available = std::min<std::size_t>(count, stream->size - stream->offset);
+    std::memcpy(buffer, stream->data + stream->offset, available);
+    stream->offset += available;
+    return available;
+}
+
+OPJ_OFF_T skipMemory(OPJ_OFF_T count, void* userData) {
+    MemoryStream* stream = static_cast<MemoryStream*>(userData);
+    const OPJ_OFF_T position = std::clamp<OPJ_OFF_T>(static_cast<OPJ_OFF_T>(stream->offset) + count, 0,
+                                                     static_cast<OPJ_OFF_T>(stream->size));
+    const OPJ_OFF_T skipped = position - static_cast<OPJ_OFF_T>(stream->offset);
+    stream->offset = static_cast<std::size_t>(position);
+    return skipped;
+}
+
+OPJ_BOOL seekMemory(OPJ_OFF_T position, void* userData) {
+    MemoryStream* stream = static_cast<MemoryStream*>(userData);
+    if (position < 0 || static_cast<std::size_t>(position) > stream->size) {
+        return OPJ_FALSE;
+    }
+    stream->offset = static_cast<std::size_t>(position);
+    return OPJ_TRUE;
+}
+
+/**
+ * @brief Decodifica um codestream JPEG 2000 (ou arquivo JP2) em amostras intercaladas.
+ */
+bool decodeJpeg2000(const std::vector<uint8_t>& encoded, int rows, int columns, int samplesPerPixel,
+                    int bitsAllocated, uint8_t* destination, std::size_t frameBytes) {
+    static const uint8_t kJp2Signature[] = {0x00, 0x00, 0x00, 0x0C, 0x6A, 0x50, 0x20, 0x20};
+    const bool jp2 = encoded.size() >= sizeof(kJp2Signature) &&
+                     std::memcmp(encoded.data(), kJp2Signature, sizeof(kJp2Signature)) == 0;
+
+    opj_codec_t* codec = opj_create_decompress(jp2 ? OPJ_CODEC_JP2 : OPJ_CODEC_J2K);
+    opj_dparameters_t parameters;
+    opj_set_default_decoder_parameters(&parameters);
+    opj_setup_decoder(codec, &parameters);
+
+    MemoryStream source{encoded.data(), encoded.size(), 0};
+    opj_stream_t* stream = opj_stream_create(OPJ_J2K_STREAM_CHUNK_SIZE, OPJ_TRUE);
+    opj_stream_set_user_data(stream, &source, nullptr);
+    opj_stream_set_user_data_length(stream, encoded.size());
+    opj_stream_set_read_function(stream, readMemory);
+    opj_stream_set_skip_function(stream, skipMemory);
+    opj_stream_set_seek_function(stream, seekMemory);
+
+    opj_image_t* image = nullptr;
+    bool ok = opj_read_header(stream, codec, &image) && opj_decode(codec, stream, image) &&
+              opj_end_decompress(codec, stream);
+    if (ok) {
+        ok = static_cast<int>(image->numcomps) == samplesPerPixel;
+        for (OPJ_UINT32 c = 0; ok && c < image->numcomps; ++c) {
+            ok = static_cast<int>(image->comps[c].w) == columns && static_cast<int>(image->comps[c].h) == rows &&
+                 image->comps[c].data != nullptr;
+        }
+    }
+    const std::size_t pixels = static_cast<std::size_t>(rows) * columns;
+    if (ok && pixels * samplesPerPixel * (bitsAllocated / 8) > frameBytes) {
+        ok = false;
+    }
+    if (ok) {
+        // Amostras intercaladas, como no Pixel Data nativo com Planar Configuration 0
+        for (int c = 0; c < samplesPerPixel; ++c) {
+            const OPJ_INT32* samples = image->comps[c].data;
+            if (bitsAllocated == 8) {
+                for (std::size_t i = 0; i < pixels; ++i) {
+                    destination[i * samplesPerPixel + c] = static_cast<uint8_t>(samples[i]);
+                }
+            } else {
+                uint16_t* words = reinterpret_cast<uint16_t*>(destination);
+                for (std::size_t i = 0; i < pixels; ++i) {
+                    words[i * samplesPerPixel + c] = static_cast<uint16_t>(samples[i]);
+                }
+            }
+        }
+    }
+
+    if (image) {
+        opj_image_destroy(image);
+    }
+    opj_stream_destroy(stream);
+    opj_destroy_codec(codec);
+    return ok;
+}
+
+/**
+ * @brief Junta os fragmentos de um quadro JPEG 2000 encapsulado.
+ *
+ * Sem tabela de offsets confiável, os quadros são separados assim: um único
+ * quadro usa todos os fragmentos; com tantos fragmentos quanto quadros, um
+ * fragmento por quadro; caso contrário, um quadro novo começa em cada
+ * fragmento iniciado pelo marcador SOC (FF 4F) ou pela assinatura JP2.
+ */
+bool jpeg2000FrameBytes(DcmDataset* dataset, DcmPixelData* pixelData, int frame, std::vector<uint8_t>& encoded) {
+    DcmPixelSequence* sequence = nullptr;
+    if (pixelData->getEncapsulatedRepresentation(dataset->getOriginalXfer(), nullptr, sequence).bad() ||
+        sequence == nullptr) {
+        return false;
+    }
+    Sint32 frames = 1;
+    dataset->findAndGetSint32(DCM_NumberOfFrames, frames);
+    // O item 0 é a tabela de offsets
+    const unsigned long fragments = sequence->card() > 0 ? sequence->card() - 1 : 0;
+
+    int current = -1;
+    for (unsigned long i = 1; i <= fragments; ++i) {
+        DcmPixelItem* item = nullptr;
+        Uint8* bytes = nullptr;
+        if (sequence->getItem(item, i).bad() || item == nullptr || item->getUint8Array(bytes).bad()) {
+            return false;
+        }
+        const Uint32 length = item->getLength();
+        bool startsFrame;
+        if (frames <= 1) {
+            startsFrame = i == 1;
+        } else if (fragments == static_cast<unsigned long>(frames)) {
+            startsFrame = true;
+        } else {
+            startsFrame = length >= 2 && bytes != nullptr &&
+                          ((bytes[0] == 0xFF && bytes[1] == 0x4F) || (length >= 8 && bytes[3] == 0x0C && bytes[4] == 0x6A));
+        }
+        if (startsFrame) {
+            ++current;
+        }
+        if (current == frame && bytes != nullptr) {
+            encoded.insert(encoded.end(), bytes, bytes + length);
+        } else if (current > frame) {
+            break;
+        }
+    }
+    return !encoded.empty();
+}
+
+/**
+ * @brief Decodifica um quadro JPEG 2000 com o OpenJPEG.
+ */
+bool decodeJpeg2000Frame(DcmDataset* dataset, DcmPixelData* pixelData, int frame, uint8_t* destination,
+                         std::size_t frameBytes) {
+    Uint16 rows = 0;
+    Uint16 columns = 0;
+    Uint16 samplesPerPixel = 1;
+    Uint16 bitsAllocated = 0;
+    dataset->findAndGetUint16(DCM_Rows, rows);
+    dataset->findAndGetUint16(DCM_Columns, columns);
+    dataset->findAndGetUint16(DCM_SamplesPerPixel, samplesPerPixel);
+    dataset->findAndGetUint16(DCM_BitsAllocated, bitsAllocated);
+    if (bitsAllocated != 8 && bitsAllocated != 16) {
+        return false;
+    }
+    std::vector<uint8_t> encoded;
+    if (!jpeg2000FrameBytes(dataset, pixelData, frame, encoded)) {
+        std::cerr << "Warning: cannot locate JPEG 2000 fragments of frame " << frame << std::endl;
+        return false;
+    }
+    if (!decodeJpeg2000(encoded, rows, columns, samplesPerPixel, bitsAllocated, destination, frameBytes)) {
+        std::cerr << "Warning: cannot decode JPEG 2000 frame " << frame << std::endl;
+        return false;
+    }
+    return true;
+}
+
+#endif
+
+/**
+ * @brief Lê um vetor de números decimais (ex.: Image Orientation) ou falha se faltar algum.
+ */
+template <std::size_t N>
+bool readFloats(DcmItem* item, const DcmTagKey& tag, std::array<double, N>& values) {
+    if (item == nullptr) {
+        return false;
+    }
+    std::array<double, N> read{};
+    for (std::size_t i = 0; i < N; ++i) {
+        Float64 value = 0.0;
+        if (item->findAndGetFloat64(tag, value, static_cast<unsigned long>(i)).bad()) {
+            return false;
+        }
+        read[i] = value;
+    }
+    values = read;
+    return true;
+}
+
+/**
+ * @brief Primeiro item da sequência de macro (ex.: Plane Position) de um item de grupo funcional, ou nullptr.
+ */
+DcmItem* macroItem(DcmItem* group, const DcmTagKey& macro) {
+    DcmItem* item = nullptr;
+    if (group == nullptr || group->findAndGetSequenceItem(macro, item).bad()) {
+        return nullptr;
+    }
+    return item;
+}
+
+/**
+ * @brief Grupos funcionais de um arquivo multi-frame aprimorado (Enhanced CT/MR).
+ *
+ * Cada macro é procurada primeiro no item do quadro (Per-frame Functional
+ * Groups) e depois no item comum (Shared Functional Groups).
+ */
+struct FunctionalGroups {
+    DcmItem* shared = nullptr;
+    std::vector<DcmItem*> perFrame;
+
+    explicit FunctionalGroups(DcmDataset* dataset) {
+        dataset->findAndGetSequenceItem(DCM_SharedFunctionalGroupsSequence, shared);
+        DcmSequenceOfItems* frames = nullptr;
+        if (dataset->findAndGetSequence(DCM_PerFrameFunctionalGroupsSequence, frames).good() && frames != nullptr) {
+            // Percurso sequencial: getItem(i) recomeçaria a lista a cada quadro
+            for (DcmObject* object = frames->nextInContainer(nullptr); object != nullptr;
+                 object = frames->nextInContainer(object)) {
+                perFrame.push_back(static_cast<DcmItem*>(object));
+            }
+        }
+    }
+
+    DcmItem* macro(std::size_t frame, const DcmTagKey& tag) const {
+        DcmItem* item = frame < perFrame.size() ? macroItem(perFrame[frame], tag) : nullptr;
+        return item != nullptr ? item : macroItem(shared, tag);
+    }
+};
+
+/**
+ * @brief Indica se a imagem é monocromática de 8 ou 16 bits, com dimensões definidas.
+ */
+bool isVolumeCompatible(DcmDataset* dataset, const MedicalImage& info) {
+    Uint16 rows = 0;
+    Uint16 columns = 0;
+    dataset->findAndGetUint16(DCM_Rows, rows);
+    dataset->findAndGetUint16(DCM_Columns, columns);
+    const bool monochrome = info.photometricInterpretation == "MONOCHROME1" ||
+                            info.photometricInterpretation == "MONOCHROME2";
+    return rows != 0 && columns != 0 && info.samplesPerPixel == 1 && monochrome &&
+           (info.bitsAllocated == 8 || info.bitsAllocated == 16);
+}
+
+}
+
+/**
+ * @brief Indica se a compilação inclui o decodificador JPEG 2000 (OpenJPEG).
+ */
+bool isJpeg2000Available() {
+#if defined(DICOM_VIEWER_HAS_OPENJPEG)
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Decodifica os valores armazenados de um quadro direto em destination.
+ */
+bool decodeStoredFrame(DcmDataset* dataset, int frame, uint8_t* destination, std::size_t frameBytes,
+                       uint32_t& startFragment) {
+    DcmElement* pixelData = nullptr;
+    if (dataset->findAndGetElement(DCM_PixelData, pixelData).bad() || pixelData == nullptr) {
+        return false;
+    }
+    if (isJpeg2000(dataset->getOriginalXfer())) {
+#if defined(DICOM_VIEWER_HAS_OPENJPEG)
+        return decodeJpeg2000Frame(dataset, static_cast<DcmPixelData*>(pixelData), frame, destination, frameBytes);
+#else
+        std::cerr << "Error: JPEG 2000 transfer syntax not supported (built without OpenJPEG)" << std::endl;
+        return false;
+#endif
+    }
+    Uint32 fragment = startFragment;
+    OFString decompressedColorModel;
+    OFCondition status = pixelData->getUncompressedFrame(dataset, static_cast<Uint32>(frame), fragment, destination,
+                                                         static_cast<Uint32>(frameBytes), decompressedColorModel);
+    if (status.bad()) {
+        std::cerr << "Warning: cannot decode frame " << frame << " (" << status.text() << ")" << std::endl;
+        return false;
+    }
+    startFragment = fragment;
+    return true;
+}
+
+/**
+ * @brief Indica se o arquivo tem vários quadros monocromáticos que loadDicomFrames() aceita.
+ */
+bool isMultiFrameVolume(const std::string& path) {
+    std::unique_ptr<DcmFileFormat> header = openDicomLazy(path);
+    if (!header) {
+        return false;
+    }
+    MedicalImage info;
+    readDicomMetadata(header->getDataset(), info);
+    return info.numberOfFrames > 1 && isVolumeCompatible(header->getDataset(), info);
+}
+
+/**
+ * @brief Carrega todos os quadros de um arquivo multi-frame monocromático em um Volume.
+ */
+Volume loadDicomFrames(const std::string& path, FrameDecodeStats* stats, const LoadProgressCallback& progress) {
+    Volume volume;
+    FrameDecodeStats localStats;
+    FrameDecodeStats& report = stats ? *stats : localStats;
+    report = FrameDecodeStats();
+    const auto loadStart = std::chrono::steady_clock::now();
+
+    ensureCodecsRegistered();
+    std::unique_ptr<DcmFileFormat> header = openDicomLazy(path);
+    if (!header) {
+        return volume;
+    }
+    DcmDataset* dataset = header->getDataset();
+    report.transferSyntax = DcmXfer(dataset->getOriginalXfer()).getXferID();
+
+    MedicalImage info;
+    readDicomMetadata(dataset, info);
+    Uint16 rows = 0;
+    Uint16 columns = 0;
+    dataset->findAndGetUint16(DCM_Rows, rows);
+    dataset->findAndGetUint16(DCM_Columns, columns);
+    if (!isVolumeCompatible(dataset, info)) {
+        std::cerr << "Error: " << path << " is not an 8 or 16-bit grayscale image" << std::endl;
+        return volume;
+    }
+
+    volume.width = columns;
+    volume.height = rows;
+    volume.depth = std::max(1, info.numberOfFrames);
+    volume.bitsAllocated = info.bitsAllocated;
+    volume.bitsStored = info.bitsStored;
+    volume.pixelRepresentation = info.pixelRepresentation;
+    volume.spacingX = info.spacingX;
+    volume.spacingY = info.spacingY;
+    volume.rescaleSlope = info.rescaleSlope;
+    volume.rescaleIntercept = info.rescaleIntercept;
+    volume.windowCenter = info.windowCenter;
+    volume.windowWidth = info.windowWidth;
+    volume.patientName = info.patientName;
+    volume.studyDate = info.studyDate;
+    volume.modality = info.modality;
+    OFString text;
+    if (dataset->findAndGetOFString(DCM_SeriesDescription, text).good()) volume.seriesDescription = text.c_str();
+    if (dataset->findAndGetOFString(DCM_SeriesInstanceUID, text).good()) volume.seriesInstanceUID = text.c_str();
+
+    // Enhanced CT/MR guardam geometria, rescale e janela nos grupos funcionais;
+    // os atributos do nível superior valem só quando os grupos não os trazem
+    const FunctionalGroups groups(dataset);
+    DcmItem* measures = groups.macro(0, DCM_PixelMeasuresSequence);
+    std::array<double, 2> pixelSpacing{{0.0, 0.0}};
+    if (readFloats(measures, DCM_PixelSpacing, pixelSpacing) && pixelSpacing[0] > 0.0 && pixelSpacing[1] > 0.0) {
+        volume.spacingY = pixelSpacing[0];
+        volume.spacingX = pixelSpacing[1];
+    }
+    Float64 spacing = 0.0;
+    DcmItem* spacingSources[] = {measures, dataset};
+    for (DcmItem* source : spacingSources) {
+        if (source != nullptr &&
+            (source->findAndGetFloat64(DCM_SpacingBetweenSlices, spacing).good() ||
+             source->findAndGetFloat64(DCM_SliceThickness, spacing).good()) && spacing > 0.0) {
+            volume.spacingZ = spacing;
+            break;
+        }
+    }
+    if (DcmItem* transformation = groups.macro(0, DCM_PixelValueTransformationSequence)) {
+        Float64 value = 0.0;
+        if (transformation->findAndGetFloat64(DCM_RescaleSlope, value).good() && value != 0.0) volume.rescaleSlope = value;
+        if (transformation->findAndGetFloat64(DCM_RescaleIntercept, value).good()) volume.rescaleIntercept = value;
+    }
+    if (DcmItem* voi = groups.macro(0, DCM_FrameVOILUTSequence)) {
+        Float64 value = 0.0;
+        if (voi->findAndGetFloat64(DCM_WindowCenter, value).good()) volume.windowCenter = value;
+        if (voi->findAndGetFloat64(DCM_WindowWidth, value).good() && value > 0.0) volume.windowWidth = value;
+    }
+    if (!readFloats(groups.macro(0, DCM_PlaneOrientationSequence), DCM_ImageOrientationPatient, volume.orientation)) {
+        readFloats(dataset, DCM_ImageOrientationPatient, volume.orientation);
+    }
+
+    // Posição de cada quadro (Plane Position); sem ela, as posições avançam na
+    // normal a partir da posição do nível superior
+    bool perFramePositions = true;
+    for (int z = 0; z < volume.depth; ++z) {
+        std::array<double, 3> position{{0.0, 0.0, 0.0}};
+        if (!readFloats(groups.macro(static_cast<std::size_t>(z), DCM_PlanePositionSequence), DCM_ImagePositionPatient,
+                        position)) {
+            perFramePositions = false;
+            break;
+        }
+        volume.slicePositions.push_back(position);
+    }
+    const std::array<double, 6>& o = volume.orientation;
+    const std::array<double, 3> normal{{o[1] * o[5] - o[2] * o[4], o[2] * o[3] - o[0] * o[5], o[0] * o[4] - o[1] * o[3]}};
+    if (perFramePositions && volume.depth > 1) {
+        const std::array<double, 3>& p0 = volume.slicePositions[0];
+        const std::array<double, 3>& p1 = volume.slicePositions[1];
+        const double step = std::fabs((p1[0] - p0[0]) * normal[0] + (p1[1] - p0[1]) * normal[1] +
+                                      (p1[2] - p0[2]) * normal[2]);
+        if (step > 0.0) {
+            volume.spacingZ = step;
+        }
+    }
+    if (!perFramePositions) {
+        volume.slicePositions.clear();
+        std::array<double, 3> origin{{0.0, 0.0, 0.0}};
+        readFloats(dataset, DCM_ImagePositionPatient, origin);
+        for (int z = 0; z < volume.depth; ++z) {
+            volume.slicePositions.push_back({{origin[0] + normal[0] * volume.spacingZ * z,
+                                              origin[1] + normal[1] * volume.spacingZ * z,
+                                              origin[2] + normal[2] * volume.spacingZ * z}});
+        }
+    }
+    report.headerMs = elapsedMs(loadStart);
+    if (progress && !progress(10)) {
+        report.cancelled = true;
+        return Volume();
+    }
+
+    // Blocos contíguos: dentro de um bloco, o fragmento inicial de cada quadro
+    // vem do quadro anterior, sem nova busca na sequência de fragmentos
+    ThreadPool& pool = ThreadPool::shared();
+    const std::size_t frames = static_cast<std::size_t>(volume.depth);
+    const std::size_t blocks = std::min<std::size_t>(frames, std::max(1u, pool.size()));
+    const std::size_t grain = (frames + blocks - 1) / blocks;
+    const std::size_t frameBytes = volume.sliceBytes();
+    volume.voxels.resize(frameBytes * frames);
+
+    const auto decodeStart = std::chrono::steady_clock::now();
+    std::atomic<std::size_t> decoded{0};
+    std::atomic<bool> failed{false};
+    std::atomic<bool> cancelled{false};
+    pool.parallelFor(0, frames, grain, [&](std::size_t lo, std::size_t hi) {
+        // O primeiro bloco reaproveita o dataset do cabeçalho; os demais abrem a sua cópia
+        std::unique_ptr<DcmFileFormat> own = lo == 0 ? nullptr : openDicomLazy(path);
+        DcmDataset* local = lo == 0 ? dataset : (own ? own->getDataset() : nullptr);
+        if (local == nullptr) {
+            failed.store(true);
+            return;
+        }
+        uint32_t startFragment = 0;
+        for (std::size_t z = lo; z < hi; ++z) {
+            if (failed.load() || cancelled.load()) {
+                return;
+            }
+            DICOM_TRACE_SCOPE(traceScope, "frame");
+            DICOM_TRACE_BYTES(traceScope, frameBytes);
+            uint8_t* destination = volume.sliceData(static_cast<int>(z));
+            if (!decodeStoredFrame(local, static_cast<int>(z), destination, frameBytes, startFragment)) {
+                failed.store(true);
+                return;
+            }
+            normalizeStoredValues(destination, frameBytes / volume.bytesPerVoxel(), volume.bitsAllocated,
+                                  volume.bitsStored, info.highBit, volume.pixelRepresentation);
+            const std::size_t done = ++decoded;
+            if (progress && !progress(10 + static_cast<int>(90 * done / frames))) {
+                cancelled.store(true);
+            }
+        }
+    });
+    report.decodeMs = elapsedMs(decodeStart);
+    report.totalMs = elapsedMs(loadStart);
+    report.threads = static_cast<int>((frames + grain - 1) / grain);
+
+    if (cancelled.load()) {
+        report.cancelled = true;
+        return Volume();
+    }
+    if (failed.load()) {
+        std::cerr << "Error: cannot decode the frames of " << path << std::endl;
+        return Volume();
+    }
+    report.frames = volume.depth;
+    report.decodedBytes = volume.voxels.size();
+    return volume;
+}
+
+}
@@ -0,0 +1,92 @@
+/**
+ * DICOM Viewer - Decodificação Paralela de Quadros
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "MedicalImage.h"
+#include "Volume.h"
+
+#ifndef FRAMEDECODER_H
+#define FRAMEDECODER_H
+
+class DcmDataset;
+
+namespace dicom_viewer_core {
+
+/**
+ * @struct FrameDecodeStats
+ * @brief Estatísticas da decodificação dos quadros de um arquivo multi-frame.
+ */
+struct FrameDecodeStats {
+    std::string transferSyntax;                       ///< UID da sintaxe de transferência do arquivo
+    int frames = 0;                                   ///< Quadros decodificados
+    int threads = 0;                                  ///< Blocos de quadros decodificados em paralelo
+    double headerMs = 0.0;                            ///< Leitura do cabeçalho
+    double decodeMs = 0.0;                            ///< Decodificação paralela dos quadros
+    double totalMs = 0.0;                             ///< Tempo total
+    std::size_t decodedBytes = 0;                     ///< Bytes de pixels produzidos
+    bool cancelled = false;                           ///< true se a decodificação foi cancelada
+};
+
+/**
+ * @brief Indica se a compilação inclui o decodificador JPEG 2000 (OpenJPEG).
+ *
+ * O DCMTK livre não traz codec JPEG 2000; sem OpenJPEG esses arquivos falham
+ * com uma mensagem de sintaxe não suportada.
+ */
+bool isJpeg2000Available();
+
+/**
+ * @brief Decodifica os valores armazenados de um quadro direto em destination.
+ *
+ * Para dados nativos os bytes são lidos do disco (ou da memória) já na ordem
+ * de bytes da máquina; para dados encapsulados o codec registrado no DCMTK
+ * (JPEG, JPEG-LS, RLE) ou o OpenJPEG (JPEG 2000) descomprime direto no
+ * destino. Os valores não são normalizados (ver normalizeStoredValues()).
+ *
+ * @param dataset Dataset do arquivo; não deve ser usado por outra thread ao mesmo tempo.
+ * @param frame Índice do quadro.
+ * @param destination Destino com ao menos frameBytes bytes.
+ * @param frameBytes Tamanho de um quadro decodificado.
+ * @param startFragment Fragmento inicial do quadro, se conhecido (0 = procurar);
+ *                      recebe o fragmento inicial do quadro seguinte.
+ * @return false se o quadro não puder ser decodificado.
+ */
+bool decodeStoredFrame(DcmDataset* dataset, int frame, uint8_t* destination, std::size_t frameBytes,
+                       uint32_t& startFragment);
+
+/**
+ * @brief Indica se o arquivo tem vários quadros monocromáticos de 8 ou 16 bits.
+ *
+ * Lê apenas o cabeçalho; serve para escolher loadDicomFrames() em vez do
+ * carregamento corte a corte quando uma série é formada por um único arquivo.
+ */
+bool isMultiFrameVolume(const std::string& path);
+
+/**
+ * @brief Carrega todos os quadros de um arquivo multi-frame monocromático em um Volume.
+ *
+ * Os quadros são divididos em blocos contíguos, decodificados em paralelo no
+ * pool compartilhado; cada bloco usa a sua própria cópia do dataset, de modo
+ * que o acesso parcial ao Pixel Data lê do disco apenas os fragmentos do
+ * bloco. O espaçamento entre quadros vem de Spacing Between Slices (ou Slice
+ * Thickness) e as posições avançam na normal de Image Orientation (Patient).
+ *
+ * @param path Caminho do arquivo DICOM.
+ * @param stats Se não nulo, recebe as estatísticas da decodificação.
+ * @param progress Se definido, é chamado entre as etapas e pode cancelar.
+ * @return O volume, ou um volume inválido se o arquivo não for monocromático de 8 ou 16 bits.
+ */
+Volume loadDicomFrames(const std::string& path, FrameDecodeStats* stats = nullptr,
+                       const LoadProgressCallback& progress = LoadProgressCallback());
+
+}
+
+#endif // FRAMEDECODER_H
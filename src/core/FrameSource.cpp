@@ -0,0 +1,220 @@
+/**
+ * DICOM Viewer - Fonte de Quadros Multi-frame
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <iostream>
+
+#include <dcmtk/dcmimgle/dcmimage.h>
+#include <dcmtk/dcmdata/dctk.h>
+
+#include "FrameSource.h"
+#include "DicomCodecs.h"
+#include "ThreadPool.h"
+
+namespace dicom_viewer_core {
+
+FrameSource::FrameSource(const std::string& path, std::size_t cacheBudgetBytes)
+    : filePath(path), cache(cacheBudgetBytes) {
+}
+
+FrameSource::~FrameSource() = default;
+
+/**
+ * @brief Abre um arquivo lendo apenas o cabeçalho.
+ */
+std::shared_ptr<FrameSource> FrameSource::open(const std::string& path, std::size_t cacheBudgetBytes) {
+    std::unique_ptr<DcmFileFormat> handle = openDicomLazy(path);
+    if (!handle) {
+        return nullptr;
+    }
+    std::shared_ptr<FrameSource> source(new FrameSource(path, cacheBudgetBytes));
+    DcmDataset* dataset = handle->getDataset();
+    if (DcmXfer(dataset->getOriginalXfer()).isEncapsulated()) {
+        ensureCodecsRegistered();
+    }
+
+    Uint16 rows = 0;
+    Uint16 cols = 0;
+    dataset->findAndGetUint16(DCM_Rows, rows);
+    dataset->findAndGetUint16(DCM_Columns, cols);
+    if (rows == 0 || cols == 0) {
+        std::cerr << "Error: invalid image dimensions in " << path << std::endl;
+        return nullptr;
+    }
+    source->info.width = cols;
+    source->info.height = rows;
+    source->info.bitDepth = 8;
+    readDicomMetadata(dataset, source->info);
+    // Cor não comprimida (cine de ultrassom): conversão direta, quadro a quadro
+    source->directColor = !DcmXfer(dataset->getOriginalXfer()).isEncapsulated() &&
+                          readColorLayout(dataset, source->colorLayout) &&
+                          (source->colorLayout.model != ColorModel::Palette ||
+                           readPaletteLut(dataset, static_cast<int>(source->colorLayout.format.bytesPerSample()) * 8,
+                                          source->palette));
+    source->releaseHandle(std::move(handle));
+    return source;
+}
+
+/**
+ * @brief Obtém uma cópia do dataset livre para uso exclusivo da thread atual.
+ */
+std::unique_ptr<DcmFileFormat> FrameSource::acquireHandle() {
+    {
+        std::lock_guard<std::mutex> lock(handlesMutex);
+        if (!idleHandles.empty()) {
+            std::unique_ptr<DcmFileFormat> handle = std::move(idleHandles.back());
+            idleHandles.pop_back();
+            return handle;
+        }
+    }
+    // Nenhuma cópia livre: abre outra (apenas o cabeçalho é lido)
+    return openDicomLazy(filePath);
+}
+
+/**
+ * @brief Devolve uma cópia do dataset ao conjunto de cópias livres.
+ */
+void FrameSource::releaseHandle(std::unique_ptr<DcmFileFormat> handle) {
+    if (!handle) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(handlesMutex);
+    idleHandles.push_back(std::move(handle));
+}
+
+/**
+ * @brief Retorna um quadro apenas se ele já estiver no cache.
+ */
+std::shared_ptr<const MedicalImage> FrameSource::cachedFrame(int index) {
+    if (!cache.contains(index)) {
+        return nullptr;
+    }
+    return cache.get(index);
+}
+
+/**
+ * @brief Retorna um quadro de 8 bits para exibição, decodificando-o se necessário.
+ */
+std::shared_ptr<const MedicalImage> FrameSource::frame(int index) {
+    if (index < 0 || index >= frameCount()) {
+        return nullptr;
+    }
+    if (std::shared_ptr<const MedicalImage> cached = cache.get(index)) {
+        return cached;
+    }
+    std::shared_ptr<const MedicalImage> decoded = decodeFrame(index);
+    if (decoded) {
+        cache.put(index, decoded, decoded->buffer.size());
+    }
+    return decoded;
+}
+
+/**
+ * @brief Agenda a decodificação antecipada de quadros no pool de threads.
+ */
+void FrameSource::prefetch(int first, int count) {
+    const int total = frameCount();
+    if (total <= 0) {
+        return;
+    }
+    std::weak_ptr<FrameSource> weakSelf = weak_from_this();
+    for (int i = 0; i < count && i < total; ++i) {
+        const int index = ((first + i) % total + total) % total;
+        if (cache.contains(index)) {
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(inflightMutex);
+            if (!inflight.insert(index).second) {
+                continue;
+            }
+        }
+        ThreadPool::shared().submit([weakSelf, index]() {
+            // A fonte pode ter sido fechada enquanto a tarefa aguardava na fila
+            std::shared_ptr<FrameSource> self = weakSelf.lock();
+            if (!self) {
+                return;
+            }
+            self->frame(index);
+            std::lock_guard<std::mutex> lock(self->inflightMutex);
+            self->inflight.erase(index);
+        });
+    }
+}
+
+/**
+ * @brief Lê e decodifica um único quadro.
+ *
+ * O janelamento é fixado no primeiro quadro decodificado (ou vem do
+ * cabeçalho), para que a reprodução não oscile de brilho entre quadros.
+ * Quadros coloridos não comprimidos são lidos e convertidos para RGB pelos
+ * kernels de ColorConversion; os demais passam pelo DicomImage.
+ */
+std::shared_ptr<const MedicalImage> FrameSource::decodeFrame(int index) {
+    std::unique_ptr<DcmFileFormat> handle = acquireHandle();
+    if (!handle) {
+        return nullptr;
+    }
+    DcmDataset* dataset = handle->getDataset();
+    auto output = std::make_shared<MedicalImage>();
+    if (directColor) {
+        *output = info;
+        output->samplesPerPixel = 3;
+        output->planarConfiguration = 0;
+        output->buffer.allocate(static_cast<std::size_t>(colorLayout.width) * colorLayout.height * 3);
+        if (decodeColorFrame(dataset, index, colorLayout, &palette, output->buffer.data(),
+                             static_cast<std::size_t>(colorLayout.width) * 3, ThreadPool::shared())) {
+            releaseHandle(std::move(handle));
+            return output;
+        }
+        // Falha na leitura direta: tenta o caminho genérico
+        output->buffer.clear();
+    }
+    {
+        DicomImage image(dataset, dataset->getOriginalXfer(), CIF_UsePartialAccessToPixelData,
+                         static_cast<unsigned long>(index), 1);
+        if (image.getStatus() != EIS_Normal) {
+            std::cerr << "Error: cannot decode frame " << index << " of " << filePath
+                      << " (" << DicomImage::getString(image.getStatus()) << ")" << std::endl;
+            releaseHandle(std::move(handle));
+            return nullptr;
+        }
+
+        if (image.isMonochrome()) {
+            std::lock_guard<std::mutex> lock(windowMutex);
+            if (!windowKnown) {
+                if (info.windowWidth > 0.0) {
+                    displayCenter = info.windowCenter;
+                    displayWidth = info.windowWidth;
+                } else {
+                    image.setMinMaxWindow();
+                    image.getWindow(displayCenter, displayWidth);
+                }
+                windowKnown = true;
+            }
+            image.setWindow(displayCenter, displayWidth);
+        }
+
+        const int bits = 8;
+        const unsigned long size = image.getOutputDataSize(bits);
+        *output = info;
+        output->width = static_cast<int>(image.getWidth());
+        output->height = static_cast<int>(image.getHeight());
+        output->samplesPerPixel = image.isMonochrome() ? 1 : 3;
+        output->planarConfiguration = 0;                  // getOutputData intercala as amostras
+        output->buffer.allocate(size);
+        if (size == 0 || image.getOutputData(output->buffer.data(), size, bits) == 0) {
+            std::cerr << "Error: cannot render frame " << index << " of " << filePath << std::endl;
+            releaseHandle(std::move(handle));
+            return nullptr;
+        }
+    }
+    releaseHandle(std::move(handle));
+    return output;
+}
+
+}
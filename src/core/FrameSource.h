@@ -0,0 +1,132 @@
+/**
+ * DICOM Viewer - Fonte de Quadros Multi-frame
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "ColorConversion.h"
+#include "MedicalImage.h"
+#include "LruCache.h"
+
+#ifndef FRAMESOURCE_H
+#define FRAMESOURCE_H
+
+class DcmFileFormat;
+
+namespace dicom_viewer_core {
+
+/**
+ * @class FrameSource
+ * @brief Acesso sob demanda aos quadros de um arquivo DICOM multi-frame.
+ *
+ * Apenas o cabeçalho é lido na abertura. Cada quadro é lido e decodificado
+ * individualmente (acesso parcial ao Pixel Data) na primeira vez em que é
+ * solicitado e fica em um cache limitado por memória. Quadros futuros podem
+ * ser decodificados antecipadamente no pool de threads com prefetch().
+ *
+ * Cada thread de decodificação usa a sua própria cópia do dataset, de modo
+ * que vários quadros podem ser decodificados em paralelo.
+ */
+class FrameSource : public std::enable_shared_from_this<FrameSource> {
+public:
+    /**
+     * @brief Abre um arquivo lendo apenas o cabeçalho.
+     * @param path Caminho do arquivo DICOM.
+     * @param cacheBudgetBytes Orçamento do cache de quadros decodificados.
+     * @return A fonte de quadros, ou nullptr se o arquivo não puder ser lido.
+     */
+    static std::shared_ptr<FrameSource> open(const std::string& path,
+                                             std::size_t cacheBudgetBytes = 256u * 1024u * 1024u);
+
+    ~FrameSource();
+
+    FrameSource(const FrameSource&) = delete;
+    FrameSource& operator=(const FrameSource&) = delete;
+
+    /**
+     * @brief Número de quadros do arquivo.
+     */
+    int frameCount() const { return info.numberOfFrames; }
+
+    /**
+     * @brief Metadados comuns a todos os quadros (sem buffer de pixels).
+     */
+    const MedicalImage& metadata() const { return info; }
+
+    /**
+     * @brief Caminho do arquivo.
+     */
+    const std::string& path() const { return filePath; }
+
+    /**
+     * @brief Retorna um quadro de 8 bits para exibição, decodificando-o se necessário.
+     * @param index Índice do quadro (0 a frameCount() - 1).
+     * @return O quadro, ou nullptr se não puder ser decodificado.
+     */
+    std::shared_ptr<const MedicalImage> frame(int index);
+
+    /**
+     * @brief Retorna um quadro apenas se ele já estiver no cache.
+     */
+    std::shared_ptr<const MedicalImage> cachedFrame(int index);
+
+    /**
+     * @brief Agenda a decodificação antecipada de quadros no pool de threads.
+     *
+     * Quadros já em cache ou em decodificação são ignorados. Os índices
+     * avançam circularmente a partir de first.
+     *
+     * @param first Primeiro quadro.
+     * @param count Quantidade de quadros.
+     */
+    void prefetch(int first, int count);
+
+    /**
+     * @brief Contadores do cache de quadros.
+     */
+    CacheCounters cacheCounters() const { return cache.counters(); }
+
+    /**
+     * @brief Altera o orçamento do cache de quadros.
+     */
+    void setCacheBudget(std::size_t budgetBytes) { cache.setBudget(budgetBytes); }
+
+private:
+    FrameSource(const std::string& path, std::size_t cacheBudgetBytes);
+
+    std::unique_ptr<DcmFileFormat> acquireHandle();
+    void releaseHandle(std::unique_ptr<DcmFileFormat> handle);
+    std::shared_ptr<const MedicalImage> decodeFrame(int index);
+
+    std::string filePath;
+    MedicalImage info;
+    LruCache<int, MedicalImage> cache;
+
+    std::mutex handlesMutex;
+    std::vector<std::unique_ptr<DcmFileFormat>> idleHandles;
+
+    std::mutex inflightMutex;
+    std::set<int> inflight;
+
+    bool directColor = false;                         ///< Quadros coloridos nativos convertidos sem o DicomImage
+    ColorLayout colorLayout;
+    PaletteLut palette;
+
+    std::mutex windowMutex;
+    bool windowKnown = false;
+    double displayCenter = 0.0;
+    double displayWidth = 0.0;
+};
+
+}
+
+#endif // FRAMESOURCE_H
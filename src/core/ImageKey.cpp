@@ -0,0 +1,52 @@
+/**
+ * DICOM Viewer - Identidade de Imagens em Cache
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <filesystem>
+#include <functional>
+#include <system_error>
+
+#include "ImageKey.h"
+
+namespace dicom_viewer_core {
+
+/**
+ * @brief Combina os campos da chave (mistura no estilo boost::hash_combine).
+ */
+std::size_t ImageKeyHash::operator()(const ImageKey& key) const {
+    std::size_t seed = std::hash<std::string>()(key.path);
+    auto combine = [&seed](std::size_t value) {
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    };
+    combine(std::hash<uint64_t>()(key.size));
+    combine(std::hash<int64_t>()(key.modified));
+    combine(std::hash<int>()(key.frame));
+    return seed;
+}
+
+/**
+ * @brief Monta a chave de um quadro a partir do estado atual do arquivo.
+ */
+ImageKey imageKeyForFile(const std::string& path, int frame) {
+    std::error_code error;
+    const std::uintmax_t size = std::filesystem::file_size(path, error);
+    if (error) {
+        return ImageKey();
+    }
+    const std::filesystem::file_time_type modified = std::filesystem::last_write_time(path, error);
+    if (error) {
+        return ImageKey();
+    }
+    ImageKey key;
+    key.path = path;
+    key.size = static_cast<uint64_t>(size);
+    key.modified = static_cast<int64_t>(modified.time_since_epoch().count());
+    key.frame = frame;
+    return key;
+}
+
+}
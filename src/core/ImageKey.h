@@ -0,0 +1,64 @@
+/**
+ * DICOM Viewer - Identidade de Imagens em Cache
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifndef IMAGEKEY_H
+#define IMAGEKEY_H
+
+namespace dicom_viewer_core {
+
+/**
+ * @struct ImageKey
+ * @brief Identifica um quadro decodificado pela identidade do arquivo de origem.
+ *
+ * Tamanho e data de modificação fazem parte da chave: um arquivo regravado no
+ * mesmo caminho gera uma chave nova, e a entrada antiga apenas envelhece no
+ * cache até ser descartada.
+ */
+struct ImageKey {
+    std::string path;                                 ///< Caminho do arquivo
+    uint64_t size = 0;                                ///< Tamanho do arquivo em bytes
+    int64_t modified = 0;                             ///< Data de modificação (unidade do sistema de arquivos)
+    int frame = 0;                                    ///< Índice do quadro
+
+    /**
+     * @brief true se a chave foi obtida de um arquivo existente.
+     */
+    bool isValid() const { return !path.empty(); }
+
+    bool operator==(const ImageKey& other) const {
+        return frame == other.frame && size == other.size && modified == other.modified && path == other.path;
+    }
+    bool operator!=(const ImageKey& other) const { return !(*this == other); }
+};
+
+/**
+ * @struct ImageKeyHash
+ * @brief Função de hash de ImageKey para contêineres não ordenados.
+ */
+struct ImageKeyHash {
+    std::size_t operator()(const ImageKey& key) const;
+};
+
+/**
+ * @brief Monta a chave de um quadro a partir do estado atual do arquivo.
+ *
+ * Consulta apenas os metadados do sistema de arquivos; o conteúdo não é lido.
+ *
+ * @param path Caminho do arquivo.
+ * @param frame Índice do quadro.
+ * @return A chave, ou uma chave inválida se o arquivo não puder ser consultado.
+ */
+ImageKey imageKeyForFile(const std::string& path, int frame = 0);
+
+}
+
+#endif // IMAGEKEY_H
@@ -0,0 +1,158 @@
+/**
+ * DICOM Viewer - Pirâmide Multirresolução
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "ImagePyramid.h"
+#include "ThreadPool.h"
+
+namespace dicom_viewer_core {
+
+namespace {
+
+/**
+ * @brief Reduz as linhas [firstRow, lastRow) do destino pela média de blocos 2x2 da origem.
+ *
+ * O número de canais é constante de compilação: o laço interno é
+ * desenrolado pelo compilador. Linhas e colunas ímpares na borda são repetidas.
+ */
+template <int Channels>
+void downsampleRows(const PyramidLevel& source, const PyramidLevel& destination,
+                    std::size_t firstRow, std::size_t lastRow) {
+    uint8_t* output = const_cast<uint8_t*>(destination.pixels);
+    for (std::size_t y = firstRow; y < lastRow; ++y) {
+        const int y0 = static_cast<int>(y) * 2;
+        const int y1 = std::min(y0 + 1, source.height - 1);
+        const uint8_t* row0 = source.pixels + static_cast<std::size_t>(y0) * source.stride;
+        const uint8_t* row1 = source.pixels + static_cast<std::size_t>(y1) * source.stride;
+        uint8_t* out = output + y * destination.stride;
+        const int fullPairs = source.width / 2;
+        for (int x = 0; x < fullPairs; ++x) {
+            const int a = 2 * x * Channels;
+            const int b = a + Channels;
+            for (int c = 0; c < Channels; ++c) {
+                out[x * Channels + c] = static_cast<uint8_t>((row0[a + c] + row0[b + c] + row1[a + c] + row1[b + c] + 2) >> 2);
+            }
+        }
+        if (destination.width > fullPairs) {
+            // Coluna ímpar final: média vertical apenas
+            const int a = (source.width - 1) * Channels;
+            for (int c = 0; c < Channels; ++c) {
+                out[fullPairs * Channels + c] = static_cast<uint8_t>((row0[a + c] + row1[a + c] + 1) >> 1);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Reduz um nível inteiro, escolhendo o kernel pelo número de canais uma única vez.
+ */
+template <int Channels>
+void downsampleLevel(const PyramidLevel& source, const PyramidLevel& destination, ThreadPool& pool) {
+    const std::size_t grain = std::max<std::size_t>(1, 65536 / std::max<std::size_t>(1, destination.stride));
+    pool.parallelFor(0, static_cast<std::size_t>(destination.height), grain,
+                     [&](std::size_t lo, std::size_t hi) {
+        downsampleRows<Channels>(source, destination, lo, hi);
+    });
+}
+
+}
+
+/**
+ * @brief Cria a pirâmide e agenda a construção dos níveis reduzidos.
+ */
+std::shared_ptr<ImagePyramid> ImagePyramid::build(const uint8_t* pixels, int width, int height, std::size_t stride,
+                                                  int channels, std::shared_ptr<const void> owner, ThreadPool& pool,
+                                                  LevelReadyCallback onLevelReady, int minSize) {
+    std::shared_ptr<ImagePyramid> pyramid(new ImagePyramid());
+    pyramid->sourceOwner = std::move(owner);
+    pyramid->sampleCount = std::clamp(channels, 1, 4);
+    pyramid->levelReady = std::move(onLevelReady);
+    pyramid->buildPool = &pool;
+
+    PyramidLevel base;
+    base.width = width;
+    base.height = height;
+    base.stride = stride;
+    base.pixels = pixels;
+    pyramid->levels.push_back(base);
+
+    // Planeja os níveis e aloca todos de uma vez; apenas o conteúdo é preenchido depois
+    minSize = std::max(minSize, 1);
+    while (std::max(pyramid->levels.back().width, pyramid->levels.back().height) > minSize) {
+        const PyramidLevel& previous = pyramid->levels.back();
+        PyramidLevel next;
+        next.width = (previous.width + 1) / 2;
+        next.height = (previous.height + 1) / 2;
+        next.stride = static_cast<std::size_t>(next.width) * pyramid->sampleCount;
+        PixelBuffer buffer;
+        buffer.allocate(next.stride * next.height);
+        next.pixels = buffer.data();
+        pyramid->storage.push_back(std::move(buffer));
+        pyramid->levels.push_back(next);
+    }
+    pyramid->ready.store(1, std::memory_order_release);
+
+    if (pyramid->levels.size() > 1) {
+        std::weak_ptr<ImagePyramid> weak = pyramid;
+        pool.submit([weak]() {
+            if (std::shared_ptr<ImagePyramid> self = weak.lock()) {
+                self->buildLevels();
+            }
+        });
+    }
+    return pyramid;
+}
+
+/**
+ * @brief Constrói os níveis reduzidos em sequência, com as linhas de cada nível em paralelo.
+ */
+void ImagePyramid::buildLevels() {
+    for (std::size_t index = 1; index < levels.size(); ++index) {
+        if (cancelled.load()) {
+            return;
+        }
+        const PyramidLevel& source = levels[index - 1];
+        const PyramidLevel& destination = levels[index];
+        switch (sampleCount) {
+        case 1: downsampleLevel<1>(source, destination, *buildPool); break;
+        case 2: downsampleLevel<2>(source, destination, *buildPool); break;
+        case 3: downsampleLevel<3>(source, destination, *buildPool); break;
+        default: downsampleLevel<4>(source, destination, *buildPool); break;
+        }
+        ready.store(static_cast<int>(index) + 1, std::memory_order_release);
+
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        if (levelReady && !cancelled.load()) {
+            levelReady(static_cast<int>(index));
+        }
+    }
+}
+
+/**
+ * @brief Nível pronto mais adequado para exibir a imagem na escala informada.
+ */
+int ImagePyramid::levelForScale(double scale) const {
+    if (scale <= 0.0) {
+        return readyLevels() - 1;
+    }
+    const int ideal = scale >= 1.0 ? 0 : static_cast<int>(std::floor(std::log2(1.0 / scale)));
+    return std::clamp(ideal, 0, readyLevels() - 1);
+}
+
+/**
+ * @brief Interrompe a construção e desliga a notificação.
+ */
+void ImagePyramid::cancel() {
+    cancelled.store(true);
+    std::lock_guard<std::mutex> lock(callbackMutex);
+    levelReady = LevelReadyCallback();
+}
+
+}
@@ -0,0 +1,126 @@
+/**
+ * DICOM Viewer - Pirâmide Multirresolução
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "PixelBuffer.h"
+
+#ifndef IMAGEPYRAMID_H
+#define IMAGEPYRAMID_H
+
+namespace dicom_viewer_core {
+
+class ThreadPool;
+
+/**
+ * @struct PyramidLevel
+ * @brief Um nível da pirâmide: imagem de 8 bits por amostra com metade da resolução do anterior.
+ */
+struct PyramidLevel {
+    int width = 0;                                    ///< Largura do nível em pixels
+    int height = 0;                                   ///< Altura do nível em pixels
+    std::size_t stride = 0;                           ///< Bytes por linha
+    const uint8_t* pixels = nullptr;                  ///< Primeira linha do nível
+};
+
+/**
+ * @class ImagePyramid
+ * @brief Pirâmide multirresolução de uma imagem de 8 bits, construída em segundo plano.
+ *
+ * O nível 0 é a própria imagem de origem (sem cópia); cada nível seguinte é
+ * reduzido pela média de blocos 2x2 do anterior, até que o maior lado caiba
+ * em minSize. Os níveis ficam disponíveis um a um, à medida que são
+ * construídos, e são imutáveis depois de publicados.
+ */
+class ImagePyramid : public std::enable_shared_from_this<ImagePyramid> {
+public:
+    /**
+     * @brief Notificação de que um nível ficou pronto; chamada na thread de construção.
+     */
+    using LevelReadyCallback = std::function<void(int level)>;
+
+    /**
+     * @brief Cria a pirâmide e agenda a construção dos níveis reduzidos.
+     *
+     * @param pixels Primeira linha da imagem de origem.
+     * @param width Largura em pixels.
+     * @param height Altura em pixels.
+     * @param stride Bytes por linha da origem.
+     * @param channels Amostras por pixel (1 a 4).
+     * @param owner Mantém a memória da origem viva enquanto a pirâmide existir.
+     * @param pool Pool usado para a construção.
+     * @param onLevelReady Chamada a cada nível pronto (opcional).
+     * @param minSize Tamanho do maior lado do nível mais grosseiro.
+     * @return A pirâmide, com o nível 0 já disponível.
+     */
+    static std::shared_ptr<ImagePyramid> build(const uint8_t* pixels, int width, int height, std::size_t stride,
+                                               int channels, std::shared_ptr<const void> owner, ThreadPool& pool,
+                                               LevelReadyCallback onLevelReady = LevelReadyCallback(),
+                                               int minSize = 256);
+
+    /**
+     * @brief Número total de níveis (prontos ou não).
+     */
+    int levelCount() const { return static_cast<int>(levels.size()); }
+
+    /**
+     * @brief Número de níveis já construídos (os níveis 0 .. readyLevels() - 1).
+     */
+    int readyLevels() const { return ready.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Descrição de um nível pronto.
+     */
+    const PyramidLevel& level(int index) const { return levels[index]; }
+
+    /**
+     * @brief Amostras por pixel.
+     */
+    int channels() const { return sampleCount; }
+
+    /**
+     * @brief Nível pronto mais adequado para exibir a imagem na escala informada.
+     *
+     * Escolhe o nível mais grosseiro cuja resolução ainda é maior ou igual à
+     * da tela, limitado aos níveis já construídos.
+     *
+     * @param scale Pixels de tela por pixel da imagem de origem.
+     */
+    int levelForScale(double scale) const;
+
+    /**
+     * @brief Interrompe a construção e desliga a notificação.
+     *
+     * Ao retornar, a notificação não será mais chamada.
+     */
+    void cancel();
+
+private:
+    ImagePyramid() = default;
+    void buildLevels();
+
+    std::vector<PyramidLevel> levels;
+    std::vector<PixelBuffer> storage;
+    std::shared_ptr<const void> sourceOwner;
+    int sampleCount = 1;
+    std::atomic<int> ready{0};
+    std::atomic<bool> cancelled{false};
+    std::mutex callbackMutex;
+    LevelReadyCallback levelReady;
+    ThreadPool* buildPool = nullptr;
+};
+
+}
+
+#endif // IMAGEPYRAMID_H
@@ -0,0 +1,168 @@
+/**
+ * DICOM Viewer - Cache LRU Limitado por Memória
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#ifndef LRUCACHE_H
+#define LRUCACHE_H
+
+namespace dicom_viewer_core {
+
+/**
+ * @struct CacheCounters
+ * @brief Contadores de uso de um cache.
+ */
+struct CacheCounters {
+    std::size_t hits = 0;                             ///< Consultas atendidas pelo cache
+    std::size_t misses = 0;                           ///< Consultas não encontradas
+    std::size_t evictions = 0;                        ///< Entradas descartadas por falta de espaço
+    std::size_t entries = 0;                          ///< Entradas atualmente no cache
+    std::size_t usedBytes = 0;                        ///< Bytes ocupados pelas entradas
+    std::size_t budgetBytes = 0;                      ///< Limite de bytes do cache
+};
+
+/**
+ * @class LruCache
+ * @brief Cache thread-safe de valores compartilhados, limitado por um orçamento em bytes.
+ *
+ * Cada entrada tem um custo informado em put(). Quando o total ultrapassa o
+ * orçamento, as entradas usadas há mais tempo são descartadas. Os valores são
+ * entregues como std::shared_ptr, portanto uma entrada descartada continua
+ * válida para quem já a obteve.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache {
+public:
+    /**
+     * @brief Cria o cache.
+     * @param budgetBytes Orçamento máximo, em bytes.
+     */
+    explicit LruCache(std::size_t budgetBytes) : budget(budgetBytes) {}
+
+    /**
+     * @brief Procura uma entrada e a marca como usada recentemente.
+     * @return O valor, ou nullptr se não estiver no cache.
+     */
+    std::shared_ptr<const Value> get(const Key& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = index.find(key);
+        if (found == index.end()) {
+            ++stats.misses;
+            return nullptr;
+        }
+        ++stats.hits;
+        order.splice(order.begin(), order, found->second);
+        return found->second->value;
+    }
+
+    /**
+     * @brief Verifica se uma chave está no cache, sem alterar contadores nem a ordem.
+     */
+    bool contains(const Key& key) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return index.find(key) != index.end();
+    }
+
+    /**
+     * @brief Insere ou substitui uma entrada.
+     * @param key Chave da entrada.
+     * @param value Valor compartilhado.
+     * @param cost Custo da entrada, em bytes.
+     */
+    void put(const Key& key, std::shared_ptr<const Value> value, std::size_t cost) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = index.find(key);
+        if (found != index.end()) {
+            used -= found->second->cost;
+            order.erase(found->second);
+            index.erase(found);
+        }
+        order.push_front(Entry{key, std::move(value), cost});
+        index[key] = order.begin();
+        used += cost;
+        evictLocked();
+    }
+
+    /**
+     * @brief Remove uma entrada, se existir.
+     */
+    void remove(const Key& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = index.find(key);
+        if (found != index.end()) {
+            used -= found->second->cost;
+            order.erase(found->second);
+            index.erase(found);
+        }
+    }
+
+    /**
+     * @brief Altera o orçamento, descartando entradas se necessário.
+     */
+    void setBudget(std::size_t budgetBytes) {
+        std::lock_guard<std::mutex> lock(mutex);
+        budget = budgetBytes;
+        evictLocked();
+    }
+
+    /**
+     * @brief Remove todas as entradas.
+     */
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.clear();
+        index.clear();
+        used = 0;
+    }
+
+    /**
+     * @brief Retorna uma cópia dos contadores de uso.
+     */
+    CacheCounters counters() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        CacheCounters result = stats;
+        result.entries = index.size();
+        result.usedBytes = used;
+        result.budgetBytes = budget;
+        return result;
+    }
+
+private:
+    struct Entry {
+        Key key;
+        std::shared_ptr<const Value> value;
+        std::size_t cost;
+    };
+
+    void evictLocked() {
+        // A entrada mais recente é mantida mesmo que sozinha exceda o orçamento
+        while (used > budget && order.size() > 1) {
+            Entry& oldest = order.back();
+            used -= oldest.cost;
+            index.erase(oldest.key);
+            order.pop_back();
+            ++stats.evictions;
+        }
+    }
+
+    mutable std::mutex mutex;
+    std::list<Entry> order;
+    std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> index;
+    std::size_t budget = 0;
+    std::size_t used = 0;
+    CacheCounters stats;
+};
+
+}
+
+#endif // LRUCACHE_H
@@ -0,0 +1,157 @@
+/**
+ * DICOM Viewer - Arquivo Mapeado em Memória
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <filesystem>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <iostream>
+#include <utility>
+
+#include "MappedFile.h"
+
+namespace dicom_viewer_core {
+
+MappedFile::View::~View() {
+    reset();
+}
+
+MappedFile::View::View(View&& other) noexcept
+    : base(std::exchange(other.base, nullptr))
+    , delta(std::exchange(other.delta, 0))
+    , length(std::exchange(other.length, 0)) {
+}
+
+MappedFile::View& MappedFile::View::operator=(View&& other) noexcept {
+    if (this != &other) {
+        reset();
+        base = std::exchange(other.base, nullptr);
+        delta = std::exchange(other.delta, 0);
+        length = std::exchange(other.length, 0);
+    }
+    return *this;
+}
+
+/**
+ * @brief Desfaz o mapeamento, devolvendo as páginas lidas ao sistema.
+ */
+void MappedFile::View::reset() {
+    if (base == nullptr) {
+        return;
+    }
+#if defined(_WIN32)
+    UnmapViewOfFile(base);
+#else
+    munmap(const_cast<uint8_t*>(base), delta + length);
+#endif
+    base = nullptr;
+    delta = 0;
+    length = 0;
+}
+
+MappedFile::~MappedFile() {
+#if defined(_WIN32)
+    if (mappingHandle != nullptr) {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle != nullptr) {
+        CloseHandle(fileHandle);
+    }
+#else
+    if (descriptor >= 0) {
+        ::close(descriptor);
+    }
+#endif
+}
+
+/**
+ * @brief Abre um arquivo para mapeamento.
+ */
+std::unique_ptr<MappedFile> MappedFile::open(const std::string& path) {
+    std::unique_ptr<MappedFile> file(new MappedFile());
+#if defined(_WIN32)
+    // FILE_SHARE_DELETE: o arquivo pode ser apagado enquanto mapeado (ex.: remoção de entradas do DecodedCache)
+    HANDLE handle = CreateFileW(std::filesystem::u8path(path).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        std::cerr << "Error: cannot open " << path << " for mapping" << std::endl;
+        return nullptr;
+    }
+    file->fileHandle = handle;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size)) {
+        return nullptr;
+    }
+    file->fileSize = static_cast<uint64_t>(size.QuadPart);
+    if (file->fileSize > 0) {
+        file->mappingHandle = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (file->mappingHandle == nullptr) {
+            std::cerr << "Error: cannot map " << path << std::endl;
+            return nullptr;
+        }
+    }
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    file->granularity = info.dwAllocationGranularity;
+#else
+    file->descriptor = ::open(path.c_str(), O_RDONLY);
+    if (file->descriptor < 0) {
+        std::cerr << "Error: cannot open " << path << " for mapping" << std::endl;
+        return nullptr;
+    }
+    struct stat status;
+    if (fstat(file->descriptor, &status) != 0) {
+        return nullptr;
+    }
+    file->fileSize = static_cast<uint64_t>(status.st_size);
+    file->granularity = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+    return file;
+}
+
+/**
+ * @brief Mapeia os bytes [offset, offset + length) do arquivo.
+ */
+MappedFile::View MappedFile::map(uint64_t offset, std::size_t length, bool sequential) const {
+    View view;
+    if (length == 0 || offset > fileSize || length > fileSize - offset) {
+        return view;
+    }
+    const uint64_t aligned = offset - offset % granularity;
+    const std::size_t delta = static_cast<std::size_t>(offset - aligned);
+#if defined(_WIN32)
+    (void)sequential;
+    void* address = MapViewOfFile(mappingHandle, FILE_MAP_READ, static_cast<DWORD>(aligned >> 32),
+                                  static_cast<DWORD>(aligned & 0xFFFFFFFFu), delta + length);
+    if (address == nullptr) {
+        std::cerr << "Error: MapViewOfFile failed" << std::endl;
+        return view;
+    }
+#else
+    void* address = mmap(nullptr, delta + length, PROT_READ, MAP_PRIVATE, descriptor, static_cast<off_t>(aligned));
+    if (address == MAP_FAILED) {
+        std::cerr << "Error: mmap failed" << std::endl;
+        return view;
+    }
+    if (sequential) {
+        madvise(address, delta + length, MADV_SEQUENTIAL);
+    }
+#endif
+    view.base = static_cast<const uint8_t*>(address);
+    view.delta = delta;
+    view.length = length;
+    return view;
+}
+
+}
@@ -0,0 +1,108 @@
+/**
+ * DICOM Viewer - Arquivo Mapeado em Memória
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+namespace dicom_viewer_core {
+
+/**
+ * @class MappedFile
+ * @brief Arquivo aberto somente para leitura, mapeado em memória em janelas.
+ *
+ * Em vez de mapear o arquivo inteiro, cada chamada a map() cria uma janela
+ * independente. Apenas as páginas efetivamente lidas ocupam memória
+ * residente, e a janela é desfeita (devolvendo as páginas ao sistema) quando
+ * a View sai de escopo. Isso permite percorrer arquivos de vários GB com a
+ * memória residente limitada ao tamanho da janela.
+ *
+ * Seguro para chamadas concorrentes de map(); cada View pertence a uma thread.
+ */
+class MappedFile {
+public:
+    /**
+     * @class View
+     * @brief Janela mapeada de um MappedFile; desfaz o mapeamento no destrutor.
+     */
+    class View {
+    public:
+        View() = default;
+        ~View();
+        View(View&& other) noexcept;
+        View& operator=(View&& other) noexcept;
+        View(const View&) = delete;
+        View& operator=(const View&) = delete;
+
+        /**
+         * @brief Primeiro byte pedido em map() (não necessariamente alinhado à página).
+         */
+        const uint8_t* data() const { return base ? base + delta : nullptr; }
+
+        /**
+         * @brief Número de bytes disponíveis a partir de data().
+         */
+        std::size_t size() const { return length; }
+
+        bool isValid() const { return base != nullptr; }
+
+    private:
+        friend class MappedFile;
+        void reset();
+
+        const uint8_t* base = nullptr;                ///< Início do mapeamento (alinhado)
+        std::size_t delta = 0;                        ///< Deslocamento do byte pedido dentro do mapeamento
+        std::size_t length = 0;                       ///< Bytes pedidos
+    };
+
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Abre um arquivo para mapeamento.
+     * @return O arquivo, ou nullptr se não puder ser aberto.
+     */
+    static std::unique_ptr<MappedFile> open(const std::string& path);
+
+    /**
+     * @brief Tamanho do arquivo em bytes.
+     */
+    uint64_t size() const { return fileSize; }
+
+    /**
+     * @brief Mapeia os bytes [offset, offset + length) do arquivo.
+     *
+     * O mapeamento começa na fronteira de página (ou de granularidade de
+     * alocação, no Windows) anterior a offset; data() aponta já para offset.
+     *
+     * @param sequential Se true, avisa o sistema que a janela será lida em ordem (read-ahead).
+     * @return A janela, ou uma View inválida se o intervalo estiver fora do arquivo.
+     */
+    View map(uint64_t offset, std::size_t length, bool sequential = false) const;
+
+private:
+    MappedFile() = default;
+
+#if defined(_WIN32)
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int descriptor = -1;
+#endif
+    uint64_t fileSize = 0;
+    uint64_t granularity = 4096;                      ///< Alinhamento exigido do deslocamento do mapeamento
+};
+
+}
+
+#endif // MAPPEDFILE_H
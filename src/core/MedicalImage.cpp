@@ -9,43 +9,316 @@
 #include <vector>
 #include <iostream>
 #include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <filesystem>
 
 #include <dcmtk/dcmimgle/dcmimage.h>
 #include <dcmtk/dcmdata/dctk.h>
-#include <dcmtk/dcmjpeg/djdecode.h>
 
 #include "MedicalImage.h"
+#include "ColorConversion.h"
+#include "DecodedCache.h"
+#include "DicomCodecs.h"
+#include "FrameDecoder.h"
+#include "ImageKey.h"
+#include "ThreadPool.h"
+#include "Trace.h"
 
 namespace dicom_viewer_core {
 
+namespace {
+
 /**
- * @brief Carrega um arquivo DICOM e retorna os dados de imagem e metadados.
- * 
- * Abre um arquivo DICOM, extrai os dados de pixel, metadados DICOM e
- * converte para um formato em memória facilmente acessível.
+ * @brief Tamanho do arquivo em bytes, ou 0 se não puder ser obtido (usado no rastreamento).
+ */
+[[maybe_unused]] std::uintmax_t fileSize(const std::string& path) {
+    std::error_code error;
+    const std::uintmax_t size = std::filesystem::file_size(path, error);
+    return error ? 0 : size;
+}
+
+/**
+ * @brief Lê os valores armazenados do quadro 0 de uma imagem monocromática.
  *
- * @param path Caminho completo do arquivo DICOM a ser carregado.
- * @param want16Bit Se true, retorna imagem em 16 bits; se false, em 8 bits.
- * @return MedicalImage contendo os dados e metadados da imagem DICOM.
- * 
- * @note Se o arquivo não puder ser carregado, retorna uma MedicalImage inválida (isValid() = false).
+ * O Pixel Data é lido (e, se encapsulado, descomprimido) direto no buffer de
+ * saída, sem passar pelo DicomImage. O rescale não é aplicado aos pixels:
+ * slope e intercept ficam nos metadados para o janelamento.
+ *
+ * Float Pixel Data (mapas paramétricos) é copiado como Float32; inteiros de
+ * 32 bits viram Int32, desde que caibam (com sinal, ou até 31 bits armazenados).
+ *
+ * @return false se a imagem não for monocromática de 8, 16 ou 32 bits ou não puder ser lida.
  */
-MedicalImage loadDicomRaw(const std::string& path, bool want16Bit) {
-    MedicalImage output;
-    DJDecoderRegistration::registerCodecs();
+bool loadStoredFrame(DcmDataset* dataset, MedicalImage& output) {
+    Uint16 rows = 0;
+    Uint16 cols = 0;
+    dataset->findAndGetUint16(DCM_Rows, rows);
+    dataset->findAndGetUint16(DCM_Columns, cols);
+    readDicomMetadata(dataset, output);
+    const bool monochrome = output.photometricInterpretation == "MONOCHROME1" ||
+                            output.photometricInterpretation == "MONOCHROME2";
+    if (rows == 0 || cols == 0 || output.samplesPerPixel != 1 || !monochrome) {
+        return false;
+    }
 
-    DcmFileFormat fileformat;
-    OFCondition status = fileformat.loadFile(path.c_str());
-    
+    const std::size_t pixels = static_cast<std::size_t>(rows) * cols;
+    const Float32* floats = nullptr;
+    unsigned long floatCount = 0;
+    if (dataset->findAndGetFloat32Array(DCM_FloatPixelData, floats, &floatCount).good() && floats != nullptr &&
+        floatCount >= pixels) {
+        output.buffer.allocate(pixels * sizeof(float));
+        std::memcpy(output.buffer.data(), floats, pixels * sizeof(float));
+        output.width = cols;
+        output.height = rows;
+        output.setPixelType(PixelType::Float32);
+        return true;
+    }
+    const bool fitsInt32 = output.bitsAllocated == 32 && (output.pixelRepresentation == 1 || output.bitsStored < 32);
+    if (output.bitsAllocated != 8 && output.bitsAllocated != 16 && !fitsInt32) {
+        return false;
+    }
+
+    DcmElement* pixelData = nullptr;
+    if (dataset->findAndGetElement(DCM_PixelData, pixelData).bad() || pixelData == nullptr) {
+        return false;
+    }
+    const std::size_t frameBytes = static_cast<std::size_t>(rows) * cols * (output.bitsAllocated / 8);
+    output.buffer.allocate(frameBytes);
+    uint32_t startFragment = 0;
+    if (!decodeStoredFrame(dataset, 0, output.buffer.data(), frameBytes, startFragment)) {
+        std::cerr << "Warning: cannot decode stored pixel values" << std::endl;
+        output.buffer.clear();
+        return false;
+    }
+    normalizeStoredValues(output.buffer.data(), static_cast<std::size_t>(rows) * cols, output.bitsAllocated,
+                          output.bitsStored, output.highBit, output.pixelRepresentation);
+    output.width = cols;
+    output.height = rows;
+    output.bitDepth = output.bitsAllocated;
+    output.fullPrecision = true;
+    return true;
+}
+
+/**
+ * @brief Converte o quadro 0 de uma imagem colorida não comprimida direto para RGB888.
+ *
+ * RGB (intercalado ou planar), YBR_FULL, YBR_FULL_422, YBR_PARTIAL_422 e
+ * PALETTE COLOR são convertidos pelos kernels de ColorConversion, sem
+ * passar pelo DicomImage.
+ *
+ * @return false se a imagem não for colorida, estiver comprimida ou o formato não tiver conversão direta.
+ */
+bool loadColorFrame(DcmDataset* dataset, MedicalImage& output) {
+    ColorLayout layout;
+    if (DcmXfer(dataset->getCurrentXfer()).isEncapsulated() || !readColorLayout(dataset, layout)) {
+        return false;
+    }
+    PaletteLut palette;
+    if (layout.model == ColorModel::Palette &&
+        !readPaletteLut(dataset, static_cast<int>(layout.format.bytesPerSample()) * 8, palette)) {
+        return false;
+    }
+    readDicomMetadata(dataset, output);
+    output.width = layout.width;
+    output.height = layout.height;
+    output.buffer.allocate(static_cast<std::size_t>(layout.width) * layout.height * 3);
+    if (!decodeColorFrame(dataset, 0, layout, &palette, output.buffer.data(), static_cast<std::size_t>(layout.width) * 3,
+                          ThreadPool::shared())) {
+        output = MedicalImage();
+        return false;
+    }
+    output.samplesPerPixel = 3;
+    output.planarConfiguration = 0;
+    output.bitDepth = 8;
+    return true;
+}
+
+}
+
+/**
+ * @brief Define o tipo das amostras de um buffer de precisão total, ajustando os atributos de pixel.
+ */
+void MedicalImage::setPixelType(PixelType type) {
+    const int bits = static_cast<int>(pixelTypeSize(type)) * 8;
+    bitsAllocated = bits;
+    bitsStored = bits;
+    highBit = bits - 1;
+    bitDepth = bits;
+    pixelRepresentation = (type == PixelType::UInt8 || type == PixelType::UInt16) ? 0 : 1;
+    floatingPoint = type == PixelType::Float32;
+    fullPrecision = true;
+}
+
+/**
+ * @brief Preenche os metadados de uma MedicalImage a partir de um dataset DICOM.
+ */
+void readDicomMetadata(DcmItem* dataset, MedicalImage& image) {
+    Uint16 samplesPerPixel = 0;
+    Uint16 bitsAllocated = 0;
+    Uint16 bitsStored = 0;
+    Uint16 highBit = 0;
+    Uint16 pixelRepresentation = 0;
+    if (dataset->findAndGetUint16(DCM_SamplesPerPixel, samplesPerPixel).good()) {
+        image.samplesPerPixel = samplesPerPixel;
+    }
+    if (dataset->findAndGetUint16(DCM_BitsAllocated, bitsAllocated).good()) {
+        image.bitsAllocated = bitsAllocated;
+    }
+    // Na ausência de Bits Stored / High Bit, assume-se que todos os bits alocados são usados
+    image.bitsStored = image.bitsAllocated;
+    if (dataset->findAndGetUint16(DCM_BitsStored, bitsStored).good()) {
+        image.bitsStored = bitsStored;
+    }
+    image.highBit = image.bitsStored - 1;
+    if (dataset->findAndGetUint16(DCM_HighBit, highBit).good()) {
+        image.highBit = highBit;
+    }
+    if (dataset->findAndGetUint16(DCM_PixelRepresentation, pixelRepresentation).good()) {
+        image.pixelRepresentation = pixelRepresentation;
+    }
+    Uint16 planarConfiguration = 0;
+    if (dataset->findAndGetUint16(DCM_PlanarConfiguration, planarConfiguration).good()) {
+        image.planarConfiguration = planarConfiguration;
+    }
+    Float64 windowCenter = 0.0;
+    Float64 windowWidth = 0.0;
+    if (dataset->findAndGetFloat64(DCM_WindowCenter, windowCenter).good()) {
+        image.windowCenter = windowCenter;
+    }
+    if (dataset->findAndGetFloat64(DCM_WindowWidth, windowWidth).good()) {
+        image.windowWidth = windowWidth;
+    }
+    Float64 rescaleSlope = 1.0;
+    Float64 rescaleIntercept = 0.0;
+    if (dataset->findAndGetFloat64(DCM_RescaleSlope, rescaleSlope).good() && rescaleSlope != 0.0) {
+        image.rescaleSlope = rescaleSlope;
+    }
+    if (dataset->findAndGetFloat64(DCM_RescaleIntercept, rescaleIntercept).good()) {
+        image.rescaleIntercept = rescaleIntercept;
+    }
+    // Pixel Spacing é (linha, coluna); radiografias projetivas trazem apenas Imager Pixel Spacing
+    const DcmTagKey spacingTag = dataset->tagExistsWithValue(DCM_PixelSpacing) ? DCM_PixelSpacing : DCM_ImagerPixelSpacing;
+    Float64 rowSpacing = 0.0;
+    Float64 columnSpacing = 0.0;
+    if (dataset->findAndGetFloat64(spacingTag, rowSpacing, 0).good() &&
+        dataset->findAndGetFloat64(spacingTag, columnSpacing, 1).good() && rowSpacing > 0.0 && columnSpacing > 0.0) {
+        image.spacingY = rowSpacing;
+        image.spacingX = columnSpacing;
+    }
+    OFString patientName;
+    OFString studyDate;
+    OFString modality;
+    OFString photometricInterpretation;
+    if (dataset->findAndGetOFString(DCM_PatientName, patientName).good()) {
+        image.patientName = patientName.c_str();
+    }
+    if (dataset->findAndGetOFString(DCM_StudyDate, studyDate).good()) {
+        image.studyDate = studyDate.c_str();
+    }
+    if (dataset->findAndGetOFString(DCM_Modality, modality).good()) {
+        image.modality = modality.c_str();
+    }
+    if (dataset->findAndGetOFString(DCM_PhotometricInterpretation, photometricInterpretation).good()) {
+        image.photometricInterpretation = photometricInterpretation.c_str();
+    }
+
+    Sint32 numberOfFrames = 0;
+    if (dataset->findAndGetSint32(DCM_NumberOfFrames, numberOfFrames).good() && numberOfFrames > 0) {
+        image.numberOfFrames = numberOfFrames;
+    }
+    // Intervalo entre quadros: Frame Time, ou derivado das taxas recomendadas
+    Float64 frameTime = 0.0;
+    Float64 frameRate = 0.0;
+    Sint32 cineRate = 0;
+    if (dataset->findAndGetFloat64(DCM_FrameTime, frameTime).good() && frameTime > 0.0) {
+        image.frameTimeMs = frameTime;
+    } else if (dataset->findAndGetFloat64(DCM_RecommendedDisplayFrameRate, frameRate).good() && frameRate > 0.0) {
+        image.frameTimeMs = 1000.0 / frameRate;
+    } else if (dataset->findAndGetSint32(DCM_CineRate, cineRate).good() && cineRate > 0) {
+        image.frameTimeMs = 1000.0 / cineRate;
+    }
+}
+
+/**
+ * @brief Abre um arquivo DICOM Parte 10 deixando o Pixel Data no disco (leitura preguiçosa).
+ */
+std::unique_ptr<DcmFileFormat> openDicomLazy(const std::string& path) {
+    auto fileformat = std::make_unique<DcmFileFormat>();
+    // ERM_fileOnly exige o meta header, substituindo a verificação separada do preâmbulo
+    OFCondition status = fileformat->loadFile(path.c_str(), EXS_Unknown, EGL_noChange, kLazyValueLength,
+                                              ERM_fileOnly);
     if (status.bad()) {
-        std::cerr << "Error: cannot read DICOM file (" << status.text() << ")" << std::endl;
-        DJDecoderRegistration::cleanup();
-        return output;
+        std::cerr << "Error: cannot read DICOM file " << path << " (" << status.text() << ")" << std::endl;
+        return nullptr;
+    }
+    return fileformat;
+}
+
+/**
+ * @brief Decodifica a imagem de um dataset DICOM já carregado.
+ *
+ * Contém as etapas de loadDicomRaw posteriores à leitura do arquivo, de modo
+ * que quem já possui o dataset em memória (por exemplo, um pipeline que separa
+ * leitura e decodificação) não precisa reabrir o arquivo.
+ *
+ * @param dataset Dataset com o Pixel Data. Pode ser modificado (descompressão).
+ * @param want16Bit Se true, imagens monocromáticas mantêm os valores armazenados em
+ *                  precisão total (fullPrecision); se false, retorna 8 bits para exibição.
+ * @param stats Se não nulo, recebe os tempos das etapas de decodificação (parseMs = 0).
+ * @param progress Se definido, é chamado entre as etapas e pode cancelar.
+ * @return MedicalImage contendo os dados e metadados da imagem, ou inválida em caso de erro.
+ */
+MedicalImage decodeDicomDataset(DcmDataset* dataset, bool want16Bit, LoadStats* stats,
+                                const LoadProgressCallback& progress) {
+    MedicalImage output;
+    LoadStats localStats;
+    LoadStats& timings = stats ? *stats : localStats;
+    timings = LoadStats();
+    const auto loadStart = std::chrono::steady_clock::now();
+
+    // Reporta o progresso e indica se a decodificação deve continuar
+    auto proceed = [&](int percent) {
+        if (progress && !progress(percent)) {
+            timings.cancelled = true;
+            timings.totalMs = elapsedMs(loadStart);
+            return false;
+        }
+        return true;
+    };
+
+    // Sintaxes nativas não passam pelos codecs: o registro fica para o primeiro arquivo comprimido
+    if (DcmXfer(dataset->getCurrentXfer()).isEncapsulated()) {
+        ensureCodecsRegistered();
+    }
+    std::chrono::steady_clock::time_point stageStart;
+
+    // Multi-frame: apenas o primeiro quadro é decodificado (os demais via FrameSource)
+    Sint32 numberOfFrames = 1;
+    dataset->findAndGetSint32(DCM_NumberOfFrames, numberOfFrames);
+    const bool multiFrame = numberOfFrames > 1;
+
+    // Precisão total: o quadro 0 é decodificado direto no buffer, sem DicomImage
+    if (want16Bit) {
+        stageStart = std::chrono::steady_clock::now();
+        const bool loaded = loadStoredFrame(dataset, output);
+        timings.decompressMs = elapsedMs(stageStart);
+        DICOM_TRACE_SPAN("decompress", stageStart, output.buffer.size());
+        if (loaded) {
+            timings.totalMs = elapsedMs(loadStart);
+            if (progress) {
+                progress(100);
+            }
+            return output;
+        }
+        // Imagens coloridas (ou formatos não suportados) seguem o caminho de exibição em 8 bits
+        output = MedicalImage();
+        want16Bit = false;
     }
-    DcmDataset *dataset = fileformat.getDataset();
     
     // Primeiro, tenta descomprimir para Little Endian Explicit VR
-    OFCondition decompResult = dataset->chooseRepresentation(EXS_LittleEndianExplicit, nullptr);
+    stageStart = std::chrono::steady_clock::now();
+    OFCondition decompResult = multiFrame ? EC_Normal : dataset->chooseRepresentation(EXS_LittleEndianExplicit, nullptr);
     if (decompResult.bad()) {
         std::cerr << "Warning: chooseRepresentation(EXS_LittleEndianExplicit) failed (" << decompResult.text() << ")" << std::endl;
         
@@ -55,11 +328,22 @@ MedicalImage loadDicomRaw(const std::string& path, bool want16Bit) {
             std::cerr << "Warning: chooseRepresentation(EXS_LittleEndianImplicit) also failed (" << decompResult.text() << ")" << std::endl;
         }
     }
+    timings.decompressMs = elapsedMs(stageStart);
+    DICOM_TRACE_SPAN("decompress", stageStart, 0);
+    if (!proceed(60)) {
+        return output;
+    }
     
-    // Força a decomposição para forma unencapsulated
-    Uint16 planarConfig = 0;
-    
-    if (dataset->findAndGetUint16(DCM_PlanarConfiguration, planarConfig).good()) {
+    // Cor não comprimida: conversão direta para RGB888, sem o DicomImage
+    stageStart = std::chrono::steady_clock::now();
+    if (loadColorFrame(dataset, output)) {
+        timings.outputMs = elapsedMs(stageStart);
+        timings.totalMs = elapsedMs(loadStart);
+        DICOM_TRACE_SPAN("output", stageStart, output.buffer.size());
+        if (progress) {
+            progress(100);
+        }
+        return output;
     }
 
     OFString photometricInterpretation;
@@ -71,7 +355,18 @@ MedicalImage loadDicomRaw(const std::string& path, bool want16Bit) {
     Uint16 rows = 0, cols = 0;
     dataset->findAndGetUint16(DCM_Rows, rows);
     dataset->findAndGetUint16(DCM_Columns, cols);
-    DicomImage dcmImage(path.c_str());
+
+    // Reaproveita o dataset já descomprimido em vez de reabrir o arquivo
+    stageStart = std::chrono::steady_clock::now();
+    // Em multi-frame o acesso parcial lê e descomprime somente o quadro 0
+    const unsigned long imageFlags = multiFrame ? CIF_UsePartialAccessToPixelData : 0;
+    const unsigned long frameCount = multiFrame ? 1 : 0;
+    DicomImage dcmImage(dataset, dataset->getCurrentXfer(), imageFlags, 0, frameCount);
+    timings.imageMs = elapsedMs(stageStart);
+    DICOM_TRACE_SPAN("decode", stageStart, 0);
+    if (!proceed(80)) {
+        return output;
+    }
 
     if (dcmImage.getStatus() != EIS_Normal) {
         std::cerr << "Error: cannot load DICOM image (status: " << (int)dcmImage.getStatus() << ")" << std::endl;
@@ -83,7 +378,7 @@ MedicalImage loadDicomRaw(const std::string& path, bool want16Bit) {
             output.height = rows;
         } else {
             std::cerr << "  Dataset dimensions also invalid" << std::endl;
-            DJDecoderRegistration::cleanup();
+            timings.totalMs = elapsedMs(loadStart);
             return output;
         }
     } else {
@@ -96,55 +391,31 @@ MedicalImage loadDicomRaw(const std::string& path, bool want16Bit) {
     // Se ainda assim width ou height forem 0, falha
     if (output.width == 0 || output.height == 0) {
         std::cerr << "Error: Image dimensions are still invalid (0x0)" << std::endl;
-        DJDecoderRegistration::cleanup();
+        timings.totalMs = elapsedMs(loadStart);
         return output;
     }
 
     // Extrair metadados
-    Uint16 samplesPerPixel = 0;
-    Uint16 bitsAllocated = 0;
-    Uint16 bitsStored = 0;
-    Uint16 highBit = 0;
-    Uint16 pixelRepresentation = 0;
-    if (dataset->findAndGetUint16(DCM_SamplesPerPixel, samplesPerPixel).good()) {
-        output.samplesPerPixel = samplesPerPixel;
-    }
-    if (dataset->findAndGetUint16(DCM_BitsAllocated, bitsAllocated).good()) {
-        output.bitsAllocated = bitsAllocated;
-    }
-    if (dataset->findAndGetUint16(DCM_BitsStored, bitsStored).good()) {
-        output.bitsStored = bitsStored;
-    }
-    if (dataset->findAndGetUint16(DCM_HighBit, highBit).good()) {
-        output.highBit = highBit;
-    }
-    if (dataset->findAndGetUint16(DCM_PixelRepresentation, pixelRepresentation).good()) {
-        output.pixelRepresentation = pixelRepresentation;
-    }
-    Float64 windowCenter = 0.0;
-    Float64 windowWidth = 0.0;
-    if (dataset->findAndGetFloat64(DCM_WindowCenter, windowCenter).good()) {
-        output.windowCenter = windowCenter;
-    }
-    if (dataset->findAndGetFloat64(DCM_WindowWidth, windowWidth).good()) {
-        output.windowWidth = windowWidth;
-    }
-    OFString patientName;
-    OFString studyDate;
-    OFString modality;
-    if (dataset->findAndGetOFString(DCM_PatientName, patientName).good()) {
-        output.patientName = patientName.c_str();
-    }
-    if (dataset->findAndGetOFString(DCM_StudyDate, studyDate).good()) {
-        output.studyDate = studyDate.c_str();
-    }
-    if (dataset->findAndGetOFString(DCM_Modality, modality).good()) {
-        output.modality = modality.c_str();
-    }
+    readDicomMetadata(dataset, output);
     output.photometricInterpretation = photometricInterpretation.c_str();
+    const int samplesPerPixel = output.samplesPerPixel;
+    const int bitsAllocated = output.bitsAllocated;
     
     // Se DicomImage falhou, tentar extrair pixel data do dataset
     bool useDirectDataset = (dcmImage.getStatus() != EIS_Normal);
+    // O DicomImage entrega as amostras intercaladas; a cópia direta preserva a organização do arquivo
+    if (!useDirectDataset) {
+        output.planarConfiguration = 0;
+    }
+    if (useDirectDataset && DcmXfer(dataset->getCurrentXfer()).isEncapsulated()) {
+        // Os bytes encapsulados são o fluxo comprimido, não pixels: copiá-los geraria ruído na tela
+        std::cerr << "Error: no decoder for transfer syntax " << DcmXfer(dataset->getCurrentXfer()).getXferName()
+                  << std::endl;
+        output.width = 0;
+        output.height = 0;
+        timings.totalMs = elapsedMs(loadStart);
+        return output;
+    }
     
     int bits = want16Bit ? 16 : 8;
     unsigned long size = 0;
@@ -159,7 +430,11 @@ MedicalImage loadDicomRaw(const std::string& path, bool want16Bit) {
         size = (unsigned long)output.width * output.height * (bitsAllocated / 8) * samplesPerPixel;
     }
     
-    if (samplesPerPixel == 3) {
+    // PALETTE COLOR tem uma amostra armazenada, mas o DicomImage a entrega em RGB
+    if (!useDirectDataset && !dcmImage.isMonochrome()) {
+        output.samplesPerPixel = 3;
+    }
+    if (output.samplesPerPixel == 3) {
         bits = 8;
         size = (unsigned long)output.width * output.height * 3;
     }
@@ -169,11 +444,17 @@ MedicalImage loadDicomRaw(const std::string& path, bool want16Bit) {
         std::cerr << "  width=" << output.width << ", height=" << output.height 
                   << ", samplesPerPixel=" << samplesPerPixel 
                   << ", bitsAllocated=" << bitsAllocated << std::endl;
-        DJDecoderRegistration::cleanup();
+        timings.totalMs = elapsedMs(loadStart);
         return output;
     }
     
-    output.buffer.resize(size);
+    stageStart = std::chrono::steady_clock::now();
+    // getOutputData preenche o buffer inteiro; a cópia direta pode preencher só parte dele
+    if (useDirectDataset) {
+        output.buffer.resize(size);
+    } else {
+        output.buffer.allocate(size);
+    }
     unsigned long bytesWritten = 0;
     
     if (!useDirectDataset) {
@@ -224,15 +505,170 @@ MedicalImage loadDicomRaw(const std::string& path, bool want16Bit) {
         output.buffer.clear();
         output.width = 0;
         output.height = 0;
-        DJDecoderRegistration::cleanup();
+        timings.outputMs = elapsedMs(stageStart);
+        timings.totalMs = elapsedMs(loadStart);
         return output;
     }
+    // Cópia direta de cor planar: intercalada aqui, para que a exibição só receba RGB888
+    if (useDirectDataset && output.samplesPerPixel == 3 && output.planarConfiguration == 1 && bitsAllocated == 8) {
+        ColorLayout layout;
+        layout.model = ColorModel::Rgb;
+        layout.format.samplesPerPixel = 3;
+        layout.format.planar = true;
+        layout.width = output.width;
+        layout.height = output.height;
+        PixelBuffer interleaved;
+        interleaved.allocate(size);
+        if (convertColorFrame(output.buffer.data(), layout, nullptr, interleaved.data(),
+                              static_cast<std::size_t>(output.width) * 3, ThreadPool::shared())) {
+            output.buffer = std::move(interleaved);
+            output.planarConfiguration = 0;
+        }
+    }
+    timings.outputMs = elapsedMs(stageStart);
+    timings.totalMs = elapsedMs(loadStart);
+    DICOM_TRACE_SPAN("output", stageStart, bytesWritten);
+    if (progress) {
+        progress(100);
+    }
+
+    return output;
+}
+
+/**
+ * @brief Carrega um arquivo DICOM e retorna os dados de imagem e metadados.
+ * 
+ * Abre um arquivo DICOM, extrai os dados de pixel, metadados DICOM e
+ * converte para um formato em memória facilmente acessível. O arquivo é
+ * lido e descomprimido uma única vez: o DicomImage é construído a partir
+ * do dataset já carregado. Em arquivos multi-frame apenas o primeiro quadro
+ * é lido e decodificado; os demais são obtidos sob demanda via FrameSource.
+ *
+ * @param path Caminho completo do arquivo DICOM a ser carregado.
+ * @param want16Bit Se true, imagens monocromáticas mantêm os valores armazenados em
+ *                  precisão total (fullPrecision); se false, retorna 8 bits para exibição.
+ * @param stats Se não nulo, recebe os tempos de cada etapa do carregamento.
+ * @param progress Se definido, é chamado entre as etapas e pode cancelar o carregamento.
+ * @return MedicalImage contendo os dados e metadados da imagem DICOM.
+ * 
+ * @note Imagens coloridas são sempre retornadas em 8 bits por amostra.
+ * @note Se o carregamento for cancelado, retorna uma MedicalImage inválida e stats->cancelled = true.
+ * @note Se o arquivo não puder ser carregado, retorna uma MedicalImage inválida (isValid() = false).
+ * @note Apenas arquivos no formato DICOM Parte 10 (preâmbulo + "DICM") são aceitos.
+ */
+MedicalImage loadDicomRaw(const std::string& path, bool want16Bit, LoadStats* stats,
+                          const LoadProgressCallback& progress) {
+    MedicalImage output;
+    LoadStats localStats;
+    LoadStats& timings = stats ? *stats : localStats;
+    timings = LoadStats();
+    const auto loadStart = std::chrono::steady_clock::now();
+
+    // Reporta o progresso e indica se o carregamento deve continuar
+    auto proceed = [&](int percent) {
+        if (progress && !progress(percent)) {
+            timings.cancelled = true;
+            timings.totalMs = elapsedMs(loadStart);
+            return false;
+        }
+        return true;
+    };
+
+    auto stageStart = std::chrono::steady_clock::now();
+    std::unique_ptr<DcmFileFormat> fileformat = openDicomLazy(path);
+    timings.parseMs = elapsedMs(stageStart);
+    DICOM_TRACE_SPAN("read", stageStart, fileSize(path));
     
-    DJDecoderRegistration::cleanup();
+    if (!fileformat) {
+        timings.totalMs = elapsedMs(loadStart);
+        return output;
+    }
+    DcmDataset *dataset = fileformat->getDataset();
+    if (!proceed(30)) {
+        return output;
+    }
+
+    // Arquivo comprimido já visto: os pixels decodificados são mapeados do cache em disco
+    std::shared_ptr<DecodedCache> cache;
+    DecodedKey cacheKey;
+    if (DcmXfer(dataset->getCurrentXfer()).isEncapsulated() && (cache = decodedCache())) {
+        const ImageKey fileKey = imageKeyForFile(path);
+        OFString sopInstanceUid;
+        dataset->findAndGetOFString(DCM_SOPInstanceUID, sopInstanceUid);
+        cacheKey.sopInstanceUid = sopInstanceUid.c_str();
+        cacheKey.fileSize = fileKey.size;
+        cacheKey.modified = fileKey.modified;
+        cacheKey.fullPrecision = want16Bit;
+        if (!fileKey.isValid()) {
+            cache.reset();
+        } else {
+            stageStart = std::chrono::steady_clock::now();
+            readDicomMetadata(dataset, output);
+            if (cache->lookup(cacheKey, output)) {
+                DICOM_TRACE_SPAN("decoded-cache", stageStart, output.buffer.size());
+                timings.totalMs = elapsedMs(loadStart);
+                if (progress) {
+                    progress(100);
+                }
+                return output;
+            }
+            output = MedicalImage();
+        }
+    }
 
+    const double parseMs = timings.parseMs;
+    output = decodeDicomDataset(dataset, want16Bit, &timings, progress);
+    timings.parseMs = parseMs;
+    if (cache && !timings.cancelled && output.isValid()) {
+        cache->store(cacheKey, output);
+    }
+    timings.totalMs = elapsedMs(loadStart);
     return output;
 }
 
+/**
+ * @brief Normaliza, no próprio buffer, valores armazenados com bitsStored < bitsAllocated.
+ */
+void normalizeStoredValues(uint8_t* data, std::size_t count, int bitsAllocated, int bitsStored,
+                           int highBit, int pixelRepresentation) {
+    if (bitsStored <= 0 || bitsStored >= bitsAllocated ||
+        (bitsAllocated != 8 && bitsAllocated != 16 && bitsAllocated != 32)) {
+        return;
+    }
+    const int shift = std::max(0, highBit + 1 - bitsStored);
+    const int extend = 32 - bitsStored;
+    const uint32_t mask = (1u << bitsStored) - 1u;
+
+    if (bitsAllocated == 32) {
+        uint32_t* samples = reinterpret_cast<uint32_t*>(data);
+        for (std::size_t i = 0; i < count; ++i) {
+            uint32_t value = (samples[i] >> shift) & mask;
+            if (pixelRepresentation == 1) {
+                value = static_cast<uint32_t>(static_cast<int32_t>(value << extend) >> extend);
+            }
+            samples[i] = value;
+        }
+    } else if (bitsAllocated == 16) {
+        uint16_t* samples = reinterpret_cast<uint16_t*>(data);
+        for (std::size_t i = 0; i < count; ++i) {
+            uint32_t value = (static_cast<uint32_t>(samples[i]) >> shift) & mask;
+            if (pixelRepresentation == 1) {
+                // Estende o sinal a partir do bit bitsStored - 1
+                value = static_cast<uint32_t>(static_cast<int32_t>(value << extend) >> extend);
+            }
+            samples[i] = static_cast<uint16_t>(value);
+        }
+    } else {
+        for (std::size_t i = 0; i < count; ++i) {
+            uint32_t value = (static_cast<uint32_t>(data[i]) >> shift) & mask;
+            if (pixelRepresentation == 1) {
+                value = static_cast<uint32_t>(static_cast<int32_t>(value << extend) >> extend);
+            }
+            data[i] = static_cast<uint8_t>(value);
+        }
+    }
+}
+
 /**
  * @brief Formata os metadados DICOM de uma imagem médica em uma string legível.
  *
@@ -251,7 +687,8 @@ std::string getDicomMetadata(const MedicalImage& medicalImage) {
     metadataText += "  Profundidade de Bits: " + std::to_string(medicalImage.bitDepth) + " bits\n";
     metadataText += "  Espaçamento X: " + std::to_string(medicalImage.spacingX) + "\n";
     metadataText += "  Espaçamento Y: " + std::to_string(medicalImage.spacingY) + "\n";
-    metadataText += "  Photometric Interpretation: " + medicalImage.photometricInterpretation + "\n\n";
+    metadataText += "  Photometric Interpretation: " + medicalImage.photometricInterpretation + "\n";
+    metadataText += "  Quadros: " + std::to_string(medicalImage.numberOfFrames) + "\n\n";
 
     metadataText += "Informações de Pixel\n";
     metadataText += "  Samples per Pixel: " + std::to_string(medicalImage.samplesPerPixel) + "\n";
@@ -262,7 +699,9 @@ std::string getDicomMetadata(const MedicalImage& medicalImage) {
     
     metadataText += "Janelamento\n";
     metadataText += "  Window Center: " + std::to_string(medicalImage.windowCenter) + "\n";
-    metadataText += "  Window Width: " + std::to_string(medicalImage.windowWidth) + "\n\n";
+    metadataText += "  Window Width: " + std::to_string(medicalImage.windowWidth) + "\n";
+    metadataText += "  Rescale Slope: " + std::to_string(medicalImage.rescaleSlope) + "\n";
+    metadataText += "  Rescale Intercept: " + std::to_string(medicalImage.rescaleIntercept) + "\n\n";
     
     metadataText += "Modalidade: " + (medicalImage.modality.empty() ? std::string("N/A") : medicalImage.modality) + "\n";
     
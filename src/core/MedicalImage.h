@@ -7,14 +7,25 @@
  */
 
 #include <vector>
+#include <chrono>
 #include <cstdint>
 #include <iostream>
+#include <functional>
+#include <memory>
+#include <string>
 
 #include <dcmtk/dcmimgle/dcmimage.h>
 
+#include "PixelBuffer.h"
+#include "PixelFormat.h"
+
 #ifndef MEDICALIMAGE_H
 #define MEDICALIMAGE_H
 
+class DcmItem;
+class DcmDataset;
+class DcmFileFormat;
+
 namespace dicom_viewer_core {
 
 /**
@@ -37,14 +48,21 @@ struct MedicalImage {
     int bitsStored = 8;                               ///< Bits realmente armazenados
     int highBit = 7;                                  ///< Posição do bit mais significativo
     int pixelRepresentation = 0;                      ///< 0 = unsigned, 1 = signed
+    int planarConfiguration = 0;                      ///< Organização das amostras no buffer: 0 = RGBRGB..., 1 = RR..GG..BB..
+    bool floatingPoint = false;                       ///< true se o buffer guarda float de 32 bits (Float Pixel Data)
     double windowCenter = 0.0;                        ///< Centro do janelamento (Window/Level)
     double windowWidth = 0.0;                         ///< Largura do janelamento (Window/Level)
+    double rescaleSlope = 1.0;                        ///< Rescale Slope (valor de modalidade = armazenado * slope + intercept)
+    double rescaleIntercept = 0.0;                    ///< Rescale Intercept
+    bool fullPrecision = false;                       ///< true se o buffer guarda os valores armazenados, sem janelamento
     std::string patientName;                          ///< Nome do paciente
     std::string studyDate;                            ///< Data do estudo
     std::string modality;                             ///< Modalidade DICOM (ex: CT, MR, XA)
     std::string photometricInterpretation = "MONOCHROME2";  ///< Interpretação fotométrica
+    int numberOfFrames = 1;                           ///< Número de quadros no arquivo
+    double frameTimeMs = 0.0;                         ///< Intervalo nominal entre quadros (0 = desconhecido)
 
-    std::vector<uint8_t> buffer;                      ///< Buffer com dados de pixel brutos
+    PixelBuffer buffer;                               ///< Dados de pixel brutos (compartilhados entre cópias)
 
     /**
      * @brief Verifica se a imagem contém dados válidos.
@@ -57,9 +75,150 @@ struct MedicalImage {
      * @return Ponteiro para o início do buffer de dados.
      */
     uint8_t* rawPtr() { return buffer.data(); }
+
+    /**
+     * @brief Tipo e organização das amostras do buffer.
+     *
+     * Com fullPrecision o tipo segue os atributos de pixel do arquivo; sem
+     * ele o buffer é a saída de exibição do DicomImage (bitDepth bits).
+     */
+    PixelFormat pixelFormat() const {
+        PixelFormat format;
+        format.type = fullPrecision ? pixelTypeFor(bitsAllocated, pixelRepresentation, floatingPoint)
+                                    : (bitDepth == 16 ? PixelType::UInt16 : PixelType::UInt8);
+        format.samplesPerPixel = samplesPerPixel;
+        format.planar = planarConfiguration == 1 && samplesPerPixel > 1;
+        return format;
+    }
+
+    /**
+     * @brief Acesso tipado ao buffer; T deve corresponder a pixelFormat().type.
+     */
+    template <typename T>
+    PixelView<const T> view() const {
+        return PixelView<const T>{reinterpret_cast<const T*>(buffer.data()), width, height, samplesPerPixel,
+                                  planarConfiguration == 1 && samplesPerPixel > 1};
+    }
+
+    template <typename T>
+    PixelView<T> view() {
+        return PixelView<T>{reinterpret_cast<T*>(buffer.data()), width, height, samplesPerPixel,
+                            planarConfiguration == 1 && samplesPerPixel > 1};
+    }
+
+    /**
+     * @brief Define o tipo das amostras de um buffer de precisão total, ajustando os atributos de pixel.
+     *
+     * Atualiza bitsAllocated, bitsStored, highBit, bitDepth, pixelRepresentation
+     * e floatingPoint, e marca a imagem como fullPrecision. Não realoca o buffer.
+     */
+    void setPixelType(PixelType type);
+};
+
+/**
+ * @brief Preenche os metadados de uma MedicalImage a partir de um dataset DICOM.
+ *
+ * Lê atributos de pixel, janelamento, paciente, estudo e quadros. Não altera
+ * as dimensões nem o buffer de pixels.
+ *
+ * @param dataset Dataset DICOM de origem.
+ * @param image Imagem que recebe os metadados.
+ */
+void readDicomMetadata(DcmItem* dataset, MedicalImage& image);
+
+/**
+ * @brief Tamanho máximo de um valor lido na abertura de um arquivo; valores
+ * maiores (o Pixel Data) permanecem no disco até serem acessados.
+ */
+constexpr uint32_t kLazyValueLength = 4096;
+
+/**
+ * @brief Abre um arquivo DICOM Parte 10 deixando o Pixel Data no disco (leitura preguiçosa).
+ *
+ * Quem decodifica quadros ou cortes lê depois apenas os bytes necessários
+ * (acesso parcial ao Pixel Data).
+ *
+ * @param path Caminho do arquivo.
+ * @return O arquivo, ou nullptr (com a causa em std::cerr) se não puder ser lido.
+ */
+std::unique_ptr<DcmFileFormat> openDicomLazy(const std::string& path);
+
+/**
+ * @brief Retorna o tempo decorrido desde start, em milissegundos.
+ */
+inline double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @struct LoadStats
+ * @brief Tempos de cada etapa do carregamento de um arquivo DICOM, em milissegundos.
+ */
+struct LoadStats {
+    double parseMs = 0.0;                             ///< Abertura e parsing do arquivo
+    double decompressMs = 0.0;                        ///< Descompressão do Pixel Data (chooseRepresentation)
+    double imageMs = 0.0;                             ///< Construção do DicomImage a partir do dataset
+    double outputMs = 0.0;                            ///< Extração dos pixels para o buffer de saída
+    double totalMs = 0.0;                             ///< Tempo total do carregamento
+    bool cancelled = false;                           ///< true se o carregamento foi cancelado
 };
 
-MedicalImage loadDicomRaw(const std::string& path, bool want16Bit);
+/**
+ * @brief Callback de progresso do carregamento.
+ *
+ * Recebe o percentual concluído (0 a 100) e retorna false para cancelar o
+ * carregamento. O cancelamento é verificado entre as etapas.
+ */
+using LoadProgressCallback = std::function<bool(int percent)>;
+
+/**
+ * @brief Carrega um arquivo DICOM e retorna os dados de imagem e metadados.
+ *
+ * O arquivo é aberto e decodificado uma única vez.
+ *
+ * @param path Caminho completo do arquivo DICOM a ser carregado.
+ * @param want16Bit Se true, imagens monocromáticas mantêm os valores armazenados em
+ *                  precisão total (fullPrecision); se false, retorna 8 bits para exibição.
+ * @param stats Se não nulo, recebe os tempos de cada etapa do carregamento.
+ * @param progress Se definido, é chamado entre as etapas e pode cancelar o carregamento.
+ * @return MedicalImage contendo os dados e metadados da imagem DICOM.
+ *
+ * @note Seguro para chamadas concorrentes a partir de várias threads.
+ */
+MedicalImage loadDicomRaw(const std::string& path, bool want16Bit, LoadStats* stats = nullptr,
+                          const LoadProgressCallback& progress = LoadProgressCallback());
+
+/**
+ * @brief Decodifica a imagem de um dataset DICOM já carregado.
+ *
+ * Mesmas etapas de loadDicomRaw após a leitura do arquivo; permite separar a
+ * leitura (E/S) da decodificação (CPU) em threads diferentes.
+ *
+ * @param dataset Dataset com o Pixel Data; pode ser modificado pela descompressão.
+ * @param want16Bit Mesmo significado que em loadDicomRaw.
+ * @param stats Se não nulo, recebe os tempos das etapas (parseMs = 0).
+ * @param progress Se definido, é chamado entre as etapas e pode cancelar.
+ * @return MedicalImage decodificada, ou inválida em caso de erro.
+ */
+MedicalImage decodeDicomDataset(DcmDataset* dataset, bool want16Bit, LoadStats* stats = nullptr,
+                                const LoadProgressCallback& progress = LoadProgressCallback());
+
+/**
+ * @brief Normaliza, no próprio buffer, valores armazenados com bitsStored < bitsAllocated.
+ *
+ * Desloca os valores para que o bit mais significativo seja highBit, descarta
+ * bits que não pertencem à amostra (ex.: overlays) e estende o sinal quando
+ * pixelRepresentation = 1.
+ *
+ * @param data Buffer com as amostras em ordem de bytes local.
+ * @param count Número de amostras no buffer.
+ * @param bitsAllocated Bits alocados por amostra (8, 16 ou 32).
+ * @param bitsStored Bits realmente armazenados.
+ * @param highBit Posição do bit mais significativo.
+ * @param pixelRepresentation 0 = unsigned, 1 = signed.
+ */
+void normalizeStoredValues(uint8_t* data, std::size_t count, int bitsAllocated, int bitsStored,
+                           int highBit, int pixelRepresentation);
 
 /**
  * @brief Formata os metadados DICOM de uma imagem médica em uma string legível.
@@ -0,0 +1,423 @@
+/**
+ * DICOM Viewer - Volume Paginado em Arquivo de Trabalho
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <iostream>
+
+#include "PagedVolume.h"
+#include "Trace.h"
+
+namespace dicom_viewer_core {
+
+namespace {
+
+/**
+ * @brief Passo da leitura antecipada: um byte por página de 4 KB.
+ */
+constexpr std::size_t kTouchStride = 4096;
+
+/**
+ * @brief Lê um byte de cada página, trazendo o intervalo para a memória na thread chamadora.
+ */
+void touchPages(const uint8_t* data, std::size_t length) {
+    volatile uint8_t sink = 0;
+    for (std::size_t offset = 0; offset < length; offset += kTouchStride) {
+        sink = static_cast<uint8_t>(sink + data[offset]);
+    }
+    (void)sink;
+}
+
+#if defined(_WIN32)
+std::atomic<unsigned> scratchCounter{0};          ///< Distingue os arquivos de trabalho do mesmo processo
+#endif
+
+}
+
+/**
+ * @struct PagedVolume::Chunk
+ * @brief Mapeamento gravável de um bloco do arquivo de trabalho; desfeito no destrutor.
+ */
+struct PagedVolume::Chunk {
+    uint8_t* base = nullptr;
+    std::size_t length = 0;
+
+    ~Chunk() {
+        if (base == nullptr) {
+            return;
+        }
+#if defined(_WIN32)
+        UnmapViewOfFile(base);
+#else
+        munmap(base, length);
+#endif
+    }
+};
+
+/**
+ * @brief Para a leitura antecipada e fecha o arquivo de trabalho.
+ *
+ * Blocos ainda referenciados por um SliceRef continuam mapeados até que ele
+ * seja destruído; o arquivo só deixa de existir depois disso.
+ */
+PagedVolume::~PagedVolume() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    prefetchWake.notify_all();
+    if (prefetchThread.joinable()) {
+        prefetchThread.join();
+    }
+    resident.clear();
+#if defined(_WIN32)
+    if (mappingHandle != nullptr) {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle != nullptr) {
+        CloseHandle(fileHandle);
+    }
+#else
+    if (descriptor >= 0) {
+        ::close(descriptor);
+    }
+#endif
+}
+
+/**
+ * @brief Cria o arquivo de trabalho de um volume (com voxels zerados).
+ */
+std::shared_ptr<PagedVolume> PagedVolume::create(const Volume& header, const PagedVolumeConfig& config) {
+    const std::size_t sliceBytes = header.sliceBytes();
+    if (sliceBytes == 0 || header.depth <= 0) {
+        std::cerr << "Error: invalid volume geometry for paged storage" << std::endl;
+        return nullptr;
+    }
+    std::shared_ptr<PagedVolume> volume(new PagedVolume());
+    volume->header = header;
+    std::vector<uint8_t>().swap(volume->header.voxels);
+    volume->settings = config;
+
+    std::error_code error;
+    const std::filesystem::path directory = config.scratchDirectory.empty()
+                                                ? std::filesystem::temp_directory_path(error)
+                                                : std::filesystem::u8path(config.scratchDirectory);
+    std::filesystem::create_directories(directory, error);
+
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const std::size_t granularity = info.dwAllocationGranularity;
+#else
+    const std::size_t granularity = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    // Blocos de cortes inteiros, alinhados para serem mapeados um a um
+    volume->slicesPerChunk = static_cast<int>(std::clamp<std::size_t>(config.chunkTargetBytes / sliceBytes, 1,
+                                                                      static_cast<std::size_t>(header.depth)));
+    const std::size_t chunkBytes = sliceBytes * static_cast<std::size_t>(volume->slicesPerChunk);
+    volume->chunkStride = (chunkBytes + granularity - 1) / granularity * granularity;
+    volume->chunkCount = static_cast<std::size_t>((header.depth + volume->slicesPerChunk - 1) / volume->slicesPerChunk);
+    volume->budgetChunks = std::max<std::size_t>(2, config.residentBudgetBytes / volume->chunkStride);
+    const uint64_t fileBytes = static_cast<uint64_t>(volume->chunkStride) * volume->chunkCount;
+
+#if defined(_WIN32)
+    const std::filesystem::path path = directory / ("dicom-viewer-volume-" + std::to_string(GetCurrentProcessId()) + "-" +
+                                                    std::to_string(scratchCounter++) + ".tmp");
+    // Apagado pelo sistema quando o último handle (ou mapeamento) é fechado
+    HANDLE handle = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_NEW,
+                                FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        std::cerr << "Error: cannot create scratch file " << path.u8string() << std::endl;
+        return nullptr;
+    }
+    volume->fileHandle = handle;
+    volume->mappingHandle = CreateFileMappingW(handle, nullptr, PAGE_READWRITE, static_cast<DWORD>(fileBytes >> 32),
+                                               static_cast<DWORD>(fileBytes & 0xFFFFFFFFu), nullptr);
+    if (volume->mappingHandle == nullptr) {
+        std::cerr << "Error: cannot reserve " << fileBytes << " bytes for the scratch file" << std::endl;
+        return nullptr;
+    }
+#else
+    std::string pattern = (directory / "dicom-viewer-volume-XXXXXX").string();
+    volume->descriptor = mkstemp(pattern.data());
+    if (volume->descriptor < 0) {
+        std::cerr << "Error: cannot create scratch file in " << directory.string() << std::endl;
+        return nullptr;
+    }
+    // Sem nome no diretório: o espaço volta ao disco mesmo se o processo terminar de forma abrupta
+    unlink(pattern.c_str());
+    if (ftruncate(volume->descriptor, static_cast<off_t>(fileBytes)) != 0) {
+        std::cerr << "Error: cannot size the scratch file (" << std::strerror(errno) << ")" << std::endl;
+        return nullptr;
+    }
+#if defined(__linux__)
+    // Reserva o espaço agora: disco cheio vira erro aqui, e não SIGBUS ao gravar um bloco mapeado
+    const int reserved = posix_fallocate(volume->descriptor, 0, static_cast<off_t>(fileBytes));
+    if (reserved != 0 && reserved != EOPNOTSUPP && reserved != EINVAL) {
+        std::cerr << "Error: cannot reserve " << fileBytes << " bytes for the scratch file (" << std::strerror(reserved)
+                  << ")" << std::endl;
+        return nullptr;
+    }
+#endif
+#endif
+
+    volume->mapped.resize(volume->chunkCount);
+    volume->resident.resize(volume->chunkCount);
+    volume->lruPosition.resize(volume->chunkCount);
+    return volume;
+}
+
+/**
+ * @brief Carrega uma série direto no arquivo de trabalho.
+ */
+std::shared_ptr<PagedVolume> PagedVolume::load(const std::vector<std::string>& paths, const PagedVolumeConfig& config,
+                                               SeriesLoadStats* stats, const LoadProgressCallback& progress) {
+    // O arquivo de trabalho é criado quando a geometria da série é conhecida
+    class Store : public SliceStore {
+    public:
+        explicit Store(const PagedVolumeConfig& settings) : config(settings) {}
+
+        bool allocate(const Volume& header) override {
+            volume = PagedVolume::create(header, config);
+            return volume != nullptr;
+        }
+
+        bool write(int z, const std::function<bool(uint8_t*)>& decode) override {
+            return volume->write(z, decode);
+        }
+
+        const PagedVolumeConfig& config;
+        std::shared_ptr<PagedVolume> volume;
+    };
+
+    Store store(config);
+    Volume header;
+    if (!loadDicomSeriesInto(paths, store, header, stats, progress)) {
+        return nullptr;
+    }
+    return store.volume;
+}
+
+/**
+ * @brief Bloco index no topo do conjunto residente, mapeando-o se necessário.
+ *
+ * Os blocos que excedem o orçamento saem pelo fim do LRU e são desmapeados
+ * fora do lock (ou ao soltar o último SliceRef que os usa).
+ */
+std::shared_ptr<PagedVolume::Chunk> PagedVolume::acquire(std::size_t index, bool prefetch) {
+    std::vector<std::shared_ptr<Chunk>> released;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (resident[index]) {
+        lru.splice(lru.begin(), lru, lruPosition[index]);
+        if (!prefetch) {
+            ++hits;
+        }
+        return resident[index];
+    }
+
+    // Fora do conjunto, mas ainda em uso por algum SliceRef: reaproveita o mapeamento
+    std::shared_ptr<Chunk> chunk = mapped[index].lock();
+    if (chunk) {
+        if (!prefetch) {
+            ++hits;
+        }
+    } else {
+        const uint64_t offset = static_cast<uint64_t>(index) * chunkStride;
+#if defined(_WIN32)
+        void* address = MapViewOfFile(mappingHandle, FILE_MAP_WRITE, static_cast<DWORD>(offset >> 32),
+                                      static_cast<DWORD>(offset & 0xFFFFFFFFu), chunkStride);
+        if (address == nullptr) {
+            std::cerr << "Error: MapViewOfFile failed for volume chunk " << index << std::endl;
+            return nullptr;
+        }
+#else
+        void* address = mmap(nullptr, chunkStride, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor,
+                             static_cast<off_t>(offset));
+        if (address == MAP_FAILED) {
+            std::cerr << "Error: mmap failed for volume chunk " << index << std::endl;
+            return nullptr;
+        }
+#endif
+        chunk = std::make_shared<Chunk>();
+        chunk->base = static_cast<uint8_t*>(address);
+        chunk->length = chunkStride;
+        mapped[index] = chunk;
+        if (prefetch) {
+            ++prefetched;
+        } else {
+            ++pageIns;
+        }
+    }
+
+    resident[index] = chunk;
+    lru.push_front(index);
+    lruPosition[index] = lru.begin();
+    while (lru.size() > budgetChunks) {
+        const std::size_t oldest = lru.back();
+        lru.pop_back();
+        released.push_back(std::move(resident[oldest]));
+        ++evictions;
+    }
+    DICOM_TRACE_COUNTER("paged-resident-chunks", lru.size());
+    return chunk;
+}
+
+/**
+ * @brief Corte z, mapeando o seu bloco se necessário.
+ */
+PagedVolume::SliceRef PagedVolume::slice(int z) {
+    SliceRef ref;
+    if (z < 0 || z >= header.depth) {
+        return ref;
+    }
+    std::shared_ptr<Chunk> chunk = acquire(static_cast<std::size_t>(z / slicesPerChunk), false);
+    if (!chunk) {
+        return ref;
+    }
+    ref.voxels = chunk->base + header.sliceBytes() * static_cast<std::size_t>(z % slicesPerChunk);
+    ref.chunk = std::move(chunk);
+    return ref;
+}
+
+/**
+ * @brief Chama decode com o destino gravável do corte z, mantido mapeado durante a chamada.
+ */
+bool PagedVolume::write(int z, const std::function<bool(uint8_t*)>& decode) {
+    if (z < 0 || z >= header.depth) {
+        return false;
+    }
+    std::shared_ptr<Chunk> chunk = acquire(static_cast<std::size_t>(z / slicesPerChunk), false);
+    if (!chunk) {
+        return false;
+    }
+    return decode(chunk->base + header.sliceBytes() * static_cast<std::size_t>(z % slicesPerChunk));
+}
+
+/**
+ * @brief Copia o corte z como imagem de precisão total.
+ */
+MedicalImage PagedVolume::extractSlice(int z) {
+    const SliceRef ref = slice(z);
+    if (!ref.isValid()) {
+        return MedicalImage();
+    }
+    return sliceImage(header, ref.data());
+}
+
+/**
+ * @brief Pede a leitura antecipada dos blocos em torno de z.
+ */
+void PagedVolume::prefetchAround(int z) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            return;
+        }
+        prefetchTarget = std::clamp(z, 0, header.depth - 1);
+        ++prefetchRequest;
+        // A thread só existe para volumes efetivamente percorridos
+        if (!prefetchThread.joinable()) {
+            prefetchThread = std::thread(&PagedVolume::prefetchLoop, this);
+        }
+    }
+    prefetchWake.notify_one();
+}
+
+/**
+ * @brief Atende o pedido de leitura antecipada mais recente.
+ *
+ * Os blocos do raio são mapeados do mais distante para o mais próximo de
+ * prefetchTarget e lidos página a página; um pedido novo interrompe a
+ * passada atual. A passada nunca toca mais blocos do que o orçamento
+ * comporta, para não expulsar os que ela mesma acabou de ler.
+ */
+void PagedVolume::prefetchLoop() {
+    uint64_t served = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        prefetchWake.wait(lock, [this, &served]() { return stopping || prefetchRequest != served; });
+        if (stopping) {
+            return;
+        }
+        served = prefetchRequest;
+        const int target = prefetchTarget;
+        lock.unlock();
+
+        const int radius = std::max(0, settings.prefetchSlices);
+        const std::size_t center = static_cast<std::size_t>(target / slicesPerChunk);
+        const std::size_t first = static_cast<std::size_t>(std::max(0, target - radius) / slicesPerChunk);
+        const std::size_t last = static_cast<std::size_t>(std::min(header.depth - 1, target + radius) / slicesPerChunk);
+        std::vector<std::size_t> order;
+        for (std::size_t index = first; index <= last; ++index) {
+            order.push_back(index);
+        }
+        auto distance = [center](std::size_t index) { return index > center ? index - center : center - index; };
+        std::stable_sort(order.begin(), order.end(), [&distance](std::size_t a, std::size_t b) {
+            return distance(a) > distance(b);
+        });
+        if (order.size() > budgetChunks) {
+            order.erase(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(order.size() - budgetChunks));
+        }
+
+        const std::size_t sliceBytes = header.sliceBytes();
+        for (std::size_t index : order) {
+            {
+                std::lock_guard<std::mutex> check(mutex);
+                if (stopping || prefetchRequest != served) {
+                    break;
+                }
+            }
+            std::shared_ptr<Chunk> chunk = acquire(index, true);
+            if (!chunk) {
+                continue;
+            }
+            const int slices = std::min(slicesPerChunk, header.depth - static_cast<int>(index) * slicesPerChunk);
+            const std::size_t used = sliceBytes * static_cast<std::size_t>(slices);
+#if !defined(_WIN32)
+            madvise(chunk->base, used, MADV_WILLNEED);
+#endif
+            DICOM_TRACE_SCOPE(traceScope, "page-in", "paged");
+            DICOM_TRACE_BYTES(traceScope, used);
+            touchPages(chunk->base, used);
+        }
+        lock.lock();
+    }
+}
+
+/**
+ * @brief Ocupação e contadores desde a criação.
+ */
+PagedVolumeStats PagedVolume::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    PagedVolumeStats report;
+    report.chunkCount = chunkCount;
+    report.slicesPerChunk = slicesPerChunk;
+    report.chunkBytes = chunkStride;
+    report.budgetBytes = budgetChunks * chunkStride;
+    report.residentChunks = lru.size();
+    report.residentBytes = lru.size() * chunkStride;
+    report.hits = hits;
+    report.pageIns = pageIns;
+    report.prefetched = prefetched;
+    report.evictions = evictions;
+    return report;
+}
+
+}
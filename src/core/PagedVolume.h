@@ -0,0 +1,199 @@
+/**
+ * DICOM Viewer - Volume Paginado em Arquivo de Trabalho
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Volume.h"
+
+#ifndef PAGEDVOLUME_H
+#define PAGEDVOLUME_H
+
+namespace dicom_viewer_core {
+
+/**
+ * @struct PagedVolumeConfig
+ * @brief Parâmetros do volume paginado.
+ */
+struct PagedVolumeConfig {
+    std::string scratchDirectory;                     ///< Diretório do arquivo de trabalho (vazio: temporário do sistema, que pode ser tmpfs)
+    std::size_t residentBudgetBytes = 512ull << 20;   ///< Blocos mapeados ao mesmo tempo, em bytes
+    std::size_t chunkTargetBytes = 8ull << 20;        ///< Tamanho aproximado de um bloco (cortes inteiros)
+    int prefetchSlices = 32;                          ///< Cortes antecipados de cada lado da posição atual
+};
+
+/**
+ * @struct PagedVolumeStats
+ * @brief Ocupação e atividade do volume paginado.
+ */
+struct PagedVolumeStats {
+    std::size_t chunkCount = 0;                       ///< Blocos do volume
+    int slicesPerChunk = 0;                           ///< Cortes por bloco
+    std::size_t chunkBytes = 0;                       ///< Bytes reservados por bloco no arquivo
+    std::size_t budgetBytes = 0;                      ///< Orçamento de blocos mapeados
+    std::size_t residentChunks = 0;                   ///< Blocos no conjunto residente
+    std::size_t residentBytes = 0;                    ///< Bytes dos blocos no conjunto residente
+    uint64_t hits = 0;                                ///< Acessos a blocos já mapeados
+    uint64_t pageIns = 0;                             ///< Blocos mapeados sob demanda
+    uint64_t prefetched = 0;                          ///< Blocos mapeados e lidos antecipadamente
+    uint64_t evictions = 0;                           ///< Blocos retirados do conjunto residente
+};
+
+/**
+ * @class PagedVolume
+ * @brief Voxels de uma série guardados em um arquivo de trabalho mapeado, em blocos de cortes.
+ *
+ * Para séries maiores que a memória (milhares de cortes finos, aquisições
+ * dinâmicas longas). O arquivo é dividido em blocos de cortes consecutivos;
+ * cada bloco é mapeado apenas enquanto está no conjunto residente, que
+ * segue a ordem LRU e é limitado por residentBudgetBytes. Um bloco que sai
+ * do conjunto é desmapeado: as páginas modificadas voltam ao arquivo pelo
+ * sistema e deixam de contar na memória residente do processo.
+ *
+ * prefetchAround() pede, a uma thread própria, os blocos em torno da posição
+ * atual, do mais distante para o mais próximo (que termina no topo do LRU);
+ * as páginas são lidas nessa thread, de modo que percorrer os cortes em
+ * sequência encontra os blocos já mapeados e lidos.
+ *
+ * Um SliceRef mantém o seu bloco mapeado mesmo depois de ele sair do
+ * conjunto residente; a memória pode passar do orçamento pelo tamanho dos
+ * blocos em uso. O arquivo de trabalho é apagado ao destruir o volume (ou
+ * ao encerrar o processo, mesmo de forma abrupta).
+ *
+ * Todos os métodos são seguros para chamadas concorrentes.
+ */
+class PagedVolume {
+    struct Chunk;
+
+public:
+    /**
+     * @class SliceRef
+     * @brief Acesso a um corte; mantém o bloco mapeado enquanto existir.
+     */
+    class SliceRef {
+    public:
+        SliceRef() = default;
+
+        const uint8_t* data() const { return voxels; }
+        bool isValid() const { return voxels != nullptr; }
+
+    private:
+        friend class PagedVolume;
+        std::shared_ptr<const Chunk> chunk;
+        const uint8_t* voxels = nullptr;
+    };
+
+    ~PagedVolume();
+    PagedVolume(const PagedVolume&) = delete;
+    PagedVolume& operator=(const PagedVolume&) = delete;
+
+    /**
+     * @brief Cria o arquivo de trabalho de um volume (com voxels zerados).
+     * @param header Geometria e metadados do volume; voxels é ignorado.
+     * @param config Orçamento, tamanho dos blocos e diretório de trabalho.
+     * @return O volume, ou nullptr se o arquivo não puder ser criado.
+     */
+    static std::shared_ptr<PagedVolume> create(const Volume& header, const PagedVolumeConfig& config = PagedVolumeConfig());
+
+    /**
+     * @brief Carrega uma série direto no arquivo de trabalho.
+     *
+     * Mesma seleção e ordenação dos cortes de loadDicomSeries(); cada corte
+     * é decodificado no seu bloco, que volta ao arquivo quando o orçamento
+     * exige, de modo que a memória residente não acompanha o tamanho da série.
+     *
+     * @return O volume, ou nullptr em caso de erro ou cancelamento.
+     */
+    static std::shared_ptr<PagedVolume> load(const std::vector<std::string>& paths,
+                                             const PagedVolumeConfig& config = PagedVolumeConfig(),
+                                             SeriesLoadStats* stats = nullptr,
+                                             const LoadProgressCallback& progress = LoadProgressCallback());
+
+    /**
+     * @brief Geometria e metadados do volume (Volume::voxels vazio).
+     */
+    const Volume& info() const { return header; }
+
+    int depth() const { return header.depth; }
+
+    /**
+     * @brief Corte z, mapeando o seu bloco se necessário.
+     * @return Referência inválida se z estiver fora do volume ou o mapeamento falhar.
+     */
+    SliceRef slice(int z);
+
+    /**
+     * @brief Chama decode com o destino gravável do corte z, mantido mapeado durante a chamada.
+     * @return false se o bloco não pôde ser mapeado ou decode falhou.
+     */
+    bool write(int z, const std::function<bool(uint8_t* destination)>& decode);
+
+    /**
+     * @brief Copia o corte z como imagem de precisão total (como extractSlice()).
+     */
+    MedicalImage extractSlice(int z);
+
+    /**
+     * @brief Pede a leitura antecipada dos blocos em torno de z; retorna de imediato.
+     *
+     * Um novo pedido substitui o anterior ainda não atendido.
+     */
+    void prefetchAround(int z);
+
+    /**
+     * @brief Ocupação e contadores desde a criação.
+     */
+    PagedVolumeStats stats() const;
+
+private:
+    PagedVolume() = default;
+    std::shared_ptr<Chunk> acquire(std::size_t index, bool prefetch);
+    void prefetchLoop();
+
+    Volume header;
+    PagedVolumeConfig settings;
+    int slicesPerChunk = 1;
+    std::size_t chunkStride = 0;                      ///< Bytes reservados por bloco (múltiplo da granularidade)
+    std::size_t chunkCount = 0;
+    std::size_t budgetChunks = 1;                     ///< Blocos que cabem no orçamento
+
+#if defined(_WIN32)
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int descriptor = -1;
+#endif
+
+    mutable std::mutex mutex;
+    std::vector<std::weak_ptr<Chunk>> mapped;        ///< Mapeamento vivo de cada bloco (residente ou em uso)
+    std::vector<std::shared_ptr<Chunk>> resident;    ///< Blocos do conjunto residente
+    std::list<std::size_t> lru;                       ///< Conjunto residente, do mais recente ao mais antigo
+    std::vector<std::list<std::size_t>::iterator> lruPosition;
+    uint64_t hits = 0;
+    uint64_t pageIns = 0;
+    uint64_t prefetched = 0;
+    uint64_t evictions = 0;
+
+    std::condition_variable prefetchWake;
+    std::thread prefetchThread;
+    int prefetchTarget = 0;
+    uint64_t prefetchRequest = 0;                     ///< Cresce a cada prefetchAround()
+    bool stopping = false;
+};
+
+}
+
+#endif // PAGEDVOLUME_H
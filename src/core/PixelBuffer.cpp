@@ -0,0 +1,127 @@
+/**
+ * DICOM Viewer - Buffer de Pixels Compartilhado
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include "PixelBuffer.h"
+
+namespace dicom_viewer_core {
+
+namespace {
+
+/**
+ * @brief Aloca size bytes alinhados a PixelBuffer::alignment.
+ */
+std::shared_ptr<uint8_t> allocateAligned(std::size_t size) {
+    // Nunca aloca zero bytes, para que data() de um buffer válido não seja nulo
+    void* memory = ::operator new(std::max<std::size_t>(size, 1), std::align_val_t(PixelBuffer::alignment));
+    return std::shared_ptr<uint8_t>(static_cast<uint8_t*>(memory), [](uint8_t* pointer) {
+        ::operator delete(pointer, std::align_val_t(PixelBuffer::alignment));
+    });
+}
+
+}
+
+/**
+ * @brief Aloca um buffer de size bytes zerados.
+ */
+PixelBuffer::PixelBuffer(std::size_t size) {
+    resize(size);
+}
+
+/**
+ * @brief Buffer somente leitura sobre bytes mantidos vivos por owner.
+ */
+PixelBuffer PixelBuffer::wrap(std::shared_ptr<const uint8_t> owner, std::size_t size) {
+    PixelBuffer buffer;
+    if (owner && size > 0) {
+        buffer.storage = std::const_pointer_cast<uint8_t>(std::move(owner));
+        buffer.length = size;
+    }
+    return buffer;
+}
+
+/**
+ * @brief Aloca um novo buffer de size bytes sem inicializá-los.
+ */
+void PixelBuffer::allocate(std::size_t size) {
+    if (size == 0) {
+        clear();
+        return;
+    }
+    if (storage && storage.use_count() == 1 && size <= capacity) {
+        length = size;
+        return;
+    }
+    storage = allocateAligned(size);
+    length = size;
+    capacity = size;
+}
+
+/**
+ * @brief Redimensiona preservando o conteúdo; bytes novos são zerados.
+ */
+void PixelBuffer::resize(std::size_t size) {
+    if (size == 0) {
+        clear();
+        return;
+    }
+    if (storage && storage.use_count() == 1 && size <= capacity) {
+        if (size > length) {
+            std::memset(storage.get() + length, 0, size - length);
+        }
+        length = size;
+        return;
+    }
+    std::shared_ptr<uint8_t> grown = allocateAligned(size);
+    const std::size_t kept = std::min(length, size);
+    if (kept > 0) {
+        std::memcpy(grown.get(), storage.get(), kept);
+    }
+    std::memset(grown.get() + kept, 0, size - kept);
+    storage = std::move(grown);
+    length = size;
+    capacity = size;
+}
+
+/**
+ * @brief Substitui o conteúdo por uma cópia de [first, last).
+ */
+void PixelBuffer::assign(const uint8_t* first, const uint8_t* last) {
+    const std::size_t size = static_cast<std::size_t>(last - first);
+    allocate(size);
+    if (size > 0) {
+        std::memcpy(storage.get(), first, size);
+    }
+}
+
+/**
+ * @brief Solta a referência ao buffer.
+ */
+void PixelBuffer::clear() {
+    storage.reset();
+    length = 0;
+    capacity = 0;
+}
+
+/**
+ * @brief Garante que este objeto seja o único dono dos bytes, copiando-os se necessário.
+ */
+void PixelBuffer::detach() {
+    if (!storage || (storage.use_count() == 1 && capacity > 0)) {
+        return;
+    }
+    std::shared_ptr<uint8_t> copy = allocateAligned(length);
+    std::memcpy(copy.get(), storage.get(), length);
+    storage = std::move(copy);
+    capacity = length;
+}
+
+}
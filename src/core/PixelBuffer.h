@@ -0,0 +1,107 @@
+/**
+ * DICOM Viewer - Buffer de Pixels Compartilhado
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#ifndef PIXELBUFFER_H
+#define PIXELBUFFER_H
+
+namespace dicom_viewer_core {
+
+/**
+ * @class PixelBuffer
+ * @brief Armazenamento de pixels alinhado e com contagem de referências.
+ *
+ * Cópias de um PixelBuffer compartilham os mesmos bytes: copiar uma
+ * MedicalImage, guardá-la em cache ou embrulhá-la em uma QImage não duplica
+ * os pixels. A memória é liberada quando a última referência deixa de
+ * existir. O início do buffer é alinhado a 64 bytes (linha de cache e
+ * largura de registradores SIMD).
+ *
+ * Quem escreve em um buffer possivelmente compartilhado deve chamar
+ * detach() antes; os caminhos de decodificação escrevem apenas em buffers
+ * recém-alocados. Um buffer criado por wrap() aponta para memória de
+ * terceiros (ex.: um arquivo mapeado), somente leitura: detach(),
+ * allocate() e resize() sempre passam para uma cópia própria.
+ */
+class PixelBuffer {
+public:
+    static constexpr std::size_t alignment = 64;      ///< Alinhamento do início do buffer, em bytes
+
+    PixelBuffer() = default;
+
+    /**
+     * @brief Aloca um buffer de size bytes zerados.
+     */
+    explicit PixelBuffer(std::size_t size);
+
+    /**
+     * @brief Buffer somente leitura sobre bytes mantidos vivos por owner.
+     *
+     * Nenhum byte é copiado. O início deve respeitar o alinhamento de
+     * PixelBuffer::alignment.
+     */
+    static PixelBuffer wrap(std::shared_ptr<const uint8_t> owner, std::size_t size);
+
+    uint8_t* data() { return storage.get(); }
+    const uint8_t* data() const { return storage.get(); }
+    std::size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+
+    uint8_t& operator[](std::size_t index) { return storage.get()[index]; }
+    const uint8_t& operator[](std::size_t index) const { return storage.get()[index]; }
+
+    /**
+     * @brief Aloca um novo buffer de size bytes sem inicializá-los.
+     *
+     * O conteúdo anterior é descartado. Usado quando os bytes serão
+     * integralmente sobrescritos (decodificação), evitando zerar a memória.
+     */
+    void allocate(std::size_t size);
+
+    /**
+     * @brief Redimensiona preservando o conteúdo; bytes novos são zerados.
+     */
+    void resize(std::size_t size);
+
+    /**
+     * @brief Substitui o conteúdo por uma cópia de [first, last).
+     */
+    void assign(const uint8_t* first, const uint8_t* last);
+
+    /**
+     * @brief Solta a referência ao buffer.
+     */
+    void clear();
+
+    /**
+     * @brief Garante que este objeto seja o único dono dos bytes, copiando-os se necessário.
+     */
+    void detach();
+
+    /**
+     * @brief Número de referências ao buffer (0 se vazio).
+     */
+    long useCount() const { return storage.use_count(); }
+
+    /**
+     * @brief Referência compartilhada aos bytes, para prolongar a vida do buffer fora do núcleo.
+     */
+    std::shared_ptr<const uint8_t> share() const { return storage; }
+
+private:
+    std::shared_ptr<uint8_t> storage;
+    std::size_t length = 0;
+    std::size_t capacity = 0;                         ///< 0 em buffer de wrap(): os bytes não podem ser reaproveitados
+};
+
+}
+
+#endif // PIXELBUFFER_H
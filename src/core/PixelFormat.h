@@ -0,0 +1,143 @@
+/**
+ * DICOM Viewer - Tipos de Pixel e Despacho de Kernels
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#ifndef PIXELFORMAT_H
+#define PIXELFORMAT_H
+
+namespace dicom_viewer_core {
+
+/**
+ * @brief Tipo de cada amostra no buffer de pixels.
+ */
+enum class PixelType {
+    UInt8,                                            ///< 8 bits sem sinal
+    Int8,                                             ///< 8 bits com sinal
+    UInt16,                                           ///< 16 bits sem sinal
+    Int16,                                            ///< 16 bits com sinal
+    Int32,                                            ///< 32 bits com sinal (também usado para 32 bits sem sinal com até 31 bits armazenados)
+    Float32                                           ///< Float Pixel Data (7FE0,0008) ou valores já reescalados
+};
+
+/**
+ * @brief Bytes por amostra de um PixelType.
+ */
+constexpr std::size_t pixelTypeSize(PixelType type) {
+    switch (type) {
+    case PixelType::UInt8:
+    case PixelType::Int8:
+        return 1;
+    case PixelType::UInt16:
+    case PixelType::Int16:
+        return 2;
+    default:
+        return 4;
+    }
+}
+
+/**
+ * @brief PixelType correspondente aos atributos DICOM de uma amostra.
+ * @param bitsAllocated Bits alocados (8, 16 ou 32).
+ * @param pixelRepresentation 0 = sem sinal, 1 = com sinal.
+ * @param floatingPoint true para Float Pixel Data.
+ */
+constexpr PixelType pixelTypeFor(int bitsAllocated, int pixelRepresentation, bool floatingPoint) {
+    if (floatingPoint) {
+        return PixelType::Float32;
+    }
+    if (bitsAllocated == 32) {
+        return PixelType::Int32;
+    }
+    if (bitsAllocated == 16) {
+        return pixelRepresentation == 1 ? PixelType::Int16 : PixelType::UInt16;
+    }
+    return pixelRepresentation == 1 ? PixelType::Int8 : PixelType::UInt8;
+}
+
+/**
+ * @struct PixelFormat
+ * @brief Tipo da amostra e organização das amostras no buffer.
+ */
+struct PixelFormat {
+    PixelType type = PixelType::UInt8;
+    int samplesPerPixel = 1;                          ///< 1 (monocromática) ou 3 (cor)
+    bool planar = false;                              ///< true: RR..GG..BB..; false: RGBRGB...
+
+    std::size_t bytesPerSample() const { return pixelTypeSize(type); }
+    std::size_t bytesPerPixel() const { return pixelTypeSize(type) * static_cast<std::size_t>(samplesPerPixel); }
+};
+
+/**
+ * @struct PixelView
+ * @brief Acesso tipado a um buffer de pixels, sem possuir os bytes.
+ *
+ * Em imagens intercaladas cada linha tem width * samples amostras e plane()
+ * é sempre 0; em imagens planares cada plano é uma imagem width x height.
+ */
+template <typename T>
+struct PixelView {
+    T* data = nullptr;
+    int width = 0;
+    int height = 0;
+    int samples = 1;
+    bool planar = false;
+
+    std::size_t planeSize() const { return static_cast<std::size_t>(width) * height; }
+
+    /**
+     * @brief Amostras por linha de um plano (width nas planares, width * samples nas intercaladas).
+     */
+    std::size_t rowLength() const { return planar ? static_cast<std::size_t>(width) : static_cast<std::size_t>(width) * samples; }
+
+    /**
+     * @brief Início da linha y do plano (plano 0 nas intercaladas).
+     */
+    T* row(int y, int plane = 0) const {
+        return data + (planar ? static_cast<std::size_t>(plane) * planeSize() : 0) + static_cast<std::size_t>(y) * rowLength();
+    }
+};
+
+/**
+ * @brief Marca de tipo passada aos kernels pelo despacho.
+ */
+template <typename T>
+struct PixelTag {
+    using type = T;
+};
+
+/**
+ * @brief Chama function(PixelTag<T>()) com o tipo C++ de type.
+ *
+ * O despacho ocorre uma vez por imagem; dentro de function o tipo é uma
+ * constante de compilação e os laços por pixel não testam o formato.
+ */
+template <typename Function>
+decltype(auto) dispatchPixelType(PixelType type, Function&& function) {
+    switch (type) {
+    case PixelType::Int8:
+        return function(PixelTag<int8_t>());
+    case PixelType::UInt16:
+        return function(PixelTag<uint16_t>());
+    case PixelType::Int16:
+        return function(PixelTag<int16_t>());
+    case PixelType::Int32:
+        return function(PixelTag<int32_t>());
+    case PixelType::Float32:
+        return function(PixelTag<float>());
+    case PixelType::UInt8:
+    default:
+        return function(PixelTag<uint8_t>());
+    }
+}
+
+}
+
+#endif // PIXELFORMAT_H
@@ -0,0 +1,101 @@
+/**
+ * DICOM Viewer - Consumo de Memória do Processo
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#include <cstdint>
+#endif
+#include <sys/resource.h>
+#include <unistd.h>
+#include <fstream>
+#endif
+
+#include "ProcessMemory.h"
+
+namespace dicom_viewer_core {
+
+/**
+ * @brief Retorna o pico de memória residente (RSS) do processo, em bytes.
+ */
+std::size_t peakResidentBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<std::size_t>(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+    // No Linux ru_maxrss é informado em kilobytes
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+/**
+ * @brief Retorna a memória residente (RSS) atual do processo, em bytes.
+ */
+std::size_t currentResidentBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<std::size_t>(counters.WorkingSetSize);
+    }
+    return 0;
+#elif defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    std::size_t totalPages = 0;
+    std::size_t residentPages = 0;
+    if (!(statm >> totalPages >> residentPages)) {
+        return 0;
+    }
+    return residentPages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Retorna a memória física instalada, em bytes.
+ */
+std::size_t physicalMemoryBytes() {
+#if defined(_WIN32)
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if (GlobalMemoryStatusEx(&status)) {
+        return static_cast<std::size_t>(status.ullTotalPhys);
+    }
+    return 0;
+#elif defined(__APPLE__)
+    uint64_t bytes = 0;
+    std::size_t length = sizeof(bytes);
+    if (sysctlbyname("hw.memsize", &bytes, &length, nullptr, 0) != 0) {
+        return 0;
+    }
+    return static_cast<std::size_t>(bytes);
+#else
+    const long pages = sysconf(_SC_PHYS_PAGES);
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    if (pages <= 0 || pageSize <= 0) {
+        return 0;
+    }
+    return static_cast<std::size_t>(pages) * static_cast<std::size_t>(pageSize);
+#endif
+}
+
+}
@@ -0,0 +1,36 @@
+/**
+ * DICOM Viewer - Consumo de Memória do Processo
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <cstddef>
+
+#ifndef PROCESSMEMORY_H
+#define PROCESSMEMORY_H
+
+namespace dicom_viewer_core {
+
+/**
+ * @brief Retorna o pico de memória residente (RSS) do processo, em bytes.
+ * @return Pico de memória residente, ou 0 se não disponível na plataforma.
+ */
+std::size_t peakResidentBytes();
+
+/**
+ * @brief Retorna a memória residente (RSS) atual do processo, em bytes.
+ * @return Memória residente atual, ou 0 se não disponível na plataforma.
+ */
+std::size_t currentResidentBytes();
+
+/**
+ * @brief Retorna a memória física instalada, em bytes.
+ * @return Memória física, ou 0 se não disponível na plataforma.
+ */
+std::size_t physicalMemoryBytes();
+
+}
+
+#endif // PROCESSMEMORY_H
@@ -0,0 +1,300 @@
+/**
+ * DICOM Viewer - Estatísticas de Regiões de Interesse
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "RegionStatistics.h"
+#include "ThreadPool.h"
+#include "WindowLevel.h"
+
+namespace dicom_viewer_core {
+
+/**
+ * @brief Somas parciais de uma região, no domínio dos valores armazenados.
+ */
+struct RegionTables::Accumulator {
+    std::size_t pixels = 0;
+    int64_t sum = 0;
+    uint64_t squares = 0;
+    int32_t lowest = std::numeric_limits<int32_t>::max();
+    int32_t highest = std::numeric_limits<int32_t>::min();
+};
+
+namespace {
+
+/**
+ * @brief Interpreta os bits de um valor armazenado como inteiro, estendendo o sinal se necessário.
+ */
+inline int32_t storedValue(uint32_t bits, int bitsAllocated, bool isSigned) {
+    if (!isSigned) {
+        return static_cast<int32_t>(bits);
+    }
+    return bitsAllocated == 16 ? static_cast<int32_t>(static_cast<int16_t>(bits))
+                               : static_cast<int32_t>(static_cast<int8_t>(bits));
+}
+
+/**
+ * @brief Acumula as linhas [firstRow, lastRow) de uma vista tipada: somas, quadrados e mínimo/máximo dos segmentos.
+ */
+template <typename T>
+void accumulateRows(const PixelView<const T>& view, int blockWidth, int blocksPerRow,
+                    int64_t* sums, uint64_t* squares, int32_t* blockMin, int32_t* blockMax,
+                    std::size_t firstRow, std::size_t lastRow) {
+    const std::size_t stride = static_cast<std::size_t>(view.width) + 1;
+    for (std::size_t y = firstRow; y < lastRow; ++y) {
+        const T* row = view.row(static_cast<int>(y));
+        int64_t* sumRow = sums + (y + 1) * stride;
+        uint64_t* squareRow = squares + (y + 1) * stride;
+        int32_t* minRow = blockMin + y * blocksPerRow;
+        int32_t* maxRow = blockMax + y * blocksPerRow;
+        int64_t sum = 0;
+        uint64_t squareSum = 0;
+        for (int block = 0; block < blocksPerRow; ++block) {
+            int32_t lowest = std::numeric_limits<int32_t>::max();
+            int32_t highest = std::numeric_limits<int32_t>::min();
+            const int end = std::min(view.width, (block + 1) * blockWidth);
+            for (int x = block * blockWidth; x < end; ++x) {
+                const int32_t v = row[x];
+                sum += v;
+                squareSum += static_cast<uint64_t>(static_cast<int64_t>(v) * v);
+                sumRow[x + 1] = sum;
+                squareRow[x + 1] = squareSum;
+                lowest = std::min(lowest, v);
+                highest = std::max(highest, v);
+            }
+            minRow[block] = lowest;
+            maxRow[block] = highest;
+        }
+    }
+}
+
+}
+
+/**
+ * @brief Constrói as tabelas de uma imagem de precisão total, em paralelo.
+ *
+ * Primeiro cada linha é acumulada independentemente (somas, quadrados e
+ * mínimo/máximo dos segmentos); depois as colunas são acumuladas de cima
+ * para baixo, com as faixas de colunas distribuídas entre as threads.
+ */
+RegionTables RegionTables::build(const MedicalImage& image, ThreadPool& pool, std::size_t maxBytes) {
+    RegionTables tables;
+    // As tabelas guardam valores inteiros de 8 e 16 bits
+    if (!isFullPrecision(image) || image.pixelFormat().bytesPerSample() > 2) {
+        return tables;
+    }
+    const std::size_t stride = static_cast<std::size_t>(image.width) + 1;
+    const std::size_t cells = stride * (static_cast<std::size_t>(image.height) + 1);
+    const int blocksPerRow = (image.width + blockWidth - 1) / blockWidth;
+    const std::size_t blockCells = static_cast<std::size_t>(blocksPerRow) * image.height;
+    if (cells * (sizeof(int64_t) + sizeof(uint64_t)) + blockCells * 2 * sizeof(int32_t) > maxBytes) {
+        return tables;
+    }
+
+    tables.sizeX = image.width;
+    tables.sizeY = image.height;
+    tables.blocksPerRow = blocksPerRow;
+    tables.bitsAllocated = image.bitsAllocated;
+    tables.signedValues = image.pixelRepresentation == 1;
+    tables.slope = image.rescaleSlope;
+    tables.intercept = image.rescaleIntercept;
+    tables.spacingX = image.spacingX;
+    tables.spacingY = image.spacingY;
+    tables.pixels = image.buffer;
+    tables.sums.assign(cells, 0);
+    tables.squares.assign(cells, 0);
+    tables.blockMin.resize(blockCells);
+    tables.blockMax.resize(blockCells);
+
+    // O tipo das amostras é resolvido uma vez; o laço por pixel não testa o formato
+    dispatchPixelType(image.pixelFormat().type, [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        if constexpr (sizeof(T) <= 2) {
+            const PixelView<const T> view = image.view<T>();
+            pool.parallelFor(0, static_cast<std::size_t>(image.height),
+                             ThreadPool::rowsPerBlock(static_cast<std::size_t>(image.width)),
+                             [&](std::size_t firstRow, std::size_t lastRow) {
+                accumulateRows(view, blockWidth, blocksPerRow, tables.sums.data(), tables.squares.data(),
+                               tables.blockMin.data(), tables.blockMax.data(), firstRow, lastRow);
+            });
+        }
+    });
+
+    // Faixas de colunas: cada thread percorre as linhas em ordem, com acesso contíguo
+    pool.parallelFor(1, stride, 4096, [&](std::size_t firstColumn, std::size_t lastColumn) {
+        for (std::size_t y = 2; y <= static_cast<std::size_t>(image.height); ++y) {
+            int64_t* sumRow = tables.sums.data() + y * stride;
+            const int64_t* sumAbove = sumRow - stride;
+            uint64_t* squareRow = tables.squares.data() + y * stride;
+            const uint64_t* squareAbove = squareRow - stride;
+            for (std::size_t x = firstColumn; x < lastColumn; ++x) {
+                sumRow[x] += sumAbove[x];
+                squareRow[x] += squareAbove[x];
+            }
+        }
+    });
+    return tables;
+}
+
+/**
+ * @brief Memória ocupada pelas tabelas, em bytes.
+ */
+std::size_t RegionTables::memoryBytes() const {
+    return sums.size() * sizeof(int64_t) + squares.size() * sizeof(uint64_t) +
+           (blockMin.size() + blockMax.size()) * sizeof(int32_t);
+}
+
+/**
+ * @brief Valor armazenado do pixel (x, y), com extensão de sinal.
+ */
+int32_t RegionTables::value(int x, int y) const {
+    const std::size_t i = static_cast<std::size_t>(y) * sizeX + x;
+    const uint32_t bits = bitsAllocated == 16 ? reinterpret_cast<const uint16_t*>(pixels.data())[i] : pixels[i];
+    return storedValue(bits, bitsAllocated, signedValues);
+}
+
+/**
+ * @brief Acumula os pixels [x0, x1) da linha y: somas pelas tabelas, mínimo/máximo pelos segmentos.
+ */
+void RegionTables::addSpan(int y, int x0, int x1, Accumulator& accumulator) const {
+    if (x0 >= x1) {
+        return;
+    }
+    const std::size_t stride = static_cast<std::size_t>(sizeX) + 1;
+    const std::size_t below = (static_cast<std::size_t>(y) + 1) * stride;
+    const std::size_t above = static_cast<std::size_t>(y) * stride;
+    accumulator.pixels += static_cast<std::size_t>(x1 - x0);
+    accumulator.sum += (sums[below + x1] - sums[below + x0]) - (sums[above + x1] - sums[above + x0]);
+    accumulator.squares += (squares[below + x1] - squares[below + x0]) - (squares[above + x1] - squares[above + x0]);
+    addExtremes(y, x0, x1, accumulator);
+}
+
+/**
+ * @brief Atualiza mínimo e máximo com os pixels [x0, x1) da linha y, pelos segmentos.
+ */
+void RegionTables::addExtremes(int y, int x0, int x1, Accumulator& accumulator) const {
+    if (x0 >= x1) {
+        return;
+    }
+    // Segmentos inteiros dentro do intervalo; as pontas são lidas pixel a pixel
+    const int firstBlock = (x0 + blockWidth - 1) / blockWidth;
+    const int lastBlock = x1 / blockWidth;
+    int32_t& lowest = accumulator.lowest;
+    int32_t& highest = accumulator.highest;
+    if (firstBlock >= lastBlock) {
+        for (int x = x0; x < x1; ++x) {
+            const int32_t v = value(x, y);
+            lowest = std::min(lowest, v);
+            highest = std::max(highest, v);
+        }
+        return;
+    }
+    for (int x = x0; x < firstBlock * blockWidth; ++x) {
+        const int32_t v = value(x, y);
+        lowest = std::min(lowest, v);
+        highest = std::max(highest, v);
+    }
+    const int32_t* minRow = blockMin.data() + static_cast<std::size_t>(y) * blocksPerRow;
+    const int32_t* maxRow = blockMax.data() + static_cast<std::size_t>(y) * blocksPerRow;
+    for (int block = firstBlock; block < lastBlock; ++block) {
+        lowest = std::min(lowest, minRow[block]);
+        highest = std::max(highest, maxRow[block]);
+    }
+    for (int x = lastBlock * blockWidth; x < x1; ++x) {
+        const int32_t v = value(x, y);
+        lowest = std::min(lowest, v);
+        highest = std::max(highest, v);
+    }
+}
+
+/**
+ * @brief Converte as somas acumuladas em estatísticas em unidades de modalidade.
+ */
+RegionStats RegionTables::finish(const Accumulator& accumulator) const {
+    RegionStats stats;
+    if (accumulator.pixels == 0) {
+        return stats;
+    }
+    const long double count = static_cast<long double>(accumulator.pixels);
+    const long double mean = accumulator.sum / count;
+    const long double variance = std::max<long double>(0.0L, accumulator.squares / count - mean * mean);
+    stats.pixels = accumulator.pixels;
+    stats.mean = static_cast<double>(mean) * slope + intercept;
+    stats.stdDev = std::sqrt(static_cast<double>(variance)) * std::fabs(slope);
+    const double a = accumulator.lowest * slope + intercept;
+    const double b = accumulator.highest * slope + intercept;
+    stats.min = std::min(a, b);
+    stats.max = std::max(a, b);
+    stats.areaMm2 = static_cast<double>(accumulator.pixels) * spacingX * spacingY;
+    return stats;
+}
+
+/**
+ * @brief Estatísticas do retângulo de pixels [x0, x1) x [y0, y1), recortado à imagem.
+ *
+ * Soma e soma dos quadrados saem das quatro quinas das tabelas; mínimo e
+ * máximo percorrem os segmentos de cada linha.
+ */
+RegionStats RegionTables::rectangle(int x0, int y0, int x1, int y1) const {
+    Accumulator accumulator;
+    if (!isValid()) {
+        return RegionStats();
+    }
+    x0 = std::clamp(x0, 0, sizeX);
+    x1 = std::clamp(x1, 0, sizeX);
+    y0 = std::clamp(y0, 0, sizeY);
+    y1 = std::clamp(y1, 0, sizeY);
+    if (x0 >= x1 || y0 >= y1) {
+        return RegionStats();
+    }
+    const std::size_t stride = static_cast<std::size_t>(sizeX) + 1;
+    const std::size_t top = static_cast<std::size_t>(y0) * stride;
+    const std::size_t bottom = static_cast<std::size_t>(y1) * stride;
+    accumulator.pixels = static_cast<std::size_t>(x1 - x0) * static_cast<std::size_t>(y1 - y0);
+    accumulator.sum = (sums[bottom + x1] - sums[bottom + x0]) - (sums[top + x1] - sums[top + x0]);
+    accumulator.squares = (squares[bottom + x1] - squares[bottom + x0]) - (squares[top + x1] - squares[top + x0]);
+    for (int y = y0; y < y1; ++y) {
+        addExtremes(y, x0, x1, accumulator);
+    }
+    return finish(accumulator);
+}
+
+/**
+ * @brief Estatísticas da elipse de centro (centerX, centerY) e semi-eixos radiusX e radiusY.
+ */
+RegionStats RegionTables::ellipse(double centerX, double centerY, double radiusX, double radiusY) const {
+    Accumulator accumulator;
+    if (!isValid() || radiusX <= 0.0 || radiusY <= 0.0) {
+        return RegionStats();
+    }
+    const int firstRow = std::max(0, static_cast<int>(std::floor(centerY - radiusY)));
+    const int lastRow = std::min(sizeY, static_cast<int>(std::ceil(centerY + radiusY)) + 1);
+    for (int y = firstRow; y < lastRow; ++y) {
+        const double dy = (y + 0.5 - centerY) / radiusY;
+        if (dy * dy > 1.0) {
+            continue;
+        }
+        // Pixels com centro em [centerX - half, centerX + half]
+        const double half = radiusX * std::sqrt(1.0 - dy * dy);
+        const int x0 = std::max(0, static_cast<int>(std::ceil(centerX - half - 0.5)));
+        const int x1 = std::min(sizeX, static_cast<int>(std::floor(centerX + half - 0.5)) + 1);
+        addSpan(y, x0, x1, accumulator);
+    }
+    return finish(accumulator);
+}
+
+/**
+ * @brief Distância entre dois pontos da imagem, em mm, usando o espaçamento de pixel.
+ */
+double measureDistanceMm(const MedicalImage& image, double x0, double y0, double x1, double y1) {
+    return std::hypot((x1 - x0) * image.spacingX, (y1 - y0) * image.spacingY);
+}
+
+}
@@ -0,0 +1,129 @@
+/**
+ * DICOM Viewer - Estatísticas de Regiões de Interesse
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MedicalImage.h"
+
+#ifndef REGIONSTATISTICS_H
+#define REGIONSTATISTICS_H
+
+namespace dicom_viewer_core {
+
+class ThreadPool;
+
+/**
+ * @struct RegionStats
+ * @brief Estatísticas de uma região de interesse, em unidades de modalidade (ex.: HU).
+ */
+struct RegionStats {
+    std::size_t pixels = 0;                           ///< Pixels cujo centro está dentro da região
+    double mean = 0.0;                                ///< Média (rescale aplicado)
+    double stdDev = 0.0;                              ///< Desvio padrão populacional
+    double min = 0.0;                                 ///< Menor valor
+    double max = 0.0;                                 ///< Maior valor
+    double areaMm2 = 0.0;                             ///< pixels x spacingX x spacingY
+
+    bool isValid() const { return pixels > 0; }
+};
+
+/**
+ * @class RegionTables
+ * @brief Tabelas pré-calculadas que respondem estatísticas de ROI sem reler a região.
+ *
+ * Guarda as tabelas de soma acumulada (summed-area) dos valores armazenados
+ * e dos seus quadrados: a soma de qualquer retângulo sai de quatro leituras,
+ * e a de uma elipse, de quatro leituras por linha. Mínimo e máximo não são
+ * decomponíveis assim; para eles cada linha é dividida em segmentos de
+ * blockWidth pixels com o seu mínimo e máximo, de modo que uma linha da
+ * região custa width / blockWidth leituras mais até 2 x blockWidth pixels
+ * nas pontas. Assim média e desvio de um retângulo custam O(1), e o
+ * mínimo/máximo, O(altura x (largura / blockWidth + blockWidth)).
+ *
+ * As tabelas ocupam cerca de 16 bytes por pixel e são construídas em
+ * paralelo; a imagem de origem é compartilhada, não copiada.
+ */
+class RegionTables {
+public:
+    static constexpr int blockWidth = 16;                        ///< Pixels por segmento de mínimo/máximo
+
+    /**
+     * @brief Limite padrão de memória das tabelas (imagens maiores não são indexadas).
+     */
+    static constexpr std::size_t kDefaultMaxBytes = std::size_t(1024) * 1024 * 1024;
+
+    /**
+     * @brief Constrói as tabelas de uma imagem de precisão total, em paralelo.
+     * @param image Imagem monocromática com os valores armazenados (fullPrecision).
+     * @param pool Pool usado para distribuir linhas e colunas.
+     * @param maxBytes Memória máxima das tabelas.
+     * @return As tabelas, ou tabelas inválidas se a imagem não for de precisão total ou exceder maxBytes.
+     */
+    static RegionTables build(const MedicalImage& image, ThreadPool& pool,
+                              std::size_t maxBytes = kDefaultMaxBytes);
+
+    bool isValid() const { return !sums.empty(); }
+    int width() const { return sizeX; }
+    int height() const { return sizeY; }
+
+    /**
+     * @brief Memória ocupada pelas tabelas, em bytes.
+     */
+    std::size_t memoryBytes() const;
+
+    /**
+     * @brief Estatísticas do retângulo de pixels [x0, x1) x [y0, y1), recortado à imagem.
+     *
+     * Soma e quadrados em O(1); mínimo e máximo percorrem os segmentos de cada linha.
+     */
+    RegionStats rectangle(int x0, int y0, int x1, int y1) const;
+
+    /**
+     * @brief Estatísticas da elipse de centro (centerX, centerY) e semi-eixos radiusX e radiusY.
+     *
+     * Coordenadas em pixels, com o pixel (x, y) ocupando [x, x + 1) x [y, y + 1);
+     * entram os pixels cujo centro está dentro da elipse.
+     */
+    RegionStats ellipse(double centerX, double centerY, double radiusX, double radiusY) const;
+
+private:
+    struct Accumulator;
+
+    int32_t value(int x, int y) const;
+    void addSpan(int y, int x0, int x1, Accumulator& accumulator) const;
+    void addExtremes(int y, int x0, int x1, Accumulator& accumulator) const;
+    RegionStats finish(const Accumulator& accumulator) const;
+
+    int sizeX = 0;
+    int sizeY = 0;
+    int blocksPerRow = 0;
+    int bitsAllocated = 16;
+    bool signedValues = false;
+    double slope = 1.0;
+    double intercept = 0.0;
+    double spacingX = 1.0;
+    double spacingY = 1.0;
+    PixelBuffer pixels;                                          ///< Valores armazenados (compartilhados com a imagem)
+    std::vector<int64_t> sums;                                   ///< (sizeX + 1) x (sizeY + 1) somas acumuladas
+    std::vector<uint64_t> squares;                               ///< Idem, dos quadrados
+    std::vector<int32_t> blockMin;                               ///< Mínimo de cada segmento, por linha
+    std::vector<int32_t> blockMax;                               ///< Máximo de cada segmento, por linha
+};
+
+/**
+ * @brief Distância entre dois pontos da imagem, em mm, usando o espaçamento de pixel.
+ *
+ * Sem Pixel Spacing no arquivo, o espaçamento vale 1.0 e o resultado está em pixels.
+ */
+double measureDistanceMm(const MedicalImage& image, double x0, double y0, double x1, double y1);
+
+}
+
+#endif // REGIONSTATISTICS_H
@@ -0,0 +1,176 @@
+/**
+ * DICOM Viewer - Reformatação Multiplanar (MPR)
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Reslicer.h"
+#include "ThreadPool.h"
+
+namespace dicom_viewer_core {
+
+namespace {
+
+/**
+ * @brief Maior lado de uma imagem reformatada.
+ */
+constexpr int kMaxResliceSize = 2048;
+
+double dot(const std::array<double, 3>& a, const std::array<double, 3>& b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+}
+
+/**
+ * @brief Ponto do volume (mm) correspondente ao pixel (i, j).
+ */
+std::array<double, 3> ReslicePlane::pointAt(double i, double j) const {
+    std::array<double, 3> point;
+    for (int k = 0; k < 3; ++k) {
+        point[k] = origin[k] + (i * axisU[k] + j * axisV[k]) * pixelSpacing;
+    }
+    return point;
+}
+
+/**
+ * @brief Projeta um ponto do volume (mm) no plano, em coordenadas de pixel.
+ */
+std::array<double, 2> ReslicePlane::project(const std::array<double, 3>& point) const {
+    const std::array<double, 3> offset{{point[0] - origin[0], point[1] - origin[1], point[2] - origin[2]}};
+    return {{dot(offset, axisU) / pixelSpacing, dot(offset, axisV) / pixelSpacing}};
+}
+
+/**
+ * @brief Plano ortogonal (ou oblíquo) que passa por center e cobre todo o volume.
+ */
+ReslicePlane mprPlane(const BrickedVolume& volume, MprOrientation orientation, const std::array<double, 3>& center,
+                      double angle) {
+    ReslicePlane plane;
+    const double c = std::cos(angle);
+    const double s = std::sin(angle);
+    switch (orientation) {
+    case MprOrientation::Axial:
+        plane.axisU = {{1.0, 0.0, 0.0}};
+        plane.axisV = {{0.0, 1.0, 0.0}};
+        break;
+    case MprOrientation::Coronal:
+        plane.axisU = {{c, s, 0.0}};
+        plane.axisV = {{0.0, 0.0, -1.0}};
+        break;
+    case MprOrientation::Sagittal:
+        plane.axisU = {{-s, c, 0.0}};
+        plane.axisV = {{0.0, 0.0, -1.0}};
+        break;
+    }
+
+    const std::array<double, 3> extent{{(volume.width() - 1) * volume.spacingX(),
+                                        (volume.height() - 1) * volume.spacingY(),
+                                        (volume.depth() - 1) * volume.spacingZ()}};
+    plane.pixelSpacing = std::min({volume.spacingX(), volume.spacingY(), volume.spacingZ()});
+    if (plane.pixelSpacing <= 0.0) {
+        plane.pixelSpacing = 1.0;
+    }
+
+    // Intervalo coberto pelos cantos do volume ao longo de cada eixo do plano
+    double minU = std::numeric_limits<double>::max();
+    double maxU = std::numeric_limits<double>::lowest();
+    double minV = minU;
+    double maxV = maxU;
+    for (int corner = 0; corner < 8; ++corner) {
+        const std::array<double, 3> point{{(corner & 1) ? extent[0] : 0.0, (corner & 2) ? extent[1] : 0.0,
+                                           (corner & 4) ? extent[2] : 0.0}};
+        const std::array<double, 3> offset{{point[0] - center[0], point[1] - center[1], point[2] - center[2]}};
+        minU = std::min(minU, dot(offset, plane.axisU));
+        maxU = std::max(maxU, dot(offset, plane.axisU));
+        minV = std::min(minV, dot(offset, plane.axisV));
+        maxV = std::max(maxV, dot(offset, plane.axisV));
+    }
+    const double longest = std::max(maxU - minU, maxV - minV);
+    plane.pixelSpacing = std::max(plane.pixelSpacing, longest / (kMaxResliceSize - 1));
+    plane.width = static_cast<int>(std::floor((maxU - minU) / plane.pixelSpacing)) + 1;
+    plane.height = static_cast<int>(std::floor((maxV - minV) / plane.pixelSpacing)) + 1;
+    for (int k = 0; k < 3; ++k) {
+        plane.origin[k] = center[k] + minU * plane.axisU[k] + minV * plane.axisV[k];
+    }
+    return plane;
+}
+
+/**
+ * @brief Reformata o volume no plano informado, com interpolação trilinear, em paralelo por linhas.
+ */
+MedicalImage reslice(const BrickedVolume& volume, const ReslicePlane& plane, ThreadPool& pool) {
+    MedicalImage output;
+    if (!volume.isValid() || plane.width <= 0 || plane.height <= 0) {
+        return output;
+    }
+    const Volume& info = volume.info();
+    output.width = plane.width;
+    output.height = plane.height;
+    output.bitDepth = info.bitsAllocated;
+    output.bitsAllocated = info.bitsAllocated;
+    output.bitsStored = info.bitsStored;
+    output.highBit = info.bitsStored - 1;
+    output.pixelRepresentation = info.pixelRepresentation;
+    output.spacingX = plane.pixelSpacing;
+    output.spacingY = plane.pixelSpacing;
+    output.rescaleSlope = info.rescaleSlope;
+    output.rescaleIntercept = info.rescaleIntercept;
+    output.windowCenter = info.windowCenter;
+    output.windowWidth = info.windowWidth;
+    output.fullPrecision = true;
+    output.patientName = info.patientName;
+    output.studyDate = info.studyDate;
+    output.modality = info.modality;
+
+    const bool is16 = info.bitsAllocated == 16;
+    const bool isSigned = volume.isSigned();
+    // Fora do volume: menor valor representável, exibido como preto por qualquer janela
+    const float outside = isSigned ? (is16 ? -32768.0f : -128.0f) : 0.0f;
+    const float low = outside;
+    const float high = isSigned ? (is16 ? 32767.0f : 127.0f) : (is16 ? 65535.0f : 255.0f);
+    output.buffer.allocate(static_cast<std::size_t>(plane.width) * plane.height * (is16 ? 2 : 1));
+
+    // Passos por pixel em coordenadas de voxel
+    const double inverse[3] = {1.0 / volume.spacingX(), 1.0 / volume.spacingY(), 1.0 / volume.spacingZ()};
+    float stepU[3];
+    float stepV[3];
+    for (int k = 0; k < 3; ++k) {
+        stepU[k] = static_cast<float>(plane.axisU[k] * plane.pixelSpacing * inverse[k]);
+        stepV[k] = static_cast<float>(plane.axisV[k] * plane.pixelSpacing * inverse[k]);
+    }
+    const float start[3] = {static_cast<float>(plane.origin[0] * inverse[0]),
+                            static_cast<float>(plane.origin[1] * inverse[1]),
+                            static_cast<float>(plane.origin[2] * inverse[2])};
+    uint8_t* destination = output.buffer.data();
+    const int width = plane.width;
+
+    pool.parallelFor(0, static_cast<std::size_t>(plane.height), 8, [&](std::size_t firstRow, std::size_t lastRow) {
+        for (std::size_t j = firstRow; j < lastRow; ++j) {
+            float x = start[0] + stepV[0] * j;
+            float y = start[1] + stepV[1] * j;
+            float z = start[2] + stepV[2] * j;
+            for (int i = 0; i < width; ++i, x += stepU[0], y += stepU[1], z += stepU[2]) {
+                const float value = std::clamp(std::nearbyint(volume.sample(x, y, z, outside)), low, high);
+                const std::size_t index = j * width + i;
+                if (is16) {
+                    const uint16_t bits = isSigned ? static_cast<uint16_t>(static_cast<int16_t>(value))
+                                                   : static_cast<uint16_t>(value);
+                    reinterpret_cast<uint16_t*>(destination)[index] = bits;
+                } else {
+                    destination[index] = isSigned ? static_cast<uint8_t>(static_cast<int8_t>(value))
+                                                  : static_cast<uint8_t>(value);
+                }
+            }
+        }
+    });
+    return output;
+}
+
+}
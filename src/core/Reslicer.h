@@ -0,0 +1,85 @@
+/**
+ * DICOM Viewer - Reformatação Multiplanar (MPR)
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <array>
+
+#include "BrickedVolume.h"
+#include "MedicalImage.h"
+
+#ifndef RESLICER_H
+#define RESLICER_H
+
+namespace dicom_viewer_core {
+
+class ThreadPool;
+
+/**
+ * @brief Orientações dos três planos da MPR.
+ */
+enum class MprOrientation {
+    Axial,
+    Coronal,
+    Sagittal
+};
+
+/**
+ * @struct ReslicePlane
+ * @brief Plano de reformatação em milímetros no espaço do volume.
+ *
+ * O espaço do volume tem origem no centro do voxel (0, 0, 0) e eixos
+ * alinhados às colunas, linhas e cortes, escalados pelo espaçamento. O
+ * pixel (i, j) da imagem reformatada corresponde ao ponto
+ * origin + i * pixelSpacing * axisU + j * pixelSpacing * axisV.
+ */
+struct ReslicePlane {
+    std::array<double, 3> origin{{0.0, 0.0, 0.0}};   ///< Ponto do pixel (0, 0), em mm
+    std::array<double, 3> axisU{{1.0, 0.0, 0.0}};    ///< Direção das colunas (unitária)
+    std::array<double, 3> axisV{{0.0, 1.0, 0.0}};    ///< Direção das linhas (unitária)
+    int width = 0;                                    ///< Largura da imagem reformatada
+    int height = 0;                                   ///< Altura da imagem reformatada
+    double pixelSpacing = 1.0;                        ///< Espaçamento dos pixels reformatados, em mm
+
+    /**
+     * @brief Ponto do volume (mm) correspondente ao pixel (i, j).
+     */
+    std::array<double, 3> pointAt(double i, double j) const;
+
+    /**
+     * @brief Projeta um ponto do volume (mm) no plano, em coordenadas de pixel.
+     */
+    std::array<double, 2> project(const std::array<double, 3>& point) const;
+};
+
+/**
+ * @brief Plano ortogonal (ou oblíquo) que passa por center e cobre todo o volume.
+ *
+ * Os planos coronal e sagital são girados de angle radianos em torno do eixo
+ * dos cortes, passando por center (reformatação oblíqua). O eixo vertical
+ * desses planos aponta para os primeiros cortes (topo = último corte).
+ *
+ * @param volume Volume de referência.
+ * @param orientation Plano desejado.
+ * @param center Ponto do volume (mm) contido no plano.
+ * @param angle Rotação dos planos coronal e sagital, em radianos.
+ */
+ReslicePlane mprPlane(const BrickedVolume& volume, MprOrientation orientation, const std::array<double, 3>& center,
+                      double angle = 0.0);
+
+/**
+ * @brief Reformata o volume no plano informado, com interpolação trilinear, em paralelo por linhas.
+ *
+ * @param volume Volume em blocos.
+ * @param plane Plano de reformatação.
+ * @param pool Pool usado para distribuir as linhas.
+ * @return Imagem de precisão total, com o rescale e a janela do volume.
+ */
+MedicalImage reslice(const BrickedVolume& volume, const ReslicePlane& plane, ThreadPool& pool);
+
+}
+
+#endif // RESLICER_H
@@ -0,0 +1,352 @@
+/**
+ * DICOM Viewer - Projeções de Intensidade em Placa (MIP/MinIP/AvgIP)
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "SlabProjection.h"
+#include "ThreadPool.h"
+#include "Trace.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DICOM_VIEWER_HAS_SSE2 1
+#endif
+
+namespace dicom_viewer_core {
+
+namespace {
+
+// Núcleos escalares: também tratam o final das linhas nas versões SSE2
+
+template <typename T>
+void maxRowScalar(T* target, const T* source, int first, int count) {
+    for (int i = first; i < count; ++i) {
+        target[i] = std::max(target[i], source[i]);
+    }
+}
+
+template <typename T>
+void minRowScalar(T* target, const T* source, int first, int count) {
+    for (int i = first; i < count; ++i) {
+        target[i] = std::min(target[i], source[i]);
+    }
+}
+
+template <typename T>
+void addRowScalar(int32_t* sums, const T* source, int first, int count) {
+    for (int i = first; i < count; ++i) {
+        sums[i] += source[i];
+    }
+}
+
+#if defined(DICOM_VIEWER_HAS_SSE2)
+/**
+ * @brief Máximo ou mínimo de 16 bits com sinal, 8 pixels por instrução.
+ *
+ * O SSE2 só compara 16 bits com sinal; para valores sem sinal o bit mais
+ * significativo é invertido antes e depois (bias), o que preserva a ordem.
+ */
+template <bool Maximum, bool Unsigned>
+void extremeRow16(uint16_t* target, const uint16_t* source, int count) {
+    const __m128i bias = _mm_set1_epi16(Unsigned ? static_cast<short>(0x8000) : 0);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i a = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(target + i)), bias);
+        const __m128i b = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)), bias);
+        const __m128i r = Maximum ? _mm_max_epi16(a, b) : _mm_min_epi16(a, b);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(target + i), _mm_xor_si128(r, bias));
+    }
+    if (Unsigned) {
+        Maximum ? maxRowScalar(target, source, i, count) : minRowScalar(target, source, i, count);
+    } else {
+        int16_t* signedTarget = reinterpret_cast<int16_t*>(target);
+        const int16_t* signedSource = reinterpret_cast<const int16_t*>(source);
+        Maximum ? maxRowScalar(signedTarget, signedSource, i, count) : minRowScalar(signedTarget, signedSource, i, count);
+    }
+}
+
+/**
+ * @brief Máximo ou mínimo de 8 bits, 16 pixels por instrução (bias para valores com sinal).
+ */
+template <bool Maximum, bool Unsigned>
+void extremeRow8(uint8_t* target, const uint8_t* source, int count) {
+    const __m128i bias = _mm_set1_epi8(Unsigned ? 0 : static_cast<char>(0x80));
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i a = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(target + i)), bias);
+        const __m128i b = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)), bias);
+        const __m128i r = Maximum ? _mm_max_epu8(a, b) : _mm_min_epu8(a, b);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(target + i), _mm_xor_si128(r, bias));
+    }
+    if (Unsigned) {
+        Maximum ? maxRowScalar(target, source, i, count) : minRowScalar(target, source, i, count);
+    } else {
+        int8_t* signedTarget = reinterpret_cast<int8_t*>(target);
+        const int8_t* signedSource = reinterpret_cast<const int8_t*>(source);
+        Maximum ? maxRowScalar(signedTarget, signedSource, i, count) : minRowScalar(signedTarget, signedSource, i, count);
+    }
+}
+
+/**
+ * @brief Soma uma linha de 16 bits a acumuladores de 32 bits, 8 pixels por iteração.
+ */
+template <bool Unsigned>
+void addRow16(int32_t* sums, const uint16_t* source, int count) {
+    const __m128i zero = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        // Sem sinal: completa com zeros; com sinal: duplica e desloca para estender o sinal
+        const __m128i low = Unsigned ? _mm_unpacklo_epi16(v, zero) : _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        const __m128i high = Unsigned ? _mm_unpackhi_epi16(v, zero) : _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        __m128i* sum = reinterpret_cast<__m128i*>(sums + i);
+        _mm_storeu_si128(sum, _mm_add_epi32(_mm_loadu_si128(sum), low));
+        _mm_storeu_si128(sum + 1, _mm_add_epi32(_mm_loadu_si128(sum + 1), high));
+    }
+    if (Unsigned) {
+        addRowScalar(sums, source, i, count);
+    } else {
+        addRowScalar(sums, reinterpret_cast<const int16_t*>(source), i, count);
+    }
+}
+#endif
+
+/**
+ * @brief Combina uma linha da origem com a linha acumulada da saída.
+ *
+ * Os valores são manipulados como bits crus (uint8_t/uint16_t); isSigned
+ * escolhe a ordem usada na comparação e a extensão de sinal na soma.
+ */
+template <typename T>
+void combineRow(ProjectionMode mode, bool isSigned, T* target, int32_t* sums, const T* source, int count) {
+    using Signed = typename std::conditional<sizeof(T) == 1, int8_t, int16_t>::type;
+    if (mode == ProjectionMode::Average) {
+#if defined(DICOM_VIEWER_HAS_SSE2)
+        if (sizeof(T) == 2) {
+            const uint16_t* source16 = reinterpret_cast<const uint16_t*>(source);
+            isSigned ? addRow16<false>(sums, source16, count) : addRow16<true>(sums, source16, count);
+            return;
+        }
+#endif
+        isSigned ? addRowScalar(sums, reinterpret_cast<const Signed*>(source), 0, count)
+                 : addRowScalar(sums, source, 0, count);
+        return;
+    }
+    const bool maximum = mode == ProjectionMode::Maximum;
+#if defined(DICOM_VIEWER_HAS_SSE2)
+    if (sizeof(T) == 2) {
+        uint16_t* t = reinterpret_cast<uint16_t*>(target);
+        const uint16_t* s = reinterpret_cast<const uint16_t*>(source);
+        if (maximum) {
+            isSigned ? extremeRow16<true, false>(t, s, count) : extremeRow16<true, true>(t, s, count);
+        } else {
+            isSigned ? extremeRow16<false, false>(t, s, count) : extremeRow16<false, true>(t, s, count);
+        }
+    } else {
+        uint8_t* t = reinterpret_cast<uint8_t*>(target);
+        const uint8_t* s = reinterpret_cast<const uint8_t*>(source);
+        if (maximum) {
+            isSigned ? extremeRow8<true, false>(t, s, count) : extremeRow8<true, true>(t, s, count);
+        } else {
+            isSigned ? extremeRow8<false, false>(t, s, count) : extremeRow8<false, true>(t, s, count);
+        }
+    }
+#else
+    if (isSigned) {
+        Signed* t = reinterpret_cast<Signed*>(target);
+        const Signed* s = reinterpret_cast<const Signed*>(source);
+        maximum ? maxRowScalar(t, s, 0, count) : minRowScalar(t, s, 0, count);
+    } else {
+        maximum ? maxRowScalar(target, source, 0, count) : minRowScalar(target, source, 0, count);
+    }
+#endif
+}
+
+/**
+ * @brief Reduz count valores contíguos (projeção sagital) a um único valor, em bits crus.
+ */
+template <typename T>
+T reduceSpan(ProjectionMode mode, bool isSigned, const T* source, int count) {
+    using Signed = typename std::conditional<sizeof(T) == 1, int8_t, int16_t>::type;
+    if (isSigned) {
+        const Signed* s = reinterpret_cast<const Signed*>(source);
+        if (mode == ProjectionMode::Average) {
+            int32_t sum = 0;
+            for (int i = 0; i < count; ++i) {
+                sum += s[i];
+            }
+            return static_cast<T>(static_cast<Signed>(std::lround(static_cast<double>(sum) / count)));
+        }
+        Signed value = s[0];
+        for (int i = 1; i < count; ++i) {
+            value = mode == ProjectionMode::Maximum ? std::max(value, s[i]) : std::min(value, s[i]);
+        }
+        return static_cast<T>(value);
+    }
+    if (mode == ProjectionMode::Average) {
+        int32_t sum = 0;
+        for (int i = 0; i < count; ++i) {
+            sum += source[i];
+        }
+        return static_cast<T>(std::lround(static_cast<double>(sum) / count));
+    }
+    T value = source[0];
+    for (int i = 1; i < count; ++i) {
+        value = mode == ProjectionMode::Maximum ? std::max(value, source[i]) : std::min(value, source[i]);
+    }
+    return value;
+}
+
+/**
+ * @brief Calcula as linhas de saída [firstRow, lastRow) da projeção.
+ */
+template <typename T>
+void projectRows(const Volume& volume, ProjectionMode mode, ProjectionAxis axis, int first, int count,
+                 MedicalImage& output, std::size_t firstRow, std::size_t lastRow) {
+    using Signed = typename std::conditional<sizeof(T) == 1, int8_t, int16_t>::type;
+    const bool isSigned = volume.pixelRepresentation == 1;
+    const int width = output.width;
+    T* pixels = reinterpret_cast<T*>(output.buffer.data());
+    std::vector<int32_t> sums(mode == ProjectionMode::Average ? width : 0);
+
+    for (std::size_t row = firstRow; row < lastRow; ++row) {
+        T* target = pixels + row * width;
+        if (axis == ProjectionAxis::Sagittal) {
+            const int z = volume.depth - 1 - static_cast<int>(row);
+            const T* slice = reinterpret_cast<const T*>(volume.sliceData(z));
+            for (int y = 0; y < width; ++y) {
+                target[y] = reduceSpan(mode, isSigned, slice + static_cast<std::size_t>(y) * volume.width + first, count);
+            }
+            continue;
+        }
+
+        // Axial: a mesma linha em cada corte; coronal: linhas consecutivas de um corte
+        auto sourceRow = [&](int k) {
+            if (axis == ProjectionAxis::Axial) {
+                return reinterpret_cast<const T*>(volume.sliceData(first + k)) + row * width;
+            }
+            const int z = volume.depth - 1 - static_cast<int>(row);
+            return reinterpret_cast<const T*>(volume.sliceData(z)) + static_cast<std::size_t>(first + k) * width;
+        };
+        if (mode == ProjectionMode::Average) {
+            std::fill(sums.begin(), sums.end(), 0);
+            for (int k = 0; k < count; ++k) {
+                combineRow(mode, isSigned, target, sums.data(), sourceRow(k), width);
+            }
+            for (int x = 0; x < width; ++x) {
+                const long value = std::lround(static_cast<double>(sums[x]) / count);
+                target[x] = isSigned ? static_cast<T>(static_cast<Signed>(value)) : static_cast<T>(value);
+            }
+        } else {
+            std::memcpy(target, sourceRow(0), static_cast<std::size_t>(width) * sizeof(T));
+            for (int k = 1; k < count; ++k) {
+                combineRow(mode, isSigned, target, sums.data(), sourceRow(k), width);
+            }
+        }
+    }
+}
+
+}
+
+/**
+ * @brief Número de posições do volume ao longo do eixo.
+ */
+int projectionExtent(const Volume& volume, ProjectionAxis axis) {
+    switch (axis) {
+    case ProjectionAxis::Coronal:
+        return volume.height;
+    case ProjectionAxis::Sagittal:
+        return volume.width;
+    default:
+        return volume.depth;
+    }
+}
+
+/**
+ * @brief Espaçamento, em mm, entre posições consecutivas ao longo do eixo.
+ */
+double projectionSpacing(const Volume& volume, ProjectionAxis axis) {
+    switch (axis) {
+    case ProjectionAxis::Coronal:
+        return volume.spacingY;
+    case ProjectionAxis::Sagittal:
+        return volume.spacingX;
+    default:
+        return volume.spacingZ;
+    }
+}
+
+/**
+ * @brief Projeta a placa [first, first + count) do volume ao longo de um eixo.
+ */
+MedicalImage projectSlab(const Volume& volume, ProjectionMode mode, ProjectionAxis axis, int first, int count,
+                         ThreadPool& pool) {
+    MedicalImage output;
+    const int extent = projectionExtent(volume, axis);
+    if (!volume.isValid() || (volume.bitsAllocated != 8 && volume.bitsAllocated != 16)) {
+        return output;
+    }
+    first = std::clamp(first, 0, extent - 1);
+    count = std::clamp(count, 1, extent - first);
+    DICOM_TRACE_SCOPE(traceScope, "projection");
+
+    switch (axis) {
+    case ProjectionAxis::Axial:
+        output.width = volume.width;
+        output.height = volume.height;
+        output.spacingX = volume.spacingX;
+        output.spacingY = volume.spacingY;
+        break;
+    case ProjectionAxis::Coronal:
+        output.width = volume.width;
+        output.height = volume.depth;
+        output.spacingX = volume.spacingX;
+        output.spacingY = volume.spacingZ;
+        break;
+    case ProjectionAxis::Sagittal:
+        output.width = volume.height;
+        output.height = volume.depth;
+        output.spacingX = volume.spacingY;
+        output.spacingY = volume.spacingZ;
+        break;
+    }
+    output.bitDepth = volume.bitsAllocated;
+    output.bitsAllocated = volume.bitsAllocated;
+    output.bitsStored = volume.bitsStored;
+    output.highBit = volume.bitsStored - 1;
+    output.pixelRepresentation = volume.pixelRepresentation;
+    output.windowCenter = volume.windowCenter;
+    output.windowWidth = volume.windowWidth;
+    output.rescaleSlope = volume.rescaleSlope;
+    output.rescaleIntercept = volume.rescaleIntercept;
+    output.fullPrecision = true;
+    output.patientName = volume.patientName;
+    output.studyDate = volume.studyDate;
+    output.modality = volume.modality;
+    output.buffer.allocate(static_cast<std::size_t>(output.width) * output.height * volume.bytesPerVoxel());
+
+    // Cada bloco de linhas lê count linhas de origem por linha de saída
+    const std::size_t grain =
+        ThreadPool::rowsPerBlock(static_cast<std::size_t>(output.width) * static_cast<std::size_t>(count), 65536);
+    pool.parallelFor(0, static_cast<std::size_t>(output.height), grain,
+                     [&](std::size_t firstRow, std::size_t lastRow) {
+        if (volume.bitsAllocated == 16) {
+            projectRows<uint16_t>(volume, mode, axis, first, count, output, firstRow, lastRow);
+        } else {
+            projectRows<uint8_t>(volume, mode, axis, first, count, output, firstRow, lastRow);
+        }
+    });
+    DICOM_TRACE_BYTES(traceScope, static_cast<std::size_t>(count) * output.buffer.size());
+    return output;
+}
+
+}
@@ -0,0 +1,71 @@
+/**
+ * DICOM Viewer - Projeções de Intensidade em Placa (MIP/MinIP/AvgIP)
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "MedicalImage.h"
+#include "Volume.h"
+
+#ifndef SLABPROJECTION_H
+#define SLABPROJECTION_H
+
+namespace dicom_viewer_core {
+
+class ThreadPool;
+
+/**
+ * @brief Operação aplicada ao longo da espessura da placa.
+ */
+enum class ProjectionMode {
+    Maximum,                                          ///< MIP: maior valor
+    Minimum,                                          ///< MinIP: menor valor
+    Average                                           ///< AvgIP: média (arredondada) dos valores
+};
+
+/**
+ * @brief Eixo do volume atravessado pela projeção.
+ */
+enum class ProjectionAxis {
+    Axial,                                            ///< Ao longo dos cortes (z); saída width x height
+    Coronal,                                          ///< Ao longo das linhas (y); saída width x depth
+    Sagittal                                          ///< Ao longo das colunas (x); saída height x depth
+};
+
+/**
+ * @brief Número de posições do volume ao longo do eixo.
+ */
+int projectionExtent(const Volume& volume, ProjectionAxis axis);
+
+/**
+ * @brief Espaçamento, em mm, entre posições consecutivas ao longo do eixo.
+ */
+double projectionSpacing(const Volume& volume, ProjectionAxis axis);
+
+/**
+ * @brief Projeta a placa [first, first + count) do volume ao longo de um eixo.
+ *
+ * Os valores armazenados são combinados sem rescale (a média de valores
+ * armazenados, depois do rescale, é a média em unidades de modalidade), de
+ * modo que o resultado é uma imagem de precisão total com o janelamento e o
+ * rescale do volume. As linhas de saída são distribuídas pelo pool; nos
+ * eixos axial e coronal cada linha combina linhas contíguas da origem com
+ * SSE2, 8 ou 16 pixels por instrução. Nas projeções coronal e sagital a
+ * linha 0 da saída é o último corte, como nas vistas MPR.
+ *
+ * @param volume Volume de origem (8 ou 16 bits).
+ * @param mode Máximo, mínimo ou média.
+ * @param axis Eixo atravessado.
+ * @param first Primeira posição da placa ao longo do eixo.
+ * @param count Espessura da placa, em posições (recortada aos limites do volume).
+ * @param pool Pool usado para distribuir as linhas de saída.
+ * @return A projeção, ou uma imagem inválida se o volume ou a placa forem inválidos.
+ */
+MedicalImage projectSlab(const Volume& volume, ProjectionMode mode, ProjectionAxis axis, int first, int count,
+                         ThreadPool& pool);
+
+}
+
+#endif // SLABPROJECTION_H
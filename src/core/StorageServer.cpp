@@ -0,0 +1,399 @@
+/**
+ * DICOM Viewer - Receptor DICOM (C-STORE SCP)
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <system_error>
+
+#include <dcmtk/config/osconfig.h>
+#include <dcmtk/dcmdata/dctk.h>
+#include <dcmtk/dcmnet/scppool.h>
+#include <dcmtk/dcmnet/scpthrd.h>
+
+#include "StorageServer.h"
+#include "Trace.h"
+
+namespace fs = std::filesystem;
+
+namespace dicom_viewer_core {
+
+namespace {
+
+/**
+ * @brief Receptor ativo, encontrado pelos workers criados pelo DCMTK.
+ */
+std::atomic<StorageServer*> activeServer{nullptr};
+
+/**
+ * @brief Sintaxes de transferência aceitas para as classes de armazenamento.
+ *
+ * As comprimidas são gravadas como chegaram, sem recompressão.
+ */
+const char* const kStorageSyntaxes[] = {
+    UID_LittleEndianExplicitTransferSyntax,
+    UID_LittleEndianImplicitTransferSyntax,
+    UID_BigEndianExplicitTransferSyntax,
+    UID_DeflatedExplicitVRLittleEndianTransferSyntax,
+    UID_JPEGProcess1TransferSyntax,
+    UID_JPEGProcess2_4TransferSyntax,
+    UID_JPEGProcess14TransferSyntax,
+    UID_JPEGProcess14SV1TransferSyntax,
+    UID_JPEGLSLosslessTransferSyntax,
+    UID_JPEGLSLossyTransferSyntax,
+    UID_JPEG2000LosslessOnlyTransferSyntax,
+    UID_JPEG2000TransferSyntax,
+    UID_RLELosslessTransferSyntax,
+};
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::string datasetString(DcmDataset* dataset, const DcmTagKey& tag) {
+    OFString value;
+    if (dataset->findAndGetOFString(tag, value).good()) {
+        return value.c_str();
+    }
+    return std::string();
+}
+
+/**
+ * @brief Nome de arquivo seguro a partir de um UID (ou fallback se vazio).
+ */
+std::string safeName(const std::string& value, const char* fallback) {
+    if (value.empty()) {
+        return fallback;
+    }
+    std::string name = value;
+    for (char& c : name) {
+        const bool allowed = (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '.' || c == '-';
+        if (!allowed) {
+            c = '_';
+        }
+    }
+    return name;
+}
+
+}
+
+/**
+ * @class StorageWorker
+ * @brief Atende uma associação: C-STORE vai para a fila do receptor; o resto (C-ECHO) fica com o DcmSCP.
+ */
+class StorageWorker : public DcmThreadSCP {
+public:
+    StorageWorker() : server(activeServer.load()) {}
+
+protected:
+    void notifyAssociationAcknowledge() override {
+        DcmThreadSCP::notifyAssociationAcknowledge();
+        if (server && !counted) {
+            server->associationStarted();
+            counted = true;
+        }
+    }
+
+    void notifyAssociationTermination() override {
+        DcmThreadSCP::notifyAssociationTermination();
+        if (server && counted) {
+            server->associationEnded();
+            counted = false;
+        }
+    }
+
+    OFCondition handleIncomingCommand(T_DIMSE_Message* message, const DcmPresentationContextInfo& context) override {
+        if (!server || message->CommandField != DIMSE_C_STORE_RQ) {
+            return DcmThreadSCP::handleIncomingCommand(message, context);
+        }
+        T_DIMSE_C_StoreRQ& request = message->msg.CStoreRQ;
+        DcmDataset* dataset = nullptr;
+        OFCondition result = receiveSTORERequest(request, context.presentationContextID, dataset);
+        if (result.bad()) {
+            delete dataset;
+            return result;
+        }
+        ReceivedInstance info;
+        info.sopInstanceUID = request.AffectedSOPInstanceUID;
+        info.callingAETitle = getPeerAETitle().c_str();
+        // O DcmFileFormat assume o dataset recebido, sem cópia
+        std::unique_ptr<DcmFileFormat> file = std::make_unique<DcmFileFormat>(dataset, OFFalse);
+        // Sucesso apenas com a instância no disco; fila fechada ou falha de gravação são recusas
+        const Uint16 status = server->store(std::move(file), std::move(info)) ? STATUS_Success
+                                                                              : STATUS_STORE_Refused_OutOfResources;
+        return sendSTOREResponse(context.presentationContextID, request, status);
+    }
+
+private:
+    StorageServer* server;
+    bool counted = false;
+};
+
+/**
+ * @class StorageServer::ListenerPool
+ * @brief Pool de associações do DCMTK com os workers do receptor.
+ */
+class StorageServer::ListenerPool : public DcmSCPPool<StorageWorker> {};
+
+/**
+ * @brief Cria o receptor (ainda parado).
+ */
+StorageServer::StorageServer(StorageServerConfig config)
+    : settings(std::move(config)) {}
+
+/**
+ * @brief Destrutor. Para o receptor, se ativo.
+ */
+StorageServer::~StorageServer() {
+    stop();
+}
+
+/**
+ * @brief Começa a escutar a porta em uma thread própria.
+ *
+ * @param onStored Chamada para cada instância gravada (opcional).
+ * @param onListenFailed Chamada se a escuta falhar sem stop() (opcional).
+ * @return false se o diretório não puder ser criado ou outro receptor estiver ativo.
+ */
+bool StorageServer::start(InstanceCallback onStored, ListenFailureCallback onListenFailed) {
+    stop();
+    if (settings.storageDirectory.empty()) {
+        std::cerr << "Error: storage server needs a storage directory" << std::endl;
+        return false;
+    }
+    std::error_code error;
+    fs::create_directories(fs::path(settings.storageDirectory) / ".incoming", error);
+    if (error) {
+        std::cerr << "Error: cannot create " << settings.storageDirectory << ": " << error.message() << std::endl;
+        return false;
+    }
+    StorageServer* expected = nullptr;
+    if (!activeServer.compare_exchange_strong(expected, this)) {
+        std::cerr << "Error: another storage server is already running" << std::endl;
+        return false;
+    }
+
+    received = 0;
+    written = 0;
+    failed = 0;
+    bytes = 0;
+    activeAssociations = 0;
+    peakAssociations = 0;
+    totalAssociations = 0;
+    firstReceivedNs = 0;
+    lastWrittenNs = 0;
+    callback = std::move(onStored);
+    listenFailed = std::move(onListenFailed);
+
+    listener = std::make_unique<ListenerPool>();
+    DcmSCPConfig& config = listener->getConfig();
+    config.setAETitle(settings.aeTitle.c_str());
+    config.setPort(settings.port);
+    config.setHostLookupEnabled(OFFalse);
+    // Sem bloqueio, a escuta volta a cada segundo e percebe stop()
+    config.setConnectionBlockingMode(DUL_NOBLOCK);
+    config.setConnectionTimeout(1);
+    // Uma associação que para de enviar é encerrada, em vez de prender a sua thread (e stop()) para sempre
+    config.setDIMSEBlockingMode(DIMSE_NONBLOCKING);
+    config.setDIMSETimeout(std::max(1u, settings.dimseTimeoutSeconds));
+    config.setACSETimeout(std::max(1u, settings.acseTimeoutSeconds));
+
+    OFList<OFString> storageSyntaxes;
+    for (const char* syntax : kStorageSyntaxes) {
+        storageSyntaxes.push_back(syntax);
+    }
+    for (int index = 0; index < numberOfDcmAllStorageSOPClassUIDs; ++index) {
+        config.addPresentationContext(dcmAllStorageSOPClassUIDs[index], storageSyntaxes);
+    }
+    OFList<OFString> verificationSyntaxes;
+    verificationSyntaxes.push_back(UID_LittleEndianExplicitTransferSyntax);
+    verificationSyntaxes.push_back(UID_LittleEndianImplicitTransferSyntax);
+    config.addPresentationContext(UID_VerificationSOPClass, verificationSyntaxes);
+    listener->setMaxThreads(static_cast<Uint16>(std::clamp<std::size_t>(settings.maxAssociations, 1, 256)));
+
+    queue = std::make_unique<BoundedQueue<PendingInstance>>(settings.queueCapacity);
+    stopping = false;
+    running = true;
+    for (unsigned index = 0; index < std::max(1u, settings.writerThreads); ++index) {
+        writers.emplace_back([this]() { writeLoop(); });
+    }
+    listenThread = std::thread([this]() {
+        const OFCondition result = listener->listen();
+        running = false;
+        if (result.bad() && !stopping.load()) {
+            std::cerr << "Error: storage server on port " << settings.port << " stopped: " << result.text() << std::endl;
+            if (listenFailed) {
+                listenFailed(result.text());
+            }
+        }
+    });
+    return true;
+}
+
+/**
+ * @brief Para de aceitar associações, aguarda as abertas e grava o que estiver na fila.
+ */
+void StorageServer::stop() {
+    if (!listenThread.joinable()) {
+        return;
+    }
+    stopping = true;
+    listener->stopAfterCurrentAssociations();
+    listenThread.join();
+    // Nenhuma associação pode mais enfileirar: as gravações esvaziam a fila e terminam
+    queue->close();
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    writers.clear();
+    listener.reset();
+    queue.reset();
+    running = false;
+    StorageServer* self = this;
+    activeServer.compare_exchange_strong(self, nullptr);
+}
+
+/**
+ * @brief Contadores e taxas desde start().
+ */
+StorageStats StorageServer::stats() const {
+    StorageStats result;
+    result.instancesReceived = received.load();
+    result.instancesWritten = written.load();
+    result.instancesFailed = failed.load();
+    result.bytesWritten = bytes.load();
+    result.activeAssociations = activeAssociations.load();
+    result.peakAssociations = peakAssociations.load();
+    result.totalAssociations = totalAssociations.load();
+    const int64_t first = firstReceivedNs.load();
+    const int64_t last = lastWrittenNs.load();
+    if (first > 0 && last > first) {
+        result.elapsedSeconds = (last - first) / 1e9;
+        result.instancesPerSecond = result.instancesWritten / result.elapsedSeconds;
+        result.megabytesPerSecond = result.bytesWritten / (1024.0 * 1024.0) / result.elapsedSeconds;
+    }
+    return result;
+}
+
+/**
+ * @brief Coloca uma instância recebida na fila de gravação e aguarda a gravação (thread da associação).
+ *
+ * Bloqueia enquanto a fila estiver cheia e até uma thread de gravação
+ * terminar a instância; outras associações continuam sendo atendidas.
+ *
+ * @return false se o receptor estiver parando ou a instância não pôde ser gravada.
+ */
+bool StorageServer::store(std::unique_ptr<DcmFileFormat> file, ReceivedInstance info) {
+    PendingInstance pending;
+    pending.file = std::move(file);
+    pending.info = std::move(info);
+    std::future<bool> stored = pending.stored.get_future();
+    if (!queue->push(std::move(pending))) {
+        ++failed;
+        return false;
+    }
+    int64_t expected = 0;
+    firstReceivedNs.compare_exchange_strong(expected, nowNs());
+    ++received;
+    // As threads de gravação esvaziam a fila mesmo durante stop(): o resultado sempre chega
+    return stored.get();
+}
+
+void StorageServer::associationStarted() {
+    const std::size_t active = ++activeAssociations;
+    ++totalAssociations;
+    std::size_t peak = peakAssociations.load();
+    while (active > peak && !peakAssociations.compare_exchange_weak(peak, active)) {
+    }
+}
+
+void StorageServer::associationEnded() {
+    --activeAssociations;
+}
+
+/**
+ * @brief Laço de uma thread de gravação: esvazia a fila até ela ser fechada.
+ */
+void StorageServer::writeLoop() {
+    PendingInstance pending;
+    while (queue->pop(pending)) {
+        const bool ok = writeInstance(pending);
+        pending.file.reset();
+        if (ok) {
+            bytes += pending.info.bytes;
+            ++written;
+            lastWrittenNs = nowNs();
+        } else {
+            ++failed;
+        }
+        pending.stored.set_value(ok);
+        if (ok && callback) {
+            callback(pending.info);
+        }
+    }
+}
+
+/**
+ * @brief Grava uma instância em <raiz>/<estudo>/<série>/.
+ *
+ * O nome começa pelo Instance Number com zeros à esquerda, de modo que a
+ * ordem alfabética do diretório segue a aquisição. O arquivo é gravado em
+ * <raiz>/.incoming e movido para o lugar ao fim.
+ */
+bool StorageServer::writeInstance(PendingInstance& pending) {
+    DICOM_TRACE_SCOPE(traceScope, "store");
+    ReceivedInstance& info = pending.info;
+    DcmDataset* dataset = pending.file->getDataset();
+    info.studyInstanceUID = datasetString(dataset, DCM_StudyInstanceUID);
+    info.seriesInstanceUID = datasetString(dataset, DCM_SeriesInstanceUID);
+    if (info.sopInstanceUID.empty()) {
+        info.sopInstanceUID = datasetString(dataset, DCM_SOPInstanceUID);
+    }
+
+    std::ostringstream name;
+    Sint32 instanceNumber = 0;
+    if (dataset->findAndGetSint32(DCM_InstanceNumber, instanceNumber).good() && instanceNumber >= 0) {
+        name << std::setw(5) << std::setfill('0') << instanceNumber << '-';
+    }
+    name << safeName(info.sopInstanceUID, "instance") << ".dcm";
+
+    const fs::path root(settings.storageDirectory);
+    const fs::path directory = root / safeName(info.studyInstanceUID, "unknown-study") /
+                               safeName(info.seriesInstanceUID, "unknown-series");
+    const fs::path target = directory / name.str();
+    const fs::path partial = root / ".incoming" / (name.str() + ".part");
+
+    std::error_code error;
+    fs::create_directories(directory, error);
+    if (error) {
+        std::cerr << "Error: cannot create " << directory.string() << ": " << error.message() << std::endl;
+        return false;
+    }
+    // EXS_Unknown mantém a sintaxe de transferência em que a instância chegou
+    const OFCondition result = pending.file->saveFile(partial.string().c_str(), EXS_Unknown);
+    if (result.bad()) {
+        std::cerr << "Error: cannot write " << partial.string() << ": " << result.text() << std::endl;
+        fs::remove(partial, error);
+        return false;
+    }
+    fs::rename(partial, target, error);
+    if (error) {
+        std::cerr << "Error: cannot move " << partial.string() << " to " << target.string() << ": " << error.message() << std::endl;
+        fs::remove(partial, error);
+        return false;
+    }
+    info.path = target.string();
+    info.bytes = static_cast<uint64_t>(fs::file_size(target, error));
+    DICOM_TRACE_BYTES(traceScope, info.bytes);
+    return true;
+}
+
+}
@@ -0,0 +1,204 @@
+/**
+ * DICOM Viewer - Receptor DICOM (C-STORE SCP)
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BoundedQueue.h"
+
+#ifndef STORAGESERVER_H
+#define STORAGESERVER_H
+
+class DcmFileFormat;
+
+namespace dicom_viewer_core {
+
+/**
+ * @struct StorageServerConfig
+ * @brief Parâmetros do receptor.
+ */
+struct StorageServerConfig {
+    uint16_t port = 11112;                            ///< Porta TCP de escuta
+    std::string aeTitle = "DICOMVIEWER";              ///< AE Title do receptor
+    std::string storageDirectory;                     ///< Raiz dos arquivos recebidos (<estudo>/<série>/<instância>.dcm)
+    std::size_t maxAssociations = 8;                  ///< Associações atendidas simultaneamente
+    std::size_t queueCapacity = 64;                   ///< Instâncias recebidas aguardando gravação
+    unsigned writerThreads = 2;                       ///< Threads de gravação
+    unsigned dimseTimeoutSeconds = 30;                ///< Espera máxima por uma mensagem DIMSE de uma associação aberta
+    unsigned acseTimeoutSeconds = 30;                 ///< Espera máxima na negociação e no encerramento da associação
+};
+
+/**
+ * @struct ReceivedInstance
+ * @brief Instância já gravada no disco.
+ */
+struct ReceivedInstance {
+    std::string path;                                 ///< Arquivo gravado
+    std::string studyInstanceUID;
+    std::string seriesInstanceUID;
+    std::string sopInstanceUID;
+    std::string callingAETitle;                       ///< AE Title de quem enviou
+    uint64_t bytes = 0;                               ///< Tamanho do arquivo gravado
+};
+
+/**
+ * @struct StorageStats
+ * @brief Contadores do receptor desde start().
+ *
+ * As taxas cobrem o intervalo entre a primeira instância recebida e a
+ * última gravada, de modo que períodos ociosos antes do primeiro envio
+ * não as reduzem.
+ */
+struct StorageStats {
+    uint64_t instancesReceived = 0;                   ///< Instâncias recebidas e enfileiradas para gravação
+    uint64_t instancesWritten = 0;                    ///< Instâncias gravadas no disco
+    uint64_t instancesFailed = 0;                     ///< Instâncias recusadas ou não gravadas
+    uint64_t bytesWritten = 0;                        ///< Bytes gravados
+    std::size_t activeAssociations = 0;               ///< Associações abertas agora
+    std::size_t peakAssociations = 0;                 ///< Maior número de associações simultâneas
+    std::size_t totalAssociations = 0;                ///< Associações aceitas
+    double elapsedSeconds = 0.0;                      ///< Da primeira instância recebida à última gravada
+    double instancesPerSecond = 0.0;
+    double megabytesPerSecond = 0.0;
+};
+
+/**
+ * @brief Chamada, na thread de gravação, para cada instância gravada.
+ */
+using InstanceCallback = std::function<void(const ReceivedInstance&)>;
+
+/**
+ * @brief Chamada, na thread de escuta, se a porta não puder ser aberta ou a escuta parar por erro.
+ */
+using ListenFailureCallback = std::function<void(const std::string& reason)>;
+
+class StorageWorker;
+
+/**
+ * @class StorageServer
+ * @brief Receptor C-STORE (Storage SCP) sobre o dcmnet do DCMTK.
+ *
+ * Cada associação é atendida por uma thread do DcmSCPPool, até
+ * maxAssociations simultâneas. Os datasets recebidos entram em uma fila
+ * limitada e são gravados por threads próprias, de modo que a rede não
+ * espera o disco; com a fila cheia, as associações aguardam (contrapressão)
+ * em vez de acumular datasets na memória. A resposta do C-STORE é enviada
+ * ao enfileirar: falhas de gravação são contadas em instancesFailed.
+ *
+ * Cada arquivo é gravado com um nome temporário e renomeado ao fim, de
+ * modo que quem observa o diretório nunca lê uma instância incompleta.
+ * São aceitas todas as classes de armazenamento, nas sintaxes nativas e
+ * nas comprimidas mais comuns, além de C-ECHO.
+ *
+ * Os workers do DcmSCPPool são criados pelo DCMTK sem argumentos e
+ * encontram o receptor por um registro global; por isso apenas um
+ * receptor pode estar ativo por processo.
+ */
+class StorageServer {
+public:
+    /**
+     * @brief Cria o receptor (ainda parado).
+     */
+    explicit StorageServer(StorageServerConfig config);
+
+    /**
+     * @brief Destrutor. Para o receptor, se ativo.
+     */
+    ~StorageServer();
+
+    StorageServer(const StorageServer&) = delete;
+    StorageServer& operator=(const StorageServer&) = delete;
+
+    /**
+     * @brief Começa a escutar a porta em uma thread própria.
+     *
+     * O DcmSCPPool só abre a porta dentro de listen(), na thread de escuta:
+     * uma porta ocupada ou sem permissão é informada a onListenFailed (e em
+     * std::cerr), e isRunning() passa a retornar false. stop() ainda deve
+     * ser chamado para encerrar as threads de gravação.
+     *
+     * @param onStored Chamada para cada instância gravada (opcional).
+     * @param onListenFailed Chamada se a escuta falhar sem stop() (opcional).
+     * @return false se o diretório não puder ser criado ou outro receptor estiver ativo.
+     */
+    bool start(InstanceCallback onStored = InstanceCallback(),
+               ListenFailureCallback onListenFailed = ListenFailureCallback());
+
+    /**
+     * @brief Para de aceitar associações, aguarda as abertas e grava o que estiver na fila.
+     *
+     * Bloqueia até as associações abertas terminarem; uma associação parada
+     * é encerrada pelos tempos máximos de DIMSE e ACSE. Em uma interface
+     * gráfica, chame-a fora da thread da interface (ver StorageReceiver).
+     */
+    void stop();
+
+    /**
+     * @brief true enquanto a porta estiver sendo escutada.
+     */
+    bool isRunning() const { return running.load(); }
+
+    /**
+     * @brief Contadores e taxas desde start().
+     */
+    StorageStats stats() const;
+
+    const StorageServerConfig& config() const { return settings; }
+
+private:
+    friend class StorageWorker;
+
+    /**
+     * @struct PendingInstance
+     * @brief Instância recebida aguardando gravação.
+     */
+    struct PendingInstance {
+        std::unique_ptr<DcmFileFormat> file;
+        ReceivedInstance info;
+        std::promise<bool> stored;                    ///< Resultado da gravação, aguardado pela associação
+    };
+
+    class ListenerPool;
+
+    bool store(std::unique_ptr<DcmFileFormat> file, ReceivedInstance info);
+    void associationStarted();
+    void associationEnded();
+    void writeLoop();
+    bool writeInstance(PendingInstance& pending);
+
+    StorageServerConfig settings;
+    InstanceCallback callback;
+    ListenFailureCallback listenFailed;
+    std::unique_ptr<ListenerPool> listener;
+    std::unique_ptr<BoundedQueue<PendingInstance>> queue;
+    std::thread listenThread;
+    std::vector<std::thread> writers;
+    std::atomic<bool> running{false};
+    std::atomic<bool> stopping{false};
+
+    std::atomic<uint64_t> received{0};
+    std::atomic<uint64_t> written{0};
+    std::atomic<uint64_t> failed{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<std::size_t> activeAssociations{0};
+    std::atomic<std::size_t> peakAssociations{0};
+    std::atomic<std::size_t> totalAssociations{0};
+    std::atomic<int64_t> firstReceivedNs{0};          ///< Instante da primeira instância (0 = nenhuma)
+    std::atomic<int64_t> lastWrittenNs{0};            ///< Instante da última gravação
+};
+
+}
+
+#endif // STORAGESERVER_H
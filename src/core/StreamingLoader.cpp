@@ -0,0 +1,400 @@
+/**
+ * DICOM Viewer - Leitura em Fluxo de Pixel Data Grande
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include <dcmtk/dcmdata/dctk.h>
+
+#include "StreamingLoader.h"
+#include "MappedFile.h"
+#include "Trace.h"
+
+namespace dicom_viewer_core {
+
+namespace {
+
+constexpr uint32_t kUndefinedLength = 0xFFFFFFFFu;
+constexpr int kMaxNesting = 64;                      ///< Profundidade máxima de sequências aninhadas
+
+/**
+ * @brief Forma de codificação dos elementos: VR explícito ou implícito e ordem dos bytes.
+ */
+struct Encoding {
+    bool explicitVr = true;
+    bool bigEndian = false;
+};
+
+/**
+ * @brief Tag, VR e comprimento de um elemento; o valor começa na posição atual do fluxo.
+ */
+struct ElementHeader {
+    uint16_t group = 0;
+    uint16_t element = 0;
+    char vr[2] = {0, 0};
+    uint32_t length = 0;
+};
+
+uint16_t decode16(const uint8_t* bytes, bool bigEndian) {
+    return bigEndian ? static_cast<uint16_t>(bytes[0] << 8 | bytes[1])
+                     : static_cast<uint16_t>(bytes[1] << 8 | bytes[0]);
+}
+
+uint32_t decode32(const uint8_t* bytes, bool bigEndian) {
+    if (bigEndian) {
+        return static_cast<uint32_t>(bytes[0]) << 24 | static_cast<uint32_t>(bytes[1]) << 16 |
+               static_cast<uint32_t>(bytes[2]) << 8 | bytes[3];
+    }
+    return static_cast<uint32_t>(bytes[3]) << 24 | static_cast<uint32_t>(bytes[2]) << 16 |
+           static_cast<uint32_t>(bytes[1]) << 8 | bytes[0];
+}
+
+/**
+ * @brief Indica se o VR usa 2 bytes reservados e comprimento de 4 bytes em Explicit VR.
+ */
+bool hasLongLength(const char* vr) {
+    static const char* const kLongVrs[] = {"OB", "OD", "OF", "OL", "OV", "OW", "SQ",
+                                           "SV", "UC", "UN", "UR", "UT", "UV"};
+    for (const char* candidate : kLongVrs) {
+        if (vr[0] == candidate[0] && vr[1] == candidate[1]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Lê o cabeçalho do próximo elemento (ou item/delimitador).
+ * @return false no fim do arquivo ou em erro de leitura.
+ */
+bool readElementHeader(std::istream& in, const Encoding& encoding, ElementHeader& header) {
+    uint8_t bytes[4];
+    if (!in.read(reinterpret_cast<char*>(bytes), 4)) {
+        return false;
+    }
+    header.group = decode16(bytes, encoding.bigEndian);
+    header.element = decode16(bytes + 2, encoding.bigEndian);
+    header.vr[0] = 0;
+    header.vr[1] = 0;
+    if (!in.read(reinterpret_cast<char*>(bytes), 4)) {
+        return false;
+    }
+    // Itens e delimitadores não têm VR em nenhuma sintaxe
+    if (header.group == 0xFFFE || !encoding.explicitVr) {
+        header.length = decode32(bytes, encoding.bigEndian);
+        return true;
+    }
+    header.vr[0] = static_cast<char>(bytes[0]);
+    header.vr[1] = static_cast<char>(bytes[1]);
+    if (!hasLongLength(header.vr)) {
+        header.length = decode16(bytes + 2, encoding.bigEndian);
+        return true;
+    }
+    if (!in.read(reinterpret_cast<char*>(bytes), 4)) {
+        return false;
+    }
+    header.length = decode32(bytes, encoding.bigEndian);
+    return true;
+}
+
+/**
+ * @brief Pula o conteúdo de um elemento de comprimento indefinido até o seu delimitador.
+ *
+ * Itens terminam em (FFFE,E00D); sequências e Pixel Data encapsulado, em
+ * (FFFE,E0DD). Elementos aninhados de comprimento indefinido são pulados
+ * recursivamente; os demais valores, com seekg.
+ *
+ * @param delimiter Elemento do delimitador esperado (grupo FFFE).
+ */
+bool skipUntilDelimiter(std::istream& in, const Encoding& encoding, uint16_t delimiter, int depth) {
+    if (depth > kMaxNesting) {
+        return false;
+    }
+    ElementHeader header;
+    while (readElementHeader(in, encoding, header)) {
+        if (header.group == 0xFFFE && header.element == delimiter) {
+            return true;
+        }
+        if (header.length != kUndefinedLength) {
+            if (!in.seekg(header.length, std::ios::cur)) {
+                return false;
+            }
+            continue;
+        }
+        const bool item = header.group == 0xFFFE && header.element == 0xE000;
+        // UN de comprimento indefinido é sempre codificado em Implicit VR Little Endian
+        Encoding nested = encoding;
+        if (header.vr[0] == 'U' && header.vr[1] == 'N') {
+            nested = Encoding{false, false};
+        }
+        if (!skipUntilDelimiter(in, nested, item ? 0xE00D : 0xE0DD, depth + 1)) {
+            return false;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Copia uma linha a cada scale colunas, trocando a ordem dos bytes se necessário.
+ */
+void sampleRow(const uint8_t* source, uint8_t* target, int samples, int scale, int bytesPerSample, bool swap) {
+    if (bytesPerSample == 1) {
+        for (int i = 0; i < samples; ++i) {
+            target[i] = source[static_cast<std::size_t>(i) * scale];
+        }
+        return;
+    }
+    for (int i = 0; i < samples; ++i) {
+        const uint8_t* sample = source + static_cast<std::size_t>(i) * scale * 2;
+        target[2 * i] = swap ? sample[1] : sample[0];
+        target[2 * i + 1] = swap ? sample[0] : sample[1];
+    }
+}
+
+/**
+ * @brief Copia amostras de 16 bits Big Endian para a ordem local (Little Endian).
+ */
+void copySwapped16(const uint8_t* source, uint8_t* target, std::size_t bytes) {
+    for (std::size_t i = 0; i + 1 < bytes; i += 2) {
+        target[i] = source[i + 1];
+        target[i + 1] = source[i];
+    }
+}
+
+}
+
+/**
+ * @brief Localiza o Pixel Data de um arquivo DICOM Parte 10 sem carregar o dataset.
+ */
+PixelDataLocation locatePixelData(const std::string& path) {
+    PixelDataLocation location;
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return location;
+    }
+    char preamble[132];
+    if (!in.read(preamble, sizeof(preamble)) || std::memcmp(preamble + 128, "DICM", 4) != 0) {
+        return location;
+    }
+
+    // Meta header: sempre Explicit VR Little Endian
+    const Encoding meta;
+    ElementHeader header;
+    for (;;) {
+        const std::streampos start = in.tellg();
+        if (!readElementHeader(in, meta, header)) {
+            return location;
+        }
+        if (header.group != 0x0002) {
+            in.seekg(start);
+            break;
+        }
+        if (header.length == kUndefinedLength) {
+            return location;
+        }
+        if (header.element == 0x0010) {
+            std::string uid(header.length, '\0');
+            if (!in.read(&uid[0], header.length)) {
+                return location;
+            }
+            while (!uid.empty() && (uid.back() == '\0' || uid.back() == ' ')) {
+                uid.pop_back();
+            }
+            location.transferSyntax = uid;
+        } else if (!in.seekg(header.length, std::ios::cur)) {
+            return location;
+        }
+    }
+
+    // O dataset deflated só pode ser lido depois de descomprimido
+    if (location.transferSyntax == "1.2.840.10008.1.2.1.99") {
+        return PixelDataLocation();
+    }
+    Encoding dataset;
+    dataset.explicitVr = location.transferSyntax != "1.2.840.10008.1.2";
+    dataset.bigEndian = location.transferSyntax == "1.2.840.10008.1.2.2";
+    location.bigEndian = dataset.bigEndian;
+
+    while (readElementHeader(in, dataset, header)) {
+        if (header.group == 0x7FE0 && header.element == 0x0010) {
+            location.offset = static_cast<uint64_t>(static_cast<std::streamoff>(in.tellg()));
+            location.encapsulated = header.length == kUndefinedLength;
+            location.length = location.encapsulated ? 0 : header.length;
+            return location;
+        }
+        if (header.group > 0x7FE0) {
+            break;
+        }
+        if (header.length == kUndefinedLength) {
+            if (!skipUntilDelimiter(in, dataset, 0xE0DD, 1)) {
+                break;
+            }
+        } else if (!in.seekg(header.length, std::ios::cur)) {
+            break;
+        }
+    }
+    return PixelDataLocation();
+}
+
+/**
+ * @brief Carrega o quadro 0 de um arquivo com Pixel Data grande mantendo a memória residente limitada.
+ *
+ * @note Apenas o quadro 0 é lido; em arquivos multi-frame os demais são
+ *       obtidos sob demanda via FrameSource, que também lê só o quadro pedido.
+ */
+MedicalImage loadDicomStreaming(const std::string& path, LoadStats* stats, const LoadProgressCallback& progress,
+                                const PreviewCallback& preview, const StreamingOptions& options) {
+    const PixelDataLocation location = locatePixelData(path);
+    if (!location.isValid() || location.encapsulated || location.length < options.minimumBytes) {
+        return loadDicomRaw(path, true, stats, progress);
+    }
+
+    MedicalImage output;
+    LoadStats localStats;
+    LoadStats& timings = stats ? *stats : localStats;
+    timings = LoadStats();
+    const auto loadStart = std::chrono::steady_clock::now();
+
+    // Reporta o progresso e indica se o carregamento deve continuar
+    auto proceed = [&](int percent) {
+        if (progress && !progress(percent)) {
+            timings.cancelled = true;
+            timings.totalMs = elapsedMs(loadStart);
+            return false;
+        }
+        return true;
+    };
+
+    // Cabeçalho: o DCMTK para antes do Pixel Data, sem ler nenhum pixel
+    auto stageStart = std::chrono::steady_clock::now();
+    DcmFileFormat fileformat;
+    OFCondition status = fileformat.loadFileUntilTag(path.c_str(), EXS_Unknown, EGL_noChange, DCM_MaxReadLength,
+                                                     ERM_fileOnly, DCM_PixelData);
+    if (status.bad()) {
+        std::cerr << "Error: cannot read DICOM header (" << status.text() << ")" << std::endl;
+        timings.totalMs = elapsedMs(loadStart);
+        return output;
+    }
+    DcmDataset* dataset = fileformat.getDataset();
+    Uint16 rows = 0;
+    Uint16 cols = 0;
+    dataset->findAndGetUint16(DCM_Rows, rows);
+    dataset->findAndGetUint16(DCM_Columns, cols);
+    readDicomMetadata(dataset, output);
+    timings.parseMs = elapsedMs(stageStart);
+    DICOM_TRACE_SPAN("read", stageStart, location.offset);
+
+    const bool monochrome = output.photometricInterpretation == "MONOCHROME1" ||
+                            output.photometricInterpretation == "MONOCHROME2";
+    if (rows == 0 || cols == 0 || output.samplesPerPixel != 1 || !monochrome ||
+        (output.bitsAllocated != 8 && output.bitsAllocated != 16)) {
+        // Cores e profundidades incomuns passam pelo DicomImage
+        return loadDicomRaw(path, true, stats, progress);
+    }
+
+    const int bytesPerSample = output.bitsAllocated / 8;
+    const std::size_t rowBytes = static_cast<std::size_t>(cols) * bytesPerSample;
+    const std::size_t frameBytes = rowBytes * rows;
+    if (frameBytes > location.length) {
+        std::cerr << "Error: Pixel Data is shorter than one frame" << std::endl;
+        timings.totalMs = elapsedMs(loadStart);
+        return output;
+    }
+    std::unique_ptr<MappedFile> file = MappedFile::open(path);
+    if (!file || location.offset + frameBytes > file->size()) {
+        std::cerr << "Error: truncated Pixel Data in " << path << std::endl;
+        timings.totalMs = elapsedMs(loadStart);
+        return output;
+    }
+    if (!proceed(5)) {
+        return MedicalImage();
+    }
+    const bool swap = location.bigEndian && bytesPerSample == 2;
+
+    // 1. Prévia: uma linha a cada scale, mapeada sozinha, toca ~1/scale das páginas
+    const int previewSide = std::max(1, options.previewSide);
+    const int scale = (std::max(rows, cols) + previewSide - 1) / previewSide;
+    if (preview && scale > 1) {
+        stageStart = std::chrono::steady_clock::now();
+        MedicalImage reduced = output;
+        reduced.width = (cols + scale - 1) / scale;
+        reduced.height = (rows + scale - 1) / scale;
+        reduced.bitDepth = output.bitsAllocated;
+        reduced.fullPrecision = true;
+        const std::size_t reducedRowBytes = static_cast<std::size_t>(reduced.width) * bytesPerSample;
+        reduced.buffer.allocate(reducedRowBytes * reduced.height);
+        std::memset(reduced.buffer.data(), 0, reduced.buffer.size());
+
+        const int rowsPerUpdate = (reduced.height + std::max(1, options.previewUpdates) - 1) /
+                                  std::max(1, options.previewUpdates);
+        int normalizedRows = 0;
+        for (int row = 0; row < reduced.height; ++row) {
+            const uint64_t rowOffset = location.offset + static_cast<uint64_t>(row) * scale * rowBytes;
+            MappedFile::View view = file->map(rowOffset, rowBytes);
+            if (!view.isValid()) {
+                timings.totalMs = elapsedMs(loadStart);
+                return MedicalImage();
+            }
+            sampleRow(view.data(), reduced.buffer.data() + row * reducedRowBytes, reduced.width, scale,
+                      bytesPerSample, swap);
+            if ((row + 1) % rowsPerUpdate != 0 && row + 1 != reduced.height) {
+                continue;
+            }
+            normalizeStoredValues(reduced.buffer.data() + normalizedRows * reducedRowBytes,
+                                  static_cast<std::size_t>(row + 1 - normalizedRows) * reduced.width,
+                                  output.bitsAllocated, output.bitsStored, output.highBit,
+                                  output.pixelRepresentation);
+            normalizedRows = row + 1;
+            preview(reduced, scale);
+            if (!proceed(5 + 15 * (row + 1) / reduced.height)) {
+                return MedicalImage();
+            }
+        }
+        DICOM_TRACE_SPAN("preview", stageStart, static_cast<std::size_t>(reduced.height) * rowBytes);
+    }
+
+    // 2. Leitura completa, em ordem, uma janela por vez
+    stageStart = std::chrono::steady_clock::now();
+    output.buffer.allocate(frameBytes);
+    const std::size_t rowsPerWindow = std::max<std::size_t>(1, options.windowBytes / rowBytes);
+    for (std::size_t first = 0; first < rows; first += rowsPerWindow) {
+        const std::size_t count = std::min(rowsPerWindow, static_cast<std::size_t>(rows) - first);
+        MappedFile::View view = file->map(location.offset + first * rowBytes, count * rowBytes, true);
+        if (!view.isValid()) {
+            timings.totalMs = elapsedMs(loadStart);
+            return MedicalImage();
+        }
+        uint8_t* target = output.buffer.data() + first * rowBytes;
+        if (swap) {
+            copySwapped16(view.data(), target, view.size());
+        } else {
+            std::memcpy(target, view.data(), view.size());
+        }
+        normalizeStoredValues(target, count * cols, output.bitsAllocated, output.bitsStored, output.highBit,
+                              output.pixelRepresentation);
+        // A janela é desfeita aqui, devolvendo as páginas lidas antes de mapear a próxima
+        view = MappedFile::View();
+        if (!proceed(20 + static_cast<int>(80 * (first + count) / rows))) {
+            return MedicalImage();
+        }
+    }
+    timings.outputMs = elapsedMs(stageStart);
+    DICOM_TRACE_SPAN("stream", stageStart, frameBytes);
+
+    output.width = cols;
+    output.height = rows;
+    output.bitDepth = output.bitsAllocated;
+    output.fullPrecision = true;
+    timings.totalMs = elapsedMs(loadStart);
+    return output;
+}
+
+}
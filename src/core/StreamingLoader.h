@@ -0,0 +1,100 @@
+/**
+ * DICOM Viewer - Leitura em Fluxo de Pixel Data Grande
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "MedicalImage.h"
+
+#ifndef STREAMINGLOADER_H
+#define STREAMINGLOADER_H
+
+namespace dicom_viewer_core {
+
+/**
+ * @struct PixelDataLocation
+ * @brief Posição do valor do Pixel Data (7FE0,0010) de nível superior no arquivo.
+ */
+struct PixelDataLocation {
+    uint64_t offset = 0;                              ///< Primeiro byte do valor no arquivo
+    uint64_t length = 0;                              ///< Comprimento do valor (0 se encapsulado)
+    std::string transferSyntax;                       ///< UID da sintaxe de transferência (meta header)
+    bool bigEndian = false;                           ///< Explicit VR Big Endian
+    bool encapsulated = false;                        ///< Comprimento indefinido (fragmentos comprimidos)
+
+    bool isValid() const { return offset > 0; }
+};
+
+/**
+ * @brief Localiza o Pixel Data de um arquivo DICOM Parte 10 sem carregar o dataset.
+ *
+ * Percorre o meta header e os elementos do dataset lendo apenas tags e
+ * comprimentos; os valores (inclusive sequências de comprimento indefinido)
+ * são pulados. Suporta Implicit e Explicit VR Little Endian, Explicit VR
+ * Big Endian e as sintaxes encapsuladas.
+ *
+ * @param path Caminho do arquivo.
+ * @return A posição, ou uma posição inválida se o arquivo não tiver Pixel Data,
+ *         não for Parte 10 ou usar Deflated Explicit VR Little Endian.
+ */
+PixelDataLocation locatePixelData(const std::string& path);
+
+/**
+ * @struct StreamingOptions
+ * @brief Parâmetros da leitura em fluxo.
+ */
+struct StreamingOptions {
+    uint64_t minimumBytes = uint64_t(64) * 1024 * 1024;  ///< Pixel Data a partir do qual a leitura é feita em fluxo
+    std::size_t windowBytes = std::size_t(32) * 1024 * 1024; ///< Tamanho de cada janela mapeada
+    int previewSide = 1024;                           ///< Maior lado da prévia, em pixels
+    int previewUpdates = 4;                           ///< Quantas vezes a prévia é entregue enquanto é lida
+};
+
+/**
+ * @brief Recebe a prévia reduzida durante a leitura.
+ *
+ * preview está em precisão total, com metadados da imagem completa e
+ * dimensões reduzidas por scale; as linhas ainda não lidas valem zero. O
+ * buffer continua sendo preenchido depois do retorno: a chamada deve
+ * convertê-lo (ou copiá-lo) antes de retornar.
+ */
+using PreviewCallback = std::function<void(const MedicalImage& preview, int scale)>;
+
+/**
+ * @brief Carrega o quadro 0 de um arquivo com Pixel Data grande mantendo a memória residente limitada.
+ *
+ * Para imagens monocromáticas nativas (não comprimidas) de 8 ou 16 bits
+ * cujo Pixel Data tem ao menos options.minimumBytes, o cabeçalho é lido pelo
+ * DCMTK até o Pixel Data e os pixels são lidos por janelas mapeadas em
+ * memória, sem passar pelo dataset:
+ *  1. prévia: uma linha e uma coluna a cada scale são amostradas, tocando
+ *     cerca de 1/scale das páginas, e entregues a preview em etapas;
+ *  2. leitura completa: as linhas são copiadas em ordem, uma janela de
+ *     options.windowBytes por vez, desfeita logo após a cópia.
+ * O pico residente fica no tamanho do quadro de saída mais uma janela,
+ * independentemente do tamanho do arquivo (ex.: multi-frame de vários GB).
+ *
+ * Os demais arquivos (pequenos, comprimidos ou coloridos) seguem loadDicomRaw().
+ *
+ * @param path Caminho do arquivo DICOM.
+ * @param stats Se não nulo, recebe os tempos (parseMs = cabeçalho, outputMs = leitura completa).
+ * @param progress Se definido, é chamado entre as janelas e pode cancelar.
+ * @param preview Se definido, recebe a prévia reduzida.
+ * @param options Limiar, tamanho da janela e da prévia.
+ * @return A imagem em precisão total, ou inválida em caso de erro ou cancelamento.
+ */
+MedicalImage loadDicomStreaming(const std::string& path, LoadStats* stats = nullptr,
+                                const LoadProgressCallback& progress = LoadProgressCallback(),
+                                const PreviewCallback& preview = PreviewCallback(),
+                                const StreamingOptions& options = StreamingOptions());
+
+}
+
+#endif // STREAMINGLOADER_H
@@ -0,0 +1,407 @@
+/**
+ * DICOM Viewer - Catálogo de Estudos
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+#include <dcmtk/dcmdata/dctk.h>
+
+#include "StudyCatalog.h"
+#include "DicomCodecs.h"
+#include "ThreadPool.h"
+
+namespace dicom_viewer_core {
+
+namespace {
+
+/**
+ * @brief Primeira linha do arquivo de catálogo (formato e versão).
+ */
+constexpr const char* kCatalogSignature = "DICOMVIEWER-CATALOG\t1";
+
+/**
+ * @brief Valores maiores que isto não são carregados na leitura do cabeçalho.
+ *
+ * O catálogo só precisa de atributos curtos; blocos grandes (ícones,
+ * dados privados) permanecem no disco.
+ */
+constexpr Uint32 kCatalogValueLength = 256;
+
+/**
+ * @brief Quantidade de arquivos entre duas chamadas de progresso.
+ */
+constexpr std::size_t kProgressInterval = 256;
+
+std::string getString(DcmDataset* dataset, const DcmTagKey& tag) {
+    OFString value;
+    if (dataset->findAndGetOFString(tag, value).good()) {
+        return value.c_str();
+    }
+    return std::string();
+}
+
+/**
+ * @brief Verifica o preâmbulo de 128 bytes seguido de "DICM" (Parte 10).
+ *
+ * Rejeita arquivos que não são DICOM lendo apenas 132 bytes, sem
+ * envolver o parser do DCMTK.
+ */
+bool hasPart10Signature(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char header[132];
+    if (!file.read(header, sizeof(header))) {
+        return false;
+    }
+    return std::memcmp(header + 128, "DICM", 4) == 0;
+}
+
+/**
+ * @brief Lê os atributos do catálogo do cabeçalho de um arquivo, parando antes do Pixel Data.
+ */
+void readCatalogHeader(CatalogEntry& entry) {
+    entry.isDicom = false;
+    if (!hasPart10Signature(entry.path)) {
+        return;
+    }
+    DcmFileFormat fileformat;
+    OFCondition status = fileformat.loadFileUntilTag(entry.path.c_str(), EXS_Unknown, EGL_noChange,
+                                                     kCatalogValueLength, ERM_fileOnly, DCM_PixelData);
+    if (status.bad()) {
+        return;
+    }
+    DcmDataset* dataset = fileformat.getDataset();
+
+    entry.patientID = getString(dataset, DCM_PatientID);
+    entry.patientName = getString(dataset, DCM_PatientName);
+    entry.studyInstanceUID = getString(dataset, DCM_StudyInstanceUID);
+    entry.studyDate = getString(dataset, DCM_StudyDate);
+    entry.studyDescription = getString(dataset, DCM_StudyDescription);
+    entry.seriesInstanceUID = getString(dataset, DCM_SeriesInstanceUID);
+    entry.seriesDescription = getString(dataset, DCM_SeriesDescription);
+    entry.modality = getString(dataset, DCM_Modality);
+    entry.sopInstanceUID = getString(dataset, DCM_SOPInstanceUID);
+
+    Sint32 value32 = 0;
+    if (dataset->findAndGetSint32(DCM_SeriesNumber, value32).good()) entry.seriesNumber = value32;
+    if (dataset->findAndGetSint32(DCM_InstanceNumber, value32).good()) entry.instanceNumber = value32;
+    if (dataset->findAndGetSint32(DCM_NumberOfFrames, value32).good() && value32 > 0) entry.numberOfFrames = value32;
+    Uint16 value16 = 0;
+    if (dataset->findAndGetUint16(DCM_Rows, value16).good()) entry.rows = value16;
+    if (dataset->findAndGetUint16(DCM_Columns, value16).good()) entry.columns = value16;
+
+    entry.isDicom = !entry.sopInstanceUID.empty() || !entry.seriesInstanceUID.empty();
+}
+
+/**
+ * @brief Remove tabulações e quebras de linha, que delimitam campos e registros.
+ */
+std::string sanitize(const std::string& value) {
+    std::string clean = value;
+    std::replace_if(clean.begin(), clean.end(), [](char c) { return c == '\t' || c == '\n' || c == '\r'; }, ' ');
+    return clean;
+}
+
+/**
+ * @brief Raiz absoluta e normalizada, terminada por separador, para comparação de prefixos.
+ */
+std::string normalizedRoot(const std::string& root) {
+    std::error_code error;
+    std::filesystem::path absolute = std::filesystem::absolute(root, error);
+    if (error) {
+        absolute = root;
+    }
+    std::string prefix = absolute.lexically_normal().string();
+    if (!prefix.empty() && prefix.back() != '/' && prefix.back() != std::filesystem::path::preferred_separator) {
+        prefix += static_cast<char>(std::filesystem::path::preferred_separator);
+    }
+    return prefix;
+}
+
+bool isUnder(const std::string& path, const std::string& prefix) {
+    return prefix.empty() || path.compare(0, prefix.size(), prefix) == 0;
+}
+
+}
+
+/**
+ * @brief Carrega um catálogo salvo anteriormente.
+ */
+bool StudyCatalog::load(const std::string& catalogPath) {
+    std::ifstream file(catalogPath);
+    if (!file) {
+        return false;
+    }
+    std::string line;
+    if (!std::getline(file, line) || line != kCatalogSignature) {
+        std::cerr << "Warning: ignoring catalog with unknown format " << catalogPath << std::endl;
+        return false;
+    }
+
+    std::vector<CatalogEntry> loaded;
+    while (std::getline(file, line)) {
+        std::vector<std::string> fields;
+        std::size_t start = 0;
+        while (true) {
+            const std::size_t tab = line.find('\t', start);
+            fields.push_back(line.substr(start, tab == std::string::npos ? std::string::npos : tab - start));
+            if (tab == std::string::npos) {
+                break;
+            }
+            start = tab + 1;
+        }
+        if (fields.size() != 18) {
+            continue;
+        }
+        CatalogEntry entry;
+        try {
+            entry.path = fields[0];
+            entry.fileSize = std::stoull(fields[1]);
+            entry.modifiedTime = std::stoll(fields[2]);
+            entry.isDicom = fields[3] == "1";
+            entry.patientID = fields[4];
+            entry.patientName = fields[5];
+            entry.studyInstanceUID = fields[6];
+            entry.studyDate = fields[7];
+            entry.studyDescription = fields[8];
+            entry.seriesInstanceUID = fields[9];
+            entry.seriesDescription = fields[10];
+            entry.modality = fields[11];
+            entry.sopInstanceUID = fields[12];
+            entry.seriesNumber = std::stoi(fields[13]);
+            entry.instanceNumber = std::stoi(fields[14]);
+            entry.rows = std::stoi(fields[15]);
+            entry.columns = std::stoi(fields[16]);
+            entry.numberOfFrames = std::stoi(fields[17]);
+        } catch (const std::exception&) {
+            continue;
+        }
+        loaded.push_back(std::move(entry));
+    }
+    std::sort(loaded.begin(), loaded.end(), [](const CatalogEntry& a, const CatalogEntry& b) {
+        return a.path < b.path;
+    });
+    catalogEntries = std::move(loaded);
+    return true;
+}
+
+/**
+ * @brief Salva o catálogo (escrita em arquivo temporário seguida de renomeação).
+ */
+bool StudyCatalog::save(const std::string& catalogPath) const {
+    const std::string temporaryPath = catalogPath + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::trunc);
+        if (!file) {
+            std::cerr << "Error: cannot write catalog " << temporaryPath << std::endl;
+            return false;
+        }
+        file << kCatalogSignature << '\n';
+        for (const CatalogEntry& entry : catalogEntries) {
+            file << sanitize(entry.path) << '\t' << entry.fileSize << '\t' << entry.modifiedTime << '\t'
+                 << (entry.isDicom ? 1 : 0) << '\t' << sanitize(entry.patientID) << '\t'
+                 << sanitize(entry.patientName) << '\t' << sanitize(entry.studyInstanceUID) << '\t'
+                 << sanitize(entry.studyDate) << '\t' << sanitize(entry.studyDescription) << '\t'
+                 << sanitize(entry.seriesInstanceUID) << '\t' << sanitize(entry.seriesDescription) << '\t'
+                 << sanitize(entry.modality) << '\t' << sanitize(entry.sopInstanceUID) << '\t'
+                 << entry.seriesNumber << '\t' << entry.instanceNumber << '\t' << entry.rows << '\t'
+                 << entry.columns << '\t' << entry.numberOfFrames << '\n';
+        }
+        if (!file.flush()) {
+            std::cerr << "Error: cannot write catalog " << temporaryPath << std::endl;
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, catalogPath, error);
+    if (error) {
+        std::cerr << "Error: cannot replace catalog " << catalogPath << " (" << error.message() << ")" << std::endl;
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Varre uma árvore de diretórios e atualiza o catálogo.
+ */
+CatalogScanStats StudyCatalog::scan(const std::string& root, const LoadProgressCallback& progress) {
+    CatalogScanStats report;
+    const auto scanStart = std::chrono::steady_clock::now();
+    const std::string prefix = normalizedRoot(root);
+
+    // Listagem: apenas metadados do sistema de arquivos
+    std::vector<CatalogEntry> found;
+    std::error_code error;
+    const auto options = std::filesystem::directory_options::skip_permission_denied;
+    for (std::filesystem::recursive_directory_iterator it(prefix, options, error), end; it != end; it.increment(error)) {
+        if (error) {
+            break;
+        }
+        const std::filesystem::directory_entry& item = *it;
+        if (!item.is_regular_file(error)) {
+            continue;
+        }
+        CatalogEntry entry;
+        entry.path = item.path().lexically_normal().string();
+        entry.fileSize = item.file_size(error);
+        entry.modifiedTime = static_cast<std::int64_t>(item.last_write_time(error).time_since_epoch().count());
+        found.push_back(std::move(entry));
+        if (found.size() % 4096 == 0 && progress && !progress(0)) {
+            report.cancelled = true;
+            return report;
+        }
+    }
+    report.filesFound = found.size();
+    report.walkMs = elapsedMs(scanStart);
+
+    // Reaproveita o que não mudou; o restante é lido de novo
+    std::unordered_map<std::string, std::size_t> known;
+    known.reserve(catalogEntries.size());
+    for (std::size_t i = 0; i < catalogEntries.size(); ++i) {
+        if (isUnder(catalogEntries[i].path, prefix)) {
+            known.emplace(catalogEntries[i].path, i);
+        }
+    }
+    std::vector<std::size_t> changed;
+    for (std::size_t i = 0; i < found.size(); ++i) {
+        auto previous = known.find(found[i].path);
+        if (previous != known.end()) {
+            const CatalogEntry& cached = catalogEntries[previous->second];
+            if (cached.fileSize == found[i].fileSize && cached.modifiedTime == found[i].modifiedTime) {
+                found[i] = cached;
+                known.erase(previous);
+                continue;
+            }
+            known.erase(previous);
+        }
+        changed.push_back(i);
+    }
+    report.filesRemoved = known.size();
+    report.filesRead = changed.size();
+    report.filesReused = found.size() - changed.size();
+
+    // Cabeçalhos em paralelo, apenas dos arquivos novos ou alterados
+    const auto readStart = std::chrono::steady_clock::now();
+    if (!changed.empty()) {
+        ensureCodecsRegistered();
+        std::atomic<std::size_t> done{0};
+        std::atomic<bool> cancelled{false};
+        ThreadPool::shared().parallelFor(0, changed.size(), 16, [&](std::size_t lo, std::size_t hi) {
+            for (std::size_t i = lo; i < hi; ++i) {
+                if (cancelled.load()) {
+                    return;
+                }
+                readCatalogHeader(found[changed[i]]);
+                const std::size_t completed = ++done;
+                if (progress && completed % kProgressInterval == 0 &&
+                    !progress(static_cast<int>(100 * completed / changed.size()))) {
+                    cancelled.store(true);
+                }
+            }
+        });
+        if (cancelled.load()) {
+            report.cancelled = true;
+            return report;
+        }
+    }
+    report.readMs = elapsedMs(readStart);
+
+    // Mescla com as entradas fora da raiz, mantendo a ordem por caminho
+    std::vector<CatalogEntry> merged;
+    merged.reserve(found.size() + catalogEntries.size());
+    for (CatalogEntry& entry : catalogEntries) {
+        if (!isUnder(entry.path, prefix)) {
+            merged.push_back(std::move(entry));
+        }
+    }
+    for (CatalogEntry& entry : found) {
+        if (entry.isDicom) {
+            ++report.dicomFiles;
+        }
+        merged.push_back(std::move(entry));
+    }
+    std::sort(merged.begin(), merged.end(), [](const CatalogEntry& a, const CatalogEntry& b) {
+        return a.path < b.path;
+    });
+    catalogEntries = std::move(merged);
+
+    report.totalMs = elapsedMs(scanStart);
+    report.filesPerSecond = report.totalMs > 0.0 ? report.filesFound * 1000.0 / report.totalMs : 0.0;
+    if (progress) {
+        progress(100);
+    }
+    return report;
+}
+
+/**
+ * @brief Agrupa as entradas DICOM sob root por paciente, estudo e série.
+ */
+std::vector<CatalogPatient> StudyCatalog::patients(const std::string& root) const {
+    const std::string prefix = root.empty() ? std::string() : normalizedRoot(root);
+
+    // Chaves: Patient ID (ou nome) -> Study UID -> Series UID
+    std::map<std::string, std::map<std::string, std::map<std::string, CatalogSeries>>> tree;
+    std::map<std::string, CatalogPatient> patientInfo;
+    std::map<std::string, CatalogStudy> studyInfo;
+    for (std::size_t i = 0; i < catalogEntries.size(); ++i) {
+        const CatalogEntry& entry = catalogEntries[i];
+        if (!entry.isDicom || !isUnder(entry.path, prefix)) {
+            continue;
+        }
+        const std::string patientKey = entry.patientID.empty() ? entry.patientName : entry.patientID;
+        CatalogSeries& series = tree[patientKey][entry.studyInstanceUID][entry.seriesInstanceUID];
+        if (series.instances.empty()) {
+            series.seriesInstanceUID = entry.seriesInstanceUID;
+            series.description = entry.seriesDescription;
+            series.modality = entry.modality;
+            series.seriesNumber = entry.seriesNumber;
+        }
+        series.instances.push_back(i);
+
+        CatalogPatient& patient = patientInfo[patientKey];
+        patient.patientID = entry.patientID;
+        patient.name = entry.patientName;
+        CatalogStudy& study = studyInfo[entry.studyInstanceUID];
+        study.studyInstanceUID = entry.studyInstanceUID;
+        study.date = entry.studyDate;
+        study.description = entry.studyDescription;
+    }
+
+    std::vector<CatalogPatient> result;
+    for (auto& [patientKey, studies] : tree) {
+        CatalogPatient patient = patientInfo[patientKey];
+        for (auto& [studyUID, seriesMap] : studies) {
+            CatalogStudy study = studyInfo[studyUID];
+            for (auto& [seriesUID, series] : seriesMap) {
+                std::stable_sort(series.instances.begin(), series.instances.end(), [this](std::size_t a, std::size_t b) {
+                    return catalogEntries[a].instanceNumber < catalogEntries[b].instanceNumber;
+                });
+                study.series.push_back(std::move(series));
+            }
+            std::stable_sort(study.series.begin(), study.series.end(), [](const CatalogSeries& a, const CatalogSeries& b) {
+                return a.seriesNumber < b.seriesNumber;
+            });
+            patient.studies.push_back(std::move(study));
+        }
+        std::stable_sort(patient.studies.begin(), patient.studies.end(), [](const CatalogStudy& a, const CatalogStudy& b) {
+            return a.date < b.date;
+        });
+        result.push_back(std::move(patient));
+    }
+    return result;
+}
+
+}
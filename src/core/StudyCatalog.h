@@ -0,0 +1,154 @@
+/**
+ * DICOM Viewer - Catálogo de Estudos
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MedicalImage.h"
+
+#ifndef STUDYCATALOG_H
+#define STUDYCATALOG_H
+
+namespace dicom_viewer_core {
+
+/**
+ * @struct CatalogEntry
+ * @brief Um arquivo do catálogo, com os atributos lidos do seu cabeçalho.
+ *
+ * Arquivos que não são DICOM também são registrados (isDicom = false), para
+ * que uma nova varredura não precise abri-los de novo enquanto não mudarem.
+ */
+struct CatalogEntry {
+    std::string path;                                 ///< Caminho absoluto do arquivo
+    std::uint64_t fileSize = 0;                       ///< Tamanho em bytes na última leitura
+    std::int64_t modifiedTime = 0;                    ///< Data de modificação na última leitura
+    bool isDicom = false;                             ///< true se o cabeçalho DICOM pôde ser lido
+    std::string patientID;                            ///< Patient ID
+    std::string patientName;                          ///< Nome do paciente
+    std::string studyInstanceUID;                     ///< Study Instance UID
+    std::string studyDate;                            ///< Data do estudo
+    std::string studyDescription;                     ///< Descrição do estudo
+    std::string seriesInstanceUID;                    ///< Series Instance UID
+    std::string seriesDescription;                    ///< Descrição da série
+    std::string modality;                             ///< Modalidade DICOM
+    std::string sopInstanceUID;                       ///< SOP Instance UID
+    int seriesNumber = 0;                             ///< Series Number
+    int instanceNumber = 0;                           ///< Instance Number
+    int rows = 0;                                     ///< Linhas da imagem
+    int columns = 0;                                  ///< Colunas da imagem
+    int numberOfFrames = 1;                           ///< Número de quadros
+};
+
+/**
+ * @struct CatalogSeries
+ * @brief Série do catálogo: índices das instâncias em StudyCatalog::entries().
+ */
+struct CatalogSeries {
+    std::string seriesInstanceUID;                    ///< Series Instance UID
+    std::string description;                          ///< Descrição da série
+    std::string modality;                             ///< Modalidade DICOM
+    int seriesNumber = 0;                             ///< Series Number
+    std::vector<std::size_t> instances;               ///< Instâncias ordenadas por Instance Number
+};
+
+/**
+ * @struct CatalogStudy
+ * @brief Estudo do catálogo e suas séries.
+ */
+struct CatalogStudy {
+    std::string studyInstanceUID;                     ///< Study Instance UID
+    std::string date;                                 ///< Data do estudo
+    std::string description;                          ///< Descrição do estudo
+    std::vector<CatalogSeries> series;                ///< Séries ordenadas por Series Number
+};
+
+/**
+ * @struct CatalogPatient
+ * @brief Paciente do catálogo e seus estudos.
+ */
+struct CatalogPatient {
+    std::string patientID;                            ///< Patient ID
+    std::string name;                                 ///< Nome do paciente
+    std::vector<CatalogStudy> studies;                ///< Estudos ordenados por data
+};
+
+/**
+ * @struct CatalogScanStats
+ * @brief Estatísticas de uma varredura.
+ */
+struct CatalogScanStats {
+    std::size_t filesFound = 0;                       ///< Arquivos encontrados na árvore
+    std::size_t filesRead = 0;                        ///< Arquivos novos ou alterados, cujo cabeçalho foi lido
+    std::size_t filesReused = 0;                      ///< Arquivos inalterados, reaproveitados do catálogo
+    std::size_t filesRemoved = 0;                     ///< Arquivos que deixaram de existir
+    std::size_t dicomFiles = 0;                       ///< Arquivos DICOM na árvore
+    double walkMs = 0.0;                              ///< Listagem dos diretórios
+    double readMs = 0.0;                              ///< Leitura paralela dos cabeçalhos
+    double totalMs = 0.0;                             ///< Tempo total
+    double filesPerSecond = 0.0;                      ///< Arquivos encontrados por segundo de varredura
+    bool cancelled = false;                           ///< true se a varredura foi cancelada
+};
+
+/**
+ * @class StudyCatalog
+ * @brief Índice persistente de arquivos DICOM agrupado por paciente, estudo e série.
+ *
+ * A varredura lê apenas o cabeçalho de cada arquivo (parando antes do Pixel
+ * Data), em paralelo no pool compartilhado. Arquivos cujo tamanho e data de
+ * modificação não mudaram desde a varredura anterior não são reabertos, de
+ * modo que o custo de uma nova varredura é limitado ao que mudou.
+ */
+class StudyCatalog {
+public:
+    /**
+     * @brief Carrega um catálogo salvo anteriormente.
+     * @param catalogPath Arquivo do catálogo.
+     * @return false se o arquivo não existir ou não for um catálogo válido.
+     */
+    bool load(const std::string& catalogPath);
+
+    /**
+     * @brief Salva o catálogo (escrita em arquivo temporário seguida de renomeação).
+     * @param catalogPath Arquivo do catálogo.
+     * @return false em caso de erro de escrita.
+     */
+    bool save(const std::string& catalogPath) const;
+
+    /**
+     * @brief Varre uma árvore de diretórios e atualiza o catálogo.
+     *
+     * Entradas sob root que não existem mais são removidas; entradas fora de
+     * root não são alteradas.
+     *
+     * @param root Diretório raiz da varredura.
+     * @param progress Se definido, recebe o progresso e pode cancelar. Pode
+     *                 ser chamado a partir de várias threads.
+     * @return Estatísticas da varredura.
+     */
+    CatalogScanStats scan(const std::string& root, const LoadProgressCallback& progress = LoadProgressCallback());
+
+    /**
+     * @brief Entradas do catálogo, ordenadas por caminho.
+     */
+    const std::vector<CatalogEntry>& entries() const { return catalogEntries; }
+
+    /**
+     * @brief Agrupa as entradas DICOM sob root por paciente, estudo e série.
+     * @param root Diretório raiz; vazio para todo o catálogo.
+     */
+    std::vector<CatalogPatient> patients(const std::string& root = std::string()) const;
+
+private:
+    std::vector<CatalogEntry> catalogEntries;
+};
+
+}
+
+#endif // STUDYCATALOG_H
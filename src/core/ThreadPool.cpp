@@ -0,0 +1,246 @@
+/**
+ * DICOM Viewer - Pool de Threads com Roubo de Tarefas
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+
+#include "ThreadPool.h"
+
+namespace dicom_viewer_core {
+
+namespace {
+
+/**
+ * @brief Identifica o pool e a fila da thread atual (nullptr fora de um pool).
+ */
+struct WorkerIdentity {
+    const void* pool = nullptr;
+    std::size_t index = 0;
+};
+
+thread_local WorkerIdentity currentWorker;
+
+}
+
+/**
+ * @brief Cria o pool.
+ * @param threadCount Número de threads; 0 usa o número de núcleos disponíveis.
+ */
+ThreadPool::ThreadPool(unsigned threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (unsigned i = 0; i < threadCount; ++i) {
+        threads.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+/**
+ * @brief Aguarda as tarefas já enfileiradas e encerra as threads.
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+/**
+ * @brief Pool compartilhado pelo processo, com uma thread por núcleo.
+ */
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+/**
+ * @brief Enfileira uma tarefa.
+ *
+ * Tarefas criadas por uma thread do pool vão para a fila dela (localidade);
+ * as demais são distribuídas em rodízio.
+ */
+void ThreadPool::push(std::function<void()> task) {
+    std::size_t index = 0;
+    if (currentWorker.pool == this) {
+        index = currentWorker.index;
+    } else {
+        index = nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+        // Incrementa sob o mutex para que nenhuma thread durma sem ver a tarefa
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        pending.fetch_add(1, std::memory_order_release);
+    }
+    wakeUp.notify_one();
+}
+
+/**
+ * @brief Retira a tarefa mais recente da própria fila.
+ */
+bool ThreadPool::tryPop(std::size_t index, std::function<void()>& task) {
+    WorkQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+/**
+ * @brief Rouba a tarefa mais antiga de outra fila.
+ */
+bool ThreadPool::trySteal(std::size_t thief, std::function<void()>& task) {
+    const std::size_t count = queues.size();
+    for (std::size_t offset = 1; offset <= count; ++offset) {
+        WorkQueue& queue = *queues[(thief + offset) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Executa uma tarefa disponível, se houver.
+ * @return true se alguma tarefa foi executada.
+ */
+bool ThreadPool::tryRunOne(std::size_t preferred) {
+    std::function<void()> task;
+    if (tryPop(preferred, task) || trySteal(preferred, task)) {
+        // Conta como ativa antes de sair de pending, para que waitForIdle() não veja um intervalo vazio
+        active.fetch_add(1, std::memory_order_acq_rel);
+        pending.fetch_sub(1, std::memory_order_acq_rel);
+        task();
+        task = nullptr;
+        if (active.fetch_sub(1, std::memory_order_acq_rel) == 1 && pending.load(std::memory_order_acquire) == 0) {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            idle.notify_all();
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Aguarda até que nenhuma tarefa esteja na fila ou em execução.
+ */
+void ThreadPool::waitForIdle() {
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    idle.wait(lock, [this]() {
+        return pending.load(std::memory_order_acquire) == 0 && active.load(std::memory_order_acquire) == 0;
+    });
+}
+
+/**
+ * @brief Laço principal de cada thread do pool.
+ */
+void ThreadPool::workerLoop(std::size_t index) {
+    currentWorker.pool = this;
+    currentWorker.index = index;
+    for (;;) {
+        if (tryRunOne(index)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this]() { return stopping || pending.load(std::memory_order_acquire) > 0; });
+        if (stopping && pending.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Executa body em paralelo sobre o intervalo [begin, end).
+ */
+void ThreadPool::parallelFor(std::size_t begin, std::size_t end, std::size_t grain,
+                             const std::function<void(std::size_t, std::size_t)>& body) {
+    if (begin >= end) {
+        return;
+    }
+    grain = std::max<std::size_t>(1, grain);
+    const std::size_t blocks = (end - begin + grain - 1) / grain;
+    if (blocks == 1 || threads.empty()) {
+        body(begin, end);
+        return;
+    }
+
+    // Os blocos são reservados por um contador: quem chega primeiro executa o próximo
+    struct Group {
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> remaining;
+        std::mutex mutex;
+        std::condition_variable done;
+        std::exception_ptr error;
+    };
+    auto group = std::make_shared<Group>();
+    group->remaining.store(blocks);
+
+    // Executa blocos do grupo até não restar nenhum para reservar; body só é
+    // acessado depois de uma reserva válida, enquanto o chamador ainda aguarda
+    auto runBlocks = [group, &body, begin, end, grain, blocks]() {
+        for (;;) {
+            const std::size_t block = group->next.fetch_add(1, std::memory_order_relaxed);
+            if (block >= blocks) {
+                return;
+            }
+            const std::size_t lo = begin + block * grain;
+            try {
+                body(lo, std::min(end, lo + grain));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(group->mutex);
+                if (!group->error) {
+                    group->error = std::current_exception();
+                }
+            }
+            if (group->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(group->mutex);
+                group->done.notify_all();
+            }
+        }
+    };
+
+    const std::size_t helpers = std::min<std::size_t>(blocks - 1, threads.size());
+    for (std::size_t i = 0; i < helpers; ++i) {
+        push(runBlocks);
+    }
+    runBlocks();
+
+    // Só threads do pool executam outras tarefas enquanto aguardam (evita
+    // deadlock em chamadas aninhadas); as demais, como a da interface, apenas
+    // esperam os blocos já em execução, sem assumir decodificações alheias
+    const bool isWorker = currentWorker.pool == this;
+    while (group->remaining.load(std::memory_order_acquire) > 0) {
+        if (!isWorker || !tryRunOne(currentWorker.index)) {
+            std::unique_lock<std::mutex> lock(group->mutex);
+            group->done.wait_for(lock, std::chrono::milliseconds(1), [&group]() {
+                return group->remaining.load(std::memory_order_acquire) == 0;
+            });
+        }
+    }
+
+    if (group->error) {
+        std::rethrow_exception(group->error);
+    }
+}
+
+}
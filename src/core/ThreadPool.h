@@ -0,0 +1,139 @@
+/**
+ * DICOM Viewer - Pool de Threads com Roubo de Tarefas
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+namespace dicom_viewer_core {
+
+/**
+ * @class ThreadPool
+ * @brief Pool de threads com uma fila por thread e roubo de tarefas (work-stealing).
+ *
+ * Cada thread consome a sua própria fila pelo final (LIFO) e, quando ela
+ * esvazia, rouba tarefas do início das filas das outras threads (FIFO).
+ * Assim tarefas de duração irregular (ex.: cortes comprimidos de tamanhos
+ * diferentes) não deixam threads ociosas enquanto outras ainda têm trabalho.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Cria o pool.
+     * @param threadCount Número de threads; 0 usa o número de núcleos disponíveis.
+     */
+    explicit ThreadPool(unsigned threadCount = 0);
+
+    /**
+     * @brief Aguarda as tarefas já enfileiradas e encerra as threads.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Número de threads do pool.
+     */
+    unsigned size() const { return static_cast<unsigned>(threads.size()); }
+
+    /**
+     * @brief Enfileira uma tarefa e retorna um future com o seu resultado.
+     * @param task Função sem argumentos a ser executada no pool.
+     */
+    template <typename F>
+    auto submit(F&& task) -> std::future<decltype(task())> {
+        using Result = decltype(task());
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+        push([packaged]() { (*packaged)(); });
+        return future;
+    }
+
+    /**
+     * @brief Executa body em paralelo sobre o intervalo [begin, end).
+     *
+     * O intervalo é dividido em blocos de até grain elementos e cada bloco é
+     * entregue a body(lo, hi). A thread chamadora executa blocos do próprio
+     * intervalo; se for uma thread do pool, também executa outras tarefas
+     * enquanto aguarda, de modo que a função pode ser usada a partir de
+     * tarefas do próprio pool sem risco de deadlock. Uma thread de fora do
+     * pool (ex.: a da interface) nunca executa tarefas de outros chamadores.
+     *
+     * @param begin Início do intervalo.
+     * @param end Fim (exclusivo) do intervalo.
+     * @param grain Tamanho máximo de cada bloco (mínimo 1).
+     * @param body Função chamada com os limites de cada bloco.
+     */
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grain,
+                     const std::function<void(std::size_t, std::size_t)>& body);
+
+    /**
+     * @brief Aguarda até que nenhuma tarefa esteja na fila ou em execução.
+     *
+     * Tarefas enfileiradas por outras tarefas também são aguardadas. Usado no
+     * encerramento, antes de liberar recursos que as tarefas usam (ex.: codecs).
+     */
+    void waitForIdle();
+
+    /**
+     * @brief Grão de parallelFor() para laços por linha de imagem.
+     *
+     * Linhas suficientes para que cada bloco tenha ao menos itemsPerBlock
+     * itens: blocos menores gastam mais com a distribuição do que com o trabalho.
+     *
+     * @param itemsPerRow Itens (pixels, amostras) processados por linha.
+     * @param itemsPerBlock Itens desejados por bloco.
+     * @return Linhas por bloco (mínimo 1).
+     */
+    static std::size_t rowsPerBlock(std::size_t itemsPerRow, std::size_t itemsPerBlock = 16384) {
+        return std::max<std::size_t>(1, itemsPerBlock / std::max<std::size_t>(1, itemsPerRow));
+    }
+
+    /**
+     * @brief Pool compartilhado pelo processo, com uma thread por núcleo.
+     */
+    static ThreadPool& shared();
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void push(std::function<void()> task);
+    bool tryPop(std::size_t index, std::function<void()>& task);
+    bool trySteal(std::size_t thief, std::function<void()>& task);
+    bool tryRunOne(std::size_t preferred);
+    void workerLoop(std::size_t index);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::condition_variable idle;
+    std::atomic<std::size_t> pending{0};
+    std::atomic<std::size_t> active{0};
+    std::atomic<std::size_t> nextQueue{0};
+    bool stopping = false;
+};
+
+}
+
+#endif // THREADPOOL_H
@@ -0,0 +1,182 @@
+/**
+ * DICOM Viewer - Rastreamento de Desempenho
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "Trace.h"
+
+namespace dicom_viewer_core {
+
+namespace {
+
+constexpr std::size_t kRingCapacity = 1 << 16;
+
+/**
+ * @brief Escreve uma string JSON; os nomes são literais do código, mas aspas e barras são escapadas.
+ */
+void writeJsonString(std::ostream& stream, const char* text) {
+    stream << '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            stream << '\\';
+        }
+        stream << *c;
+    }
+    stream << '"';
+}
+
+}
+
+/**
+ * @brief Instância única do processo.
+ */
+Tracer& Tracer::instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::Tracer() : epoch(Clock::now()), ring(kRingCapacity) {}
+
+/**
+ * @brief Identificador compacto da thread chamadora, atribuído no primeiro evento.
+ */
+uint32_t Tracer::threadIndex() {
+    thread_local uint32_t index = threadCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    return index;
+}
+
+void Tracer::push(const TraceEvent& event) {
+    ring[next] = event;
+    next = (next + 1) % ring.size();
+    stored = std::min(stored + 1, ring.size());
+}
+
+/**
+ * @brief Marca o início de um carregamento.
+ */
+void Tracer::beginLoad() {
+    std::lock_guard<std::mutex> lock(mutex);
+    loadSummary.clear();
+}
+
+/**
+ * @brief Estágios registrados desde o último beginLoad().
+ */
+std::vector<TraceStageSummary> Tracer::lastLoad() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return loadSummary;
+}
+
+/**
+ * @brief Registra um span terminado.
+ */
+void Tracer::recordSpan(const char* name, const char* category, Clock::time_point start, Clock::time_point end,
+                        uint64_t bytes) {
+    if (!isEnabled()) {
+        return;
+    }
+    TraceEvent event;
+    event.name = name;
+    event.category = category;
+    event.thread = threadIndex();
+    event.startUs = std::chrono::duration_cast<std::chrono::microseconds>(start - epoch).count();
+    event.durationUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    event.bytes = bytes;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    push(event);
+    // A inicialização do processo não faz parte de nenhum carregamento
+    if (std::strcmp(category, "startup") == 0) {
+        return;
+    }
+    auto found = std::find_if(loadSummary.begin(), loadSummary.end(),
+                              [name](const TraceStageSummary& stage) { return stage.name == name; });
+    if (found == loadSummary.end()) {
+        found = loadSummary.insert(loadSummary.end(), TraceStageSummary{name, 0.0, 0, 0});
+    }
+    found->totalMs += std::chrono::duration<double, std::milli>(end - start).count();
+    found->bytes += bytes;
+    ++found->count;
+}
+
+/**
+ * @brief Registra uma amostra de contador.
+ */
+void Tracer::recordCounter(const char* name, double value) {
+    if (!isEnabled()) {
+        return;
+    }
+    TraceEvent event;
+    event.name = name;
+    event.category = "counter";
+    event.thread = threadIndex();
+    event.startUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - epoch).count();
+    event.value = value;
+    event.counter = true;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    push(event);
+}
+
+/**
+ * @brief Cópia dos eventos do buffer, do mais antigo para o mais recente.
+ */
+std::vector<TraceEvent> Tracer::events() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<TraceEvent> copy;
+    copy.reserve(stored);
+    const std::size_t first = (next + ring.size() - stored) % ring.size();
+    for (std::size_t i = 0; i < stored; ++i) {
+        copy.push_back(ring[(first + i) % ring.size()]);
+    }
+    return copy;
+}
+
+/**
+ * @brief Grava os eventos no formato JSON do Chrome trace-event.
+ */
+bool Tracer::exportChromeTrace(const std::string& path) const {
+    std::ofstream stream(path, std::ios::trunc);
+    if (!stream) {
+        std::cerr << "Error: cannot write trace file " << path << std::endl;
+        return false;
+    }
+    const std::vector<TraceEvent> snapshot = events();
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (std::size_t i = 0; i < snapshot.size(); ++i) {
+        const TraceEvent& event = snapshot[i];
+        stream << "{\"name\":";
+        writeJsonString(stream, event.name);
+        stream << ",\"cat\":";
+        writeJsonString(stream, event.category);
+        stream << ",\"pid\":1,\"tid\":" << event.thread << ",\"ts\":" << event.startUs;
+        if (event.counter) {
+            stream << ",\"ph\":\"C\",\"args\":{\"value\":" << event.value << "}}";
+        } else {
+            stream << ",\"ph\":\"X\",\"dur\":" << event.durationUs << ",\"args\":{\"bytes\":" << event.bytes << "}}";
+        }
+        stream << (i + 1 < snapshot.size() ? ",\n" : "\n");
+    }
+    stream << "]}\n";
+    return static_cast<bool>(stream);
+}
+
+/**
+ * @brief Descarta todos os eventos.
+ */
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    next = 0;
+    stored = 0;
+    loadSummary.clear();
+}
+
+}
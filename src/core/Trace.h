@@ -0,0 +1,196 @@
+/**
+ * DICOM Viewer - Rastreamento de Desempenho
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifndef TRACE_H
+#define TRACE_H
+
+namespace dicom_viewer_core {
+
+/**
+ * @struct TraceEvent
+ * @brief Um intervalo medido (span) ou uma amostra de contador.
+ *
+ * Os nomes devem ser literais de string: apenas o ponteiro é guardado.
+ */
+struct TraceEvent {
+    const char* name = "";                            ///< Nome do estágio ou contador
+    const char* category = "";                        ///< Categoria (ex.: "load", "ui")
+    uint32_t thread = 0;                              ///< Identificador compacto da thread
+    int64_t startUs = 0;                              ///< Início, em microssegundos desde a criação do Tracer
+    int64_t durationUs = 0;                           ///< Duração (spans)
+    uint64_t bytes = 0;                               ///< Bytes movidos pelo estágio (spans)
+    double value = 0.0;                               ///< Valor (contadores)
+    bool counter = false;                             ///< true para amostras de contador
+};
+
+/**
+ * @struct TraceStageSummary
+ * @brief Tempo e bytes acumulados de um estágio desde o início do último carregamento.
+ */
+struct TraceStageSummary {
+    std::string name;                                 ///< Nome do estágio
+    double totalMs = 0.0;                             ///< Soma das durações
+    uint64_t bytes = 0;                               ///< Soma dos bytes movidos
+    int count = 0;                                    ///< Número de ocorrências
+};
+
+/**
+ * @class Tracer
+ * @brief Registro global de spans e contadores, exportável no formato Chrome trace-event.
+ *
+ * Os eventos ficam em um buffer circular de capacidade fixa; os mais antigos
+ * são sobrescritos. Cada span é registrado uma única vez, ao terminar, sob um
+ * mutex: os estágios instrumentados duram de micro a milissegundos, então o
+ * custo por evento (duas leituras de relógio e um lock) é desprezível.
+ * Desligado em tempo de execução, o custo é uma leitura atômica.
+ */
+class Tracer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Instância única do processo.
+     */
+    static Tracer& instance();
+
+    /**
+     * @brief Liga ou desliga o registro em tempo de execução.
+     */
+    void setEnabled(bool on) { enabled.store(on, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Marca o início de um carregamento; lastLoad() passa a somar apenas os spans seguintes.
+     */
+    void beginLoad();
+
+    /**
+     * @brief Estágios registrados desde o último beginLoad(), na ordem da primeira ocorrência.
+     *
+     * Spans da categoria "startup" ficam apenas no buffer de eventos.
+     */
+    std::vector<TraceStageSummary> lastLoad() const;
+
+    /**
+     * @brief Registra um span terminado.
+     */
+    void recordSpan(const char* name, const char* category, Clock::time_point start, Clock::time_point end,
+                    uint64_t bytes);
+
+    /**
+     * @brief Registra uma amostra de contador.
+     */
+    void recordCounter(const char* name, double value);
+
+    /**
+     * @brief Cópia dos eventos do buffer, do mais antigo para o mais recente.
+     */
+    std::vector<TraceEvent> events() const;
+
+    /**
+     * @brief Grava os eventos no formato JSON do Chrome trace-event (chrome://tracing, Perfetto).
+     * @return false se o arquivo não puder ser gravado.
+     */
+    bool exportChromeTrace(const std::string& path) const;
+
+    /**
+     * @brief Descarta todos os eventos.
+     */
+    void clear();
+
+private:
+    Tracer();
+    uint32_t threadIndex();
+    void push(const TraceEvent& event);
+
+    std::atomic<bool> enabled{true};
+    Clock::time_point epoch;
+    mutable std::mutex mutex;
+    std::vector<TraceEvent> ring;
+    std::size_t next = 0;                             ///< Próxima posição de escrita no buffer
+    std::size_t stored = 0;                           ///< Eventos válidos no buffer
+    std::vector<TraceStageSummary> loadSummary;
+    std::atomic<uint32_t> threadCount{0};
+};
+
+/**
+ * @class TraceScope
+ * @brief Mede o tempo de vida do escopo e o registra como um span ao sair.
+ */
+class TraceScope {
+public:
+    explicit TraceScope(const char* name, const char* category = "load")
+        : spanName(name), spanCategory(category), active(Tracer::instance().isEnabled()) {
+        if (active) {
+            start = Tracer::Clock::now();
+        }
+    }
+    ~TraceScope() {
+        if (active) {
+            Tracer::instance().recordSpan(spanName, spanCategory, start, Tracer::Clock::now(), movedBytes);
+        }
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    /**
+     * @brief Acrescenta bytes movidos ao span.
+     */
+    void addBytes(uint64_t bytes) { movedBytes += bytes; }
+
+private:
+    const char* spanName;
+    const char* spanCategory;
+    bool active;
+    Tracer::Clock::time_point start;
+    uint64_t movedBytes = 0;
+};
+
+/**
+ * @class NullTraceScope
+ * @brief Substituto vazio de TraceScope quando o rastreamento é removido da compilação.
+ */
+class NullTraceScope {
+public:
+    explicit NullTraceScope(const char*, const char* = "load") {}
+    void addBytes(uint64_t) {}
+};
+
+}
+
+// Com DICOM_VIEWER_TRACE indefinido, as macros não geram código (nem avaliam os argumentos).
+// DICOM_TRACE_SPAN registra um span iniciado em start, para trechos que já medem o próprio tempo.
+// DICOM_TRACE_STARTUP faz o mesmo na categoria "startup", fora dos somatórios de lastLoad().
+#if defined(DICOM_VIEWER_TRACE)
+#define DICOM_TRACE_SCOPE(var, ...) ::dicom_viewer_core::TraceScope var(__VA_ARGS__)
+#define DICOM_TRACE_BYTES(var, bytes) (var).addBytes(static_cast<uint64_t>(bytes))
+#define DICOM_TRACE_SPAN(name, start, bytes) \
+    ::dicom_viewer_core::Tracer::instance().recordSpan(name, "load", start, std::chrono::steady_clock::now(), \
+                                                       static_cast<uint64_t>(bytes))
+#define DICOM_TRACE_COUNTER(name, value) ::dicom_viewer_core::Tracer::instance().recordCounter(name, static_cast<double>(value))
+#define DICOM_TRACE_BEGIN_LOAD() ::dicom_viewer_core::Tracer::instance().beginLoad()
+#define DICOM_TRACE_STARTUP(name, start) \
+    ::dicom_viewer_core::Tracer::instance().recordSpan(name, "startup", start, std::chrono::steady_clock::now(), 0)
+#else
+#define DICOM_TRACE_SCOPE(var, ...) ::dicom_viewer_core::NullTraceScope var(__VA_ARGS__)
+#define DICOM_TRACE_BYTES(var, bytes) ((void)0)
+#define DICOM_TRACE_SPAN(name, start, bytes) ((void)0)
+#define DICOM_TRACE_COUNTER(name, value) ((void)0)
+#define DICOM_TRACE_BEGIN_LOAD() ((void)0)
+#define DICOM_TRACE_STARTUP(name, start) ((void)0)
+#endif
+
+#endif // TRACE_H
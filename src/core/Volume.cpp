@@ -0,0 +1,436 @@
+/**
+ * DICOM Viewer - Volume 3D de uma Série
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <map>
+
+#include <dcmtk/dcmdata/dctk.h>
+
+#include "Volume.h"
+#include "DicomCodecs.h"
+#include "FrameDecoder.h"
+#include "ProcessMemory.h"
+#include "ThreadPool.h"
+#include "Trace.h"
+
+namespace dicom_viewer_core {
+
+namespace {
+
+/**
+ * @brief Cabeçalho de um corte, lido sem o Pixel Data.
+ */
+struct SliceHeader {
+    std::string path;
+    std::string seriesInstanceUID;
+    int rows = 0;
+    int columns = 0;
+    int bitsAllocated = 0;
+    int bitsStored = 0;
+    int highBit = 0;
+    int pixelRepresentation = 0;
+    int samplesPerPixel = 1;
+    int numberOfFrames = 1;
+    int instanceNumber = 0;
+    bool hasPosition = false;
+    std::array<double, 3> position{{0.0, 0.0, 0.0}};
+    std::array<double, 6> orientation{{1.0, 0.0, 0.0, 0.0, 1.0, 0.0}};
+    double spacingX = 1.0;
+    double spacingY = 1.0;
+    double sliceThickness = 0.0;
+    double rescaleSlope = 1.0;
+    double rescaleIntercept = 0.0;
+    double windowCenter = 0.0;
+    double windowWidth = 0.0;
+    std::string patientName;
+    std::string studyDate;
+    std::string modality;
+    std::string seriesDescription;
+    bool valid = false;
+};
+
+std::string getString(DcmDataset* dataset, const DcmTagKey& tag) {
+    OFString value;
+    if (dataset->findAndGetOFString(tag, value).good()) {
+        return value.c_str();
+    }
+    return std::string();
+}
+
+/**
+ * @brief Lê o cabeçalho de um arquivo, parando antes do Pixel Data.
+ */
+SliceHeader readSliceHeader(const std::string& path) {
+    SliceHeader header;
+    header.path = path;
+
+    DcmFileFormat fileformat;
+    OFCondition status = fileformat.loadFileUntilTag(path.c_str(), EXS_Unknown, EGL_noChange,
+                                                     kLazyValueLength, ERM_fileOnly, DCM_PixelData);
+    if (status.bad()) {
+        return header;
+    }
+    DcmDataset* dataset = fileformat.getDataset();
+
+    Uint16 value16 = 0;
+    if (dataset->findAndGetUint16(DCM_Rows, value16).good()) header.rows = value16;
+    if (dataset->findAndGetUint16(DCM_Columns, value16).good()) header.columns = value16;
+    if (dataset->findAndGetUint16(DCM_BitsAllocated, value16).good()) header.bitsAllocated = value16;
+    header.bitsStored = header.bitsAllocated;
+    if (dataset->findAndGetUint16(DCM_BitsStored, value16).good()) header.bitsStored = value16;
+    header.highBit = header.bitsStored - 1;
+    if (dataset->findAndGetUint16(DCM_HighBit, value16).good()) header.highBit = value16;
+    if (dataset->findAndGetUint16(DCM_PixelRepresentation, value16).good()) header.pixelRepresentation = value16;
+    if (dataset->findAndGetUint16(DCM_SamplesPerPixel, value16).good()) header.samplesPerPixel = value16;
+
+    Sint32 value32 = 0;
+    if (dataset->findAndGetSint32(DCM_NumberOfFrames, value32).good() && value32 > 0) header.numberOfFrames = value32;
+    if (dataset->findAndGetSint32(DCM_InstanceNumber, value32).good()) header.instanceNumber = value32;
+
+    header.hasPosition = true;
+    for (unsigned long i = 0; i < 3; ++i) {
+        Float64 coordinate = 0.0;
+        if (dataset->findAndGetFloat64(DCM_ImagePositionPatient, coordinate, i).bad()) {
+            header.hasPosition = false;
+            break;
+        }
+        header.position[i] = coordinate;
+    }
+    std::array<double, 6> orientation;
+    bool hasOrientation = true;
+    for (unsigned long i = 0; i < 6; ++i) {
+        Float64 component = 0.0;
+        if (dataset->findAndGetFloat64(DCM_ImageOrientationPatient, component, i).bad()) {
+            hasOrientation = false;
+            break;
+        }
+        orientation[i] = component;
+    }
+    if (hasOrientation) {
+        header.orientation = orientation;
+    }
+
+    Float64 valueF = 0.0;
+    // Pixel Spacing é (linha, coluna): o primeiro valor é o espaçamento vertical
+    if (dataset->findAndGetFloat64(DCM_PixelSpacing, valueF, 0).good()) header.spacingY = valueF;
+    if (dataset->findAndGetFloat64(DCM_PixelSpacing, valueF, 1).good()) header.spacingX = valueF;
+    if (dataset->findAndGetFloat64(DCM_SliceThickness, valueF).good()) header.sliceThickness = valueF;
+    if (dataset->findAndGetFloat64(DCM_RescaleSlope, valueF).good()) header.rescaleSlope = valueF;
+    if (dataset->findAndGetFloat64(DCM_RescaleIntercept, valueF).good()) header.rescaleIntercept = valueF;
+    if (dataset->findAndGetFloat64(DCM_WindowCenter, valueF).good()) header.windowCenter = valueF;
+    if (dataset->findAndGetFloat64(DCM_WindowWidth, valueF).good()) header.windowWidth = valueF;
+
+    header.seriesInstanceUID = getString(dataset, DCM_SeriesInstanceUID);
+    header.patientName = getString(dataset, DCM_PatientName);
+    header.studyDate = getString(dataset, DCM_StudyDate);
+    header.modality = getString(dataset, DCM_Modality);
+    header.seriesDescription = getString(dataset, DCM_SeriesDescription);
+
+    header.valid = header.rows > 0 && header.columns > 0 && header.samplesPerPixel == 1 &&
+                   header.numberOfFrames == 1 && (header.bitsAllocated == 8 || header.bitsAllocated == 16);
+    return header;
+}
+
+/**
+ * @brief Normal dos cortes (produto vetorial das direções de linha e coluna).
+ */
+std::array<double, 3> sliceNormal(const std::array<double, 6>& orientation) {
+    return {{orientation[1] * orientation[5] - orientation[2] * orientation[4],
+             orientation[2] * orientation[3] - orientation[0] * orientation[5],
+             orientation[0] * orientation[4] - orientation[1] * orientation[3]}};
+}
+
+/**
+ * @brief Decodifica o quadro 0 de um arquivo diretamente em destination.
+ *
+ * O Pixel Data não é carregado na leitura do arquivo: para dados não
+ * comprimidos os bytes vão do disco direto para destination; para dados
+ * encapsulados o codec descomprime direto em destination.
+ */
+bool decodeSliceInto(const SliceHeader& header, uint8_t* destination, std::size_t sliceBytes) {
+    std::unique_ptr<DcmFileFormat> fileformat = openDicomLazy(header.path);
+    if (!fileformat) {
+        return false;
+    }
+    DcmDataset* dataset = fileformat->getDataset();
+    DcmElement* pixelData = nullptr;
+    if (dataset->findAndGetElement(DCM_PixelData, pixelData).bad() || pixelData == nullptr) {
+        std::cerr << "Error: slice without PixelData " << header.path << std::endl;
+        return false;
+    }
+
+    Uint32 frameSize = 0;
+    if (pixelData->getUncompressedFrameSize(dataset, frameSize).bad() || frameSize < sliceBytes) {
+        std::cerr << "Error: unexpected frame size in " << header.path << std::endl;
+        return false;
+    }
+    uint32_t startFragment = 0;
+    if (!decodeStoredFrame(dataset, 0, destination, sliceBytes, startFragment)) {
+        std::cerr << "Error: cannot decode slice " << header.path << std::endl;
+        return false;
+    }
+    normalizeStoredValues(destination, sliceBytes / (header.bitsAllocated / 8), header.bitsAllocated,
+                          header.bitsStored, header.highBit, header.pixelRepresentation);
+    return true;
+}
+
+/**
+ * @brief Destino dos cortes no buffer contíguo do próprio Volume.
+ *
+ * allocate() recebe o Volume que também guarda o resultado: o buffer é
+ * dimensionado nele e preenchido corte a corte.
+ */
+class ContiguousStore : public SliceStore {
+public:
+    bool allocate(const Volume& header) override {
+        volume.voxels.resize(header.sliceBytes() * static_cast<std::size_t>(header.depth));
+        return true;
+    }
+
+    bool write(int z, const std::function<bool(uint8_t*)>& decode) override {
+        return decode(volume.sliceData(z));
+    }
+
+    Volume volume;
+};
+
+}
+
+/**
+ * @brief Carrega todos os cortes de uma série de um diretório em um Volume.
+ */
+Volume loadDicomSeries(const std::string& directory, SeriesLoadStats* stats,
+                       const LoadProgressCallback& progress) {
+    std::vector<std::string> paths;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (entry.is_regular_file(error)) {
+            paths.push_back(entry.path().string());
+        }
+    }
+    if (paths.empty()) {
+        std::cerr << "Error: no files found in " << directory << std::endl;
+        if (stats) {
+            *stats = SeriesLoadStats();
+        }
+        return Volume();
+    }
+    return loadDicomSeries(paths, stats, progress);
+}
+
+/**
+ * @brief Carrega os cortes de uma série em store, a partir de uma lista de arquivos.
+ */
+bool loadDicomSeriesInto(const std::vector<std::string>& paths, SliceStore& store, Volume& volume,
+                         SeriesLoadStats* stats, const LoadProgressCallback& progress) {
+    volume = Volume();
+    SeriesLoadStats localStats;
+    SeriesLoadStats& report = stats ? *stats : localStats;
+    report = SeriesLoadStats();
+    const auto loadStart = std::chrono::steady_clock::now();
+
+    ensureCodecsRegistered();
+    ThreadPool& pool = ThreadPool::shared();
+
+    report.filesScanned = paths.size();
+    if (paths.empty()) {
+        return false;
+    }
+
+    // Cabeçalhos em paralelo, sem o Pixel Data
+    std::vector<SliceHeader> headers(paths.size());
+    pool.parallelFor(0, paths.size(), 8, [&](std::size_t lo, std::size_t hi) {
+        for (std::size_t i = lo; i < hi; ++i) {
+            headers[i] = readSliceHeader(paths[i]);
+        }
+    });
+
+    // A série mais numerosa com a mesma geometria define o volume
+    std::map<std::string, std::size_t> seriesCount;
+    for (const SliceHeader& header : headers) {
+        if (header.valid) {
+            ++seriesCount[header.seriesInstanceUID];
+        }
+    }
+    if (seriesCount.empty()) {
+        std::cerr << "Error: no single-frame grayscale DICOM slices among " << paths.size() << " files" << std::endl;
+        return false;
+    }
+    const std::string seriesUID = std::max_element(seriesCount.begin(), seriesCount.end(),
+        [](const auto& a, const auto& b) { return a.second < b.second; })->first;
+    std::vector<SliceHeader> slices;
+    for (SliceHeader& header : headers) {
+        if (header.valid && header.seriesInstanceUID == seriesUID) {
+            slices.push_back(std::move(header));
+        }
+    }
+    const SliceHeader reference = slices.front();
+    slices.erase(std::remove_if(slices.begin(), slices.end(), [&reference](const SliceHeader& header) {
+        return header.rows != reference.rows || header.columns != reference.columns ||
+               header.bitsAllocated != reference.bitsAllocated ||
+               header.pixelRepresentation != reference.pixelRepresentation;
+    }), slices.end());
+
+    // Ordena pela posição projetada na normal e, em seguida, pelo Instance Number
+    const std::array<double, 3> normal = sliceNormal(reference.orientation);
+    auto distance = [&normal](const SliceHeader& header) {
+        return header.position[0] * normal[0] + header.position[1] * normal[1] + header.position[2] * normal[2];
+    };
+    std::stable_sort(slices.begin(), slices.end(), [&distance](const SliceHeader& a, const SliceHeader& b) {
+        if (a.hasPosition && b.hasPosition) {
+            const double da = distance(a);
+            const double db = distance(b);
+            if (std::abs(da - db) > 1e-4) {
+                return da < db;
+            }
+        }
+        return a.instanceNumber < b.instanceNumber;
+    });
+    report.headerMs = elapsedMs(loadStart);
+    DICOM_TRACE_SPAN("headers", loadStart, 0);
+    if (progress && !progress(10)) {
+        report.cancelled = true;
+        return false;
+    }
+
+    volume.width = reference.columns;
+    volume.height = reference.rows;
+    volume.depth = static_cast<int>(slices.size());
+    volume.bitsAllocated = reference.bitsAllocated;
+    volume.bitsStored = reference.bitsStored;
+    volume.pixelRepresentation = reference.pixelRepresentation;
+    volume.spacingX = reference.spacingX;
+    volume.spacingY = reference.spacingY;
+    volume.spacingZ = reference.sliceThickness > 0.0 ? reference.sliceThickness : 1.0;
+    volume.rescaleSlope = reference.rescaleSlope;
+    volume.rescaleIntercept = reference.rescaleIntercept;
+    volume.windowCenter = reference.windowCenter;
+    volume.windowWidth = reference.windowWidth;
+    volume.orientation = reference.orientation;
+    volume.patientName = reference.patientName;
+    volume.studyDate = reference.studyDate;
+    volume.modality = reference.modality;
+    volume.seriesDescription = reference.seriesDescription;
+    volume.seriesInstanceUID = seriesUID;
+    for (const SliceHeader& header : slices) {
+        volume.slicePositions.push_back(header.position);
+    }
+
+    // Espaçamento entre cortes pela mediana das distâncias entre posições consecutivas
+    if (slices.size() > 1 && reference.hasPosition) {
+        std::vector<double> gaps;
+        for (std::size_t i = 1; i < slices.size(); ++i) {
+            gaps.push_back(std::abs(distance(slices[i]) - distance(slices[i - 1])));
+        }
+        std::nth_element(gaps.begin(), gaps.begin() + gaps.size() / 2, gaps.end());
+        if (gaps[gaps.size() / 2] > 1e-4) {
+            volume.spacingZ = gaps[gaps.size() / 2];
+        }
+    }
+
+    // Cada corte é decodificado direto no seu lugar no destino
+    const auto decodeStart = std::chrono::steady_clock::now();
+    const std::size_t sliceBytes = volume.sliceBytes();
+    if (!store.allocate(volume)) {
+        return false;
+    }
+    std::atomic<std::size_t> decoded{0};
+    std::atomic<bool> failed{false};
+    std::atomic<bool> cancelled{false};
+    pool.parallelFor(0, slices.size(), 1, [&](std::size_t lo, std::size_t hi) {
+        for (std::size_t z = lo; z < hi; ++z) {
+            if (failed.load() || cancelled.load()) {
+                return;
+            }
+            DICOM_TRACE_SCOPE(traceScope, "slice");
+            DICOM_TRACE_BYTES(traceScope, sliceBytes);
+            const bool written = store.write(static_cast<int>(z), [&](uint8_t* destination) {
+                return decodeSliceInto(slices[z], destination, sliceBytes);
+            });
+            if (!written) {
+                failed.store(true);
+                return;
+            }
+            const std::size_t done = ++decoded;
+            if (progress && !progress(10 + static_cast<int>(90 * done / slices.size()))) {
+                cancelled.store(true);
+            }
+        }
+    });
+    report.decodeMs = elapsedMs(decodeStart);
+    report.totalMs = elapsedMs(loadStart);
+    report.peakResidentBytes = peakResidentBytes();
+
+    if (cancelled.load()) {
+        report.cancelled = true;
+        return false;
+    }
+    if (failed.load()) {
+        return false;
+    }
+    report.slicesLoaded = slices.size();
+    report.voxelBytes = sliceBytes * slices.size();
+    report.slicesPerSecond = report.decodeMs > 0.0 ? slices.size() * 1000.0 / report.decodeMs : 0.0;
+    return true;
+}
+
+/**
+ * @brief Carrega em um Volume os cortes de uma série a partir de uma lista de arquivos.
+ */
+Volume loadDicomSeries(const std::vector<std::string>& paths, SeriesLoadStats* stats,
+                       const LoadProgressCallback& progress) {
+    ContiguousStore store;
+    if (!loadDicomSeriesInto(paths, store, store.volume, stats, progress)) {
+        return Volume();
+    }
+    return std::move(store.volume);
+}
+
+
+/**
+ * @brief Extrai um corte do volume como imagem de precisão total.
+ */
+MedicalImage extractSlice(const Volume& volume, int z) {
+    if (!volume.isValid() || z < 0 || z >= volume.depth) {
+        return MedicalImage();
+    }
+    return sliceImage(volume, volume.sliceData(z));
+}
+
+/**
+ * @brief Monta a imagem de precisão total de um corte a partir dos seus voxels.
+ */
+MedicalImage sliceImage(const Volume& volume, const uint8_t* voxels) {
+    MedicalImage output;
+    output.width = volume.width;
+    output.height = volume.height;
+    output.bitDepth = volume.bitsAllocated;
+    output.spacingX = volume.spacingX;
+    output.spacingY = volume.spacingY;
+    output.bitsAllocated = volume.bitsAllocated;
+    output.bitsStored = volume.bitsStored;
+    output.highBit = volume.bitsStored - 1;
+    output.pixelRepresentation = volume.pixelRepresentation;
+    output.windowCenter = volume.windowCenter;
+    output.windowWidth = volume.windowWidth;
+    output.rescaleSlope = volume.rescaleSlope;
+    output.rescaleIntercept = volume.rescaleIntercept;
+    output.fullPrecision = true;
+    output.patientName = volume.patientName;
+    output.studyDate = volume.studyDate;
+    output.modality = volume.modality;
+    output.buffer.assign(voxels, voxels + volume.sliceBytes());
+    return output;
+}
+
+}
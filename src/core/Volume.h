@@ -0,0 +1,196 @@
+/**
+ * DICOM Viewer - Volume 3D de uma Série
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "MedicalImage.h"
+
+#ifndef VOLUME_H
+#define VOLUME_H
+
+namespace dicom_viewer_core {
+
+/**
+ * @struct Volume
+ * @brief Série de cortes DICOM montada em um único buffer contíguo de voxels.
+ *
+ * Os voxels guardam os valores armazenados (antes do rescale), corte após
+ * corte, na ordem espacial ao longo da normal dos cortes.
+ */
+struct Volume {
+    int width = 0;                                    ///< Colunas de cada corte
+    int height = 0;                                   ///< Linhas de cada corte
+    int depth = 0;                                    ///< Número de cortes
+    int bitsAllocated = 16;                           ///< Bits alocados por voxel (8 ou 16)
+    int bitsStored = 16;                              ///< Bits realmente armazenados
+    int pixelRepresentation = 0;                      ///< 0 = unsigned, 1 = signed
+    double spacingX = 1.0;                            ///< Espaçamento entre colunas (mm)
+    double spacingY = 1.0;                            ///< Espaçamento entre linhas (mm)
+    double spacingZ = 1.0;                            ///< Espaçamento entre cortes (mm)
+    double rescaleSlope = 1.0;                        ///< Rescale Slope
+    double rescaleIntercept = 0.0;                    ///< Rescale Intercept
+    double windowCenter = 0.0;                        ///< Centro do janelamento (Window/Level)
+    double windowWidth = 0.0;                         ///< Largura do janelamento (Window/Level)
+    std::array<double, 6> orientation{{1.0, 0.0, 0.0, 0.0, 1.0, 0.0}}; ///< Image Orientation (Patient)
+    std::vector<std::array<double, 3>> slicePositions; ///< Image Position (Patient) de cada corte
+    std::string patientName;                          ///< Nome do paciente
+    std::string studyDate;                            ///< Data do estudo
+    std::string modality;                             ///< Modalidade DICOM
+    std::string seriesDescription;                    ///< Descrição da série
+    std::string seriesInstanceUID;                    ///< Series Instance UID
+
+    std::vector<uint8_t> voxels;                      ///< Voxels de todos os cortes, contíguos
+
+    /**
+     * @brief Verifica se o volume contém dados válidos.
+     */
+    bool isValid() const { return !voxels.empty() && width > 0 && height > 0 && depth > 0; }
+
+    /**
+     * @brief Bytes ocupados por um voxel.
+     */
+    std::size_t bytesPerVoxel() const { return static_cast<std::size_t>(bitsAllocated / 8); }
+
+    /**
+     * @brief Bytes ocupados por um corte.
+     */
+    std::size_t sliceBytes() const { return static_cast<std::size_t>(width) * height * bytesPerVoxel(); }
+
+    /**
+     * @brief Ponteiro para o início do corte z.
+     */
+    uint8_t* sliceData(int z) { return voxels.data() + sliceBytes() * z; }
+
+    /**
+     * @brief Ponteiro constante para o início do corte z.
+     */
+    const uint8_t* sliceData(int z) const { return voxels.data() + sliceBytes() * z; }
+};
+
+/**
+ * @struct SeriesLoadStats
+ * @brief Estatísticas do carregamento de uma série.
+ */
+struct SeriesLoadStats {
+    std::size_t filesScanned = 0;                     ///< Arquivos examinados no diretório
+    std::size_t slicesLoaded = 0;                     ///< Cortes decodificados no volume
+    double headerMs = 0.0;                            ///< Leitura dos cabeçalhos e ordenação
+    double decodeMs = 0.0;                            ///< Decodificação paralela dos cortes
+    double totalMs = 0.0;                             ///< Tempo total
+    double slicesPerSecond = 0.0;                     ///< Cortes decodificados por segundo
+    std::size_t voxelBytes = 0;                       ///< Tamanho do buffer de voxels
+    std::size_t peakResidentBytes = 0;                ///< Pico de memória residente do processo
+    bool cancelled = false;                           ///< true se o carregamento foi cancelado
+};
+
+/**
+ * @class SliceStore
+ * @brief Destino dos cortes decodificados por loadDicomSeriesInto().
+ *
+ * Permite guardar os voxels fora do buffer contíguo de Volume, por exemplo
+ * em um arquivo de trabalho mapeado (PagedVolume).
+ */
+class SliceStore {
+public:
+    virtual ~SliceStore() = default;
+
+    /**
+     * @brief Prepara o destino do volume descrito; chamada uma vez, antes dos cortes.
+     * @param header Geometria e metadados do volume (sem voxels).
+     * @return false para abortar o carregamento.
+     */
+    virtual bool allocate(const Volume& header) = 0;
+
+    /**
+     * @brief Chama decode com o destino do corte z (sliceBytes() bytes), válido durante a chamada.
+     *
+     * Chamada em paralelo pelas threads do pool, sempre para cortes distintos.
+     *
+     * @return false se o destino não pôde ser obtido ou decode falhou.
+     */
+    virtual bool write(int z, const std::function<bool(uint8_t* destination)>& decode) = 0;
+};
+
+/**
+ * @brief Carrega todos os cortes de uma série de um diretório em um Volume.
+ *
+ * Lê apenas os cabeçalhos (até o Pixel Data) em paralelo, escolhe a série
+ * mais numerosa do diretório, ordena os cortes por Image Position (Patient)
+ * projetada na normal e por Instance Number, e então decodifica os cortes em
+ * paralelo diretamente na posição de cada um no buffer do volume.
+ *
+ * @param directory Diretório contendo os arquivos da série.
+ * @param stats Se não nulo, recebe as estatísticas do carregamento.
+ * @param progress Se definido, recebe o progresso e pode cancelar. Pode ser
+ *                 chamado a partir de várias threads.
+ * @return Volume montado, ou Volume inválido em caso de erro ou cancelamento.
+ */
+Volume loadDicomSeries(const std::string& directory, SeriesLoadStats* stats = nullptr,
+                       const LoadProgressCallback& progress = LoadProgressCallback());
+
+/**
+ * @brief Carrega em um Volume os cortes de uma série a partir de uma lista de arquivos.
+ *
+ * Igual à versão por diretório, mas considera apenas os arquivos informados
+ * (por exemplo, as instâncias de uma série do catálogo de estudos).
+ *
+ * @param paths Arquivos candidatos a cortes.
+ * @param stats Se não nulo, recebe as estatísticas do carregamento.
+ * @param progress Se definido, recebe o progresso e pode cancelar.
+ * @return Volume montado, ou Volume inválido em caso de erro ou cancelamento.
+ */
+Volume loadDicomSeries(const std::vector<std::string>& paths, SeriesLoadStats* stats = nullptr,
+                       const LoadProgressCallback& progress = LoadProgressCallback());
+
+/**
+ * @brief Carrega os cortes de uma série em store, a partir de uma lista de arquivos.
+ *
+ * Mesma seleção, ordenação e decodificação paralela de loadDicomSeries(); os
+ * voxels vão para store em vez do buffer de header.
+ *
+ * @param paths Arquivos candidatos a cortes.
+ * @param store Destino dos cortes.
+ * @param header Recebe a geometria e os metadados do volume (voxels fica vazio).
+ * @param stats Se não nulo, recebe as estatísticas do carregamento.
+ * @param progress Se definido, recebe o progresso e pode cancelar.
+ * @return false em caso de erro ou cancelamento.
+ */
+bool loadDicomSeriesInto(const std::vector<std::string>& paths, SliceStore& store, Volume& header,
+                         SeriesLoadStats* stats = nullptr,
+                         const LoadProgressCallback& progress = LoadProgressCallback());
+
+/**
+ * @brief Extrai um corte do volume como imagem de precisão total.
+ *
+ * O resultado guarda os valores armazenados do corte com o rescale e o
+ * janelamento do volume, pronto para o motor de janelamento.
+ *
+ * @param volume Volume de origem.
+ * @param z Índice do corte.
+ * @return MedicalImage com fullPrecision = true, ou inválida se z estiver fora do volume.
+ */
+MedicalImage extractSlice(const Volume& volume, int z);
+
+/**
+ * @brief Monta a imagem de precisão total de um corte a partir dos seus voxels.
+ *
+ * Usada quando os voxels não estão no buffer do volume (PagedVolume).
+ *
+ * @param volume Geometria, rescale e janelamento do corte.
+ * @param voxels sliceBytes() bytes do corte.
+ * @return MedicalImage com fullPrecision = true.
+ */
+MedicalImage sliceImage(const Volume& volume, const uint8_t* voxels);
+
+}
+
+#endif // VOLUME_H
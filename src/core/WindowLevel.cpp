@@ -0,0 +1,328 @@
+/**
+ * DICOM Viewer - Janelamento (Window/Level)
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DICOM_VIEWER_HAS_SSE2 1
+#endif
+
+#include "WindowLevel.h"
+#include "ThreadPool.h"
+
+namespace dicom_viewer_core {
+
+namespace {
+
+/**
+ * @brief Valor armazenado (com sinal, se for o caso) a partir dos bits crus.
+ */
+inline int32_t storedValue(uint32_t bits, int bitsAllocated, bool isSigned) {
+    if (!isSigned) {
+        return static_cast<int32_t>(bits);
+    }
+    return bitsAllocated == 16 ? static_cast<int32_t>(static_cast<int16_t>(bits))
+                               : static_cast<int32_t>(static_cast<int8_t>(bits));
+}
+
+/**
+ * @brief Nível de cinza pela função afim, com NaN e valores abaixo da janela em 0.
+ */
+inline uint8_t affineGray(float value, float scale, float offset) {
+    const float gray = value * scale + offset;
+    if (!(gray > 0.0f)) {
+        return 0;
+    }
+    return gray >= 255.0f ? 255 : static_cast<uint8_t>(gray + 0.5f);
+}
+
+#if defined(DICOM_VIEWER_HAS_SSE2)
+/**
+ * @brief Converte 8 valores em ponto flutuante para cinza e grava 8 bytes.
+ */
+inline void storeGray8(__m128 fLow, __m128 fHigh, __m128 vScale, __m128 vOffset, uint8_t* destination) {
+    const __m128 vLow = _mm_setzero_ps();
+    const __m128 vHigh = _mm_set1_ps(255.0f);
+    fLow = _mm_add_ps(_mm_mul_ps(fLow, vScale), vOffset);
+    fHigh = _mm_add_ps(_mm_mul_ps(fHigh, vScale), vOffset);
+    // max_ps devolve o segundo operando quando o primeiro é NaN: NaN vira 0
+    fLow = _mm_min_ps(_mm_max_ps(fLow, vLow), vHigh);
+    fHigh = _mm_min_ps(_mm_max_ps(fHigh, vLow), vHigh);
+    const __m128i words = _mm_packs_epi32(_mm_cvtps_epi32(fLow), _mm_cvtps_epi32(fHigh));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(destination), _mm_packus_epi16(words, words));
+}
+
+/**
+ * @brief Janela uma linha de 16 bits com SSE2, 8 pixels por iteração.
+ * @return Número de pixels processados (múltiplo de 8).
+ */
+template <bool Signed>
+int windowRow16Sse2(const uint16_t* source, uint8_t* destination, int width, float scale, float offset) {
+    const __m128 vScale = _mm_set1_ps(scale);
+    const __m128 vOffset = _mm_set1_ps(offset);
+    const __m128i zero = _mm_setzero_si128();
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        const __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x));
+        __m128i low;
+        __m128i high;
+        if constexpr (Signed) {
+            low = _mm_srai_epi32(_mm_unpacklo_epi16(raw, raw), 16);
+            high = _mm_srai_epi32(_mm_unpackhi_epi16(raw, raw), 16);
+        } else {
+            low = _mm_unpacklo_epi16(raw, zero);
+            high = _mm_unpackhi_epi16(raw, zero);
+        }
+        storeGray8(_mm_cvtepi32_ps(low), _mm_cvtepi32_ps(high), vScale, vOffset, destination + x);
+    }
+    return x;
+}
+
+/**
+ * @brief Janela uma linha de 32 bits (int32 ou float) com SSE2, 8 pixels por iteração.
+ * @return Número de pixels processados (múltiplo de 8).
+ */
+template <typename T>
+int windowRow32Sse2(const T* source, uint8_t* destination, int width, float scale, float offset) {
+    const __m128 vScale = _mm_set1_ps(scale);
+    const __m128 vOffset = _mm_set1_ps(offset);
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        __m128 fLow;
+        __m128 fHigh;
+        if constexpr (std::is_floating_point_v<T>) {
+            fLow = _mm_loadu_ps(source + x);
+            fHigh = _mm_loadu_ps(source + x + 4);
+        } else {
+            fLow = _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x)));
+            fHigh = _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x + 4)));
+        }
+        storeGray8(fLow, fHigh, vScale, vOffset, destination + x);
+    }
+    return x;
+}
+#endif
+
+/**
+ * @brief Janela uma linha de amostras do tipo T.
+ *
+ * Tipos de 8 e 16 bits usam a tabela (e SSE2 em 16 bits); int32 e float,
+ * cujo domínio não cabe em uma tabela, usam a função afim equivalente.
+ */
+template <typename T>
+void windowRow(const T* source, uint8_t* destination, int width, const WindowLut& lut) {
+    int x = 0;
+    if constexpr (sizeof(T) <= 2) {
+#if defined(DICOM_VIEWER_HAS_SSE2)
+        if constexpr (sizeof(T) == 2) {
+            x = windowRow16Sse2<std::is_signed_v<T>>(reinterpret_cast<const uint16_t*>(source), destination, width,
+                                                     lut.scale(), lut.offset());
+        }
+#endif
+        const uint8_t* table = lut.data();
+        for (; x < width; ++x) {
+            destination[x] = table[static_cast<std::make_unsigned_t<T>>(source[x])];
+        }
+    } else {
+#if defined(DICOM_VIEWER_HAS_SSE2)
+        x = windowRow32Sse2(source, destination, width, lut.scale(), lut.offset());
+#endif
+        for (; x < width; ++x) {
+            destination[x] = affineGray(static_cast<float>(source[x]), lut.scale(), lut.offset());
+        }
+    }
+}
+
+/**
+ * @brief Janela as linhas [firstRow, lastRow) de uma vista tipada.
+ */
+template <typename T>
+void windowRows(const PixelView<const T>& view, const WindowLut& lut, uint8_t* destination,
+                std::size_t destinationStride, std::size_t firstRow, std::size_t lastRow) {
+    for (std::size_t y = firstRow; y < lastRow; ++y) {
+        windowRow(view.row(static_cast<int>(y)), destination + y * destinationStride, view.width, lut);
+    }
+}
+
+}
+
+/**
+ * @brief Indica se a imagem guarda valores armazenados de precisão total (monocromática).
+ */
+bool isFullPrecision(const MedicalImage& image) {
+    if (!image.fullPrecision || image.samplesPerPixel != 1 || !image.isValid() ||
+        (image.bitsAllocated != 8 && image.bitsAllocated != 16 && image.bitsAllocated != 32)) {
+        return false;
+    }
+    const std::size_t required = static_cast<std::size_t>(image.width) * image.height * image.pixelFormat().bytesPerSample();
+    return image.buffer.size() >= required;
+}
+
+/**
+ * @brief Reconstrói a tabela para a imagem e a janela informadas.
+ */
+void WindowLut::rebuild(const MedicalImage& image, double center, double width) {
+    const PixelType type = image.pixelFormat().type;
+    const double denominator = std::max(width - 1.0, 1e-3);
+
+    // cinza = ((v * slope + intercept) - (c - 0.5)) / (w - 1) + 0.5, escalado para 0..255
+    affineScale = static_cast<float>(image.rescaleSlope * 255.0 / denominator);
+    affineOffset = static_cast<float>((image.rescaleIntercept - center + 0.5) * 255.0 / denominator + 127.5);
+    if (image.photometricInterpretation == "MONOCHROME1") {
+        // MONOCHROME1: o valor mínimo é exibido como branco
+        affineScale = -affineScale;
+        affineOffset = 255.0f - affineOffset;
+    }
+
+    if (pixelTypeSize(type) > 2) {
+        // int32 e float: apenas a função afim
+        table.clear();
+        return;
+    }
+    const int bitsAllocated = static_cast<int>(pixelTypeSize(type)) * 8;
+    const bool isSigned = type == PixelType::Int8 || type == PixelType::Int16;
+    table.resize(std::size_t(1) << bitsAllocated);
+    for (std::size_t bits = 0; bits < table.size(); ++bits) {
+        const double value = storedValue(static_cast<uint32_t>(bits), bitsAllocated, isSigned);
+        const double gray = std::nearbyint(value * affineScale + affineOffset);
+        table[bits] = static_cast<uint8_t>(std::clamp(gray, 0.0, 255.0));
+    }
+}
+
+/**
+ * @brief Aplica o janelamento a uma imagem de precisão total, gerando 8 bits.
+ *
+ * O tipo das amostras é resolvido uma vez; as linhas são distribuídas pelo
+ * pool já com o kernel especializado.
+ */
+void applyWindowLevel(const MedicalImage& image, const WindowLut& lut, uint8_t* destination,
+                      std::size_t destinationStride, ThreadPool& pool) {
+    if (!isFullPrecision(image)) {
+        return;
+    }
+    dispatchPixelType(image.pixelFormat().type, [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        const PixelView<const T> view = image.view<T>();
+        pool.parallelFor(0, static_cast<std::size_t>(image.height), ThreadPool::rowsPerBlock(static_cast<std::size_t>(image.width)),
+                         [&](std::size_t firstRow, std::size_t lastRow) {
+            windowRows(view, lut, destination, destinationStride, firstRow, lastRow);
+        });
+    });
+}
+
+/**
+ * @brief Aplica o janelamento na thread chamadora, sem distribuir as linhas.
+ */
+void applyWindowLevel(const MedicalImage& image, const WindowLut& lut, uint8_t* destination,
+                      std::size_t destinationStride) {
+    if (!isFullPrecision(image)) {
+        return;
+    }
+    dispatchPixelType(image.pixelFormat().type, [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        windowRows(image.view<T>(), lut, destination, destinationStride, 0, static_cast<std::size_t>(image.height));
+    });
+}
+
+namespace {
+
+/**
+ * @brief Menor e maior valor armazenado nas linhas [firstRow, lastRow); NaN é ignorado.
+ */
+template <typename T>
+void storedRange(const PixelView<const T>& view, std::size_t firstRow, std::size_t lastRow,
+                 double& lowest, double& highest) {
+    T low = std::numeric_limits<T>::max();
+    T high = std::numeric_limits<T>::lowest();
+    for (std::size_t y = firstRow; y < lastRow; ++y) {
+        const T* row = view.row(static_cast<int>(y));
+        for (int x = 0; x < view.width; ++x) {
+            const T value = row[x];
+            if constexpr (std::is_floating_point_v<T>) {
+                if (value != value) {
+                    continue;
+                }
+            }
+            low = std::min(low, value);
+            high = std::max(high, value);
+        }
+    }
+    if (low <= high) {
+        lowest = std::min(lowest, static_cast<double>(low));
+        highest = std::max(highest, static_cast<double>(high));
+    }
+}
+
+/**
+ * @brief Converte o intervalo de valores armazenados para unidades de modalidade.
+ */
+void modalityRange(const MedicalImage& image, double lowest, double highest, double& minValue, double& maxValue) {
+    if (lowest > highest) {
+        // Nenhum valor válido (ex.: float todo NaN)
+        lowest = highest = 0.0;
+    }
+    const double a = lowest * image.rescaleSlope + image.rescaleIntercept;
+    const double b = highest * image.rescaleSlope + image.rescaleIntercept;
+    minValue = std::min(a, b);
+    maxValue = std::max(a, b);
+}
+
+}
+
+/**
+ * @brief Calcula os valores mínimo e máximo, em unidades de modalidade, de uma imagem de precisão total.
+ */
+bool computeValueRange(const MedicalImage& image, double& minValue, double& maxValue, ThreadPool& pool) {
+    if (!isFullPrecision(image)) {
+        return false;
+    }
+    double lowest = std::numeric_limits<double>::infinity();
+    double highest = -std::numeric_limits<double>::infinity();
+    std::mutex resultMutex;
+
+    dispatchPixelType(image.pixelFormat().type, [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        const PixelView<const T> view = image.view<T>();
+        pool.parallelFor(0, static_cast<std::size_t>(image.height), ThreadPool::rowsPerBlock(static_cast<std::size_t>(image.width)),
+                         [&](std::size_t firstRow, std::size_t lastRow) {
+            double blockLow = std::numeric_limits<double>::infinity();
+            double blockHigh = -std::numeric_limits<double>::infinity();
+            storedRange(view, firstRow, lastRow, blockLow, blockHigh);
+            std::lock_guard<std::mutex> lock(resultMutex);
+            lowest = std::min(lowest, blockLow);
+            highest = std::max(highest, blockHigh);
+        });
+    });
+
+    modalityRange(image, lowest, highest, minValue, maxValue);
+    return true;
+}
+
+/**
+ * @brief Calcula os valores mínimo e máximo na thread chamadora.
+ */
+bool computeValueRange(const MedicalImage& image, double& minValue, double& maxValue) {
+    if (!isFullPrecision(image)) {
+        return false;
+    }
+    double lowest = std::numeric_limits<double>::infinity();
+    double highest = -std::numeric_limits<double>::infinity();
+    dispatchPixelType(image.pixelFormat().type, [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        storedRange(image.view<T>(), 0, static_cast<std::size_t>(image.height), lowest, highest);
+    });
+    modalityRange(image, lowest, highest, minValue, maxValue);
+    return true;
+}
+
+}
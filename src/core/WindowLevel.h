@@ -0,0 +1,110 @@
+/**
+ * DICOM Viewer - Janelamento (Window/Level)
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MedicalImage.h"
+
+#ifndef WINDOWLEVEL_H
+#define WINDOWLEVEL_H
+
+namespace dicom_viewer_core {
+
+class ThreadPool;
+
+/**
+ * @class WindowLut
+ * @brief Tabela que leva cada valor armazenado diretamente ao nível de cinza de 8 bits.
+ *
+ * A tabela incorpora o rescale (slope/intercept) e a função linear de
+ * janelamento do DICOM (PS3.3 C.11.2.1.2), cobrindo todo o domínio dos
+ * valores armazenados (256 entradas para 8 bits, 65536 para 16 bits).
+ * Imagens MONOCHROME1 são invertidas. Para int32 e float a tabela fica
+ * vazia e os kernels usam a função afim equivalente (scale/offset).
+ */
+class WindowLut {
+public:
+    /**
+     * @brief Reconstrói a tabela para a imagem e a janela informadas.
+     * @param image Imagem com bitsAllocated, pixelRepresentation e rescale.
+     * @param center Centro da janela, em unidades de modalidade (ex.: HU).
+     * @param width Largura da janela, em unidades de modalidade.
+     */
+    void rebuild(const MedicalImage& image, double center, double width);
+
+    /**
+     * @brief Nível de cinza de um valor armazenado (bits crus, sem extensão de sinal).
+     */
+    uint8_t operator[](std::size_t storedBits) const { return table[storedBits]; }
+
+    /**
+     * @brief Ponteiro para as entradas da tabela.
+     */
+    const uint8_t* data() const { return table.data(); }
+
+    /**
+     * @brief Coeficientes da função afim equivalente: cinza = valor * scale + offset.
+     */
+    float scale() const { return affineScale; }
+    float offset() const { return affineOffset; }
+
+private:
+    std::vector<uint8_t> table;
+    float affineScale = 0.0f;
+    float affineOffset = 0.0f;
+};
+
+/**
+ * @brief Aplica o janelamento a uma imagem de precisão total, gerando 8 bits.
+ *
+ * O tipo das amostras é resolvido uma vez por imagem e as linhas, processadas
+ * em paralelo por um kernel especializado: tabela de consulta em 8 bits,
+ * SSE2 em 16 e 32 bits (int32 e float pela função afim).
+ *
+ * @param image Imagem monocromática de precisão total (8, 16 ou 32 bits, inteira ou float).
+ * @param lut Tabela construída para a mesma imagem.
+ * @param destination Buffer de destino (height linhas de pelo menos width bytes).
+ * @param destinationStride Bytes por linha no destino.
+ * @param pool Pool usado para distribuir as linhas.
+ */
+void applyWindowLevel(const MedicalImage& image, const WindowLut& lut, uint8_t* destination,
+                      std::size_t destinationStride, ThreadPool& pool);
+
+/**
+ * @brief Aplica o janelamento na thread chamadora.
+ *
+ * Para quem já paraleliza em outro nível (por exemplo, uma imagem por thread).
+ */
+void applyWindowLevel(const MedicalImage& image, const WindowLut& lut, uint8_t* destination,
+                      std::size_t destinationStride);
+
+/**
+ * @brief Calcula os valores mínimo e máximo, em unidades de modalidade, de uma imagem de precisão total.
+ * @return false se a imagem não for monocromática de precisão total.
+ */
+bool computeValueRange(const MedicalImage& image, double& minValue, double& maxValue, ThreadPool& pool);
+
+/**
+ * @brief Calcula os valores mínimo e máximo na thread chamadora.
+ * @return false se a imagem não for monocromática de precisão total.
+ */
+bool computeValueRange(const MedicalImage& image, double& minValue, double& maxValue);
+
+/**
+ * @brief Indica se a imagem guarda valores armazenados de precisão total (monocromática).
+ *
+ * Vale para qualquer PixelType; consumidores limitados a 8 e 16 bits (ex.:
+ * tabelas de ROI) verificam o tipo por conta própria.
+ */
+bool isFullPrecision(const MedicalImage& image);
+
+}
+
+#endif // WINDOWLEVEL_H
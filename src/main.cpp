@@ -7,15 +7,57 @@
  */
 
 #include "ui/windows/mainwindow.h"
+#include "ui/services/instancechannel.h"
+#include "core/DicomCodecs.h"
+#include "core/ThreadPool.h"
+#include "core/Trace.h"
 
 #include <QApplication>
+#include <QFileInfo>
 #include <QLocale>
+#include <QThreadPool>
 #include <QTranslator>
 
+#include <chrono>
+
+namespace {
+
+/**
+ * @brief Arquivos e diretórios da linha de comando, em caminhos absolutos.
+ *
+ * As opções do próprio Qt (-platform, -style...) já foram retiradas pelo
+ * QApplication; as demais opções são ignoradas.
+ */
+QStringList commandLinePaths(const QStringList &arguments)
+{
+    QStringList paths;
+    for (qsizetype i = 1; i < arguments.size(); ++i) {
+        if (!arguments.at(i).startsWith('-')) {
+            paths.append(QFileInfo(arguments.at(i)).absoluteFilePath());
+        }
+    }
+    return paths;
+}
+
+}
+
 int main(int argc, char *argv[])
 {
+    const auto processStart = std::chrono::steady_clock::now();
+    // Cria o rastreador já na entrada: os spans de inicialização começam no instante zero do trace
+    DICOM_TRACE_STARTUP("main", processStart);
+    auto stageStart = processStart;
+
     QApplication a(argc, argv);
+    DICOM_TRACE_STARTUP("qapplication", stageStart);
+    const QStringList paths = commandLinePaths(QCoreApplication::arguments());
+
+    // Outra instância aberta recebe os caminhos: esta termina antes do tradutor, da janela e do DCMTK
+    if (dicom_viewer_windows::InstanceChannel::sendToRunning(paths)) {
+        return 0;
+    }
 
+    stageStart = std::chrono::steady_clock::now();
     QTranslator translator;
     const QStringList uiLanguages = QLocale::system().uiLanguages();
     for (const QString &locale : uiLanguages) {
@@ -25,7 +67,37 @@ int main(int argc, char *argv[])
             break;
         }
     }
-    MainWindow w;
-    w.show();
-    return a.exec();
+    DICOM_TRACE_STARTUP("translator", stageStart);
+
+    int result = 0;
+    {
+        // A janela (e suas threads de carregamento) é destruída antes de liberar os codecs
+        stageStart = std::chrono::steady_clock::now();
+        MainWindow w;
+        DICOM_TRACE_STARTUP("mainwindow", stageStart);
+
+        // Execuções seguintes entregam seus caminhos a esta janela
+        dicom_viewer_windows::InstanceChannel channel;
+        QObject::connect(&channel, &dicom_viewer_windows::InstanceChannel::pathsReceived, &w,
+                         [&w](const QStringList &received) {
+            w.openPaths(received);
+            w.setWindowState(w.windowState() & ~Qt::WindowMinimized);
+            w.raise();
+            w.activateWindow();
+        });
+        channel.listen();
+
+        stageStart = std::chrono::steady_clock::now();
+        w.show();
+        DICOM_TRACE_STARTUP("show", stageStart);
+        // Codecs e catálogo ficam para depois da primeira imagem
+        w.openAtStartup(paths, processStart);
+        result = a.exec();
+    }
+    // O registro adiado dos codecs pode ainda estar no pool global; leituras
+    // antecipadas de quadros e níveis da pirâmide podem estar dentro de um codec
+    QThreadPool::globalInstance()->waitForDone();
+    dicom_viewer_core::ThreadPool::shared().waitForIdle();
+    dicom_viewer_core::releaseCodecs();
+    return result;
 }
@@ -0,0 +1,496 @@
+/**
+ * DICOM Viewer - Conversão em Lote (linha de comando)
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <dcmtk/dcmdata/dctk.h>
+
+#include "core/BoundedQueue.h"
+#include "core/DicomCodecs.h"
+#include "core/MedicalImage.h"
+#include "core/WindowLevel.h"
+#include "pngwriter.h"
+
+namespace fs = std::filesystem;
+using namespace dicom_viewer_core;
+using dicom_viewer_tools::encodePng;
+
+namespace {
+
+enum class OutputFormat { Png, Raw };
+
+/**
+ * @struct Options
+ * @brief Parâmetros da linha de comando.
+ */
+struct Options {
+    fs::path input;
+    fs::path output;
+    OutputFormat format = OutputFormat::Png;
+    unsigned threads = 0;                             ///< Threads de CPU (0 = todos os núcleos)
+    unsigned ioThreads = 2;                           ///< Threads de leitura e de escrita
+    int level = 6;                                    ///< Nível de compressão do PNG
+};
+
+/**
+ * @struct Job
+ * @brief Um arquivo percorrendo o pipeline leitura -> decodificação -> codificação -> escrita.
+ */
+struct Job {
+    fs::path source;
+    std::string target;                               ///< Caminho de saída, sem a extensão
+    std::uintmax_t inputBytes = 0;
+    std::unique_ptr<DcmFileFormat> file;              ///< Dataset lido (liberado após a decodificação)
+    MedicalImage image;                               ///< Imagem decodificada (valores armazenados)
+    PixelBuffer display;                              ///< Imagem de 8 bits após o janelamento (PNG)
+    int channels = 1;
+    std::vector<uint8_t> encoded;                     ///< PNG, ou JSON com os metadados (raw)
+};
+
+using JobPtr = std::unique_ptr<Job>;
+
+/**
+ * @struct StageTimer
+ * @brief Tempo ocupado acumulado pelas threads de um estágio.
+ */
+struct StageTimer {
+    std::atomic<int64_t> busyNs{0};
+
+    template <typename F>
+    void measure(F&& work) {
+        const auto start = std::chrono::steady_clock::now();
+        work();
+        busyNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now() - start).count(),
+                         std::memory_order_relaxed);
+    }
+    double seconds() const { return busyNs.load() / 1e9; }
+};
+
+/**
+ * @struct Totals
+ * @brief Contadores globais da conversão.
+ */
+struct Totals {
+    std::atomic<std::size_t> converted{0};
+    std::atomic<std::size_t> skipped{0};              ///< Arquivos que não são DICOM Parte 10
+    std::atomic<std::size_t> failed{0};
+    std::atomic<std::uintmax_t> inputBytes{0};
+    std::atomic<std::uintmax_t> outputBytes{0};
+};
+
+void printUsage() {
+    std::cerr << "Usage: dicom-convert <input> <output> [options]\n"
+                 "\n"
+                 "Converts every DICOM file under <input> (file or directory, recursive)\n"
+                 "into <output>, mirroring the directory layout. Multi-frame files export\n"
+                 "their first frame.\n"
+                 "\n"
+                 "Options:\n"
+                 "  --format png|raw   png: 8-bit image after the default window (default)\n"
+                 "                     raw: stored pixel values (.raw) plus a .json sidecar\n"
+                 "  --threads N        CPU worker threads (default: all cores)\n"
+                 "  --io-threads N     reader and writer threads (default: 2)\n"
+                 "  --level N          PNG compression level 0-9 (default: 6)\n";
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (argument == "--format" && hasValue) {
+            const std::string value = argv[++i];
+            if (value == "png") {
+                options.format = OutputFormat::Png;
+            } else if (value == "raw") {
+                options.format = OutputFormat::Raw;
+            } else {
+                std::cerr << "Error: unknown format '" << value << "'" << std::endl;
+                return false;
+            }
+        } else if (argument == "--threads" && hasValue) {
+            options.threads = static_cast<unsigned>(std::max(0, std::atoi(argv[++i])));
+        } else if (argument == "--io-threads" && hasValue) {
+            options.ioThreads = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        } else if (argument == "--level" && hasValue) {
+            options.level = std::clamp(std::atoi(argv[++i]), 0, 9);
+        } else if (argument == "-h" || argument == "--help") {
+            return false;
+        } else if (!argument.empty() && argument[0] == '-') {
+            std::cerr << "Error: unknown option '" << argument << "'" << std::endl;
+            return false;
+        } else {
+            positional.push_back(argument);
+        }
+    }
+    if (positional.size() != 2) {
+        return false;
+    }
+    options.input = positional[0];
+    options.output = positional[1];
+    return true;
+}
+
+/**
+ * @brief Lista os arquivos de entrada em ordem estável.
+ */
+std::vector<fs::path> collectInputs(const fs::path& input) {
+    std::vector<fs::path> files;
+    std::error_code error;
+    if (fs::is_regular_file(input, error)) {
+        files.push_back(input);
+        return files;
+    }
+    fs::recursive_directory_iterator it(input, fs::directory_options::skip_permission_denied, error);
+    if (error) {
+        std::cerr << "Error: cannot open " << input.string() << " (" << error.message() << ")" << std::endl;
+        return files;
+    }
+    for (const fs::recursive_directory_iterator end; it != end; it.increment(error)) {
+        if (error) {
+            break;
+        }
+        if (it->is_regular_file(error)) {
+            files.push_back(it->path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+/**
+ * @brief Caminho de saída (sem extensão) que espelha a posição do arquivo na entrada.
+ *
+ * A extensão é acrescentada, e não substituída: nomes de arquivos DICOM
+ * costumam ser UIDs, cujo último componente seria confundido com extensão.
+ */
+std::string targetPath(const Options& options, const fs::path& source) {
+    std::error_code error;
+    fs::path relative = fs::is_directory(options.input, error) ? source.lexically_relative(options.input)
+                                                                : source.filename();
+    if (relative.empty() || *relative.begin() == "..") {
+        relative = source.filename();
+    }
+    return (options.output / relative).string();
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            std::ostringstream code;
+            code << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
+            escaped += code.str();
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+/**
+ * @brief Metadados necessários para interpretar o arquivo .raw (sem dados do paciente).
+ */
+std::string rawSidecar(const MedicalImage& image, const fs::path& source) {
+    std::ostringstream json;
+    json << std::setprecision(10);
+    json << "{\n"
+         << "  \"source\": \"" << jsonEscape(source.filename().string()) << "\",\n"
+         << "  \"width\": " << image.width << ",\n"
+         << "  \"height\": " << image.height << ",\n"
+         << "  \"samplesPerPixel\": " << image.samplesPerPixel << ",\n"
+         << "  \"bitsAllocated\": " << (image.fullPrecision ? image.bitsAllocated : 8) << ",\n"
+         << "  \"bitsStored\": " << (image.fullPrecision ? image.bitsStored : 8) << ",\n"
+         << "  \"pixelRepresentation\": " << (image.fullPrecision ? image.pixelRepresentation : 0) << ",\n"
+         << "  \"byteOrder\": \"little\",\n"
+         << "  \"storedValues\": " << (image.fullPrecision ? "true" : "false") << ",\n"
+         << "  \"photometricInterpretation\": \"" << jsonEscape(image.photometricInterpretation) << "\",\n"
+         << "  \"rescaleSlope\": " << image.rescaleSlope << ",\n"
+         << "  \"rescaleIntercept\": " << image.rescaleIntercept << ",\n"
+         << "  \"windowCenter\": " << image.windowCenter << ",\n"
+         << "  \"windowWidth\": " << image.windowWidth << ",\n"
+         << "  \"pixelSpacing\": [" << image.spacingY << ", " << image.spacingX << "],\n"
+         << "  \"modality\": \"" << jsonEscape(image.modality) << "\",\n"
+         << "  \"numberOfFrames\": " << image.numberOfFrames << ",\n"
+         << "  \"frame\": 0\n"
+         << "}\n";
+    return json.str();
+}
+
+/**
+ * @brief Leitura: carrega o arquivo inteiro e faz o parsing do dataset.
+ */
+bool readStage(Job& job) {
+    std::error_code error;
+    job.inputBytes = fs::file_size(job.source, error);
+    job.file = std::make_unique<DcmFileFormat>();
+    const OFCondition status = job.file->loadFile(job.source.string().c_str(), EXS_Unknown, EGL_noChange,
+                                                  DCM_MaxReadLength, ERM_fileOnly);
+    if (status.bad()) {
+        std::cerr << "Skipped " << job.source.string() << " (" << status.text() << ")" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Decodificação e janelamento: valores armazenados e, para PNG, a imagem de 8 bits.
+ */
+bool decodeStage(Job& job, OutputFormat format) {
+    job.image = decodeDicomDataset(job.file->getDataset(), true);
+    job.file.reset();
+    if (!job.image.isValid()) {
+        std::cerr << "Failed " << job.source.string() << " (cannot decode pixel data)" << std::endl;
+        return false;
+    }
+    if (format == OutputFormat::Raw) {
+        return true;
+    }
+
+    job.channels = job.image.samplesPerPixel == 3 ? 3 : 1;
+    if (!isFullPrecision(job.image)) {
+        // Imagens coloridas (ou já convertidas pelo DicomImage) chegam em 8 bits
+        job.display = job.image.buffer;
+        return true;
+    }
+
+    double center = job.image.windowCenter;
+    double width = job.image.windowWidth;
+    if (width <= 1.0) {
+        double minValue = 0.0;
+        double maxValue = 0.0;
+        computeValueRange(job.image, minValue, maxValue);
+        center = (minValue + maxValue) / 2.0;
+        width = std::max(1.0, maxValue - minValue + 1.0);
+    }
+    WindowLut lut;
+    lut.rebuild(job.image, center, width);
+    job.display.allocate(static_cast<std::size_t>(job.image.width) * job.image.height);
+    applyWindowLevel(job.image, lut, job.display.data(), static_cast<std::size_t>(job.image.width));
+    job.image.buffer.clear();
+    return true;
+}
+
+/**
+ * @brief Codificação: PNG comprimido ou o JSON que acompanha o arquivo .raw.
+ */
+bool encodeStage(Job& job, const Options& options) {
+    if (options.format == OutputFormat::Raw) {
+        const std::string json = rawSidecar(job.image, job.source);
+        job.encoded.assign(json.begin(), json.end());
+        return true;
+    }
+    const std::size_t stride = static_cast<std::size_t>(job.image.width) * job.channels;
+    const bool encoded = encodePng(job.display.data(), job.image.width, job.image.height, stride, job.channels,
+                                   options.level, job.encoded);
+    job.display.clear();
+    if (!encoded) {
+        std::cerr << "Failed " << job.source.string() << " (PNG encoding)" << std::endl;
+    }
+    return encoded;
+}
+
+bool writeFile(const std::string& path, const uint8_t* data, std::size_t size) {
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    stream.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    return static_cast<bool>(stream);
+}
+
+/**
+ * @brief Escrita: cria os diretórios de saída e grava os arquivos.
+ * @return Bytes gravados, ou 0 em caso de erro.
+ */
+std::uintmax_t writeStage(Job& job, OutputFormat format) {
+    std::error_code error;
+    fs::create_directories(fs::path(job.target).parent_path(), error);
+
+    bool written = false;
+    std::uintmax_t bytes = 0;
+    if (format == OutputFormat::Png) {
+        written = writeFile(job.target + ".png", job.encoded.data(), job.encoded.size());
+        bytes = job.encoded.size();
+    } else {
+        written = writeFile(job.target + ".raw", job.image.buffer.data(), job.image.buffer.size()) &&
+                  writeFile(job.target + ".json", job.encoded.data(), job.encoded.size());
+        bytes = job.image.buffer.size() + job.encoded.size();
+    }
+    if (!written) {
+        std::cerr << "Failed " << job.source.string() << " (cannot write " << job.target << ")" << std::endl;
+        return 0;
+    }
+    return bytes;
+}
+
+/**
+ * @brief Inicia count threads executando body.
+ */
+template <typename F>
+std::vector<std::thread> startThreads(unsigned count, F body) {
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < count; ++i) {
+        threads.emplace_back(body);
+    }
+    return threads;
+}
+
+void joinAll(std::vector<std::thread>& threads) {
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void printStage(const char* name, const StageTimer& timer, unsigned threads, double elapsed) {
+    const double utilization = elapsed > 0.0 ? 100.0 * timer.seconds() / (threads * elapsed) : 0.0;
+    std::cout << "  " << std::left << std::setw(8) << name << std::right << std::setw(3) << threads
+              << " threads  " << std::setw(8) << std::setprecision(2) << timer.seconds() << " s busy  "
+              << std::setw(5) << std::setprecision(0) << utilization << "% utilization\n";
+}
+
+}
+
+/**
+ * @brief Converte arquivos DICOM em lote, sem interface gráfica.
+ *
+ * Cada estágio tem suas próprias threads, ligadas por filas limitadas: a
+ * leitura (E/S) de um arquivo se sobrepõe à decodificação e à codificação
+ * (CPU) dos anteriores, e a memória em uso fica limitada pela capacidade
+ * das filas, independentemente do tamanho do lote.
+ */
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    const std::vector<fs::path> inputs = collectInputs(options.input);
+    if (inputs.empty()) {
+        std::cerr << "Error: no input files found in " << options.input.string() << std::endl;
+        return 1;
+    }
+
+    // Decodificação e codificação dividem os núcleos; no formato raw a codificação é trivial
+    const unsigned cores = options.threads > 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    const unsigned encodeThreads = options.format == OutputFormat::Raw ? 1 : std::max(1u, cores / 2);
+    const unsigned decodeThreads = options.format == OutputFormat::Raw ? cores : std::max(1u, cores - encodeThreads);
+    const unsigned ioThreads = options.ioThreads;
+
+    ensureCodecsRegistered();
+
+    BoundedQueue<JobPtr> decodeQueue(2 * decodeThreads);
+    BoundedQueue<JobPtr> encodeQueue(2 * encodeThreads);
+    BoundedQueue<JobPtr> writeQueue(2 * ioThreads);
+    StageTimer readTimer;
+    StageTimer decodeTimer;
+    StageTimer encodeTimer;
+    StageTimer writeTimer;
+    Totals totals;
+    std::atomic<std::size_t> nextInput{0};
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> readers = startThreads(ioThreads, [&]() {
+        for (std::size_t index = nextInput++; index < inputs.size(); index = nextInput++) {
+            JobPtr job = std::make_unique<Job>();
+            job->source = inputs[index];
+            job->target = targetPath(options, job->source);
+            bool ok = false;
+            readTimer.measure([&]() { ok = readStage(*job); });
+            if (!ok) {
+                ++totals.skipped;
+                continue;
+            }
+            totals.inputBytes += job->inputBytes;
+            decodeQueue.push(std::move(job));
+        }
+    });
+    std::vector<std::thread> decoders = startThreads(decodeThreads, [&]() {
+        JobPtr job;
+        while (decodeQueue.pop(job)) {
+            bool ok = false;
+            decodeTimer.measure([&]() { ok = decodeStage(*job, options.format); });
+            if (!ok) {
+                ++totals.failed;
+                continue;
+            }
+            encodeQueue.push(std::move(job));
+        }
+    });
+    std::vector<std::thread> encoders = startThreads(encodeThreads, [&]() {
+        JobPtr job;
+        while (encodeQueue.pop(job)) {
+            bool ok = false;
+            encodeTimer.measure([&]() { ok = encodeStage(*job, options); });
+            if (!ok) {
+                ++totals.failed;
+                continue;
+            }
+            writeQueue.push(std::move(job));
+        }
+    });
+    std::vector<std::thread> writers = startThreads(ioThreads, [&]() {
+        JobPtr job;
+        while (writeQueue.pop(job)) {
+            std::uintmax_t bytes = 0;
+            writeTimer.measure([&]() { bytes = writeStage(*job, options.format); });
+            if (bytes == 0) {
+                ++totals.failed;
+                continue;
+            }
+            totals.outputBytes += bytes;
+            ++totals.converted;
+        }
+    });
+
+    // Cada fila é fechada quando o estágio que a alimenta termina
+    joinAll(readers);
+    decodeQueue.close();
+    joinAll(decoders);
+    encodeQueue.close();
+    joinAll(encoders);
+    writeQueue.close();
+    joinAll(writers);
+
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double inputMb = totals.inputBytes.load() / (1024.0 * 1024.0);
+    const double outputMb = totals.outputBytes.load() / (1024.0 * 1024.0);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Converted " << totals.converted.load() << " of " << inputs.size() << " files ("
+              << totals.skipped.load() << " skipped, " << totals.failed.load() << " failed) in " << elapsed << " s\n";
+    std::cout << "  input   " << inputMb << " MB, output " << outputMb << " MB\n";
+    if (elapsed > 0.0) {
+        std::cout << "  throughput " << totals.converted.load() / elapsed << " files/s, "
+                  << inputMb / elapsed << " MB/s\n";
+    }
+    printStage("read", readTimer, ioThreads, elapsed);
+    printStage("decode", decodeTimer, decodeThreads, elapsed);
+    printStage("encode", encodeTimer, encodeThreads, elapsed);
+    printStage("write", writeTimer, ioThreads, elapsed);
+
+    releaseCodecs();
+    return totals.failed.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+/**
+ * DICOM Viewer - Codificador PNG
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <cstring>
+#include <iostream>
+
+#include <zlib.h>
+
+#include "pngwriter.h"
+
+namespace dicom_viewer_tools {
+
+namespace {
+
+void appendUint32(std::vector<uint8_t>& output, uint32_t value) {
+    output.push_back(static_cast<uint8_t>(value >> 24));
+    output.push_back(static_cast<uint8_t>(value >> 16));
+    output.push_back(static_cast<uint8_t>(value >> 8));
+    output.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * @brief Acrescenta um chunk (tamanho, tipo, dados, CRC) ao arquivo.
+ */
+void appendChunk(std::vector<uint8_t>& output, const char type[4], const uint8_t* data, std::size_t size) {
+    appendUint32(output, static_cast<uint32_t>(size));
+    const std::size_t typeOffset = output.size();
+    output.insert(output.end(), type, type + 4);
+    if (size > 0) {
+        output.insert(output.end(), data, data + size);
+    }
+    const uLong crc = crc32(0L, output.data() + typeOffset, static_cast<uInt>(4 + size));
+    appendUint32(output, static_cast<uint32_t>(crc));
+}
+
+}
+
+/**
+ * @brief Codifica uma imagem de 8 bits por amostra como PNG, em memória.
+ */
+bool encodePng(const uint8_t* pixels, int width, int height, std::size_t stride, int channels, int level,
+               std::vector<uint8_t>& output) {
+    if (!pixels || width <= 0 || height <= 0 || (channels != 1 && channels != 3)) {
+        return false;
+    }
+
+    // Linhas filtradas: um byte de tipo de filtro seguido das diferenças para o pixel à esquerda
+    const std::size_t rowBytes = static_cast<std::size_t>(width) * channels;
+    std::vector<uint8_t> filtered((rowBytes + 1) * height);
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* row = pixels + static_cast<std::size_t>(y) * stride;
+        uint8_t* out = filtered.data() + static_cast<std::size_t>(y) * (rowBytes + 1);
+        out[0] = 1;
+        std::memcpy(out + 1, row, static_cast<std::size_t>(channels));
+        for (std::size_t i = channels; i < rowBytes; ++i) {
+            out[i + 1] = static_cast<uint8_t>(row[i] - row[i - channels]);
+        }
+    }
+
+    uLongf compressedSize = compressBound(static_cast<uLong>(filtered.size()));
+    std::vector<uint8_t> compressed(compressedSize);
+    const int status = compress2(compressed.data(), &compressedSize, filtered.data(),
+                                 static_cast<uLong>(filtered.size()), level);
+    if (status != Z_OK) {
+        std::cerr << "Error: PNG compression failed (zlib " << status << ")" << std::endl;
+        return false;
+    }
+
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    output.clear();
+    output.reserve(compressedSize + 64);
+    output.insert(output.end(), signature, signature + 8);
+
+    std::vector<uint8_t> header;
+    appendUint32(header, static_cast<uint32_t>(width));
+    appendUint32(header, static_cast<uint32_t>(height));
+    header.push_back(8);                              // bits por amostra
+    header.push_back(channels == 3 ? 2 : 0);          // RGB ou tons de cinza
+    header.push_back(0);                              // compressão deflate
+    header.push_back(0);                              // filtragem adaptativa
+    header.push_back(0);                              // sem entrelaçamento
+    appendChunk(output, "IHDR", header.data(), header.size());
+    appendChunk(output, "IDAT", compressed.data(), compressedSize);
+    appendChunk(output, "IEND", nullptr, 0);
+    return true;
+}
+
+}
@@ -0,0 +1,38 @@
+/**
+ * DICOM Viewer - Codificador PNG
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifndef PNGWRITER_H
+#define PNGWRITER_H
+
+namespace dicom_viewer_tools {
+
+/**
+ * @brief Codifica uma imagem de 8 bits por amostra como PNG, em memória.
+ *
+ * Cada linha usa o filtro Sub, que favorece a compressão das regiões suaves
+ * comuns em imagens médicas a um custo baixo de CPU.
+ *
+ * @param pixels Primeira linha da imagem.
+ * @param width Largura em pixels.
+ * @param height Altura em pixels.
+ * @param stride Bytes por linha da origem.
+ * @param channels 1 (tons de cinza) ou 3 (RGB).
+ * @param level Nível de compressão do zlib (0 a 9).
+ * @param output Recebe o arquivo PNG completo.
+ * @return false se os parâmetros forem inválidos ou a compressão falhar.
+ */
+bool encodePng(const uint8_t* pixels, int width, int height, std::size_t stride, int channels, int level,
+               std::vector<uint8_t>& output);
+
+}
+
+#endif // PNGWRITER_H
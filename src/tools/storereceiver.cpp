@@ -0,0 +1,123 @@
+/**
+ * DICOM Viewer - Receptor C-STORE (linha de comando)
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/StorageServer.h"
+
+using namespace dicom_viewer_core;
+
+namespace {
+
+std::atomic<bool> interrupted{false};
+
+void onSignal(int) {
+    interrupted = true;
+}
+
+void printUsage() {
+    std::cerr << "Usage: dicom-receive <output> [options]\n"
+                 "\n"
+                 "Receives DICOM instances over C-STORE and writes them under\n"
+                 "<output>/<StudyInstanceUID>/<SeriesInstanceUID>/. Prints throughput\n"
+                 "every second; Ctrl+C stops after the open associations finish.\n"
+                 "\n"
+                 "Options:\n"
+                 "  --port N           TCP port (default: 11112)\n"
+                 "  --aet TITLE        AE title (default: DICOMVIEWER)\n"
+                 "  --associations N   concurrent associations (default: 8)\n"
+                 "  --queue N          received instances waiting to be written (default: 64)\n"
+                 "  --writers N        writer threads (default: 2)\n";
+}
+
+bool parseOptions(int argc, char* argv[], StorageServerConfig& config) {
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (argument == "--port" && hasValue) {
+            config.port = static_cast<uint16_t>(std::clamp(std::atoi(argv[++i]), 1, 65535));
+        } else if (argument == "--aet" && hasValue) {
+            config.aeTitle = argv[++i];
+        } else if (argument == "--associations" && hasValue) {
+            config.maxAssociations = static_cast<std::size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (argument == "--queue" && hasValue) {
+            config.queueCapacity = static_cast<std::size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (argument == "--writers" && hasValue) {
+            config.writerThreads = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        } else if (argument == "-h" || argument == "--help") {
+            return false;
+        } else if (!argument.empty() && argument[0] == '-') {
+            std::cerr << "Error: unknown option '" << argument << "'" << std::endl;
+            return false;
+        } else {
+            positional.push_back(argument);
+        }
+    }
+    if (positional.size() != 1) {
+        return false;
+    }
+    config.storageDirectory = positional[0];
+    return true;
+}
+
+void printStats(const StorageStats& stats) {
+    std::cout << std::fixed << std::setprecision(1)
+              << stats.instancesWritten << " instances, "
+              << stats.bytesWritten / (1024.0 * 1024.0) << " MB, "
+              << stats.instancesPerSecond << " inst/s, "
+              << stats.megabytesPerSecond << " MB/s, "
+              << stats.activeAssociations << " active associations (peak " << stats.peakAssociations << ", total "
+              << stats.totalAssociations << "), " << stats.instancesFailed << " failed" << std::endl;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    StorageServerConfig config;
+    if (!parseOptions(argc, argv, config)) {
+        printUsage();
+        return 2;
+    }
+
+    StorageServer server(config);
+    // A porta é aberta na thread de escuta: uma falha ali encerra o laço abaixo com erro
+    std::atomic<bool> listenFailed{false};
+    if (!server.start(InstanceCallback(), [&listenFailed](const std::string&) { listenFailed = true; })) {
+        return 1;
+    }
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    std::cout << "Listening as " << config.aeTitle << " on port " << config.port << ", writing to "
+              << config.storageDirectory << std::endl;
+
+    uint64_t reported = 0;
+    while (!interrupted.load() && server.isRunning()) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        const StorageStats stats = server.stats();
+        // Silencioso enquanto nada chega
+        if (stats.instancesWritten != reported || stats.activeAssociations > 0) {
+            reported = stats.instancesWritten;
+            printStats(stats);
+        }
+    }
+
+    server.stop();
+    std::cout << "Total: ";
+    printStats(server.stats());
+    return listenFailed.load() ? 1 : 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * DICOM Viewer - Varredura de Diretórios em Segundo Plano
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+/**
+ * @file catalogscanner.cpp
+ * @brief Implementação da classe CatalogScanner.
+ */
+
+#include <QDir>
+#include <QFileInfo>
+
+#include "catalogscanner.h"
+
+namespace dicom_viewer_windows {
+
+/**
+ * @brief Construtor do serviço.
+ * @param catalogPath Arquivo onde o catálogo é persistido.
+ * @param parent Objeto pai (opcional).
+ */
+CatalogScanner::CatalogScanner(const QString &catalogPath, QObject *parent)
+    : QObject(parent)
+    , catalogPath(catalogPath)
+{
+    qRegisterMetaType<dicom_viewer_windows::ScannedCatalog>();
+    // Uma única thread coordena; a leitura dos cabeçalhos usa o pool do núcleo
+    pool.setMaxThreadCount(1);
+}
+
+/**
+ * @brief Destrutor. Cancela a varredura em andamento e aguarda a thread.
+ */
+CatalogScanner::~CatalogScanner()
+{
+    ++latestRequest;
+    pool.clear();
+    pool.waitForDone();
+}
+
+/**
+ * @brief Inicia a varredura de um diretório, cancelando a anterior.
+ *
+ * @param root Diretório raiz.
+ * @return Identificador da requisição.
+ */
+quint64 CatalogScanner::scan(const QString &root)
+{
+    const quint64 requestId = ++latestRequest;
+    pool.clear();
+
+    pool.start([this, requestId, root]() {
+        if (!isCurrent(requestId)) {
+            return;
+        }
+        loadCatalog();
+
+        auto progress = [this, requestId](int percent) {
+            if (!isCurrent(requestId)) {
+                return false;
+            }
+            emit progressChanged(requestId, percent);
+            return true;
+        };
+
+        ScannedCatalog result;
+        result.root = root;
+        result.stats = catalog.scan(root.toStdString(), progress);
+        if (result.stats.cancelled) {
+            return;
+        }
+        QDir().mkpath(QFileInfo(catalogPath).absolutePath());
+        catalog.save(catalogPath.toStdString());
+
+        result.patients = catalog.patients(root.toStdString());
+        result.catalog = std::make_shared<dicom_viewer_core::StudyCatalog>(catalog);
+        if (isCurrent(requestId)) {
+            emit scanned(requestId, result);
+        }
+    });
+    return requestId;
+}
+
+/**
+ * @brief Lê o catálogo persistido em segundo plano, antes da primeira varredura.
+ */
+void CatalogScanner::preload()
+{
+    pool.start([this]() {
+        loadCatalog();
+    });
+}
+
+/**
+ * @brief Lê o catálogo persistido na primeira chamada. Executado na thread do pool.
+ */
+void CatalogScanner::loadCatalog()
+{
+    if (!catalogLoaded) {
+        catalog.load(catalogPath.toStdString());
+        catalogLoaded = true;
+    }
+}
+
+}
@@ -0,0 +1,104 @@
+/**
+ * DICOM Viewer - Varredura de Diretórios em Segundo Plano
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+#ifndef CATALOGSCANNER_H
+#define CATALOGSCANNER_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+
+#include "../../core/StudyCatalog.h"
+
+namespace dicom_viewer_windows {
+
+/**
+ * @struct ScannedCatalog
+ * @brief Resultado de uma varredura, pronto para montar a árvore de estudos.
+ */
+struct ScannedCatalog {
+    QString root;                                                    ///< Diretório varrido
+    std::shared_ptr<const dicom_viewer_core::StudyCatalog> catalog;  ///< Cópia do catálogo após a varredura
+    std::vector<dicom_viewer_core::CatalogPatient> patients;         ///< Pacientes, estudos e séries sob root
+    dicom_viewer_core::CatalogScanStats stats;                       ///< Estatísticas da varredura
+};
+
+/**
+ * @class CatalogScanner
+ * @brief Mantém o catálogo de estudos persistente e o atualiza fora da thread da interface.
+ *
+ * O catálogo é lido do disco na primeira varredura e salvo ao fim de cada
+ * uma. Uma nova varredura cancela a anterior.
+ */
+class CatalogScanner : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Construtor do serviço.
+     * @param catalogPath Arquivo onde o catálogo é persistido.
+     * @param parent Objeto pai (opcional).
+     */
+    explicit CatalogScanner(const QString &catalogPath, QObject *parent = nullptr);
+
+    /**
+     * @brief Destrutor. Cancela a varredura em andamento e aguarda a thread.
+     */
+    ~CatalogScanner();
+
+    /**
+     * @brief Inicia a varredura de um diretório, cancelando a anterior.
+     * @param root Diretório raiz.
+     * @return Identificador da requisição.
+     */
+    quint64 scan(const QString &root);
+
+    /**
+     * @brief Lê o catálogo persistido em segundo plano, antes da primeira varredura.
+     *
+     * Sem efeito se o catálogo já tiver sido lido; uma varredura iniciada
+     * antes da leitura o lê por conta própria.
+     */
+    void preload();
+
+    /**
+     * @brief Identificador da requisição mais recente.
+     */
+    quint64 currentRequest() const { return latestRequest.load(); }
+
+signals:
+    /**
+     * @brief Emitido durante a leitura dos cabeçalhos.
+     */
+    void progressChanged(quint64 requestId, int percent);
+
+    /**
+     * @brief Emitido quando a varredura termina.
+     */
+    void scanned(quint64 requestId, const dicom_viewer_windows::ScannedCatalog &result);
+
+private:
+    bool isCurrent(quint64 requestId) const { return latestRequest.load() == requestId; }
+    void loadCatalog();
+
+    QString catalogPath;
+    dicom_viewer_core::StudyCatalog catalog;  ///< Acessado apenas pela thread do pool
+    bool catalogLoaded = false;
+    QThreadPool pool;
+    std::atomic<quint64> latestRequest{0};
+};
+
+}
+
+Q_DECLARE_METATYPE(dicom_viewer_windows::ScannedCatalog)
+
+#endif // CATALOGSCANNER_H
@@ -0,0 +1,211 @@
+/**
+ * DICOM Viewer - Reprodução Cine de Quadros
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+/**
+ * @file cineplayer.cpp
+ * @brief Implementação da classe CinePlayer.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <QCoreApplication>
+#include <QPointer>
+#include <QThreadPool>
+
+#include "cineplayer.h"
+#include "../windows/utils.h"
+#include "../../core/ThreadPool.h"
+
+namespace dicom_viewer_windows {
+
+namespace {
+
+/**
+ * @brief Quantidade de quadros decodificados antecipadamente.
+ */
+int readAheadFrames() {
+    return std::max(4, static_cast<int>(dicom_viewer_core::ThreadPool::shared().size()) * 2);
+}
+
+}
+
+/**
+ * @brief Construtor do reprodutor.
+ * @param parent Objeto pai (opcional).
+ */
+CinePlayer::CinePlayer(QObject *parent)
+    : QObject(parent)
+{
+    timer.setTimerType(Qt::PreciseTimer);
+    connect(&timer, &QTimer::timeout, this, &CinePlayer::tick);
+}
+
+/**
+ * @brief Define a fonte de quadros e volta ao primeiro quadro.
+ */
+void CinePlayer::setSource(std::shared_ptr<dicom_viewer_core::FrameSource> source)
+{
+    pause();
+    frames = std::move(source);
+    current = 0;
+    pendingSeek = -1;
+    dropped = 0;
+    presented = 0;
+    if (frames && frames->metadata().frameTimeMs > 0.0) {
+        setTargetFps(1000.0 / frames->metadata().frameTimeMs);
+    }
+    if (frames) {
+        frames->prefetch(0, readAheadFrames());
+    }
+}
+
+/**
+ * @brief Define a taxa alvo de reprodução, em quadros por segundo.
+ */
+void CinePlayer::setTargetFps(double targetFps)
+{
+    fps = std::clamp(targetFps, 1.0, 120.0);
+    if (isPlaying()) {
+        // Reinicia o relógio para que a mudança de taxa não salte quadros
+        pause();
+        play();
+    }
+}
+
+/**
+ * @brief Inicia a reprodução a partir do quadro atual.
+ */
+void CinePlayer::play()
+{
+    if (!frames || frames->frameCount() < 2) {
+        return;
+    }
+    startFrame = current;
+    pendingSeek = -1;
+    lastTarget = 0;
+    dropped = 0;
+    presented = 0;
+    frames->prefetch(current + 1, readAheadFrames());
+    clock.start();
+    // O relógio é amostrado duas vezes por quadro para reduzir o atraso de apresentação
+    timer.start(std::max(1, static_cast<int>(500.0 / fps)));
+}
+
+/**
+ * @brief Pausa a reprodução.
+ */
+void CinePlayer::pause()
+{
+    timer.stop();
+}
+
+/**
+ * @brief Exibe um quadro específico, decodificando-o fora da thread da interface se necessário.
+ *
+ * Um quadro ainda não decodificado é exibido quando a decodificação termina;
+ * durante o arraste do controle de quadros apenas uma decodificação fica em
+ * andamento e, ao final, o último quadro pedido é o exibido.
+ */
+void CinePlayer::seek(int index)
+{
+    if (!frames || index < 0 || index >= frames->frameCount()) {
+        return;
+    }
+    frames->prefetch(index + 1, readAheadFrames());
+    std::shared_ptr<const dicom_viewer_core::MedicalImage> image = frames->cachedFrame(index);
+    if (isPlaying()) {
+        // A reprodução recomeça do quadro pedido; os seguintes vêm do relógio
+        pause();
+        current = index;
+        play();
+        present(index, image);
+        return;
+    }
+    if (image) {
+        pendingSeek = -1;
+        present(index, image);
+        return;
+    }
+    pendingSeek = index;
+    if (seekDecoding) {
+        return;
+    }
+    seekDecoding = true;
+    QPointer<CinePlayer> guard(this);
+    std::shared_ptr<dicom_viewer_core::FrameSource> source = frames;
+    QThreadPool::globalInstance()->start([guard, source, index]() {
+        std::shared_ptr<const dicom_viewer_core::MedicalImage> decoded = source->frame(index);
+        QMetaObject::invokeMethod(qApp, [guard, source, index, decoded]() {
+            if (guard) {
+                guard->finishSeek(source, index, decoded);
+            }
+        }, Qt::QueuedConnection);
+    });
+}
+
+/**
+ * @brief Exibe o quadro decodificado por seek(), ou passa ao último quadro pedido.
+ */
+void CinePlayer::finishSeek(const std::shared_ptr<dicom_viewer_core::FrameSource> &source, int index,
+                            const std::shared_ptr<const dicom_viewer_core::MedicalImage> &image)
+{
+    seekDecoding = false;
+    const int wanted = pendingSeek;
+    pendingSeek = -1;
+    if (source == frames && wanted == index && !isPlaying()) {
+        present(index, image);
+    } else if (wanted >= 0) {
+        seek(wanted);
+    }
+}
+
+/**
+ * @brief Avança o relógio de apresentação e exibe o quadro correspondente, se pronto.
+ */
+void CinePlayer::tick()
+{
+    const qint64 target = static_cast<qint64>(std::floor(clock.elapsed() * fps / 1000.0));
+    if (target <= lastTarget) {
+        return;
+    }
+    const int total = frames->frameCount();
+    const int index = static_cast<int>((startFrame + target) % total);
+
+    // Quadros cujo instante passou sem que fossem exibidos
+    dropped += static_cast<int>(target - lastTarget - 1);
+    lastTarget = target;
+
+    std::shared_ptr<const dicom_viewer_core::MedicalImage> image = frames->cachedFrame(index);
+    if (image) {
+        present(index, image);
+    } else {
+        ++dropped;
+    }
+    frames->prefetch(index + 1, readAheadFrames());
+    emit statsChanged(presented, dropped);
+}
+
+/**
+ * @brief Converte e entrega um quadro para exibição.
+ */
+void CinePlayer::present(int index, const std::shared_ptr<const dicom_viewer_core::MedicalImage> &image)
+{
+    if (!image) {
+        return;
+    }
+    QImage displayImage = convertMedicalImage(*image);
+    if (displayImage.isNull()) {
+        return;
+    }
+    current = index;
+    ++presented;
+    emit frameReady(index, displayImage);
+}
+
+}
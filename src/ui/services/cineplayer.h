@@ -0,0 +1,133 @@
+/**
+ * DICOM Viewer - Reprodução Cine de Quadros
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+#ifndef CINEPLAYER_H
+#define CINEPLAYER_H
+
+#include <memory>
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QImage>
+
+#include "../../core/FrameSource.h"
+
+namespace dicom_viewer_windows {
+
+/**
+ * @class CinePlayer
+ * @brief Reproduz os quadros de uma FrameSource a uma taxa alvo.
+ *
+ * O quadro exibido é determinado pelo relógio de apresentação: a cada tique
+ * calcula-se qual quadro deveria estar na tela. Se ele ainda não foi
+ * decodificado, o quadro atual permanece e o quadro é contado como
+ * descartado. A decodificação dos próximos quadros é feita antecipadamente
+ * no pool de threads.
+ */
+class CinePlayer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Construtor do reprodutor.
+     * @param parent Objeto pai (opcional).
+     */
+    explicit CinePlayer(QObject *parent = nullptr);
+
+    /**
+     * @brief Define a fonte de quadros e volta ao primeiro quadro.
+     */
+    void setSource(std::shared_ptr<dicom_viewer_core::FrameSource> source);
+
+    /**
+     * @brief Fonte de quadros atual.
+     */
+    std::shared_ptr<dicom_viewer_core::FrameSource> source() const { return frames; }
+
+    /**
+     * @brief Define a taxa alvo de reprodução, em quadros por segundo.
+     */
+    void setTargetFps(double fps);
+
+    /**
+     * @brief Taxa alvo de reprodução, em quadros por segundo.
+     */
+    double targetFps() const { return fps; }
+
+    /**
+     * @brief Indica se a reprodução está em andamento.
+     */
+    bool isPlaying() const { return timer.isActive(); }
+
+    /**
+     * @brief Quadros descartados desde o início da reprodução.
+     */
+    int droppedFrames() const { return dropped; }
+
+    /**
+     * @brief Quadros exibidos desde o início da reprodução.
+     */
+    int presentedFrames() const { return presented; }
+
+    /**
+     * @brief Índice do quadro exibido.
+     */
+    int currentFrame() const { return current; }
+
+public slots:
+    /**
+     * @brief Inicia a reprodução a partir do quadro atual.
+     */
+    void play();
+
+    /**
+     * @brief Pausa a reprodução.
+     */
+    void pause();
+
+    /**
+     * @brief Exibe um quadro específico; se ainda não decodificado, ao fim da decodificação.
+     */
+    void seek(int index);
+
+signals:
+    /**
+     * @brief Emitido quando um novo quadro deve ser exibido.
+     */
+    void frameReady(int index, const QImage &image);
+
+    /**
+     * @brief Emitido após cada tique com os contadores atualizados.
+     */
+    void statsChanged(int presented, int dropped);
+
+private slots:
+    void tick();
+
+private:
+    void present(int index, const std::shared_ptr<const dicom_viewer_core::MedicalImage> &image);
+    void finishSeek(const std::shared_ptr<dicom_viewer_core::FrameSource> &source, int index,
+                    const std::shared_ptr<const dicom_viewer_core::MedicalImage> &image);
+
+    std::shared_ptr<dicom_viewer_core::FrameSource> frames;
+    QTimer timer;
+    QElapsedTimer clock;
+    double fps = 30.0;
+    int startFrame = 0;
+    int current = 0;
+    int pendingSeek = -1;                             ///< Último quadro pedido a seek() ainda não exibido
+    bool seekDecoding = false;                        ///< Decodificação de seek() em andamento
+    qint64 lastTarget = 0;
+    int dropped = 0;
+    int presented = 0;
+};
+
+}
+
+#endif // CINEPLAYER_H
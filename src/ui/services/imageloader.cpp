@@ -0,0 +1,569 @@
+/**
+ * DICOM Viewer - Carregamento assíncrono de imagens
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+/**
+ * @file imageloader.cpp
+ * @brief Implementação da classe ImageLoader.
+ */
+
+#include <algorithm>
+#include <chrono>
+
+#include <QDir>
+#include <QFileInfo>
+
+#include "imageloader.h"
+#include "../windows/utils.h"
+#include "../../core/FrameDecoder.h"
+#include "../../core/ProcessMemory.h"
+#include "../../core/Trace.h"
+#include "../../core/WindowLevel.h"
+
+namespace dicom_viewer_windows {
+
+namespace {
+
+/**
+ * @brief Destino dos cortes de uma série: o Volume contíguo ou, acima do limite, um PagedVolume.
+ *
+ * O tamanho só é conhecido depois da leitura dos cabeçalhos, em allocate().
+ * volume recebe também o cabeçalho devolvido por loadDicomSeriesInto().
+ */
+class SeriesStore : public dicom_viewer_core::SliceStore {
+public:
+    SeriesStore(std::size_t limit, const dicom_viewer_core::PagedVolumeConfig &settings)
+        : inMemoryLimit(limit), config(settings) {}
+
+    bool allocate(const dicom_viewer_core::Volume &header) override
+    {
+        const std::size_t bytes = header.sliceBytes() * static_cast<std::size_t>(header.depth);
+        if (bytes <= this->inMemoryLimit) {
+            this->volume.voxels.resize(bytes);
+            return true;
+        }
+        this->paged = dicom_viewer_core::PagedVolume::create(header, this->config);
+        return this->paged != nullptr;
+    }
+
+    bool write(int z, const std::function<bool(uint8_t *)> &decode) override
+    {
+        return this->paged ? this->paged->write(z, decode) : decode(this->volume.sliceData(z));
+    }
+
+    dicom_viewer_core::Volume volume;
+    std::shared_ptr<dicom_viewer_core::PagedVolume> paged;
+
+private:
+    std::size_t inMemoryLimit;
+    dicom_viewer_core::PagedVolumeConfig config;
+};
+
+}
+
+/**
+ * @brief Construtor do serviço de carregamento.
+ * @param parent Objeto pai (opcional).
+ */
+ImageLoader::ImageLoader(QObject *parent)
+    : QObject(parent)
+    , cache(kDefaultCacheBudget)
+{
+    qRegisterMetaType<dicom_viewer_windows::LoadedImage>();
+    qRegisterMetaType<dicom_viewer_windows::LoadedSeries>();
+    // Uma requisição ativa e uma sendo cancelada; o restante aguarda na fila
+    pool.setMaxThreadCount(2);
+    prefetchPool.setMaxThreadCount(2);
+}
+
+/**
+ * @brief Destrutor. Cancela as requisições pendentes e aguarda as threads.
+ */
+ImageLoader::~ImageLoader()
+{
+    cancel();
+    pool.clear();
+    prefetchPool.clear();
+    pool.waitForDone();
+    prefetchPool.waitForDone();
+}
+
+/**
+ * @brief Inicia o carregamento de um arquivo, cancelando o anterior.
+ *
+ * O trabalho pesado (leitura, descompressão, conversão para QImage e
+ * formatação dos metadados) é executado no pool de threads. A thread da
+ * interface apenas desenha a QImage entregue, que compartilha os pixels.
+ * Se o arquivo já estiver no cache (inclusive por pré-busca), nada é
+ * decodificado; se estiver sendo pré-carregado, a requisição aguarda a
+ * pré-busca em vez de repetir o trabalho.
+ *
+ * @param path Caminho do arquivo DICOM.
+ * @param neighbors Arquivos na ordem de navegação; se vazio, os do diretório de path.
+ * @return Identificador da requisição.
+ */
+quint64 ImageLoader::load(const QString &path, const QStringList &neighbors)
+{
+    const quint64 requestId = ++latestRequest;
+    // Requisições ainda não iniciadas são descartadas imediatamente, inclusive as pré-buscas
+    pool.clear();
+    prefetchPool.clear();
+    DICOM_TRACE_BEGIN_LOAD();
+
+    const QString absolutePath = QFileInfo(path).absoluteFilePath();
+    if (neighbors.isEmpty()) {
+        const QString directory = QFileInfo(absolutePath).absolutePath();
+        this->navigation = directoryFiles(directory, false);
+        if (!this->navigation.contains(absolutePath)) {
+            // Arquivo criado depois da última listagem do diretório
+            this->navigation = directoryFiles(directory, true);
+        }
+    } else {
+        this->navigation.clear();
+        for (const QString &neighbor : neighbors) {
+            this->navigation << QFileInfo(neighbor).absoluteFilePath();
+        }
+    }
+    this->navigationIndex = this->navigation.indexOf(absolutePath);
+
+    pool.start([this, requestId, path, absolutePath]() {
+        if (!isCurrent(requestId)) {
+            return;
+        }
+        auto progress = [this, requestId](int percent) {
+            if (!isCurrent(requestId)) {
+                return false;
+            }
+            emit progressChanged(requestId, percent);
+            return true;
+        };
+
+        const auto started = std::chrono::steady_clock::now();
+        const dicom_viewer_core::ImageKey key = dicom_viewer_core::imageKeyForFile(absolutePath.toStdString());
+        if (!key.isValid()) {
+            emit failed(requestId, path, tr("O arquivo selecionado não foi encontrado."));
+            return;
+        }
+
+        LoadedImage result;
+        result.path = path;
+        std::shared_ptr<const CachedImage> entry = lookupOrReserve(key);
+        if (entry) {
+            DICOM_TRACE_SPAN("cache", started, entry->image->buffer.size());
+            result.fromCache = true;
+            result.stats.totalMs = dicom_viewer_core::elapsedMs(started);
+        } else {
+            // Arquivos grandes são lidos em fluxo; a prévia aparece antes da imagem completa
+            auto preview = [this, requestId](const dicom_viewer_core::MedicalImage &reduced, int scale) {
+                if (!isCurrent(requestId)) {
+                    return;
+                }
+                const QImage image = convertMedicalImage(reduced);
+                if (!image.isNull()) {
+                    emit previewReady(requestId, image, scale);
+                }
+            };
+            QString error;
+            entry = decodeImage(path, &result.stats, progress, &error, preview);
+            release(key, entry);
+            if (result.stats.cancelled || !isCurrent(requestId)) {
+                return;
+            }
+            if (!entry) {
+                emit failed(requestId, path, error);
+                return;
+            }
+        }
+
+        result.image = entry->image;
+        result.displayImage = entry->displayImage;
+        result.metadata = entry->metadata;
+        if (result.image->numberOfFrames > 1) {
+            // Os demais quadros são decodificados sob demanda pela FrameSource
+            result.frames = dicom_viewer_core::FrameSource::open(path.toStdString());
+        }
+
+        if (isCurrent(requestId)) {
+            emit loaded(requestId, result);
+            // A pré-busca só começa depois da exibição, para não disputar CPU e disco com ela
+            QMetaObject::invokeMethod(this, [this, requestId]() { schedulePrefetch(requestId); }, Qt::QueuedConnection);
+        }
+    });
+    return requestId;
+}
+
+/**
+ * @brief Arquivo a offset posições do último aberto com load(), na sua lista de vizinhos.
+ */
+QString ImageLoader::neighborPath(int offset) const
+{
+    if (this->navigationIndex < 0) {
+        return QString();
+    }
+    const int index = this->navigationIndex + offset;
+    if (index < 0 || index >= this->navigation.size()) {
+        return QString();
+    }
+    return this->navigation.at(index);
+}
+
+/**
+ * @brief Abre o arquivo a offset posições do atual, mantendo a mesma lista de vizinhos.
+ */
+quint64 ImageLoader::loadNeighbor(int offset)
+{
+    const QString path = neighborPath(offset);
+    if (path.isEmpty()) {
+        return 0;
+    }
+    // Cópia: load() substitui a lista
+    const QStringList neighbors = this->navigation;
+    return load(path, neighbors);
+}
+
+/**
+ * @brief Informa que um arquivo foi criado depois da listagem do seu diretório.
+ *
+ * Usado quando instâncias chegam pela rede enquanto a série é exibida: o
+ * arquivo é inserido na posição alfabética, sem reler o diretório a cada
+ * chegada.
+ */
+void ImageLoader::fileAdded(const QString &path)
+{
+    const QString absolutePath = QFileInfo(path).absoluteFilePath();
+    const QString directory = QFileInfo(absolutePath).absolutePath();
+    auto found = this->directoryListings.find(directory);
+    if (found == this->directoryListings.end() || found.value().contains(absolutePath)) {
+        return;
+    }
+    const bool navigating = this->navigationIndex >= 0 && this->navigation == found.value();
+    QStringList &files = found.value();
+    files.insert(std::lower_bound(files.begin(), files.end(), absolutePath), absolutePath);
+    if (navigating) {
+        const QString current = this->navigation.at(this->navigationIndex);
+        this->navigation = files;
+        this->navigationIndex = this->navigation.indexOf(current);
+    }
+}
+
+/**
+ * @brief Altera o orçamento do cache de imagens, descartando entradas se necessário.
+ */
+void ImageLoader::setCacheBudget(std::size_t bytes)
+{
+    if (bytes == 0) {
+        prefetchPool.clear();
+        cache.clear();
+    }
+    cache.setBudget(bytes);
+}
+
+/**
+ * @brief Define quando uma série deixa de ser montada em memória e como ela é paginada.
+ */
+void ImageLoader::setSeriesStorage(std::size_t inMemoryLimit, const dicom_viewer_core::PagedVolumeConfig &config)
+{
+    this->inMemorySeriesLimit = inMemoryLimit;
+    this->pagedConfig = config;
+}
+
+/**
+ * @brief Decodifica o primeiro quadro de um arquivo e o prepara para exibição.
+ *
+ * Executado nas threads dos pools; não altera o estado do objeto.
+ *
+ * @param path Caminho do arquivo DICOM.
+ * @param stats Recebe os tempos de cada etapa.
+ * @param progress Progresso e cancelamento.
+ * @param error Recebe o motivo da falha.
+ * @param preview Se definido, recebe a prévia reduzida de arquivos lidos em fluxo.
+ * @return A entrada pronta para o cache, ou nullptr em caso de falha ou cancelamento.
+ */
+std::shared_ptr<const CachedImage> ImageLoader::decodeImage(const QString &path, dicom_viewer_core::LoadStats *stats,
+                                                            const dicom_viewer_core::LoadProgressCallback &progress,
+                                                            QString *error,
+                                                            const dicom_viewer_core::PreviewCallback &preview) const
+{
+    // Pixel Data grande e não comprimido é lido por janelas mapeadas; o resto segue loadDicomRaw()
+    auto image = std::make_shared<dicom_viewer_core::MedicalImage>(
+        dicom_viewer_core::loadDicomStreaming(path.toStdString(), stats, progress, preview));
+    if (stats->cancelled) {
+        return nullptr;
+    }
+    if (!image->isValid()) {
+        *error = tr("O arquivo selecionado não é um DICOM válido.");
+        return nullptr;
+    }
+
+    auto entry = std::make_shared<CachedImage>();
+    entry->displayImage = convertMedicalImage(*image);
+    if (entry->displayImage.isNull()) {
+        *error = tr("Erro ao converter Medical Image para QImage");
+        return nullptr;
+    }
+    entry->metadata = QString::fromStdString(dicom_viewer_core::getDicomMetadata(*image));
+    entry->stats = *stats;
+    entry->image = std::move(image);
+    return entry;
+}
+
+/**
+ * @brief Procura a chave no cache ou reserva a sua decodificação para a thread chamadora.
+ *
+ * Se outra thread já decodifica a mesma chave, espera por ela. A consulta
+ * conta como acerto ou falta nos contadores do cache.
+ *
+ * @return A entrada, ou nullptr se a chamadora deve decodificar e depois chamar release().
+ */
+std::shared_ptr<const CachedImage> ImageLoader::lookupOrReserve(const dicom_viewer_core::ImageKey &key)
+{
+    std::unique_lock<std::mutex> lock(inflightMutex);
+    inflightChanged.wait(lock, [this, &key]() { return inflight.count(key) == 0; });
+    std::shared_ptr<const CachedImage> entry = cache.get(key);
+    if (!entry) {
+        inflight.insert(key);
+    }
+    return entry;
+}
+
+/**
+ * @brief Reserva a decodificação de uma chave para a pré-busca.
+ *
+ * Ao contrário de lookupOrReserve(), não conta acertos nem faltas e não
+ * espera: uma chave já em decodificação é simplesmente ignorada.
+ *
+ * @return true se a chamadora deve decodificar e depois chamar release().
+ */
+bool ImageLoader::reserveForPrefetch(const dicom_viewer_core::ImageKey &key)
+{
+    std::lock_guard<std::mutex> lock(inflightMutex);
+    if (inflight.count(key) != 0 || cache.contains(key)) {
+        return false;
+    }
+    inflight.insert(key);
+    return true;
+}
+
+/**
+ * @brief Guarda o resultado de uma decodificação reservada e libera quem aguarda a chave.
+ * @param key Chave reservada.
+ * @param decoded Entrada decodificada, ou nullptr em caso de falha ou cancelamento.
+ */
+void ImageLoader::release(const dicom_viewer_core::ImageKey &key, std::shared_ptr<const CachedImage> decoded)
+{
+    const dicom_viewer_core::CacheCounters counters = cache.counters();
+    if (decoded && counters.budgetBytes > 0) {
+        // Sem janelamento, a QImage compartilha os bytes da imagem decodificada
+        std::size_t cost = decoded->image->buffer.size();
+        if (dicom_viewer_core::isFullPrecision(*decoded->image)) {
+            cost += static_cast<std::size_t>(decoded->displayImage.sizeInBytes());
+        }
+        cache.put(key, std::move(decoded), cost);
+    }
+    {
+        std::lock_guard<std::mutex> lock(inflightMutex);
+        inflight.erase(key);
+    }
+    inflightChanged.notify_all();
+}
+
+/**
+ * @brief Arquivos de um diretório em ordem alfabética, com a listagem guardada entre chamadas.
+ * @param directory Diretório absoluto.
+ * @param refresh Se true, lista o diretório novamente.
+ */
+QStringList ImageLoader::directoryFiles(const QString &directory, bool refresh)
+{
+    auto found = this->directoryListings.find(directory);
+    if (found != this->directoryListings.end() && !refresh) {
+        return found.value();
+    }
+    QStringList files;
+    const QFileInfoList entries = QDir(directory).entryInfoList(QDir::Files | QDir::Readable, QDir::Name);
+    for (const QFileInfo &entry : entries) {
+        files << entry.absoluteFilePath();
+    }
+    this->directoryListings.insert(directory, files);
+    return files;
+}
+
+/**
+ * @brief Agenda a decodificação dos vizinhos do arquivo exibido.
+ *
+ * Os vizinhos são visitados alternando os lados (+1, -1, +2, -2, ...),
+ * começando pelo próximo. Uma nova chamada a load() descarta as pré-buscas
+ * ainda não iniciadas; as que estão em andamento terminam e vão para o
+ * cache, pois o arquivo pedido costuma ser justamente um desses vizinhos.
+ *
+ * @param requestId Requisição que acabou de ser exibida.
+ */
+void ImageLoader::schedulePrefetch(quint64 requestId)
+{
+    if (!isCurrent(requestId) || this->navigationIndex < 0 || cache.counters().budgetBytes == 0) {
+        return;
+    }
+    for (int distance = 1; distance <= this->prefetchRadius; ++distance) {
+        for (int direction : {1, -1}) {
+            const QString path = neighborPath(distance * direction);
+            if (path.isEmpty()) {
+                continue;
+            }
+            prefetchPool.start([this, requestId, path]() {
+                if (!isCurrent(requestId)) {
+                    return;
+                }
+                const dicom_viewer_core::ImageKey key = dicom_viewer_core::imageKeyForFile(path.toStdString());
+                if (!key.isValid() || !reserveForPrefetch(key)) {
+                    return;
+                }
+                DICOM_TRACE_SCOPE(traceScope, "prefetch", "prefetch");
+                dicom_viewer_core::LoadStats stats;
+                QString error;
+                std::shared_ptr<const CachedImage> entry =
+                    decodeImage(path, &stats, dicom_viewer_core::LoadProgressCallback(), &error);
+                if (entry) {
+                    DICOM_TRACE_BYTES(traceScope, entry->image->buffer.size());
+                }
+                release(key, std::move(entry));
+            });
+        }
+    }
+}
+
+/**
+ * @brief Inicia o carregamento de uma série (diretório), cancelando o anterior.
+ *
+ * A decodificação dos cortes é distribuída pelo pool compartilhado do núcleo;
+ * a thread deste serviço apenas coordena e monta o resultado.
+ *
+ * @param directory Diretório com os cortes da série.
+ * @return Identificador da requisição.
+ */
+quint64 ImageLoader::loadSeries(const QString &directory)
+{
+    return startSeriesLoad(directory, std::vector<std::string>());
+}
+
+/**
+ * @brief Inicia o carregamento de uma série a partir de uma lista de arquivos.
+ *
+ * @param files Arquivos da série (por exemplo, as instâncias de uma série do catálogo).
+ * @param label Descrição usada nas mensagens e em LoadedSeries::directory.
+ * @return Identificador da requisição.
+ */
+quint64 ImageLoader::loadSeriesFiles(const QStringList &files, const QString &label)
+{
+    std::vector<std::string> paths;
+    paths.reserve(files.size());
+    for (const QString &file : files) {
+        paths.push_back(file.toStdString());
+    }
+    return startSeriesLoad(label, std::move(paths));
+}
+
+/**
+ * @brief Agenda o carregamento de uma série de um diretório ou de uma lista de arquivos.
+ *
+ * @param directory Diretório da série, ou descrição quando files não está vazio.
+ * @param files Arquivos da série; se vazio, todos os arquivos de directory são considerados.
+ * @return Identificador da requisição.
+ */
+quint64 ImageLoader::startSeriesLoad(const QString &directory, std::vector<std::string> files)
+{
+    const quint64 requestId = ++latestRequest;
+    pool.clear();
+    prefetchPool.clear();
+    this->navigationIndex = -1;
+    DICOM_TRACE_BEGIN_LOAD();
+
+    pool.start([this, requestId, directory, files = std::move(files), inMemoryLimit = this->inMemorySeriesLimit,
+                config = this->pagedConfig]() mutable {
+        if (!isCurrent(requestId)) {
+            return;
+        }
+        if (files.empty()) {
+            const QFileInfoList entries = QDir(directory).entryInfoList(QDir::Files | QDir::Readable, QDir::Name);
+            for (const QFileInfo &entry : entries) {
+                files.push_back(entry.absoluteFilePath().toStdString());
+            }
+        }
+        auto progress = [this, requestId](int percent) {
+            if (!isCurrent(requestId)) {
+                return false;
+            }
+            emit progressChanged(requestId, percent);
+            return true;
+        };
+
+        LoadedSeries result;
+        result.directory = directory;
+        SeriesStore store(inMemoryLimit, config);
+        bool loaded = false;
+        if (files.size() == 1 && dicom_viewer_core::isMultiFrameVolume(files.front())) {
+            // Série de um único arquivo multi-frame: quadros decodificados em paralelo, sempre em memória
+            dicom_viewer_core::FrameDecodeStats frameStats;
+            store.volume = dicom_viewer_core::loadDicomFrames(files.front(), &frameStats, progress);
+            loaded = store.volume.isValid();
+            result.stats.filesScanned = 1;
+            result.stats.slicesLoaded = static_cast<std::size_t>(frameStats.frames);
+            result.stats.headerMs = frameStats.headerMs;
+            result.stats.decodeMs = frameStats.decodeMs;
+            result.stats.totalMs = frameStats.totalMs;
+            result.stats.slicesPerSecond = frameStats.decodeMs > 0.0 ? frameStats.frames * 1000.0 / frameStats.decodeMs
+                                                                     : 0.0;
+            result.stats.voxelBytes = frameStats.decodedBytes;
+            result.stats.peakResidentBytes = dicom_viewer_core::peakResidentBytes();
+            result.stats.cancelled = frameStats.cancelled;
+        } else {
+            loaded = dicom_viewer_core::loadDicomSeriesInto(files, store, store.volume, &result.stats, progress);
+        }
+        if (result.stats.cancelled || !isCurrent(requestId)) {
+            return;
+        }
+        if (!loaded) {
+            emit failed(requestId, directory, tr("O diretório selecionado não contém uma série DICOM válida."));
+            return;
+        }
+
+        // Série paginada: apenas o bloco do corte central é lido para a exibição inicial
+        auto volume = std::make_shared<dicom_viewer_core::Volume>(std::move(store.volume));
+        auto middle = std::make_shared<dicom_viewer_core::MedicalImage>(
+            store.paged ? store.paged->extractSlice(volume->depth / 2)
+                        : dicom_viewer_core::extractSlice(*volume, volume->depth / 2));
+        result.displayImage = convertMedicalImage(*middle);
+        if (result.displayImage.isNull()) {
+            emit failed(requestId, directory, tr("Erro ao converter Medical Image para QImage"));
+            return;
+        }
+        result.metadata = QString::fromStdString(dicom_viewer_core::getDicomMetadata(*middle));
+        result.image = std::move(middle);
+        result.metadata += tr("\nSérie\n  Descrição: %1\n  Cortes: %2\n  Espaçamento Z: %3\n")
+                               .arg(QString::fromStdString(volume->seriesDescription))
+                               .arg(volume->depth)
+                               .arg(volume->spacingZ);
+        if (store.paged) {
+            result.pagedVolume = std::move(store.paged);
+        } else {
+            result.volume = std::move(volume);
+        }
+
+        if (isCurrent(requestId)) {
+            emit seriesLoaded(requestId, result);
+        }
+    });
+    return requestId;
+}
+
+/**
+ * @brief Cancela a requisição em andamento, se houver.
+ */
+void ImageLoader::cancel()
+{
+    ++latestRequest;
+}
+
+}
@@ -0,0 +1,259 @@
+/**
+ * DICOM Viewer - Carregamento assíncrono de imagens
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+#ifndef IMAGELOADER_H
+#define IMAGELOADER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <QHash>
+#include <QObject>
+#include <QImage>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+
+#include "../../core/MedicalImage.h"
+#include "../../core/Volume.h"
+#include "../../core/PagedVolume.h"
+#include "../../core/FrameSource.h"
+#include "../../core/ImageKey.h"
+#include "../../core/LruCache.h"
+#include "../../core/StreamingLoader.h"
+
+namespace dicom_viewer_windows {
+
+/**
+ * @struct LoadedImage
+ * @brief Resultado de um carregamento concluído, pronto para exibição.
+ */
+struct LoadedImage {
+    QString path;                                                ///< Arquivo carregado
+    std::shared_ptr<const dicom_viewer_core::MedicalImage> image; ///< Imagem decodificada
+    QImage displayImage;                                         ///< Imagem convertida para exibição
+    QString metadata;                                            ///< Metadados formatados
+    dicom_viewer_core::LoadStats stats;                          ///< Tempos de cada etapa
+    std::shared_ptr<dicom_viewer_core::FrameSource> frames;      ///< Quadros sob demanda (apenas multi-frame)
+    bool fromCache = false;                                      ///< true se veio do cache de imagens decodificadas
+};
+
+/**
+ * @struct CachedImage
+ * @brief Entrada do cache de imagens: o primeiro quadro decodificado e tudo o que a exibição precisa dele.
+ */
+struct CachedImage {
+    std::shared_ptr<const dicom_viewer_core::MedicalImage> image; ///< Imagem decodificada
+    QImage displayImage;                                         ///< Imagem convertida para exibição
+    QString metadata;                                            ///< Metadados formatados
+    dicom_viewer_core::LoadStats stats;                          ///< Tempos da decodificação original
+};
+
+/**
+ * @struct LoadedSeries
+ * @brief Série carregada como volume, com o corte central pronto para exibição.
+ */
+struct LoadedSeries {
+    QString directory;                                           ///< Diretório da série
+    std::shared_ptr<const dicom_viewer_core::Volume> volume;     ///< Volume montado (nulo se a série foi paginada)
+    std::shared_ptr<dicom_viewer_core::PagedVolume> pagedVolume; ///< Série maior que o limite em memória, no arquivo de trabalho
+    std::shared_ptr<const dicom_viewer_core::MedicalImage> image; ///< Corte central em precisão total
+    QImage displayImage;                                         ///< Corte central para exibição
+    QString metadata;                                            ///< Metadados formatados
+    dicom_viewer_core::SeriesLoadStats stats;                    ///< Estatísticas do carregamento
+};
+
+/**
+ * @class ImageLoader
+ * @brief Serviço de carregamento de imagens DICOM fora da thread da interface.
+ *
+ * Cada chamada a load() recebe um identificador crescente e cancela as
+ * requisições anteriores ainda em andamento. Os sinais são entregues na
+ * thread do objeto (normalmente a thread da interface).
+ *
+ * As imagens abertas com load() ficam em um cache LRU limitado por memória,
+ * indexado pela identidade do arquivo (caminho, tamanho, data de modificação)
+ * e pelo quadro. Depois de cada exibição, os vizinhos do arquivo no diretório
+ * (ou na lista de vizinhos informada) são decodificados em segundo plano, de
+ * modo que percorrer um estudo paga a decodificação uma única vez por imagem.
+ */
+class ImageLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Construtor do serviço de carregamento.
+     * @param parent Objeto pai (opcional).
+     */
+    explicit ImageLoader(QObject *parent = nullptr);
+
+    /**
+     * @brief Destrutor. Cancela as requisições pendentes e aguarda as threads.
+     */
+    ~ImageLoader();
+
+    /**
+     * @brief Orçamento padrão do cache de imagens decodificadas, em bytes.
+     */
+    static constexpr std::size_t kDefaultCacheBudget = std::size_t(512) * 1024 * 1024;
+
+    /**
+     * @brief Maior série montada em memória até setSeriesStorage(); acima disso ela vai para um PagedVolume.
+     */
+    static constexpr std::size_t kDefaultInMemorySeriesLimit = std::size_t(2048) * 1024 * 1024;
+
+    /**
+     * @brief Inicia o carregamento de um arquivo, cancelando o anterior.
+     * @param path Caminho do arquivo DICOM.
+     * @param neighbors Arquivos na ordem de navegação, incluindo path (por exemplo,
+     *                  as instâncias de uma série). Se vazio, usa os arquivos do
+     *                  diretório de path em ordem alfabética.
+     * @return Identificador da requisição.
+     */
+    quint64 load(const QString &path, const QStringList &neighbors = QStringList());
+
+    /**
+     * @brief Arquivo a offset posições do último aberto com load(), na sua lista de vizinhos.
+     * @return O caminho, ou uma string vazia fora dos limites da lista.
+     */
+    QString neighborPath(int offset) const;
+
+    /**
+     * @brief Abre o arquivo a offset posições do atual, mantendo a mesma lista de vizinhos.
+     * @return Identificador da requisição, ou 0 fora dos limites da lista.
+     */
+    quint64 loadNeighbor(int offset);
+
+    /**
+     * @brief Informa que um arquivo foi criado depois da listagem do seu diretório.
+     *
+     * A listagem guardada e, se ela for a lista de navegação atual, a
+     * navegação passam a incluir o arquivo, sem reler o diretório.
+     */
+    void fileAdded(const QString &path);
+
+    /**
+     * @brief Inicia o carregamento de uma série (diretório), cancelando o anterior.
+     * @param directory Diretório com os cortes da série.
+     * @return Identificador da requisição.
+     */
+    quint64 loadSeries(const QString &directory);
+
+    /**
+     * @brief Inicia o carregamento de uma série a partir de uma lista de arquivos.
+     * @param files Arquivos da série.
+     * @param label Descrição usada nas mensagens.
+     * @return Identificador da requisição.
+     */
+    quint64 loadSeriesFiles(const QStringList &files, const QString &label);
+
+    /**
+     * @brief Cancela a requisição em andamento, se houver.
+     */
+    void cancel();
+
+    /**
+     * @brief Identificador da requisição mais recente.
+     */
+    quint64 currentRequest() const { return latestRequest.load(); }
+
+    /**
+     * @brief Altera o orçamento do cache de imagens, descartando entradas se necessário.
+     * @param bytes Novo orçamento, em bytes (0 desativa o cache e a pré-busca).
+     */
+    void setCacheBudget(std::size_t bytes);
+
+    /**
+     * @brief Quantos vizinhos de cada lado do arquivo atual são pré-carregados (0 desativa).
+     */
+    void setPrefetchRadius(int radius) { prefetchRadius = radius < 0 ? 0 : radius; }
+
+    /**
+     * @brief Define quando uma série deixa de ser montada em memória e como ela é paginada.
+     * @param inMemoryLimit Maior série (em bytes de voxels) montada em um Volume contíguo.
+     * @param config Orçamento residente, blocos e diretório das séries maiores.
+     */
+    void setSeriesStorage(std::size_t inMemoryLimit, const dicom_viewer_core::PagedVolumeConfig &config);
+
+    /**
+     * @brief Contadores do cache de imagens (acertos, faltas, descartes e ocupação).
+     */
+    dicom_viewer_core::CacheCounters cacheCounters() const { return cache.counters(); }
+
+signals:
+    /**
+     * @brief Emitido entre as etapas do carregamento.
+     */
+    void progressChanged(quint64 requestId, int percent);
+
+    /**
+     * @brief Emitido quando o carregamento é concluído com sucesso.
+     */
+    void loaded(quint64 requestId, const dicom_viewer_windows::LoadedImage &result);
+
+    /**
+     * @brief Emitido durante a leitura de um arquivo grande com uma prévia reduzida.
+     * @param image Prévia já janelada; ainda pode ter linhas não lidas.
+     * @param scale Fator de redução em relação à imagem completa.
+     */
+    void previewReady(quint64 requestId, const QImage &image, int scale);
+
+    /**
+     * @brief Emitido quando o carregamento de uma série é concluído com sucesso.
+     */
+    void seriesLoaded(quint64 requestId, const dicom_viewer_windows::LoadedSeries &result);
+
+    /**
+     * @brief Emitido quando o arquivo não pode ser carregado.
+     */
+    void failed(quint64 requestId, const QString &path, const QString &reason);
+
+private:
+    bool isCurrent(quint64 requestId) const { return latestRequest.load() == requestId; }
+    quint64 startSeriesLoad(const QString &directory, std::vector<std::string> files);
+    std::shared_ptr<const CachedImage> decodeImage(const QString &path, dicom_viewer_core::LoadStats *stats,
+                                                   const dicom_viewer_core::LoadProgressCallback &progress,
+                                                   QString *error,
+                                                   const dicom_viewer_core::PreviewCallback &preview =
+                                                       dicom_viewer_core::PreviewCallback()) const;
+    std::shared_ptr<const CachedImage> lookupOrReserve(const dicom_viewer_core::ImageKey &key);
+    bool reserveForPrefetch(const dicom_viewer_core::ImageKey &key);
+    void release(const dicom_viewer_core::ImageKey &key, std::shared_ptr<const CachedImage> decoded);
+    QStringList directoryFiles(const QString &directory, bool refresh);
+    void schedulePrefetch(quint64 requestId);
+
+    QThreadPool pool;
+    std::atomic<quint64> latestRequest{0};
+
+    dicom_viewer_core::LruCache<dicom_viewer_core::ImageKey, CachedImage, dicom_viewer_core::ImageKeyHash> cache;
+    QThreadPool prefetchPool;                                    ///< Pré-busca, separada para não atrasar a requisição atual
+    int prefetchRadius = 2;
+    std::size_t inMemorySeriesLimit = kDefaultInMemorySeriesLimit;
+    dicom_viewer_core::PagedVolumeConfig pagedConfig;            ///< Copiado para cada carregamento de série
+    std::mutex inflightMutex;
+    std::condition_variable inflightChanged;
+    std::unordered_set<dicom_viewer_core::ImageKey, dicom_viewer_core::ImageKeyHash> inflight; ///< Chaves em decodificação
+
+    // Acessados apenas na thread do objeto
+    QHash<QString, QStringList> directoryListings;               ///< Arquivos por diretório, em ordem alfabética
+    QStringList navigation;                                      ///< Vizinhos do último arquivo aberto com load()
+    int navigationIndex = -1;                                    ///< Posição do último arquivo em navigation
+};
+
+}
+
+Q_DECLARE_METATYPE(dicom_viewer_windows::LoadedImage)
+Q_DECLARE_METATYPE(dicom_viewer_windows::LoadedSeries)
+
+#endif // IMAGELOADER_H
@@ -0,0 +1,134 @@
+/**
+ * DICOM Viewer - Instância Única do Aplicativo
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+/**
+ * @file instancechannel.cpp
+ * @brief Implementação da classe InstanceChannel.
+ */
+
+#include <memory>
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QLocalServer>
+#include <QLocalSocket>
+
+#include "instancechannel.h"
+
+namespace dicom_viewer_windows {
+
+/**
+ * @brief Construtor do canal (ainda sem escutar).
+ * @param parent Objeto pai (opcional).
+ */
+InstanceChannel::InstanceChannel(QObject *parent)
+    : QObject(parent)
+    , server(new QLocalServer(this))
+{
+    // Apenas o próprio usuário pode entregar arquivos à instância
+    this->server->setSocketOptions(QLocalServer::UserAccessOption);
+    connect(this->server, &QLocalServer::newConnection, this, &InstanceChannel::onNewConnection);
+}
+
+/**
+ * @brief Nome do socket local, distinto para cada usuário.
+ */
+QString InstanceChannel::serverName()
+{
+    QString user = qEnvironmentVariable("USER");
+    if (user.isEmpty()) {
+        user = qEnvironmentVariable("USERNAME");
+    }
+    // O nome vira um arquivo em /tmp (Unix) ou um pipe nomeado (Windows): apenas caracteres seguros
+    const QByteArray digest = QCryptographicHash::hash(user.toUtf8(), QCryptographicHash::Sha1).toHex().left(12);
+    return QStringLiteral("dicom-viewer-") + QString::fromLatin1(digest);
+}
+
+/**
+ * @brief Entrega os caminhos à instância em execução, se houver.
+ * @param paths Arquivos e diretórios, em caminhos absolutos.
+ * @param timeoutMs Tempo máximo de espera pela conexão e pelo envio.
+ * @return true se outra instância recebeu os caminhos.
+ */
+bool InstanceChannel::sendToRunning(const QStringList &paths, int timeoutMs)
+{
+    QLocalSocket socket;
+    socket.connectToServer(serverName());
+    if (!socket.waitForConnected(timeoutMs)) {
+        return false;
+    }
+
+    QByteArray message;
+    for (const QString &path : paths) {
+        message += path.toUtf8();
+        message += '\n';
+    }
+    if (message.isEmpty()) {
+        message = "\n";
+    }
+    socket.write(message);
+    // disconnectFromServer() aguarda o envio do que ainda estiver no buffer
+    socket.disconnectFromServer();
+    if (socket.state() != QLocalSocket::UnconnectedState && !socket.waitForDisconnected(timeoutMs)) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Passa a receber os caminhos das execuções seguintes.
+ * @return false se o canal não pôde ser aberto (outra instância já escuta).
+ */
+bool InstanceChannel::listen()
+{
+    const QString name = serverName();
+    if (this->server->listen(name)) {
+        return true;
+    }
+    if (this->server->serverError() != QAbstractSocket::AddressInUseError) {
+        return false;
+    }
+    // O nome existe: ou outra instância acabou de abrir o canal, ou sobrou de uma instância encerrada
+    QLocalSocket probe;
+    probe.connectToServer(name);
+    if (probe.waitForConnected(200)) {
+        return false;
+    }
+    QLocalServer::removeServer(name);
+    return this->server->listen(name);
+}
+
+/**
+ * @brief Lê cada conexão até o fim e entrega os caminhos recebidos.
+ */
+void InstanceChannel::onNewConnection()
+{
+    while (QLocalSocket *socket = this->server->nextPendingConnection()) {
+        auto received = std::make_shared<QByteArray>();
+        connect(socket, &QLocalSocket::readyRead, this, [socket, received]() {
+            received->append(socket->readAll());
+        });
+        connect(socket, &QLocalSocket::disconnected, this, [this, socket, received]() {
+            received->append(socket->readAll());
+            socket->deleteLater();
+            // Sondagem de listen() em outra execução
+            if (received->isEmpty()) {
+                return;
+            }
+            QStringList paths;
+            for (const QByteArray &line : received->split('\n')) {
+                if (!line.isEmpty()) {
+                    paths.append(QString::fromUtf8(line));
+                }
+            }
+            emit pathsReceived(paths);
+        });
+    }
+}
+
+}
@@ -0,0 +1,76 @@
+/**
+ * DICOM Viewer - Instância Única do Aplicativo
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+#ifndef INSTANCECHANNEL_H
+#define INSTANCECHANNEL_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+class QLocalServer;
+
+namespace dicom_viewer_windows {
+
+/**
+ * @class InstanceChannel
+ * @brief Canal local pelo qual uma nova execução entrega seus arquivos à instância já aberta.
+ *
+ * A primeira instância escuta um socket local (QLocalServer) com nome
+ * próprio do usuário. As execuções seguintes conectam-se a ele, enviam os
+ * caminhos recebidos na linha de comando e terminam sem criar a janela nem
+ * inicializar o DCMTK.
+ *
+ * Protocolo: cada caminho absoluto em UTF-8 seguido de '\n'; uma execução
+ * sem caminhos envia apenas '\n' (a instância aberta só é trazida à frente).
+ * Conexões encerradas sem dados são ignoradas.
+ */
+class InstanceChannel : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Construtor do canal (ainda sem escutar).
+     * @param parent Objeto pai (opcional).
+     */
+    explicit InstanceChannel(QObject *parent = nullptr);
+
+    /**
+     * @brief Entrega os caminhos à instância em execução, se houver.
+     * @param paths Arquivos e diretórios, em caminhos absolutos.
+     * @param timeoutMs Tempo máximo de espera pela conexão e pelo envio.
+     * @return true se outra instância recebeu os caminhos.
+     */
+    static bool sendToRunning(const QStringList &paths, int timeoutMs = 1000);
+
+    /**
+     * @brief Passa a receber os caminhos das execuções seguintes.
+     *
+     * Um socket deixado por uma instância encerrada de forma abrupta é removido.
+     *
+     * @return false se o canal não pôde ser aberto (outra instância já escuta).
+     */
+    bool listen();
+
+signals:
+    /**
+     * @brief Emitido quando outra execução entrega seus caminhos.
+     * @param paths Arquivos e diretórios recebidos (vazio: apenas trazer a janela à frente).
+     */
+    void pathsReceived(const QStringList &paths);
+
+private:
+    static QString serverName();
+    void onNewConnection();
+
+    QLocalServer *server;
+};
+
+}
+
+#endif // INSTANCECHANNEL_H
@@ -0,0 +1,188 @@
+/**
+ * DICOM Viewer - Séries Compartilhadas entre Vistas
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+/**
+ * @file seriescache.cpp
+ * @brief Implementação da classe SeriesCache.
+ */
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "seriescache.h"
+
+namespace dicom_viewer_windows {
+
+namespace {
+
+/**
+ * @brief Destino dos cortes no Volume contíguo, recusando séries acima do limite.
+ *
+ * O tamanho só é conhecido depois da leitura dos cabeçalhos, em allocate();
+ * volume recebe também o cabeçalho devolvido por loadDicomSeriesInto().
+ */
+class LimitedStore : public dicom_viewer_core::SliceStore {
+public:
+    explicit LimitedStore(std::size_t limit)
+        : inMemoryLimit(limit) {}
+
+    bool allocate(const dicom_viewer_core::Volume &header) override
+    {
+        this->requiredBytes = header.sliceBytes() * static_cast<std::size_t>(header.depth);
+        if (tooLarge()) {
+            return false;
+        }
+        this->volume.voxels.resize(this->requiredBytes);
+        return true;
+    }
+
+    bool write(int z, const std::function<bool(uint8_t *)> &decode) override
+    {
+        return decode(this->volume.sliceData(z));
+    }
+
+    bool tooLarge() const { return this->requiredBytes > this->inMemoryLimit; }
+
+    dicom_viewer_core::Volume volume;
+    std::size_t requiredBytes = 0;
+    std::size_t inMemoryLimit;
+};
+
+}
+
+/**
+ * @brief Construtor do cache.
+ * @param parent Objeto pai (opcional).
+ */
+SeriesCache::SeriesCache(QObject *parent)
+    : QObject(parent)
+{
+    // Cada carregamento já decodifica os cortes em paralelo no pool do núcleo
+    pool.setMaxThreadCount(2);
+}
+
+/**
+ * @brief Destrutor. Cancela os carregamentos pendentes e aguarda as threads.
+ */
+SeriesCache::~SeriesCache()
+{
+    closing = true;
+    pool.clear();
+    pool.waitForDone();
+}
+
+/**
+ * @brief Chave de uma série a partir dos seus arquivos.
+ */
+QString SeriesCache::keyFor(const QStringList &files)
+{
+    return files.join(QLatin1Char('\n'));
+}
+
+/**
+ * @brief Define a maior série (em bytes de voxels) carregada em memória; as maiores são recusadas.
+ */
+void SeriesCache::setInMemoryLimit(std::size_t bytes)
+{
+    this->inMemoryLimit = bytes;
+}
+
+/**
+ * @brief Volume da série, se ainda estiver em uso por alguma vista.
+ * @return O volume, ou nullptr.
+ */
+std::shared_ptr<const dicom_viewer_core::Volume> SeriesCache::volume(const QString &key) const
+{
+    const auto found = this->volumes.constFind(key);
+    return found == this->volumes.constEnd() ? nullptr : found->lock();
+}
+
+/**
+ * @brief Registra um volume já carregado (por exemplo, pela janela principal).
+ */
+void SeriesCache::insert(const QString &key, const std::shared_ptr<const dicom_viewer_core::Volume> &volume)
+{
+    if (!key.isEmpty() && volume) {
+        this->volumes.insert(key, volume);
+    }
+}
+
+/**
+ * @brief Pede o carregamento de uma série, se ela não estiver em uso nem em carregamento.
+ *
+ * @param key Chave obtida com keyFor().
+ * @param files Arquivos da série.
+ */
+void SeriesCache::request(const QString &key, const QStringList &files)
+{
+    if (this->pending.contains(key) || volume(key)) {
+        return;
+    }
+    // Entradas de séries que nenhuma vista usa mais
+    for (auto it = this->volumes.begin(); it != this->volumes.end();) {
+        if (it->expired()) {
+            it = this->volumes.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    this->pending.insert(key);
+
+    std::vector<std::string> paths;
+    paths.reserve(files.size());
+    for (const QString &file : files) {
+        paths.push_back(file.toStdString());
+    }
+    pool.start([this, key, paths = std::move(paths), limit = this->inMemoryLimit]() {
+        dicom_viewer_core::SeriesLoadStats stats;
+        LimitedStore store(limit);
+        std::shared_ptr<const dicom_viewer_core::Volume> loaded;
+        QString reason;
+        if (dicom_viewer_core::loadDicomSeriesInto(paths, store, store.volume, &stats,
+                                                   [this](int) { return !closing.load(); })) {
+            loaded = std::make_shared<const dicom_viewer_core::Volume>(std::move(store.volume));
+        } else if (store.tooLarge()) {
+            reason = tr("A série (%1 MB) excede o limite de %2 MB em memória da grade.\n"
+                        "Abra-a na janela principal.")
+                         .arg(store.requiredBytes >> 20)
+                         .arg(limit >> 20);
+        } else {
+            reason = tr("Os arquivos não formam uma série DICOM válida.");
+        }
+        if (closing.load()) {
+            return;
+        }
+        // O destrutor aguarda o pool, então this ainda existe ao enfileirar
+        QMetaObject::invokeMethod(this, [this, key, loaded, reason]() { onLoaded(key, loaded, reason); },
+                                  Qt::QueuedConnection);
+    });
+}
+
+/**
+ * @brief Registra o volume carregado e avisa as vistas (thread do objeto).
+ *
+ * A referência local mantém o volume vivo durante a emissão de ready(),
+ * para que as vistas o obtenham com volume().
+ *
+ * @param loaded Volume carregado, ou nullptr se a série foi recusada ou é inválida.
+ * @param reason Motivo da falha, exibido nas vistas quando loaded é nulo.
+ */
+void SeriesCache::onLoaded(const QString &key, std::shared_ptr<const dicom_viewer_core::Volume> loaded,
+                           const QString &reason)
+{
+    this->pending.remove(key);
+    if (!loaded || !loaded->isValid()) {
+        emit failed(key, reason);
+        return;
+    }
+    this->volumes.insert(key, loaded);
+    emit ready(key);
+}
+
+}
@@ -0,0 +1,115 @@
+/**
+ * DICOM Viewer - Séries Compartilhadas entre Vistas
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+#ifndef SERIESCACHE_H
+#define SERIESCACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+
+#include "../../core/Volume.h"
+
+namespace dicom_viewer_windows {
+
+/**
+ * @class SeriesCache
+ * @brief Volumes decodificados compartilhados por todas as vistas que exibem a mesma série.
+ *
+ * Cada série é identificada pela lista dos seus arquivos. Enquanto alguma
+ * vista mantiver o volume, novos pedidos da mesma série o recebem sem nova
+ * decodificação; pedidos simultâneos da mesma série resultam em um único
+ * carregamento. O cache guarda apenas referências fracas: o volume é
+ * liberado quando a última vista deixa de exibi-lo.
+ *
+ * As vistas exibem apenas volumes contíguos em memória: séries maiores que
+ * o limite definido em setInMemoryLimit() são recusadas com failed(), e
+ * devem ser abertas na janela principal, que as pagina em disco.
+ */
+class SeriesCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Construtor do cache.
+     * @param parent Objeto pai (opcional).
+     */
+    explicit SeriesCache(QObject *parent = nullptr);
+
+    /**
+     * @brief Destrutor. Cancela os carregamentos pendentes e aguarda as threads.
+     */
+    ~SeriesCache();
+
+    /**
+     * @brief Chave de uma série a partir dos seus arquivos.
+     */
+    static QString keyFor(const QStringList &files);
+
+    /**
+     * @brief Define a maior série (em bytes de voxels) carregada em memória; as maiores são recusadas.
+     */
+    void setInMemoryLimit(std::size_t bytes);
+
+    /**
+     * @brief Volume da série, se ainda estiver em uso por alguma vista.
+     * @return O volume, ou nullptr.
+     */
+    std::shared_ptr<const dicom_viewer_core::Volume> volume(const QString &key) const;
+
+    /**
+     * @brief Registra um volume já carregado (por exemplo, pela janela principal).
+     */
+    void insert(const QString &key, const std::shared_ptr<const dicom_viewer_core::Volume> &volume);
+
+    /**
+     * @brief Pede o carregamento de uma série, se ela não estiver em uso nem em carregamento.
+     *
+     * ready() é emitido ao fim do carregamento; se o volume já estiver em
+     * uso, o chamador deve obtê-lo com volume().
+     *
+     * @param key Chave obtida com keyFor().
+     * @param files Arquivos da série.
+     */
+    void request(const QString &key, const QStringList &files);
+
+signals:
+    /**
+     * @brief Emitido quando a série termina de carregar; o volume está disponível em volume().
+     */
+    void ready(const QString &key);
+
+    /**
+     * @brief Emitido quando a série não pode ser carregada.
+     */
+    void failed(const QString &key, const QString &reason);
+
+private:
+    /**
+     * @brief Registra o volume carregado e avisa as vistas (thread do objeto).
+     */
+    void onLoaded(const QString &key, std::shared_ptr<const dicom_viewer_core::Volume> loaded, const QString &reason);
+
+    QHash<QString, std::weak_ptr<const dicom_viewer_core::Volume>> volumes; ///< Séries em uso
+    QSet<QString> pending;                                       ///< Séries em carregamento
+    QThreadPool pool;
+    std::size_t inMemoryLimit = std::numeric_limits<std::size_t>::max();
+    std::atomic<bool> closing{false};
+};
+
+}
+
+#endif // SERIESCACHE_H
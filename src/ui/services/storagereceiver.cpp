@@ -0,0 +1,116 @@
+/**
+ * DICOM Viewer - Recepção de Estudos pela Rede
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+/**
+ * @file storagereceiver.cpp
+ * @brief Implementação da classe StorageReceiver.
+ */
+
+#include "storagereceiver.h"
+
+namespace dicom_viewer_windows {
+
+/**
+ * @brief Construtor do serviço (parado).
+ * @param parent Objeto pai (opcional).
+ */
+StorageReceiver::StorageReceiver(QObject *parent)
+    : QObject(parent)
+{
+}
+
+/**
+ * @brief Destrutor. Para o receptor e aguarda as threads.
+ *
+ * A espera é limitada pelos tempos máximos de DIMSE e ACSE do receptor.
+ * Avisos ainda na fila de eventos são descartados pelo Qt junto com o objeto.
+ */
+StorageReceiver::~StorageReceiver()
+{
+    stop();
+    waitForStop();
+}
+
+/**
+ * @brief Começa a receber na porta informada, gravando em directory.
+ * @return false se o receptor não pôde ser iniciado.
+ */
+bool StorageReceiver::start(quint16 port, const QString &aeTitle, const QString &directory)
+{
+    waitForStop();
+    this->server.reset();
+    dicom_viewer_core::StorageServerConfig config;
+    config.port = port;
+    config.aeTitle = aeTitle.toStdString();
+    config.storageDirectory = directory.toStdString();
+    this->server = std::make_shared<dicom_viewer_core::StorageServer>(config);
+    const bool started = this->server->start([this](const dicom_viewer_core::ReceivedInstance &instance) {
+        // Thread de gravação: o aviso segue para a thread do objeto
+        const QString path = QString::fromStdString(instance.path);
+        const QString study = QString::fromStdString(instance.studyInstanceUID);
+        const QString series = QString::fromStdString(instance.seriesInstanceUID);
+        QMetaObject::invokeMethod(this, [this, path, study, series]() {
+            emit instanceStored(path, study, series);
+        }, Qt::QueuedConnection);
+    }, [this](const std::string &reason) {
+        // Thread de escuta: o aviso segue para a thread do objeto
+        const QString text = QString::fromStdString(reason);
+        QMetaObject::invokeMethod(this, [this, text]() {
+            emit listenFailed(text);
+        }, Qt::QueuedConnection);
+    });
+    if (!started) {
+        this->server.reset();
+    }
+    return started;
+}
+
+/**
+ * @brief Para de receber; as instâncias já recebidas ainda são gravadas.
+ */
+void StorageReceiver::stop()
+{
+    if (!this->server || this->stopping) {
+        return;
+    }
+    waitForStop();
+    this->stopping = true;
+    // As associações abertas podem levar até os tempos máximos do receptor: a espera fica fora da interface
+    this->stopThread = std::thread([this, server = this->server]() {
+        server->stop();
+        QMetaObject::invokeMethod(this, [this]() {
+            // start() ou o destrutor já aguardaram este encerramento
+            if (!this->stopping) {
+                return;
+            }
+            this->stopping = false;
+            emit stopped();
+        }, Qt::QueuedConnection);
+    });
+}
+
+/**
+ * @brief Aguarda a thread de um stop() anterior.
+ */
+void StorageReceiver::waitForStop()
+{
+    if (this->stopThread.joinable()) {
+        this->stopThread.join();
+    }
+    this->stopping = false;
+}
+
+/**
+ * @brief Contadores e taxas do receptor.
+ */
+dicom_viewer_core::StorageStats StorageReceiver::stats() const
+{
+    return this->server ? this->server->stats() : dicom_viewer_core::StorageStats();
+}
+
+}
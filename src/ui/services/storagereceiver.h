@@ -0,0 +1,113 @@
+/**
+ * DICOM Viewer - Recepção de Estudos pela Rede
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+#ifndef STORAGERECEIVER_H
+#define STORAGERECEIVER_H
+
+#include <memory>
+#include <thread>
+
+#include <QObject>
+#include <QString>
+
+#include "../../core/StorageServer.h"
+
+namespace dicom_viewer_windows {
+
+/**
+ * @class StorageReceiver
+ * @brief Receptor C-STORE que avisa a interface a cada instância gravada.
+ *
+ * As instâncias são recebidas e gravadas pelas threads do StorageServer;
+ * instanceStored() é entregue na thread do objeto (normalmente a da
+ * interface), na ordem em que as gravações terminam.
+ *
+ * stop() retorna de imediato: o receptor termina as associações abertas e
+ * a fila de gravação em uma thread própria e avisa com stopped().
+ *
+ * A porta só é aberta depois de start() retornar: se ela estiver ocupada
+ * ou sem permissão, listenFailed() é emitido e o chamador deve chamar stop().
+ */
+class StorageReceiver : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Construtor do serviço (parado).
+     * @param parent Objeto pai (opcional).
+     */
+    explicit StorageReceiver(QObject *parent = nullptr);
+
+    /**
+     * @brief Destrutor. Para o receptor e aguarda as threads (limitado pelos tempos máximos do receptor).
+     */
+    ~StorageReceiver();
+
+    /**
+     * @brief Começa a receber na porta informada, gravando em directory.
+     *
+     * Um encerramento ainda em andamento é aguardado antes. Falhas ao abrir
+     * a porta chegam depois, por listenFailed().
+     *
+     * @return false se o receptor não pôde ser iniciado.
+     */
+    bool start(quint16 port, const QString &aeTitle, const QString &directory);
+
+    /**
+     * @brief Para de receber sem bloquear; as instâncias já recebidas ainda são gravadas.
+     *
+     * stopped() é emitido quando o receptor termina.
+     */
+    void stop();
+
+    /**
+     * @brief true entre stop() e stopped().
+     */
+    bool isStopping() const { return stopping; }
+
+    /**
+     * @brief true enquanto a porta estiver sendo escutada.
+     */
+    bool isRunning() const { return server && server->isRunning(); }
+
+    /**
+     * @brief Contadores e taxas do receptor.
+     */
+    dicom_viewer_core::StorageStats stats() const;
+
+signals:
+    /**
+     * @brief Emitido quando uma instância recebida termina de ser gravada.
+     * @param path Arquivo gravado.
+     * @param studyInstanceUID Estudo da instância.
+     * @param seriesInstanceUID Série da instância.
+     */
+    void instanceStored(const QString &path, const QString &studyInstanceUID, const QString &seriesInstanceUID);
+
+    /**
+     * @brief Emitido quando a porta não pôde ser aberta ou a escuta parou por erro.
+     * @param reason Descrição do erro informada pelo DCMTK.
+     */
+    void listenFailed(const QString &reason);
+
+    /**
+     * @brief Emitido quando o receptor parado por stop() terminou; stats() tem os totais finais.
+     */
+    void stopped();
+
+private:
+    void waitForStop();
+
+    std::shared_ptr<dicom_viewer_core::StorageServer> server;
+    std::thread stopThread;
+    bool stopping = false;
+};
+
+}
+
+#endif // STORAGERECEIVER_H
@@ -0,0 +1,357 @@
+/**
+ * DICOM Viewer - Modelo da Árvore de Tags DICOM
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+/**
+ * @file tagtreemodel.cpp
+ * @brief Implementação da classe TagTreeModel.
+ */
+
+#include <algorithm>
+
+#include <QFontDatabase>
+
+#include "tagtreemodel.h"
+
+namespace dicom_viewer_windows {
+
+namespace {
+
+constexpr int kDisplayChars = 256;                   ///< Caracteres do valor exibidos na linha (o resto vai na dica)
+
+}
+
+/**
+ * @brief Construtor do modelo.
+ * @param parent Objeto pai (opcional).
+ */
+TagTreeModel::TagTreeModel(QObject *parent)
+    : QAbstractItemModel(parent)
+{
+    qRegisterMetaType<dicom_viewer_windows::TagSearchHit>();
+    qRegisterMetaType<QVector<dicom_viewer_windows::TagSearchHit>>();
+    // Uma thread para a leitura do arquivo e outra para a busca
+    pool.setMaxThreadCount(2);
+}
+
+/**
+ * @brief Destrutor. Cancela a leitura e a busca em andamento e aguarda as threads.
+ */
+TagTreeModel::~TagTreeModel()
+{
+    ++latestOpen;
+    ++latestSearch;
+    pool.clear();
+    pool.waitForDone();
+}
+
+/**
+ * @brief Lê um arquivo em segundo plano; o modelo é reiniciado quando a leitura termina.
+ *
+ * @param path Caminho do arquivo DICOM.
+ * @return Identificador da requisição.
+ */
+quint64 TagTreeModel::open(const QString &path)
+{
+    const quint64 requestId = ++latestOpen;
+    ++latestSearch;
+    beginResetModel();
+    this->tree.reset();
+    this->path = path;
+    endResetModel();
+
+    pool.start([this, requestId, path]() {
+        if (latestOpen.load() != requestId) {
+            return;
+        }
+        std::shared_ptr<dicom_viewer_core::DatasetTree> loaded = dicom_viewer_core::DatasetTree::open(path.toStdString());
+        // A árvore passa para a thread da interface, que é a única a tocá-la daqui em diante
+        QMetaObject::invokeMethod(this, [this, requestId, loaded]() {
+            if (latestOpen.load() != requestId) {
+                return;
+            }
+            beginResetModel();
+            this->tree = loaded;
+            if (this->tree) {
+                this->tree->materialize(this->tree->root(), this->tree->root().childTotal);
+            }
+            endResetModel();
+            emit opened(requestId, loaded != nullptr);
+        }, Qt::QueuedConnection);
+    });
+    return requestId;
+}
+
+/**
+ * @brief Esvazia o modelo e cancela a leitura e a busca em andamento.
+ */
+void TagTreeModel::clear()
+{
+    ++latestOpen;
+    ++latestSearch;
+    beginResetModel();
+    this->tree.reset();
+    this->path.clear();
+    endResetModel();
+}
+
+/**
+ * @brief Inicia uma busca no arquivo atual, cancelando a anterior.
+ *
+ * A busca lê o arquivo de novo em uma árvore própria (a árvore exibida não
+ * é thread-safe) e emite searchHits() a cada lote de ocorrências.
+ */
+quint64 TagTreeModel::search(const QString &query, bool includeLargeValues)
+{
+    const quint64 searchId = ++latestSearch;
+    if (this->path.isEmpty() || query.trimmed().isEmpty()) {
+        return 0;
+    }
+
+    const QString path = this->path;
+    const std::string needle = query.trimmed().toStdString();
+    pool.start([this, searchId, path, needle, includeLargeValues]() {
+        if (latestSearch.load() != searchId) {
+            return;
+        }
+        dicom_viewer_core::DatasetSearchOptions options;
+        options.includeLargeValues = includeLargeValues;
+        bool cancelled = false;
+        const std::size_t matches = dicom_viewer_core::searchDataset(path.toStdString(), needle, options,
+            [this, searchId, &cancelled](std::vector<dicom_viewer_core::DatasetMatch> &batch, int percent) {
+                if (latestSearch.load() != searchId) {
+                    cancelled = true;
+                    return false;
+                }
+                QVector<TagSearchHit> hits;
+                hits.reserve(static_cast<int>(batch.size()));
+                for (const dicom_viewer_core::DatasetMatch &match : batch) {
+                    TagSearchHit hit;
+                    hit.path = QVector<quint32>(match.path.begin(), match.path.end());
+                    hit.tag = QString::fromStdString(match.entry.tag);
+                    hit.name = QString::fromStdString(match.entry.name);
+                    hit.value = QString::fromStdString(match.entry.value).left(kDisplayChars);
+                    hits.append(hit);
+                }
+                emit searchHits(searchId, hits, percent);
+                return true;
+            });
+        if (!cancelled && latestSearch.load() == searchId) {
+            emit searchFinished(searchId, static_cast<int>(matches));
+        }
+    });
+    return searchId;
+}
+
+/**
+ * @brief Índice de um caminho entregue pela busca, materializando os nós do trajeto.
+ */
+QModelIndex TagTreeModel::indexForPath(const QVector<quint32> &path)
+{
+    if (!this->tree) {
+        return QModelIndex();
+    }
+    QModelIndex current;
+    dicom_viewer_core::DatasetNode *node = &this->tree->root();
+    for (quint32 row : path) {
+        ensureRows(current, node, static_cast<std::size_t>(row) + 1);
+        if (row >= node->children.size()) {
+            return QModelIndex();
+        }
+        current = index(static_cast<int>(row), 0, current);
+        node = node->children[row].get();
+    }
+    return current;
+}
+
+/**
+ * @brief Exibe o valor completo (ou o início, se binário) de um elemento adiado.
+ */
+void TagTreeModel::loadFullValue(const QModelIndex &index)
+{
+    dicom_viewer_core::DatasetNode *node = nodeFor(index);
+    if (!index.isValid() || !node || node->kind != dicom_viewer_core::DatasetNodeKind::Element || node->fullValue) {
+        return;
+    }
+    node->fullValue = true;
+    node->entry.reset();
+    emit dataChanged(index.siblingAtColumn(TagColumn), index.siblingAtColumn(ValueColumn));
+}
+
+/**
+ * @brief Nó de um índice; o índice inválido é a raiz.
+ */
+dicom_viewer_core::DatasetNode *TagTreeModel::nodeFor(const QModelIndex &index) const
+{
+    if (!this->tree) {
+        return nullptr;
+    }
+    if (!index.isValid()) {
+        return &this->tree->root();
+    }
+    return static_cast<dicom_viewer_core::DatasetNode *>(index.internalPointer());
+}
+
+/**
+ * @brief Materializa os filhos de node até count, notificando a vista.
+ */
+void TagTreeModel::ensureRows(const QModelIndex &parent, dicom_viewer_core::DatasetNode *node, std::size_t count)
+{
+    const std::size_t first = node->children.size();
+    const std::size_t last = std::min(count, node->childTotal);
+    if (last <= first) {
+        return;
+    }
+    beginInsertRows(parent, static_cast<int>(first), static_cast<int>(last - 1));
+    this->tree->materialize(*node, last);
+    endInsertRows();
+}
+
+QModelIndex TagTreeModel::index(int row, int column, const QModelIndex &parent) const
+{
+    if (!hasIndex(row, column, parent)) {
+        return QModelIndex();
+    }
+    dicom_viewer_core::DatasetNode *node = nodeFor(parent);
+    return createIndex(row, column, node->children[static_cast<std::size_t>(row)].get());
+}
+
+QModelIndex TagTreeModel::parent(const QModelIndex &child) const
+{
+    dicom_viewer_core::DatasetNode *node = child.isValid() ? nodeFor(child) : nullptr;
+    if (!node || !node->parent || node->parent == &this->tree->root()) {
+        return QModelIndex();
+    }
+    return createIndex(static_cast<int>(node->parent->row), 0, node->parent);
+}
+
+int TagTreeModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.column() > 0) {
+        return 0;
+    }
+    const dicom_viewer_core::DatasetNode *node = nodeFor(parent);
+    return node ? static_cast<int>(node->children.size()) : 0;
+}
+
+int TagTreeModel::columnCount(const QModelIndex &) const
+{
+    return ColumnCount;
+}
+
+/**
+ * @brief true se o nó tem filhos no arquivo, materializados ou não (a vista mostra o expansor).
+ */
+bool TagTreeModel::hasChildren(const QModelIndex &parent) const
+{
+    if (parent.column() > 0) {
+        return false;
+    }
+    const dicom_viewer_core::DatasetNode *node = nodeFor(parent);
+    return node && node->childTotal > 0;
+}
+
+bool TagTreeModel::canFetchMore(const QModelIndex &parent) const
+{
+    const dicom_viewer_core::DatasetNode *node = nodeFor(parent);
+    return node && node->children.size() < node->childTotal;
+}
+
+/**
+ * @brief Materializa o próximo lote de filhos; a vista chama ao expandir ou ao rolar até o fim.
+ */
+void TagTreeModel::fetchMore(const QModelIndex &parent)
+{
+    dicom_viewer_core::DatasetNode *node = nodeFor(parent);
+    if (node) {
+        ensureRows(parent, node, node->children.size() + fetchBatch);
+    }
+}
+
+QVariant TagTreeModel::data(const QModelIndex &index, int role) const
+{
+    dicom_viewer_core::DatasetNode *node = index.isValid() ? nodeFor(index) : nullptr;
+    if (!node) {
+        return QVariant();
+    }
+    using dicom_viewer_core::DatasetNodeKind;
+    const dicom_viewer_core::DatasetEntry &entry = dicom_viewer_core::DatasetTree::entry(*node);
+
+    if (role == Qt::FontRole && (index.column() == TagColumn || index.column() == VrColumn)) {
+        return QFontDatabase::systemFont(QFontDatabase::FixedFont);
+    }
+    if (role == Qt::ToolTipRole && index.column() == ValueColumn && !entry.deferred) {
+        return QString::fromStdString(entry.value);
+    }
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    switch (index.column()) {
+    case TagColumn:
+        switch (entry.kind) {
+        case DatasetNodeKind::MetaHeader:
+            return tr("Meta-informação do arquivo");
+        case DatasetNodeKind::Dataset:
+            return tr("Conjunto de dados");
+        case DatasetNodeKind::Item:
+            return tr("Item %1").arg(node->row + 1);
+        default:
+            return QString::fromStdString(entry.tag);
+        }
+    case NameColumn:
+        return QString::fromStdString(entry.name);
+    case VrColumn:
+        return QString::fromStdString(entry.vr);
+    case LengthColumn:
+        if (entry.kind != DatasetNodeKind::Element && entry.kind != DatasetNodeKind::Sequence) {
+            return QVariant();
+        }
+        return entry.undefinedLength ? tr("indefinido") : QString::number(entry.length);
+    case ValueColumn:
+        switch (entry.kind) {
+        case DatasetNodeKind::Sequence:
+            return tr("%1 itens").arg(entry.children);
+        case DatasetNodeKind::Element:
+            if (entry.deferred) {
+                return entry.undefinedLength ? tr("(encapsulado)")
+                                             : tr("(%1 bytes - clique duas vezes para ler)").arg(entry.length);
+            }
+            if (entry.truncated || entry.value.size() > static_cast<std::size_t>(kDisplayChars)) {
+                return QString::fromStdString(entry.value).left(kDisplayChars) + QStringLiteral("...");
+            }
+            return QString::fromStdString(entry.value);
+        default:
+            return tr("%1 elementos").arg(entry.children);
+        }
+    default:
+        return QVariant();
+    }
+}
+
+QVariant TagTreeModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    switch (section) {
+    case TagColumn:
+        return tr("Tag");
+    case NameColumn:
+        return tr("Nome");
+    case VrColumn:
+        return tr("VR");
+    case LengthColumn:
+        return tr("Tamanho");
+    case ValueColumn:
+        return tr("Valor");
+    default:
+        return QVariant();
+    }
+}
+
+}
@@ -0,0 +1,159 @@
+/**
+ * DICOM Viewer - Modelo da Árvore de Tags DICOM
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+#ifndef TAGTREEMODEL_H
+#define TAGTREEMODEL_H
+
+#include <atomic>
+#include <memory>
+
+#include <QAbstractItemModel>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+
+#include "../../core/DatasetTree.h"
+
+namespace dicom_viewer_windows {
+
+/**
+ * @struct TagSearchHit
+ * @brief Ocorrência de uma busca, com o caminho até o nó na árvore.
+ */
+struct TagSearchHit {
+    QVector<quint32> path;                           ///< Índices a partir da raiz (ver TagTreeModel::indexForPath)
+    QString tag;                                     ///< "(gggg,eeee)"
+    QString name;                                    ///< Nome no dicionário
+    QString value;                                   ///< Valor formatado (vazio se adiado)
+};
+
+/**
+ * @class TagTreeModel
+ * @brief Modelo Qt sobre a árvore completa de um arquivo DICOM, materializada sob demanda.
+ *
+ * O arquivo é lido fora da thread da interface. A árvore expõe o
+ * cabeçalho de meta-informação e o conjunto de dados, com sequências e
+ * itens aninhados; os filhos de um nó só são criados quando a vista pede
+ * (canFetchMore/fetchMore), em lotes de fetchBatch, de modo que expandir uma
+ * sequência com centenas de milhares de itens custa apenas as linhas
+ * visíveis. Valores grandes ou binários são exibidos como tamanho até que
+ * loadFullValue() seja chamado.
+ *
+ * A busca roda em uma thread própria sobre uma segunda leitura do arquivo e
+ * entrega as ocorrências em lotes; uma nova busca (ou um novo arquivo)
+ * cancela a anterior.
+ */
+class TagTreeModel : public QAbstractItemModel
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Colunas do modelo.
+     */
+    enum Column { TagColumn, NameColumn, VrColumn, LengthColumn, ValueColumn, ColumnCount };
+
+    static constexpr int fetchBatch = 500;           ///< Filhos materializados por fetchMore()
+
+    /**
+     * @brief Construtor do modelo.
+     * @param parent Objeto pai (opcional).
+     */
+    explicit TagTreeModel(QObject *parent = nullptr);
+
+    /**
+     * @brief Destrutor. Cancela a leitura e a busca em andamento e aguarda as threads.
+     */
+    ~TagTreeModel();
+
+    /**
+     * @brief Lê um arquivo em segundo plano; o modelo é reiniciado quando a leitura termina.
+     * @param path Caminho do arquivo DICOM.
+     * @return Identificador da requisição.
+     */
+    quint64 open(const QString &path);
+
+    /**
+     * @brief Esvazia o modelo e cancela a leitura e a busca em andamento.
+     */
+    void clear();
+
+    /**
+     * @brief Arquivo exibido (ou em leitura).
+     */
+    QString filePath() const { return this->path; }
+
+    /**
+     * @brief Inicia uma busca no arquivo atual, cancelando a anterior.
+     * @param query Texto procurado na tag, no nome ou no valor.
+     * @param includeLargeValues Se true, os valores adiados são lidos do disco e comparados.
+     * @return Identificador da busca (0 se não há arquivo ou o texto é vazio).
+     */
+    quint64 search(const QString &query, bool includeLargeValues);
+
+    /**
+     * @brief Cancela a busca em andamento.
+     */
+    void cancelSearch() { ++this->latestSearch; }
+
+    /**
+     * @brief Índice de um caminho entregue pela busca, materializando os nós do trajeto.
+     */
+    QModelIndex indexForPath(const QVector<quint32> &path);
+
+    /**
+     * @brief Exibe o valor completo (ou o início, se binário) de um elemento adiado.
+     */
+    void loadFullValue(const QModelIndex &index);
+
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex &child) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+signals:
+    /**
+     * @brief Emitido quando a leitura de open() termina.
+     * @param ok false se o arquivo não pôde ser lido.
+     */
+    void opened(quint64 requestId, bool ok);
+
+    /**
+     * @brief Emitido a cada lote de ocorrências (possivelmente vazio, para o progresso).
+     */
+    void searchHits(quint64 searchId, const QVector<dicom_viewer_windows::TagSearchHit> &hits, int percent);
+
+    /**
+     * @brief Emitido quando a busca termina sem ser cancelada.
+     */
+    void searchFinished(quint64 searchId, int matches);
+
+private:
+    dicom_viewer_core::DatasetNode *nodeFor(const QModelIndex &index) const;
+
+    /**
+     * @brief Materializa os filhos de node até count, notificando a vista.
+     */
+    void ensureRows(const QModelIndex &parent, dicom_viewer_core::DatasetNode *node, std::size_t count);
+
+    QString path;
+    std::shared_ptr<dicom_viewer_core::DatasetTree> tree;   ///< Acessada apenas pela thread da interface
+    QThreadPool pool;
+    std::atomic<quint64> latestOpen{0};
+    std::atomic<quint64> latestSearch{0};
+};
+
+}
+
+Q_DECLARE_METATYPE(dicom_viewer_windows::TagSearchHit)
+
+#endif // TAGTREEMODEL_H
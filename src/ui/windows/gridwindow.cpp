@@ -0,0 +1,502 @@
+/**
+ * DICOM Viewer - Janela de Comparação em Grade
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+/**
+ * @file gridwindow.cpp
+ * @brief Implementação da classe GridWindow.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <QHBoxLayout>
+#include <QMouseEvent>
+#include <QTimer>
+#include <QVBoxLayout>
+#include <QWheelEvent>
+
+#include "gridwindow.h"
+#include "utils.h"
+#include "../../core/ThreadPool.h"
+#include "../../core/Trace.h"
+#include "../../core/WindowLevel.h"
+
+namespace dicom_viewer_windows {
+
+namespace {
+
+constexpr double kZoomStep = 1.15;
+
+const char *const kActiveStyle = "QGraphicsView { border: 2px solid #3c8cff; }";
+const char *const kInactiveStyle = "QGraphicsView { border: 2px solid #202020; }";
+
+}
+
+/**
+ * @brief Construtor da janela, com a grade 1x2.
+ * @param parent Widget pai (opcional).
+ */
+GridWindow::GridWindow(QWidget *parent)
+    : QWidget(parent, Qt::Window)
+{
+    setWindowTitle(tr("Comparação em Grade"));
+    resize(1400, 900);
+
+    this->seriesCache = new SeriesCache(this);
+    connect(this->seriesCache, &SeriesCache::ready, this, &GridWindow::onSeriesReady);
+    connect(this->seriesCache, &SeriesCache::failed, this, &GridWindow::onSeriesFailed);
+
+    this->layoutCombo = new QComboBox(this);
+    this->layoutCombo->addItem(tr("1 x 2"), QSize(2, 1));
+    this->layoutCombo->addItem(tr("2 x 2"), QSize(2, 2));
+    this->layoutCombo->addItem(tr("3 x 3"), QSize(3, 3));
+    connect(this->layoutCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index) {
+        const QSize grid = this->layoutCombo->itemData(index).toSize();
+        setGrid(grid.height(), grid.width());
+    });
+    this->syncScrollCheck = new QCheckBox(tr("Sincronizar cortes"), this);
+    this->syncZoomCheck = new QCheckBox(tr("Sincronizar zoom"), this);
+    this->syncWindowCheck = new QCheckBox(tr("Sincronizar janela"), this);
+    this->syncScrollCheck->setChecked(true);
+    this->syncZoomCheck->setChecked(true);
+    this->syncWindowCheck->setChecked(true);
+
+    QWidget *controls = new QWidget(this);
+    QHBoxLayout *controlLayout = new QHBoxLayout(controls);
+    controlLayout->setContentsMargins(0, 0, 0, 0);
+    controlLayout->addWidget(new QLabel(tr("Grade"), controls));
+    controlLayout->addWidget(this->layoutCombo);
+    controlLayout->addWidget(this->syncScrollCheck);
+    controlLayout->addWidget(this->syncZoomCheck);
+    controlLayout->addWidget(this->syncWindowCheck);
+    controlLayout->addStretch(1);
+
+    this->gridLayout = new QGridLayout();
+    this->gridLayout->setSpacing(2);
+    for (Viewport &viewport : this->viewports) {
+        viewport.scene = new QGraphicsScene(this);
+        viewport.scene->setBackgroundBrush(Qt::black);
+        viewport.view = new QGraphicsView(viewport.scene, this);
+        viewport.view->setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
+        viewport.view->setDragMode(QGraphicsView::ScrollHandDrag);
+        viewport.view->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+        viewport.view->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+        viewport.view->setStyleSheet(kInactiveStyle);
+        viewport.view->viewport()->installEventFilter(this);
+        viewport.view->hide();
+        viewport.item = new ImageItem();
+        viewport.scene->addItem(viewport.item);
+        viewport.caption = new QLabel(viewport.view->viewport());
+        viewport.caption->setStyleSheet("color: white; background: transparent;");
+        viewport.caption->setAttribute(Qt::WA_TransparentForMouseEvents);
+        viewport.caption->move(6, 4);
+    }
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addWidget(controls);
+    layout->addLayout(this->gridLayout, 1);
+
+    setGrid(1, 2);
+    setActive(0);
+}
+
+/**
+ * @brief Destrutor. Aguarda as renderizações em andamento.
+ *
+ * Resultados ainda na fila de eventos são descartados pelo Qt junto com a janela.
+ */
+GridWindow::~GridWindow()
+{
+    this->renderPool.clear();
+    this->renderPool.waitForDone();
+}
+
+/**
+ * @brief Reorganiza a grade com rows x columns vistas visíveis.
+ *
+ * As vistas além da grade ficam ocultas e mantêm a série; voltam a
+ * aparecer, com o mesmo estado, se a grade aumentar.
+ */
+void GridWindow::setGrid(int rows, int columns)
+{
+    for (Viewport &viewport : this->viewports) {
+        this->gridLayout->removeWidget(viewport.view);
+        viewport.view->hide();
+    }
+    this->visibleCount = std::min(rows * columns, maxViewports);
+    for (int index = 0; index < this->visibleCount; ++index) {
+        this->gridLayout->addWidget(this->viewports[index].view, index / columns, index % columns);
+        this->viewports[index].view->show();
+    }
+    if (this->active >= this->visibleCount) {
+        setActive(0);
+    }
+    // Os tamanhos das vistas só são conhecidos depois do novo layout
+    QTimer::singleShot(0, this, [this]() {
+        for (int index = 0; index < this->visibleCount; ++index) {
+            Viewport &viewport = this->viewports[index];
+            if (!viewport.item->image().isNull()) {
+                viewport.view->fitInView(viewport.item, Qt::KeepAspectRatio);
+            }
+        }
+    });
+}
+
+/**
+ * @brief Destaca a vista ativa (a que recebe a próxima série).
+ */
+void GridWindow::setActive(int index)
+{
+    this->viewports[this->active].view->setStyleSheet(kInactiveStyle);
+    this->active = index;
+    this->viewports[this->active].view->setStyleSheet(kActiveStyle);
+}
+
+/**
+ * @brief Exibe uma série na vista ativa e ativa a vista seguinte.
+ *
+ * Se outra vista já exibe a série, o volume é compartilhado; senão o
+ * SeriesCache a carrega, uma única vez mesmo que várias vistas a peçam.
+ *
+ * @param files Arquivos da série.
+ * @param label Descrição exibida na vista.
+ */
+void GridWindow::showSeries(const QStringList &files, const QString &label)
+{
+    const int index = this->active;
+    Viewport &viewport = this->viewports[index];
+    viewport.key = SeriesCache::keyFor(files);
+    viewport.label = label;
+    if (std::shared_ptr<const dicom_viewer_core::Volume> shared = this->seriesCache->volume(viewport.key)) {
+        assignVolume(index, std::move(shared));
+    } else {
+        viewport.volume.reset();
+        ++viewport.generation;
+        viewport.item->setImage(QImage());
+        viewport.caption->setText(tr("%1\nCarregando...").arg(label));
+        viewport.caption->adjustSize();
+        this->seriesCache->request(viewport.key, files);
+    }
+    setActive((index + 1) % this->visibleCount);
+}
+
+/**
+ * @brief Exibe um volume já carregado na vista ativa e ativa a vista seguinte.
+ * @param volume Volume da série.
+ * @param label Descrição exibida na vista.
+ * @param files Arquivos da série, se conhecidos, para compartilhá-la com outras vistas.
+ */
+void GridWindow::showVolume(std::shared_ptr<const dicom_viewer_core::Volume> volume, const QString &label,
+                            const QStringList &files)
+{
+    if (!volume || !volume->isValid()) {
+        return;
+    }
+    const int index = this->active;
+    Viewport &viewport = this->viewports[index];
+    viewport.key = files.isEmpty() ? QString() : SeriesCache::keyFor(files);
+    viewport.label = label;
+    this->seriesCache->insert(viewport.key, volume);
+    assignVolume(index, std::move(volume));
+    setActive((index + 1) % this->visibleCount);
+}
+
+/**
+ * @brief Define a maior série carregada em memória pelas vistas; as maiores são recusadas.
+ * @param bytes Limite em bytes de voxels (o mesmo da janela principal).
+ */
+void GridWindow::setInMemorySeriesLimit(std::size_t bytes)
+{
+    this->seriesCache->setInMemoryLimit(bytes);
+}
+
+/**
+ * @brief Passa a exibir um volume na vista, no corte central.
+ *
+ * A janela inicial e a sensibilidade do arraste vêm do corte central.
+ */
+void GridWindow::assignVolume(int index, std::shared_ptr<const dicom_viewer_core::Volume> volume)
+{
+    Viewport &viewport = this->viewports[index];
+    viewport.volume = std::move(volume);
+    ++viewport.generation;
+    viewport.slice = viewport.volume->depth / 2;
+    viewport.position = viewport.slice * viewport.volume->spacingZ;
+
+    const dicom_viewer_core::MedicalImage middle = dicom_viewer_core::extractSlice(*viewport.volume, viewport.slice);
+    defaultWindow(middle, viewport.windowCenter, viewport.windowWidth);
+    double minValue = 0.0;
+    double maxValue = 0.0;
+    if (dicom_viewer_core::computeValueRange(middle, minValue, maxValue, dicom_viewer_core::ThreadPool::shared())) {
+        viewport.windowStep = std::max((maxValue - minValue) / 1024.0, 0.01);
+    }
+    viewport.fitPending = true;
+    updateCaption(viewport);
+    requestRender(index);
+}
+
+/**
+ * @brief Entrega o volume carregado às vistas que aguardam a série.
+ */
+void GridWindow::onSeriesReady(const QString &key)
+{
+    const std::shared_ptr<const dicom_viewer_core::Volume> loaded = this->seriesCache->volume(key);
+    if (!loaded) {
+        return;
+    }
+    for (int index = 0; index < maxViewports; ++index) {
+        Viewport &viewport = this->viewports[index];
+        if (viewport.key == key && viewport.volume != loaded) {
+            assignVolume(index, loaded);
+        }
+    }
+}
+
+/**
+ * @brief Informa nas vistas que aguardam a série que ela não pôde ser carregada.
+ */
+void GridWindow::onSeriesFailed(const QString &key, const QString &reason)
+{
+    for (Viewport &viewport : this->viewports) {
+        if (viewport.key == key && !viewport.volume) {
+            viewport.caption->setText(tr("%1\n%2").arg(viewport.label, reason));
+            viewport.caption->adjustSize();
+        }
+    }
+}
+
+/**
+ * @brief Percorre os cortes a partir de uma vista e, com a sincronização ativa, nas demais.
+ *
+ * As outras vistas andam a mesma distância em mm, não o mesmo número de
+ * cortes, de modo que séries com espessuras diferentes continuam
+ * alinhadas. O deslocamento entre as séries é mantido: para alinhar um
+ * estudo anterior, basta posicioná-lo com a sincronização desligada.
+ */
+void GridWindow::scroll(int index, int steps)
+{
+    Viewport &source = this->viewports[index];
+    if (!source.volume) {
+        return;
+    }
+    const double extent = (source.volume->depth - 1) * source.volume->spacingZ;
+    const double target = std::clamp(source.position + steps * source.volume->spacingZ, 0.0, extent);
+    const double delta = target - source.position;
+    moveTo(index, target);
+    if (!this->syncScrollCheck->isChecked() || delta == 0.0) {
+        return;
+    }
+    for (int other = 0; other < this->visibleCount; ++other) {
+        if (other != index && this->viewports[other].volume) {
+            moveTo(other, this->viewports[other].position + delta);
+        }
+    }
+}
+
+/**
+ * @brief Move a vista para uma posição em mm; exibe o corte mais próximo dentro da pilha.
+ *
+ * A posição não é limitada, para que o deslocamento em relação às outras
+ * vistas se mantenha quando uma delas chega ao fim da pilha e volta.
+ */
+void GridWindow::moveTo(int index, double position)
+{
+    Viewport &viewport = this->viewports[index];
+    viewport.position = position;
+    const int slice = std::clamp(static_cast<int>(std::lround(position / viewport.volume->spacingZ)), 0,
+                                 viewport.volume->depth - 1);
+    if (slice != viewport.slice) {
+        viewport.slice = slice;
+        requestRender(index);
+    }
+}
+
+/**
+ * @brief Agenda a renderização da vista, agrupando pedidos durante uma renderização.
+ *
+ * A thread extrai o corte e aplica a janela no buffer reserva da vista.
+ * Cada vista tem no máximo uma renderização em andamento; pedidos feitos
+ * nesse intervalo resultam em uma única renderização, com o estado mais
+ * recente, quando ela termina.
+ */
+void GridWindow::requestRender(int index)
+{
+    Viewport &viewport = this->viewports[index];
+    if (!viewport.volume) {
+        return;
+    }
+    if (viewport.rendering) {
+        viewport.renderPending = true;
+        return;
+    }
+    viewport.rendering = true;
+    viewport.renderPending = false;
+
+    std::shared_ptr<const dicom_viewer_core::Volume> volume = viewport.volume;
+    const int slice = viewport.slice;
+    const double center = viewport.windowCenter;
+    const double width = viewport.windowWidth;
+    const quint64 generation = viewport.generation;
+    QImage target = std::move(viewport.spare);
+    viewport.spare = QImage();
+    this->renderPool.start([this, index, volume, slice, center, width, generation, target = std::move(target)]() mutable {
+        DICOM_TRACE_SCOPE(traceScope, "viewport", "ui");
+        const dicom_viewer_core::MedicalImage image = dicom_viewer_core::extractSlice(*volume, slice);
+        if (!renderWindowLevel(image, center, width, target)) {
+            target = convertMedicalImage(image).copy();
+        }
+        QMetaObject::invokeMethod(this, [this, index, generation, target = std::move(target)]() mutable {
+            onRendered(index, generation, std::move(target));
+        }, Qt::QueuedConnection);
+    });
+}
+
+/**
+ * @brief Exibe o resultado de uma renderização e inicia a pendente, se houver.
+ *
+ * A imagem que sai de exibição vira o buffer reserva da próxima
+ * renderização, de modo que percorrer os cortes não aloca memória.
+ *
+ * @param generation Geração do volume renderizado; resultados de um volume anterior são descartados.
+ */
+void GridWindow::onRendered(int index, quint64 generation, QImage image)
+{
+    Viewport &viewport = this->viewports[index];
+    viewport.rendering = false;
+    if (generation != viewport.generation || image.isNull()) {
+        viewport.spare = std::move(image);
+    } else {
+        QImage shown = viewport.item->takeImage();
+        const bool resized = image.size() != shown.size();
+        viewport.item->setImage(std::move(image));
+        viewport.spare = std::move(shown);
+        if (resized || viewport.fitPending) {
+            viewport.scene->setSceneRect(viewport.item->boundingRect());
+        }
+        if (viewport.fitPending) {
+            viewport.view->fitInView(viewport.item, Qt::KeepAspectRatio);
+            viewport.fitPending = false;
+        }
+        updateCaption(viewport);
+    }
+    if (viewport.renderPending) {
+        requestRender(index);
+    }
+}
+
+/**
+ * @brief Atualiza o texto sobreposto à vista.
+ */
+void GridWindow::updateCaption(Viewport &viewport)
+{
+    if (!viewport.volume) {
+        return;
+    }
+    viewport.caption->setText(tr("%1\nCorte %2/%3 · W/L %4/%5")
+                                  .arg(viewport.label)
+                                  .arg(viewport.slice + 1)
+                                  .arg(viewport.volume->depth)
+                                  .arg(viewport.windowWidth, 0, 'f', 0)
+                                  .arg(viewport.windowCenter, 0, 'f', 0));
+    viewport.caption->adjustSize();
+}
+
+int GridWindow::indexFor(QObject *viewport) const
+{
+    for (int index = 0; index < maxViewports; ++index) {
+        if (this->viewports[index].view->viewport() == viewport) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Trata o mouse sobre as vistas.
+ *
+ * Qualquer clique ativa a vista; o arraste com o botão esquerdo é tratado
+ * pelo próprio QGraphicsView.
+ */
+bool GridWindow::eventFilter(QObject *watched, QEvent *event)
+{
+    const int index = indexFor(watched);
+    if (index < 0) {
+        return QWidget::eventFilter(watched, event);
+    }
+    Viewport &viewport = this->viewports[index];
+
+    switch (event->type()) {
+    case QEvent::MouseButtonPress: {
+        QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(event);
+        setActive(index);
+        if (mouseEvent->button() == Qt::RightButton) {
+            this->draggingWindow = true;
+            this->dragOrigin = mouseEvent->position().toPoint();
+            return true;
+        }
+        break;
+    }
+    case QEvent::MouseMove: {
+        if (!this->draggingWindow) {
+            break;
+        }
+        QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(event);
+        const QPoint position = mouseEvent->position().toPoint();
+        const QPoint delta = position - this->dragOrigin;
+        this->dragOrigin = position;
+        if (!viewport.volume) {
+            return true;
+        }
+        viewport.windowWidth = std::max(1.0, viewport.windowWidth + delta.x() * viewport.windowStep);
+        viewport.windowCenter += delta.y() * viewport.windowStep;
+        for (int other = 0; other < this->visibleCount; ++other) {
+            Viewport &target = this->viewports[other];
+            if (other != index && (!this->syncWindowCheck->isChecked() || !target.volume)) {
+                continue;
+            }
+            target.windowCenter = viewport.windowCenter;
+            target.windowWidth = viewport.windowWidth;
+            requestRender(other);
+        }
+        return true;
+    }
+    case QEvent::MouseButtonRelease:
+        if (static_cast<QMouseEvent *>(event)->button() == Qt::RightButton) {
+            this->draggingWindow = false;
+            return true;
+        }
+        break;
+    case QEvent::Wheel: {
+        QWheelEvent *wheelEvent = static_cast<QWheelEvent *>(event);
+        const int steps = wheelEvent->angleDelta().y() / 120;
+        if (steps == 0) {
+            return true;
+        }
+        if (wheelEvent->modifiers() & Qt::ControlModifier) {
+            // Sem o cursor sobre elas, as outras vistas aproximam em torno do centro
+            const double factor = std::pow(kZoomStep, steps);
+            for (int other = 0; other < this->visibleCount; ++other) {
+                if (other == index || (this->syncZoomCheck->isChecked() && this->viewports[other].volume)) {
+                    this->viewports[other].view->scale(factor, factor);
+                }
+            }
+        } else {
+            // Roda para baixo avança para o próximo corte
+            scroll(index, -steps);
+        }
+        return true;
+    }
+    case QEvent::ContextMenu:
+        return true;
+    default:
+        break;
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+}
@@ -0,0 +1,184 @@
+/**
+ * DICOM Viewer - Janela de Comparação em Grade
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+#ifndef GRIDWINDOW_H
+#define GRIDWINDOW_H
+
+#include <array>
+#include <cstddef>
+#include <memory>
+
+#include <QWidget>
+#include <QGraphicsView>
+#include <QGraphicsScene>
+#include <QGridLayout>
+#include <QCheckBox>
+#include <QComboBox>
+#include <QLabel>
+#include <QThreadPool>
+
+#include "imageitem.h"
+#include "../services/seriescache.h"
+#include "../../core/Volume.h"
+
+namespace dicom_viewer_windows {
+
+/**
+ * @class GridWindow
+ * @brief Grade de vistas (1x2, 2x2 ou 3x3) para comparar séries e estudos lado a lado.
+ *
+ * Cada vista exibe os cortes de uma série. A roda percorre os cortes,
+ * Ctrl+roda aproxima, o botão esquerdo arrasta e o botão direito ajusta a
+ * janela. Com a sincronização ativa, cortes (pelo deslocamento em mm),
+ * zoom e janela acompanham a vista sob o cursor em todas as outras.
+ *
+ * Vistas da mesma série compartilham o volume pelo SeriesCache. Cada vista
+ * é janelada em uma thread do pool da janela, em um buffer reserva que é
+ * trocado com o exibido ao terminar; mudanças que chegam durante uma
+ * renderização são agrupadas em uma única renderização seguinte.
+ */
+class GridWindow : public QWidget
+{
+    Q_OBJECT
+
+public:
+    static constexpr int maxViewports = 9;            ///< Vistas da maior grade (3x3)
+
+    /**
+     * @brief Construtor da janela, com a grade 1x2.
+     * @param parent Widget pai (opcional).
+     */
+    explicit GridWindow(QWidget *parent = nullptr);
+
+    /**
+     * @brief Destrutor. Aguarda as renderizações em andamento.
+     */
+    ~GridWindow();
+
+    /**
+     * @brief Exibe uma série na vista ativa e ativa a vista seguinte.
+     * @param files Arquivos da série.
+     * @param label Descrição exibida na vista.
+     */
+    void showSeries(const QStringList &files, const QString &label);
+
+    /**
+     * @brief Exibe um volume já carregado na vista ativa e ativa a vista seguinte.
+     * @param volume Volume da série.
+     * @param label Descrição exibida na vista.
+     * @param files Arquivos da série, se conhecidos, para compartilhá-la com outras vistas.
+     */
+    void showVolume(std::shared_ptr<const dicom_viewer_core::Volume> volume, const QString &label,
+                    const QStringList &files = QStringList());
+
+    /**
+     * @brief Define a maior série carregada em memória pelas vistas; as maiores são recusadas.
+     * @param bytes Limite em bytes de voxels (o mesmo da janela principal).
+     */
+    void setInMemorySeriesLimit(std::size_t bytes);
+
+protected:
+    /**
+     * @brief Trata o mouse sobre as vistas.
+     */
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    /**
+     * @struct Viewport
+     * @brief Estado de uma vista da grade.
+     */
+    struct Viewport {
+        QGraphicsView *view = nullptr;
+        QGraphicsScene *scene = nullptr;
+        ImageItem *item = nullptr;
+        QLabel *caption = nullptr;
+        QString key;                                  ///< Série exibida (ou aguardada) no SeriesCache
+        QString label;
+        std::shared_ptr<const dicom_viewer_core::Volume> volume;
+        int slice = 0;
+        double position = 0.0;                        ///< Posição ao longo da pilha, em mm
+        double windowCenter = 0.0;
+        double windowWidth = 1.0;
+        double windowStep = 1.0;
+        quint64 generation = 0;                       ///< Incrementada a cada troca de volume
+        QImage spare;                                 ///< Buffer reserva da próxima renderização
+        bool rendering = false;
+        bool renderPending = false;
+        bool fitPending = false;                      ///< Enquadrar ao receber a primeira imagem
+    };
+
+    /**
+     * @brief Reorganiza a grade com rows x columns vistas visíveis.
+     */
+    void setGrid(int rows, int columns);
+
+    /**
+     * @brief Destaca a vista ativa (a que recebe a próxima série).
+     */
+    void setActive(int index);
+
+    /**
+     * @brief Passa a exibir um volume na vista, no corte central.
+     */
+    void assignVolume(int index, std::shared_ptr<const dicom_viewer_core::Volume> volume);
+
+    /**
+     * @brief Entrega o volume carregado às vistas que aguardam a série.
+     */
+    void onSeriesReady(const QString &key);
+
+    /**
+     * @brief Informa nas vistas que aguardam a série que ela não pôde ser carregada.
+     */
+    void onSeriesFailed(const QString &key, const QString &reason);
+
+    /**
+     * @brief Percorre os cortes a partir de uma vista e, com a sincronização ativa, nas demais.
+     */
+    void scroll(int index, int steps);
+
+    /**
+     * @brief Move a vista para uma posição em mm; exibe o corte mais próximo dentro da pilha.
+     */
+    void moveTo(int index, double position);
+
+    /**
+     * @brief Agenda a renderização da vista, agrupando pedidos durante uma renderização.
+     */
+    void requestRender(int index);
+
+    /**
+     * @brief Exibe o resultado de uma renderização e inicia a pendente, se houver.
+     * @param generation Geração do volume renderizado; resultados de um volume anterior são descartados.
+     */
+    void onRendered(int index, quint64 generation, QImage image);
+
+    /**
+     * @brief Atualiza o texto sobreposto à vista.
+     */
+    void updateCaption(Viewport &viewport);
+
+    int indexFor(QObject *viewport) const;
+
+    std::array<Viewport, maxViewports> viewports;
+    SeriesCache *seriesCache = nullptr;
+    QThreadPool renderPool;                           ///< Renderizações das vistas, em paralelo
+    QGridLayout *gridLayout = nullptr;
+    QComboBox *layoutCombo = nullptr;
+    QCheckBox *syncScrollCheck = nullptr;
+    QCheckBox *syncZoomCheck = nullptr;
+    QCheckBox *syncWindowCheck = nullptr;
+    int visibleCount = 2;
+    int active = 0;
+    bool draggingWindow = false;
+    QPoint dragOrigin;
+};
+
+}
+
+#endif // GRIDWINDOW_H
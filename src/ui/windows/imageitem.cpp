@@ -0,0 +1,210 @@
+/**
+ * DICOM Viewer - Item de Cena para Imagens
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+/**
+ * @file imageitem.cpp
+ * @brief Implementação da classe ImageItem.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+
+#include "imageitem.h"
+#include "../../core/ThreadPool.h"
+#include "../../core/Trace.h"
+
+namespace dicom_viewer_windows {
+
+namespace {
+
+/**
+ * @brief Orçamento padrão do cache de ladrilhos.
+ */
+constexpr std::size_t kDefaultTileBudget = 128u * 1024u * 1024u;
+
+/**
+ * @brief Chave de um ladrilho: nível, coluna e linha.
+ */
+std::uint64_t tileKey(int level, int column, int row) {
+    return (static_cast<std::uint64_t>(level) << 48) | (static_cast<std::uint64_t>(column) << 24) |
+           static_cast<std::uint64_t>(row);
+}
+
+}
+
+/**
+ * @brief Construtor do item.
+ * @param parent Item pai (opcional).
+ */
+ImageItem::ImageItem(QGraphicsItem *parent)
+    : QGraphicsObject(parent)
+    , tiles(kDefaultTileBudget)
+{
+    // Necessário para que exposedRect seja preenchido em paint()
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
+/**
+ * @brief Destrutor. Interrompe a construção da pirâmide.
+ */
+ImageItem::~ImageItem()
+{
+    releasePyramid();
+}
+
+/**
+ * @brief Troca a imagem exibida e reinicia a pirâmide.
+ */
+void ImageItem::setImage(QImage image)
+{
+    if (image.size() != extent) {
+        prepareGeometryChange();
+        extent = image.size();
+    }
+    releasePyramid();
+    displayed = std::move(image);
+
+    const bool tiled = std::max(displayed.width(), displayed.height()) > pyramidThreshold &&
+                       (displayed.format() == QImage::Format_Grayscale8 || displayed.format() == QImage::Format_RGB888);
+    if (tiled) {
+        const int channels = displayed.format() == QImage::Format_RGB888 ? 3 : 1;
+        // A cópia rasa mantém os pixels do nível 0 vivos enquanto a pirâmide existir
+        auto owner = std::make_shared<const QImage>(displayed);
+        const uint8_t* pixels = owner->constBits();
+        pyramid = dicom_viewer_core::ImagePyramid::build(
+            pixels, owner->width(), owner->height(), static_cast<std::size_t>(owner->bytesPerLine()), channels, owner,
+            dicom_viewer_core::ThreadPool::shared(), [this](int) {
+                // Chamada na thread de construção; a atualização é feita na thread do item
+                QMetaObject::invokeMethod(this, [this]() { update(); }, Qt::QueuedConnection);
+            }, tileSize);
+    }
+    update();
+}
+
+/**
+ * @brief Retira a imagem do item, deixando-o vazio.
+ */
+QImage ImageItem::takeImage()
+{
+    releasePyramid();
+    QImage taken = std::move(displayed);
+    displayed = QImage();
+    return taken;
+}
+
+/**
+ * @brief Define o orçamento, em bytes, do cache de ladrilhos.
+ */
+void ImageItem::setTileBudget(std::size_t bytes)
+{
+    tiles.setBudget(bytes);
+}
+
+/**
+ * @brief Descarta a pirâmide atual e os seus ladrilhos.
+ */
+void ImageItem::releasePyramid()
+{
+    if (pyramid) {
+        // Após cancel() a notificação não é mais chamada, então `this` não é usado depois de destruído
+        pyramid->cancel();
+        pyramid.reset();
+    }
+    tiles.clear();
+}
+
+/**
+ * @brief Retângulo ocupado pela imagem, em coordenadas do item.
+ */
+QRectF ImageItem::boundingRect() const
+{
+    return QRectF(QPointF(0, 0), QSizeF(extent));
+}
+
+/**
+ * @brief Ladrilho do cache, convertendo-o para QPixmap se necessário.
+ */
+std::shared_ptr<const QPixmap> ImageItem::tile(int level, int column, int row)
+{
+    const std::uint64_t key = tileKey(level, column, row);
+    std::shared_ptr<const QPixmap> cached = tiles.get(key);
+    if (cached) {
+        return cached;
+    }
+    DICOM_TRACE_SCOPE(traceScope, "pixmap", "ui");
+    const dicom_viewer_core::PyramidLevel &source = pyramid->level(level);
+    const int x = column * tileSize;
+    const int y = row * tileSize;
+    const int width = std::min(tileSize, source.width - x);
+    const int height = std::min(tileSize, source.height - y);
+    const int channels = pyramid->channels();
+    const uchar *origin = source.pixels + static_cast<std::size_t>(y) * source.stride + static_cast<std::size_t>(x) * channels;
+
+    // Visão sem cópia sobre o nível; a única cópia é a conversão para QPixmap
+    const QImage view(origin, width, height, static_cast<qsizetype>(source.stride),
+                      channels == 3 ? QImage::Format_RGB888 : QImage::Format_Grayscale8);
+    auto pixmap = std::make_shared<const QPixmap>(QPixmap::fromImage(view));
+    const std::size_t cost = static_cast<std::size_t>(pixmap->width()) * pixmap->height() * std::max(1, pixmap->depth() / 8);
+    tiles.put(key, pixmap, cost);
+    DICOM_TRACE_BYTES(traceScope, cost);
+    DICOM_TRACE_COUNTER("tile cache MB", tiles.counters().usedBytes / (1024.0 * 1024.0));
+    return pixmap;
+}
+
+/**
+ * @brief Desenha a parte exposta da imagem.
+ *
+ * Com a pirâmide, escolhe o nível pela escala atual da vista e desenha
+ * apenas os ladrilhos visíveis; enquanto os níveis reduzidos não ficam
+ * prontos, usa o nível pronto mais próximo.
+ */
+void ImageItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(widget);
+    if (displayed.isNull()) {
+        return;
+    }
+    const QRectF exposed = option->exposedRect.intersected(boundingRect());
+    if (exposed.isEmpty()) {
+        return;
+    }
+    DICOM_TRACE_SCOPE(traceScope, "paint", "ui");
+    if (!pyramid) {
+        painter->drawImage(exposed, displayed, exposed);
+        return;
+    }
+
+    const qreal scale = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    const int level = pyramid->levelForScale(scale);
+    const dicom_viewer_core::PyramidLevel &source = pyramid->level(level);
+    const qreal scaleX = static_cast<qreal>(extent.width()) / source.width;
+    const qreal scaleY = static_cast<qreal>(extent.height()) / source.height;
+
+    const int columns = (source.width + tileSize - 1) / tileSize;
+    const int rows = (source.height + tileSize - 1) / tileSize;
+    const int firstColumn = std::clamp(static_cast<int>(std::floor(exposed.left() / scaleX / tileSize)), 0, columns - 1);
+    const int lastColumn = std::clamp(static_cast<int>(std::ceil(exposed.right() / scaleX / tileSize)) - 1, 0, columns - 1);
+    const int firstRow = std::clamp(static_cast<int>(std::floor(exposed.top() / scaleY / tileSize)), 0, rows - 1);
+    const int lastRow = std::clamp(static_cast<int>(std::ceil(exposed.bottom() / scaleY / tileSize)) - 1, 0, rows - 1);
+
+    // Redução suavizada; ampliação mostra os pixels como são
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, scale < 1.0);
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            const std::shared_ptr<const QPixmap> pixmap = tile(level, column, row);
+            const QRectF target(column * tileSize * scaleX, row * tileSize * scaleY,
+                                pixmap->width() * scaleX, pixmap->height() * scaleY);
+            painter->drawPixmap(target, *pixmap, QRectF(pixmap->rect()));
+        }
+    }
+}
+
+}
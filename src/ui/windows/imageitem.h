@@ -0,0 +1,103 @@
+/**
+ * DICOM Viewer - Item de Cena para Imagens
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+#ifndef IMAGEITEM_H
+#define IMAGEITEM_H
+
+#include <cstdint>
+#include <memory>
+
+#include <QGraphicsObject>
+#include <QImage>
+#include <QPixmap>
+
+#include "../../core/ImagePyramid.h"
+#include "../../core/LruCache.h"
+
+namespace dicom_viewer_windows {
+
+/**
+ * @class ImageItem
+ * @brief Item de cena que desenha uma QImage em ladrilhos de uma pirâmide multirresolução.
+ *
+ * Imagens pequenas são desenhadas diretamente. Para imagens grandes, uma
+ * pirâmide é construída em segundo plano e, a cada pintura, apenas os
+ * ladrilhos que cruzam a área exposta são desenhados, a partir do nível
+ * cuja resolução é a mais próxima da escala de exibição. Os ladrilhos já
+ * convertidos para QPixmap ficam em um cache limitado por orçamento.
+ */
+class ImageItem : public QGraphicsObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int tileSize = 256;              ///< Lado de um ladrilho, em pixels do nível
+    static constexpr int pyramidThreshold = 2048;     ///< Maior lado a partir do qual a pirâmide é usada
+
+    /**
+     * @brief Construtor do item.
+     * @param parent Item pai (opcional).
+     */
+    explicit ImageItem(QGraphicsItem *parent = nullptr);
+
+    /**
+     * @brief Destrutor. Interrompe a construção da pirâmide.
+     */
+    ~ImageItem();
+
+    /**
+     * @brief Troca a imagem exibida e reinicia a pirâmide.
+     */
+    void setImage(QImage image);
+
+    /**
+     * @brief Imagem exibida.
+     */
+    const QImage &image() const { return displayed; }
+
+    /**
+     * @brief Retira a imagem do item, deixando-o vazio.
+     *
+     * Permite reescrever os pixels sem que a QImage seja desanexada
+     * (copiada) por ainda estar referenciada pelo item. A geometria do
+     * item é mantida até a próxima chamada de setImage().
+     */
+    QImage takeImage();
+
+    /**
+     * @brief Define o orçamento, em bytes, do cache de ladrilhos.
+     */
+    void setTileBudget(std::size_t bytes);
+
+    /**
+     * @brief Contadores do cache de ladrilhos.
+     */
+    dicom_viewer_core::CacheCounters tileCounters() const { return tiles.counters(); }
+
+    QRectF boundingRect() const override;
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+private:
+    /**
+     * @brief Ladrilho do cache, convertendo-o para QPixmap se necessário.
+     */
+    std::shared_ptr<const QPixmap> tile(int level, int column, int row);
+
+    /**
+     * @brief Descarta a pirâmide atual e os seus ladrilhos.
+     */
+    void releasePyramid();
+
+    QImage displayed;
+    QSize extent;
+    std::shared_ptr<dicom_viewer_core::ImagePyramid> pyramid;
+    dicom_viewer_core::LruCache<std::uint64_t, QPixmap> tiles;
+};
+
+}
+
+#endif // IMAGEITEM_H
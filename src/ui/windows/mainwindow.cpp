@@ -13,15 +13,102 @@
 
 #include <QMessageBox>
 #include <QFileDialog>
+#include <QFileInfo>
+#include <QStatusBar>
 #include <QImage>
 #include <QGraphicsScene>
-#include <QGraphicsPixmapItem>
+#include <QMouseEvent>
+#include <QWheelEvent>
+#include <QStandardPaths>
+#include <QFontDatabase>
+#include <QActionGroup>
+#include <QApplication>
+#include <QGraphicsRectItem>
+#include <QGraphicsEllipseItem>
+#include <QGraphicsLineItem>
+#include <QPointer>
+#include <QThreadPool>
+#include <QHeaderView>
+#include <QVBoxLayout>
+#include <QMenu>
+#include <QSettings>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 
 #include "mainwindow.h"
-#include "../forms/ui_mainwindow.h"
 #include "utils.h"
+#include "mprwindow.h"
+#include "../forms/ui_mainwindow.h"
 #include "../../core/MedicalImage.h"
+#include "../../core/WindowLevel.h"
+#include "../../core/ThreadPool.h"
+#include "../../core/RegionStatistics.h"
+#include "../../core/SlabProjection.h"
+#include "../../core/Trace.h"
+#include "../../core/DicomCodecs.h"
+#include "../../core/DecodedCache.h"
+#include "../../core/ProcessMemory.h"
+
+namespace {
+
+constexpr quint16 kStoragePort = 11112;          ///< Porta padrão do receptor C-STORE
+const QString kStorageAeTitle = QStringLiteral("DICOMVIEWER");
+
+// Cache em disco de imagens decodificadas: desligado até o usuário ligá-lo no menu Arquivo
+const QString kDecodedCacheEnabledKey = QStringLiteral("decodedCache/enabled");
+const QString kDecodedCacheBudgetKey = QStringLiteral("decodedCache/budgetMegabytes");
+constexpr qint64 kDefaultDecodedCacheMegabytes = 2048;  ///< Limite padrão do cache, em MB
+
+// Armazenamento de séries: acima do limite, os voxels vão para um arquivo de trabalho paginado
+const QString kInMemorySeriesLimitKey = QStringLiteral("seriesStorage/inMemoryLimitMegabytes");
+const QString kResidentBudgetKey = QStringLiteral("seriesStorage/residentBudgetMegabytes");
+constexpr std::size_t kInMemorySeriesFraction = 4;     ///< Fração da memória física para uma série em memória
+
+/**
+ * @brief Limite de série em memória e configuração da paginação, das preferências ou da memória física.
+ *
+ * O arquivo de trabalho fica no diretório de cache do usuário: o temporário
+ * do sistema é tmpfs (memória) em várias distribuições Linux, o que anularia
+ * a paginação.
+ */
+std::size_t seriesStorageSettings(dicom_viewer_core::PagedVolumeConfig &config)
+{
+    const QSettings settings;
+    std::size_t limit = dicom_viewer_windows::ImageLoader::kDefaultInMemorySeriesLimit;
+    const qint64 limitMegabytes = settings.value(kInMemorySeriesLimitKey, 0).toLongLong();
+    if (limitMegabytes > 0) {
+        limit = static_cast<std::size_t>(limitMegabytes) << 20;
+    } else if (const std::size_t physical = dicom_viewer_core::physicalMemoryBytes(); physical > 0) {
+        limit = physical / kInMemorySeriesFraction;
+    }
+    const qint64 budgetMegabytes = settings.value(kResidentBudgetKey, 0).toLongLong();
+    if (budgetMegabytes > 0) {
+        config.residentBudgetBytes = static_cast<std::size_t>(budgetMegabytes) << 20;
+    }
+    config.scratchDirectory = (QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/scratch").toStdString();
+    return limit;
+}
 
+/**
+ * @brief Diretório do cache de imagens decodificadas.
+ */
+QString decodedCacheDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/decoded";
+}
+
+/**
+ * @brief Limite do cache de imagens decodificadas, em bytes, lido das preferências.
+ */
+uint64_t decodedCacheBudget()
+{
+    const qint64 megabytes = QSettings().value(kDecodedCacheBudgetKey, kDefaultDecodedCacheMegabytes).toLongLong();
+    return static_cast<uint64_t>(std::max<qint64>(megabytes, 1)) << 20;
+}
+
+}
 
 /**
  * @brief Construtor da janela principal.
@@ -35,6 +122,737 @@ MainWindow::MainWindow(QWidget *parent)
     setWindowIcon(QIcon(":/resources/dicom-viewer.ico"));
     this->sceneMedicalImage = new QGraphicsScene(this);
     this->ui->medicalImageView->setScene(this->sceneMedicalImage);
+
+    this->loadProgress = new QProgressBar(this);
+    this->loadProgress->setRange(0, 100);
+    this->loadProgress->setMaximumWidth(200);
+    this->loadProgress->setVisible(false);
+    statusBar()->addPermanentWidget(this->loadProgress);
+
+    this->imageLoader = new dicom_viewer_windows::ImageLoader(this);
+    connect(this->imageLoader, &dicom_viewer_windows::ImageLoader::progressChanged, this, &MainWindow::onLoadProgress);
+    connect(this->imageLoader, &dicom_viewer_windows::ImageLoader::previewReady, this, &MainWindow::onImagePreview);
+    connect(this->imageLoader, &dicom_viewer_windows::ImageLoader::loaded, this, &MainWindow::onImageLoaded);
+    connect(this->imageLoader, &dicom_viewer_windows::ImageLoader::seriesLoaded, this, &MainWindow::onSeriesLoaded);
+    connect(this->imageLoader, &dicom_viewer_windows::ImageLoader::failed, this, &MainWindow::onImageLoadFailed);
+    dicom_viewer_core::PagedVolumeConfig pagedConfig;
+    const std::size_t inMemorySeriesLimit = seriesStorageSettings(pagedConfig);
+    this->imageLoader->setSeriesStorage(inMemorySeriesLimit, pagedConfig);
+
+    setupCineToolBar();
+    setupProjectionToolBar();
+    setupStudyDock();
+    setupTagDock();
+    setupStorageReceiver();
+    setupDecodedCache();
+    setupPerfOverlay();
+    setupMeasureTools();
+
+    // Zoom pela roda, arraste (ou medida) com o botão esquerdo e janelamento com o botão direito
+    this->ui->medicalImageView->setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
+    this->ui->medicalImageView->setDragMode(QGraphicsView::ScrollHandDrag);
+    this->ui->medicalImageView->viewport()->installEventFilter(this);
+}
+
+/**
+ * @brief Cria a barra de ferramentas de reprodução cine.
+ *
+ * A barra só fica visível quando o arquivo aberto possui mais de um quadro.
+ */
+void MainWindow::setupCineToolBar()
+{
+    this->cinePlayer = new dicom_viewer_windows::CinePlayer(this);
+    this->cineToolBar = addToolBar(tr("Cine"));
+    this->cineToolBar->setVisible(false);
+
+    this->cinePlayAction = this->cineToolBar->addAction(QIcon::fromTheme("media-playback-start"), tr("Reproduzir"));
+    this->cinePlayAction->setCheckable(true);
+    connect(this->cinePlayAction, &QAction::toggled, this, [this](bool checked) {
+        if (checked) {
+            this->cinePlayer->play();
+        } else {
+            this->cinePlayer->pause();
+        }
+    });
+
+    this->cineFrameSlider = new QSlider(Qt::Horizontal, this);
+    this->cineFrameSlider->setMinimumWidth(300);
+    this->cineToolBar->addWidget(this->cineFrameSlider);
+    connect(this->cineFrameSlider, &QSlider::sliderMoved, this->cinePlayer, &dicom_viewer_windows::CinePlayer::seek);
+
+    this->cineFpsSpin = new QSpinBox(this);
+    this->cineFpsSpin->setRange(1, 120);
+    this->cineFpsSpin->setSuffix(tr(" fps"));
+    this->cineFpsSpin->setValue(30);
+    this->cineToolBar->addWidget(this->cineFpsSpin);
+    connect(this->cineFpsSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int fps) {
+        this->cinePlayer->setTargetFps(fps);
+    });
+
+    this->cineStatsLabel = new QLabel(this);
+    this->cineToolBar->addWidget(this->cineStatsLabel);
+
+    connect(this->cinePlayer, &dicom_viewer_windows::CinePlayer::frameReady, this, &MainWindow::onCineFrame);
+    connect(this->cinePlayer, &dicom_viewer_windows::CinePlayer::statsChanged, this, &MainWindow::onCineStats);
+}
+
+/**
+ * @brief Cria a barra de ferramentas de projeções (MIP/MinIP/AvgIP).
+ *
+ * A barra só fica visível com uma série carregada. "Corte" exibe uma única
+ * posição; os demais modos combinam a espessura em mm ao redor do centro.
+ */
+void MainWindow::setupProjectionToolBar()
+{
+    this->projectionToolBar = addToolBar(tr("Projeção"));
+    this->projectionToolBar->setVisible(false);
+
+    this->projectionModeCombo = new QComboBox(this);
+    this->projectionModeCombo->addItems({tr("Corte"), tr("MIP"), tr("MinIP"), tr("AvgIP")});
+    this->projectionToolBar->addWidget(this->projectionModeCombo);
+
+    // Mesma ordem de dicom_viewer_core::ProjectionAxis
+    this->projectionAxisCombo = new QComboBox(this);
+    this->projectionAxisCombo->addItems({tr("Axial"), tr("Coronal"), tr("Sagital")});
+    this->projectionToolBar->addWidget(this->projectionAxisCombo);
+
+    this->projectionSlider = new QSlider(Qt::Horizontal, this);
+    this->projectionSlider->setMinimumWidth(300);
+    this->projectionToolBar->addWidget(this->projectionSlider);
+
+    this->projectionThicknessSpin = new QDoubleSpinBox(this);
+    this->projectionThicknessSpin->setRange(0.1, 1000.0);
+    this->projectionThicknessSpin->setDecimals(1);
+    this->projectionThicknessSpin->setSuffix(tr(" mm"));
+    this->projectionThicknessSpin->setValue(10.0);
+    this->projectionThicknessSpin->setEnabled(false);
+    this->projectionToolBar->addWidget(this->projectionThicknessSpin);
+
+    this->projectionLabel = new QLabel(this);
+    this->projectionToolBar->addWidget(this->projectionLabel);
+
+    connect(this->projectionModeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index) {
+        this->projectionThicknessSpin->setEnabled(index > 0);
+        updateProjection(true);
+    });
+    connect(this->projectionAxisCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index) {
+        if (!this->currentVolume) {
+            return;
+        }
+        const int extent = dicom_viewer_core::projectionExtent(*this->currentVolume,
+                                                               static_cast<dicom_viewer_core::ProjectionAxis>(index));
+        const QSignalBlocker blocker(this->projectionSlider);
+        this->projectionSlider->setRange(0, extent - 1);
+        this->projectionSlider->setValue(extent / 2);
+        updateProjection(true);
+    });
+    connect(this->projectionSlider, &QSlider::valueChanged, this, [this]() { updateProjection(false); });
+    connect(this->projectionThicknessSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this,
+            [this]() { updateProjection(false); });
+}
+
+/**
+ * @brief Recalcula a projeção da série atual com os parâmetros da barra.
+ *
+ * A projeção é síncrona, como o janelamento: distribuída pelo pool, uma
+ * placa de 100 cortes de 512x512 leva poucos milissegundos, o que permite
+ * recalcular a cada movimento do controle deslizante.
+ */
+void MainWindow::updateProjection(bool resetView)
+{
+    if (this->currentPagedVolume) {
+        updatePagedSlice(resetView);
+        return;
+    }
+    if (!this->currentVolume || this->currentVolume->depth < 2) {
+        return;
+    }
+    const dicom_viewer_core::Volume &volume = *this->currentVolume;
+    const auto axis = static_cast<dicom_viewer_core::ProjectionAxis>(this->projectionAxisCombo->currentIndex());
+    const int modeIndex = this->projectionModeCombo->currentIndex();
+    const dicom_viewer_core::ProjectionMode mode = modeIndex == 2 ? dicom_viewer_core::ProjectionMode::Minimum
+                                                   : modeIndex == 3 ? dicom_viewer_core::ProjectionMode::Average
+                                                                    : dicom_viewer_core::ProjectionMode::Maximum;
+    const int extent = dicom_viewer_core::projectionExtent(volume, axis);
+    const double spacing = dicom_viewer_core::projectionSpacing(volume, axis);
+    int count = 1;
+    if (modeIndex > 0) {
+        count = std::max(1, static_cast<int>(std::lround(this->projectionThicknessSpin->value() / spacing)));
+    }
+    count = std::min(count, extent);
+    const int first = std::clamp(this->projectionSlider->value() - count / 2, 0, extent - count);
+
+    const auto started = std::chrono::steady_clock::now();
+    auto projection = std::make_shared<dicom_viewer_core::MedicalImage>(
+        dicom_viewer_core::projectSlab(volume, mode, axis, first, count, dicom_viewer_core::ThreadPool::shared()));
+    const double elapsed = dicom_viewer_core::elapsedMs(started);
+    if (!projection->isValid()) {
+        return;
+    }
+    this->currentImage = std::move(projection);
+    showVolumeImage(resetView);
+    this->projectionLabel->setText(tr("%1/%2 | %3 posições (%4 mm) | %5 ms")
+                                       .arg(this->projectionSlider->value() + 1)
+                                       .arg(extent)
+                                       .arg(count)
+                                       .arg(count * spacing, 0, 'f', 1)
+                                       .arg(elapsed, 0, 'f', 1));
+}
+
+/**
+ * @brief Exibe o corte axial escolhido da série paginada e pede a leitura dos blocos vizinhos.
+ *
+ * Como a projeção, a leitura é síncrona: com a leitura antecipada, o bloco
+ * do corte já está mapeado e lido, e o custo é o da cópia do corte. Um
+ * salto para longe paga a leitura de um bloco.
+ */
+void MainWindow::updatePagedSlice(bool resetView)
+{
+    dicom_viewer_core::PagedVolume &volume = *this->currentPagedVolume;
+    const int z = this->projectionSlider->value();
+    const auto started = std::chrono::steady_clock::now();
+    auto slice = std::make_shared<dicom_viewer_core::MedicalImage>(volume.extractSlice(z));
+    const double elapsed = dicom_viewer_core::elapsedMs(started);
+    // Os blocos em torno do corte são lidos enquanto ele é exibido
+    volume.prefetchAround(z);
+    if (!slice->isValid()) {
+        return;
+    }
+    this->currentImage = std::move(slice);
+    showVolumeImage(resetView);
+
+    const dicom_viewer_core::PagedVolumeStats stats = volume.stats();
+    this->projectionLabel->setText(tr("%1/%2 | %3 ms | residente %4/%5 MB | %6 leituras sob demanda, %7 antecipadas")
+                                       .arg(z + 1)
+                                       .arg(volume.depth())
+                                       .arg(elapsed, 0, 'f', 1)
+                                       .arg(stats.residentBytes / (1024.0 * 1024.0), 0, 'f', 0)
+                                       .arg(stats.budgetBytes / (1024.0 * 1024.0), 0, 'f', 0)
+                                       .arg(stats.pageIns)
+                                       .arg(stats.prefetched));
+}
+
+/**
+ * @brief Exibe currentImage, derivada do volume atual (projeção ou corte).
+ */
+void MainWindow::showVolumeImage(bool resetView)
+{
+    if (resetView || !this->imageItem) {
+        resetWindowLevel();
+        QImage display;
+        if (!dicom_viewer_windows::renderWindowLevel(*this->currentImage, this->windowCenter, this->windowWidth, display)) {
+            return;
+        }
+        showImage(display);
+        // Cortes coronais e sagitais costumam ter espaçamento entre linhas diferente do das colunas
+        this->imageItem->setTransform(QTransform::fromScale(1.0, this->currentImage->spacingY / this->currentImage->spacingX));
+        this->sceneMedicalImage->setSceneRect(this->imageItem->sceneBoundingRect());
+        ui->medicalImageView->fitInView(this->imageItem, Qt::KeepAspectRatio);
+    } else {
+        applyWindowLevel();
+    }
+    scheduleRegionTables();
+}
+
+/**
+ * @brief Cria o painel com a árvore de estudos do catálogo.
+ *
+ * O catálogo fica no diretório de dados do aplicativo e é reaproveitado
+ * entre execuções: uma nova varredura só relê os arquivos alterados.
+ */
+void MainWindow::setupStudyDock()
+{
+    const QString catalogPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/catalog.tsv";
+    this->catalogScanner = new dicom_viewer_windows::CatalogScanner(catalogPath, this);
+    connect(this->catalogScanner, &dicom_viewer_windows::CatalogScanner::progressChanged, this, [this](quint64 requestId, int percent) {
+        if (requestId == this->catalogScanner->currentRequest()) {
+            this->loadProgress->setValue(percent);
+        }
+    });
+    connect(this->catalogScanner, &dicom_viewer_windows::CatalogScanner::scanned, this, &MainWindow::onCatalogScanned);
+
+    this->studyTree = new QTreeWidget(this);
+    this->studyTree->setHeaderLabels({tr("Estudo"), tr("Imagens")});
+    this->studyTree->setUniformRowHeights(true);
+    connect(this->studyTree, &QTreeWidget::itemActivated, this, &MainWindow::onStudyItemActivated);
+    // Séries podem ser abertas também na vista ativa da grade de comparação
+    this->studyTree->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(this->studyTree, &QTreeWidget::customContextMenuRequested, this, [this](const QPoint &position) {
+        QTreeWidgetItem *item = this->studyTree->itemAt(position);
+        if (!item || item->data(0, Qt::UserRole).toStringList().isEmpty() || item->data(1, Qt::UserRole).toInt() > 1) {
+            return;
+        }
+        QMenu menu(this);
+        QAction *openInGrid = menu.addAction(tr("Abrir na grade"));
+        if (menu.exec(this->studyTree->viewport()->mapToGlobal(position)) == openInGrid) {
+            openGridWindow()->showSeries(item->data(0, Qt::UserRole).toStringList(), item->text(0));
+        }
+    });
+
+    this->studyDock = new QDockWidget(tr("Estudos"), this);
+    this->studyDock->setObjectName("studyDock");
+    this->studyDock->setWidget(this->studyTree);
+    this->studyDock->setVisible(false);
+    addDockWidget(Qt::LeftDockWidgetArea, this->studyDock);
+}
+
+/**
+ * @brief Cria o painel com a árvore completa de tags do arquivo atual e a busca.
+ *
+ * O painel começa oculto e só lê o arquivo quando fica visível. A árvore
+ * materializa os nós ao expandir; a busca roda em segundo plano a cada
+ * pausa na digitação e as ocorrências entram na lista à medida que chegam.
+ * Um duplo clique em um valor adiado (grande ou binário) o lê do disco.
+ */
+void MainWindow::setupTagDock()
+{
+    this->tagModel = new dicom_viewer_windows::TagTreeModel(this);
+
+    this->tagSearchEdit = new QLineEdit(this);
+    this->tagSearchEdit->setPlaceholderText(tr("Buscar tag, nome ou valor"));
+    this->tagSearchEdit->setClearButtonEnabled(true);
+    this->tagLargeValuesCheck = new QCheckBox(tr("Incluir valores grandes e binários"), this);
+
+    this->tagTreeView = new QTreeView(this);
+    this->tagTreeView->setModel(this->tagModel);
+    this->tagTreeView->setUniformRowHeights(true);
+    this->tagTreeView->header()->setSectionResizeMode(QHeaderView::Interactive);
+    this->tagTreeView->header()->setStretchLastSection(true);
+
+    this->tagSearchLabel = new QLabel(this);
+    this->tagSearchResults = new QListWidget(this);
+    this->tagSearchResults->setUniformItemSizes(true);
+    this->tagSearchResults->setVisible(false);
+
+    QWidget *panel = new QWidget(this);
+    QVBoxLayout *layout = new QVBoxLayout(panel);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addWidget(this->tagSearchEdit);
+    layout->addWidget(this->tagLargeValuesCheck);
+    layout->addWidget(this->tagTreeView, 3);
+    layout->addWidget(this->tagSearchLabel);
+    layout->addWidget(this->tagSearchResults, 1);
+
+    this->tagSearchTimer = new QTimer(this);
+    this->tagSearchTimer->setSingleShot(true);
+    this->tagSearchTimer->setInterval(250);
+    connect(this->tagSearchTimer, &QTimer::timeout, this, &MainWindow::startTagSearch);
+    connect(this->tagSearchEdit, &QLineEdit::textChanged, this->tagSearchTimer, QOverload<>::of(&QTimer::start));
+    connect(this->tagLargeValuesCheck, &QCheckBox::toggled, this, &MainWindow::startTagSearch);
+
+    connect(this->tagTreeView, &QTreeView::doubleClicked, this->tagModel, &dicom_viewer_windows::TagTreeModel::loadFullValue);
+    connect(this->tagModel, &dicom_viewer_windows::TagTreeModel::opened, this, [this](quint64, bool ok) {
+        if (!ok) {
+            this->tagSearchLabel->setText(tr("Não foi possível ler as tags de %1").arg(QFileInfo(this->tagModel->filePath()).fileName()));
+            return;
+        }
+        // Linha 1: conjunto de dados (a linha 0 é a meta-informação)
+        this->tagTreeView->expand(this->tagModel->index(1, 0));
+        this->tagTreeView->resizeColumnToContents(dicom_viewer_windows::TagTreeModel::TagColumn);
+    });
+    connect(this->tagModel, &dicom_viewer_windows::TagTreeModel::searchHits, this,
+            [this](quint64 searchId, const QVector<dicom_viewer_windows::TagSearchHit> &hits, int percent) {
+        if (searchId != this->tagSearchId) {
+            return;
+        }
+        // A lista mostra as primeiras ocorrências; a contagem segue até o fim da busca
+        constexpr int maxListed = 5000;
+        for (const dicom_viewer_windows::TagSearchHit &hit : hits) {
+            if (this->tagSearchCount++ >= maxListed) {
+                continue;
+            }
+            QListWidgetItem *item = new QListWidgetItem(QString("%1 %2  %3").arg(hit.tag, hit.name, hit.value),
+                                                        this->tagSearchResults);
+            item->setData(Qt::UserRole, QVariant::fromValue(hit.path));
+        }
+        this->tagSearchLabel->setText(tr("%1 ocorrências (%2%)").arg(this->tagSearchCount).arg(percent));
+    });
+    connect(this->tagModel, &dicom_viewer_windows::TagTreeModel::searchFinished, this, [this](quint64 searchId, int matches) {
+        if (searchId == this->tagSearchId) {
+            this->tagSearchLabel->setText(tr("%1 ocorrências").arg(matches));
+        }
+    });
+    connect(this->tagSearchResults, &QListWidget::currentItemChanged, this, [this](QListWidgetItem *item) {
+        if (!item) {
+            return;
+        }
+        const QModelIndex index = this->tagModel->indexForPath(item->data(Qt::UserRole).value<QVector<quint32>>());
+        if (index.isValid()) {
+            this->tagTreeView->scrollTo(index, QAbstractItemView::PositionAtCenter);
+            this->tagTreeView->setCurrentIndex(index);
+        }
+    });
+
+    this->tagDock = new QDockWidget(tr("Tags DICOM"), this);
+    this->tagDock->setObjectName("tagDock");
+    this->tagDock->setWidget(panel);
+    this->tagDock->setVisible(false);
+    addDockWidget(Qt::RightDockWidgetArea, this->tagDock);
+    connect(this->tagDock, &QDockWidget::visibilityChanged, this, [this](bool visible) {
+        if (visible) {
+            showTagTree(this->tagFilePath);
+        }
+    });
+    ui->menuArquivo->addSeparator();
+    ui->menuArquivo->addAction(this->tagDock->toggleViewAction());
+}
+
+/**
+ * @brief Define o arquivo do painel de tags; a leitura só ocorre com o painel visível.
+ */
+void MainWindow::showTagTree(const QString &path)
+{
+    this->tagFilePath = path;
+    if (!this->tagDock->isVisible() || path == this->tagModel->filePath()) {
+        return;
+    }
+    this->tagSearchResults->clear();
+    this->tagSearchLabel->clear();
+    if (path.isEmpty()) {
+        this->tagModel->clear();
+        return;
+    }
+    this->tagModel->open(path);
+    startTagSearch();
+}
+
+/**
+ * @brief Reinicia a busca de tags com o texto atual.
+ */
+void MainWindow::startTagSearch()
+{
+    this->tagSearchTimer->stop();
+    this->tagSearchResults->clear();
+    this->tagSearchCount = 0;
+    this->tagSearchId = this->tagModel->search(this->tagSearchEdit->text(), this->tagLargeValuesCheck->isChecked());
+    this->tagSearchResults->setVisible(this->tagSearchId != 0);
+    this->tagSearchLabel->setText(this->tagSearchId != 0 ? tr("Buscando...") : QString());
+}
+
+/**
+ * @brief Cria o painel de desempenho sobreposto à imagem.
+ *
+ * O painel fica oculto até ser ativado no menu Diagnóstico. Sem o
+ * rastreamento na compilação (DICOM_VIEWER_TRACE), o menu é desabilitado.
+ */
+void MainWindow::setupPerfOverlay()
+{
+    this->perfOverlay = new QLabel(ui->medicalImageView);
+    this->perfOverlay->setStyleSheet("background-color: rgba(0, 0, 0, 170); color: #e0e0e0; padding: 6px;");
+    this->perfOverlay->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    this->perfOverlay->setAttribute(Qt::WA_TransparentForMouseEvents);
+    this->perfOverlay->move(8, 8);
+    this->perfOverlay->setVisible(false);
+#if !defined(DICOM_VIEWER_TRACE)
+    ui->menuDiagnostico->setEnabled(false);
+#endif
+}
+
+/**
+ * @brief Atualiza o painel de desempenho com os estágios do último carregamento.
+ *
+ * Mostra o tempo e os bytes movidos por estágio, somados desde o início do
+ * último carregamento (inclusive a conversão e a exibição na interface).
+ */
+void MainWindow::updatePerfOverlay()
+{
+    if (!this->perfOverlay->isVisible()) {
+        return;
+    }
+    const std::vector<dicom_viewer_core::TraceStageSummary> stages = dicom_viewer_core::Tracer::instance().lastLoad();
+    QStringList lines;
+    lines << tr("Último carregamento");
+    double totalMs = 0.0;
+    double totalMb = 0.0;
+    for (const dicom_viewer_core::TraceStageSummary &stage : stages) {
+        const double megabytes = stage.bytes / (1024.0 * 1024.0);
+        lines << QString("%1 %2 ms %3 MB%4")
+                     .arg(QString::fromStdString(stage.name), -10)
+                     .arg(stage.totalMs, 8, 'f', 1)
+                     .arg(megabytes, 7, 'f', 1)
+                     .arg(stage.count > 1 ? QString(" x%1").arg(stage.count) : QString());
+        totalMs += stage.totalMs;
+        totalMb += megabytes;
+    }
+    if (stages.empty()) {
+        lines << tr("(nenhum estágio registrado)");
+    } else {
+        lines << QString("%1 %2 ms %3 MB").arg(tr("total"), -10).arg(totalMs, 8, 'f', 1).arg(totalMb, 7, 'f', 1);
+    }
+    const dicom_viewer_core::CacheCounters cache = this->imageLoader->cacheCounters();
+    lines << tr("cache      %1 imagens, %2/%3 MB")
+                 .arg(cache.entries)
+                 .arg(cache.usedBytes / (1024.0 * 1024.0), 0, 'f', 0)
+                 .arg(cache.budgetBytes / (1024.0 * 1024.0), 0, 'f', 0);
+    lines << tr("           %1 acertos, %2 faltas, %3 descartes").arg(cache.hits).arg(cache.misses).arg(cache.evictions);
+    if (this->firstImageMs >= 0.0) {
+        lines << tr("início     %1 ms até a primeira imagem").arg(this->firstImageMs, 0, 'f', 1);
+    }
+    this->perfOverlay->setText(lines.join('\n'));
+    this->perfOverlay->adjustSize();
+}
+
+/**
+ * @brief Cria o grupo exclusivo das ferramentas de medida.
+ *
+ * Com uma ferramenta ativa, o botão esquerdo desenha a medida em vez de
+ * arrastar a imagem; "Navegar" devolve o arraste.
+ */
+void MainWindow::setupMeasureTools()
+{
+    this->regionTablesGeneration = std::make_shared<std::atomic<quint64>>(0);
+    this->regionTablesTimer = new QTimer(this);
+    this->regionTablesTimer->setSingleShot(true);
+    this->regionTablesTimer->setInterval(150);
+    connect(this->regionTablesTimer, &QTimer::timeout, this, &MainWindow::buildRegionTables);
+
+    QActionGroup *group = new QActionGroup(this);
+    group->addAction(ui->actionNavegar);
+    group->addAction(ui->actionRoiRetangulo);
+    group->addAction(ui->actionRoiElipse);
+    group->addAction(ui->actionDistancia);
+    connect(group, &QActionGroup::triggered, this, [this](QAction *action) {
+        if (action == ui->actionRoiRetangulo) {
+            this->measureTool = MeasureTool::Rectangle;
+        } else if (action == ui->actionRoiElipse) {
+            this->measureTool = MeasureTool::Ellipse;
+        } else if (action == ui->actionDistancia) {
+            this->measureTool = MeasureTool::Distance;
+        } else {
+            this->measureTool = MeasureTool::None;
+        }
+        this->measuring = false;
+        ui->medicalImageView->setDragMode(this->measureTool == MeasureTool::None ? QGraphicsView::ScrollHandDrag
+                                                                                 : QGraphicsView::NoDrag);
+        buildRegionTables();
+    });
+}
+
+/**
+ * @brief Remove as medidas desenhadas sobre a imagem.
+ */
+void MainWindow::on_actionLimparMedidas_triggered()
+{
+    delete this->measureShape;
+    delete this->measureLabel;
+    this->measureShape = nullptr;
+    this->measureLabel = nullptr;
+    this->measuring = false;
+}
+
+/**
+ * @brief Descarta as tabelas da imagem anterior e adia a construção das da imagem atual.
+ *
+ * Enquanto o corte ou a projeção mudam (arraste do controle deslizante),
+ * o temporizador é reiniciado a cada imagem, e as construções já na fila
+ * para imagens anteriores são ignoradas pela geração.
+ */
+void MainWindow::scheduleRegionTables()
+{
+    this->regionTables.reset();
+    this->regionTablesImage.reset();
+    this->regionTablesGeneration->fetch_add(1);
+    this->regionTablesTimer->start();
+}
+
+/**
+ * @brief Constrói em segundo plano as tabelas de estatísticas da imagem atual.
+ *
+ * Só há construção com uma ferramenta de ROI ativa. As somas acumuladas são
+ * calculadas uma vez, em paralelo; daí em diante cada movimento do mouse
+ * sobre uma ROI custa poucas leituras, independentemente do tamanho da região.
+ */
+void MainWindow::buildRegionTables()
+{
+    if (this->measureTool != MeasureTool::Rectangle && this->measureTool != MeasureTool::Ellipse) {
+        return;
+    }
+    if (!this->currentImage || !dicom_viewer_core::isFullPrecision(*this->currentImage) ||
+        this->regionTablesTimer->isActive() || this->regionTablesImage == this->currentImage) {
+        return;
+    }
+    this->regionTablesImage = this->currentImage;
+    QPointer<MainWindow> guard(this);
+    std::shared_ptr<const dicom_viewer_core::MedicalImage> image = this->currentImage;
+    std::shared_ptr<std::atomic<quint64>> generation = this->regionTablesGeneration;
+    const quint64 requested = generation->load();
+    QThreadPool::globalInstance()->start([guard, image, generation, requested]() {
+        // A imagem foi substituída enquanto a construção aguardava na fila
+        if (generation->load() != requested) {
+            return;
+        }
+        DICOM_TRACE_SCOPE(traceScope, "roi-tables");
+        auto tables = std::make_shared<const dicom_viewer_core::RegionTables>(
+            dicom_viewer_core::RegionTables::build(*image, dicom_viewer_core::ThreadPool::shared()));
+        DICOM_TRACE_BYTES(traceScope, tables->memoryBytes());
+        QMetaObject::invokeMethod(qApp, [guard, image, tables]() {
+            // Descarta tabelas de uma imagem que já foi substituída
+            if (guard && guard->currentImage == image) {
+                guard->regionTables = tables;
+                guard->updateMeasurement();
+            }
+        }, Qt::QueuedConnection);
+    });
+}
+
+/**
+ * @brief Trata o arraste com o botão esquerdo quando uma ferramenta de medida está ativa.
+ */
+bool MainWindow::handleMeasureEvent(QEvent *event)
+{
+    if (event->type() != QEvent::MouseButtonPress && event->type() != QEvent::MouseMove &&
+        event->type() != QEvent::MouseButtonRelease) {
+        return false;
+    }
+    QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(event);
+    if (!this->currentImage || !this->imageItem) {
+        return false;
+    }
+    // Coordenadas do item são pixels da imagem (mesmo com a escala de aspecto); a medida fica presa aos limites dela
+    const QPointF itemPosition = this->imageItem->mapFromScene(
+        ui->medicalImageView->mapToScene(mouseEvent->position().toPoint()));
+    const QPointF position(std::clamp(itemPosition.x(), 0.0, static_cast<double>(this->currentImage->width)),
+                           std::clamp(itemPosition.y(), 0.0, static_cast<double>(this->currentImage->height)));
+
+    switch (event->type()) {
+    case QEvent::MouseButtonPress: {
+        if (mouseEvent->button() != Qt::LeftButton) {
+            return false;
+        }
+        // Estatísticas do quadro 0 não valem para os demais quadros do cine
+        if (this->measureTool != MeasureTool::Distance && this->cinePlayer->source()) {
+            statusBar()->showMessage(tr("Estatísticas de ROI não estão disponíveis em arquivos multi-frame"));
+            return true;
+        }
+        on_actionLimparMedidas_triggered();
+        QPen pen(QColor(255, 210, 0), 0);
+        // Filhos do item da imagem: acompanham a sua escala e são apagados com ele
+        if (this->measureTool == MeasureTool::Rectangle) {
+            QGraphicsRectItem *rectItem = new QGraphicsRectItem(this->imageItem);
+            rectItem->setPen(pen);
+            this->measureShape = rectItem;
+        } else if (this->measureTool == MeasureTool::Ellipse) {
+            QGraphicsEllipseItem *ellipseItem = new QGraphicsEllipseItem(this->imageItem);
+            ellipseItem->setPen(pen);
+            this->measureShape = ellipseItem;
+        } else {
+            QGraphicsLineItem *lineItem = new QGraphicsLineItem(this->imageItem);
+            lineItem->setPen(pen);
+            this->measureShape = lineItem;
+        }
+        this->measureLabel = new QGraphicsSimpleTextItem(this->imageItem);
+        this->measureLabel->setBrush(QColor(255, 210, 0));
+        // O texto mantém o tamanho na tela em qualquer zoom
+        this->measureLabel->setFlag(QGraphicsItem::ItemIgnoresTransformations);
+        this->measureOrigin = position;
+        this->measureEnd = position;
+        this->measuring = true;
+        updateMeasurement();
+        return true;
+    }
+    case QEvent::MouseMove:
+        if (!this->measuring) {
+            return false;
+        }
+        this->measureEnd = position;
+        updateMeasurement();
+        return true;
+    case QEvent::MouseButtonRelease:
+        if (mouseEvent->button() != Qt::LeftButton || !this->measuring) {
+            return false;
+        }
+        this->measuring = false;
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Atualiza a forma e o texto da medida em edição.
+ */
+void MainWindow::updateMeasurement()
+{
+    if (!this->measureShape || !this->measureLabel || !this->currentImage) {
+        return;
+    }
+    const QRectF rect = QRectF(this->measureOrigin, this->measureEnd).normalized();
+    this->measureLabel->setPos(rect.bottomRight());
+
+    if (this->measureShape->type() == QGraphicsLineItem::Type) {
+        static_cast<QGraphicsLineItem *>(this->measureShape)->setLine(QLineF(this->measureOrigin, this->measureEnd));
+        const double distance = dicom_viewer_core::measureDistanceMm(*this->currentImage,
+                                                                      this->measureOrigin.x(), this->measureOrigin.y(),
+                                                                      this->measureEnd.x(), this->measureEnd.y());
+        this->measureLabel->setText(tr("%1 mm").arg(distance, 0, 'f', 2));
+        return;
+    }
+
+    dicom_viewer_core::RegionStats stats;
+    if (this->measureShape->type() == QGraphicsRectItem::Type) {
+        static_cast<QGraphicsRectItem *>(this->measureShape)->setRect(rect);
+        if (this->regionTables) {
+            // Pixels com centro dentro do retângulo
+            stats = this->regionTables->rectangle(static_cast<int>(std::lround(rect.left())),
+                                                  static_cast<int>(std::lround(rect.top())),
+                                                  static_cast<int>(std::lround(rect.right())),
+                                                  static_cast<int>(std::lround(rect.bottom())));
+        }
+    } else {
+        static_cast<QGraphicsEllipseItem *>(this->measureShape)->setRect(rect);
+        if (this->regionTables) {
+            stats = this->regionTables->ellipse(rect.center().x(), rect.center().y(),
+                                                rect.width() / 2.0, rect.height() / 2.0);
+        }
+    }
+
+    if (!this->regionTables) {
+        this->measureLabel->setText(tr("Calculando estatísticas..."));
+    } else if (!this->regionTables->isValid()) {
+        this->measureLabel->setText(tr("Estatísticas indisponíveis para esta imagem"));
+    } else if (!stats.isValid()) {
+        this->measureLabel->setText(QString());
+    } else {
+        const QString unit = this->currentImage->modality == "CT" ? tr(" HU") : QString();
+        this->measureLabel->setText(tr("Média %1 ± %2%3\nMín %4  Máx %5\nÁrea %6 mm² (%7 px)")
+                                        .arg(stats.mean, 0, 'f', 1)
+                                        .arg(stats.stdDev, 0, 'f', 1)
+                                        .arg(unit)
+                                        .arg(stats.min, 0, 'f', 1)
+                                        .arg(stats.max, 0, 'f', 1)
+                                        .arg(stats.areaMm2, 0, 'f', 1)
+                                        .arg(stats.pixels));
+    }
+}
+
+/**
+ * @brief Mostra ou oculta o painel de desempenho sobre a imagem.
+ */
+void MainWindow::on_actionDesempenho_toggled(bool checked)
+{
+    this->perfOverlay->setVisible(checked);
+    this->perfOverlay->raise();
+    updatePerfOverlay();
+}
+
+/**
+ * @brief Grava os eventos rastreados no formato Chrome trace-event.
+ *
+ * O arquivo abre em chrome://tracing ou no Perfetto e mostra cada estágio
+ * por thread, com os bytes movidos nos argumentos do evento.
+ */
+void MainWindow::on_actionExportarTrace_triggered()
+{
+    const QString path = QFileDialog::getSaveFileName(this, tr("Exportar trace"), "dicom-viewer-trace.json",
+                                                      tr("Chrome trace (*.json)"));
+    if (path.isEmpty()) {
+        return;
+    }
+    if (!dicom_viewer_core::Tracer::instance().exportChromeTrace(path.toStdString())) {
+        QMessageBox::critical(this, tr("Erro ao exportar trace"), tr("Não foi possível gravar %1.").arg(path));
+        return;
+    }
+    statusBar()->showMessage(tr("Trace gravado em %1").arg(path));
 }
 
 /**
@@ -56,52 +874,851 @@ void MainWindow::on_actionAbrir_triggered()
         return;
     }
 
-    QFile file(fileName);
-    if (!file.exists()) {
+    // Apenas metadados do sistema de arquivos: o arquivo é aberto uma única vez pelo loader
+    QFileInfo fileInfo(fileName);
+    if (!fileInfo.exists()) {
         QMessageBox::critical(this, tr("Erro ao abrir arquivo"), tr("O arquivo selecionado não foi encontrado."));
         return;
     }
-    if (!file.open(QIODevice::ReadOnly)) {
+    if (!fileInfo.isReadable()) {
         QMessageBox::critical(this, tr("Erro ao abrir arquivo"), tr("Permissão negada ou arquivo em uso."));
         return;
     }
 
-    if (!dicom_viewer_windows::isValidDicomFile(fileName)) {
-        QMessageBox::critical(this, tr("Arquivo inválido - Header Check"), tr("O arquivo selecionado não é um DICOM válido."));
-        file.close();
+    // Cancela qualquer carregamento anterior ainda em andamento
+    this->imageLoader->load(fileName);
+    this->loadProgress->setValue(0);
+    this->loadProgress->setVisible(true);
+    statusBar()->showMessage(tr("Carregando %1...").arg(fileInfo.fileName()));
+}
+
+/**
+ * @brief Atualiza a barra de progresso do carregamento em andamento.
+ */
+void MainWindow::onLoadProgress(quint64 requestId, int percent)
+{
+    if (requestId != this->imageLoader->currentRequest()) {
         return;
     }
+    this->loadProgress->setValue(percent);
+}
 
-    dicom_viewer_core::MedicalImage medicalImage = dicom_viewer_core::loadDicomRaw(fileName.toStdString(), false);
-
-    if (!medicalImage.isValid())
-    {
-        QMessageBox::critical(this, tr("Arquivo inválido - Data Check"), tr("O arquivo selecionado não é um DICOM válido."));
-        file.close();
+/**
+ * @brief Exibe a prévia reduzida de um arquivo grande ainda em leitura.
+ *
+ * A prévia é ampliada por scale para ocupar a geometria da imagem completa,
+ * de modo que a troca pela imagem final não altera o enquadramento. As
+ * entregas seguintes da mesma requisição apenas substituem os pixels.
+ */
+void MainWindow::onImagePreview(quint64 requestId, const QImage &image, int scale)
+{
+    if (requestId != this->imageLoader->currentRequest()) {
+        return;
+    }
+    if (this->previewRequest == requestId && this->imageItem) {
+        updateImage(image);
         return;
     }
+    this->previewRequest = requestId;
+    // O janelamento interativo só vale para a imagem completa
+    this->currentImage.reset();
+    this->currentVolume.reset();
+    this->currentPagedVolume.reset();
+    scheduleRegionTables();
+    this->projectionToolBar->setVisible(false);
+    this->cinePlayer->setSource(nullptr);
+    this->cineToolBar->setVisible(false);
+    showImage(image);
+    this->imageItem->setScale(scale);
+    this->sceneMedicalImage->setSceneRect(this->imageItem->sceneBoundingRect());
+    ui->medicalImageView->fitInView(this->imageItem, Qt::KeepAspectRatio);
+    statusBar()->showMessage(tr("Prévia 1:%1 - lendo a imagem completa...").arg(scale));
+}
 
-    QImage img = dicom_viewer_windows::convertMedicalImage(medicalImage);
-    if (img.isNull())
-    {
-        QMessageBox::critical(this, tr("Erro ao converter Medical Image para QImage"), tr("Erro ao converter Medical Image para QImage"));
-        file.close();
+/**
+ * @brief Exibe a imagem entregue pelo serviço de carregamento.
+ */
+void MainWindow::onImageLoaded(quint64 requestId, const dicom_viewer_windows::LoadedImage &result)
+{
+    // Resultados de requisições substituídas são descartados
+    if (requestId != this->imageLoader->currentRequest()) {
         return;
     }
-    this->sceneMedicalImage->clear();
-    QPixmap pixmap = QPixmap::fromImage(img);
-    QGraphicsPixmapItem* item = this->sceneMedicalImage->addPixmap(pixmap);
-    this->sceneMedicalImage->setSceneRect(pixmap.rect()); 
-    ui->medicalImageView->fitInView(item, Qt::KeepAspectRatio);
+    this->loadProgress->setVisible(false);
+    this->currentImage = result.image;
+    this->currentVolume.reset();
+    this->currentPagedVolume.reset();
+    this->projectionToolBar->setVisible(false);
+    ui->actionMpr->setEnabled(false);
+    showImage(result.displayImage);
+    resetWindowLevel();
+    scheduleRegionTables();
+
+    this->cinePlayAction->setChecked(false);
+    this->cinePlayer->setSource(result.frames);
+    this->cineToolBar->setVisible(result.frames != nullptr);
+    if (result.frames) {
+        this->cineFrameSlider->setRange(0, result.frames->frameCount() - 1);
+        this->cineFrameSlider->setValue(0);
+        this->cineFpsSpin->setValue(qRound(this->cinePlayer->targetFps()));
+        this->cineStatsLabel->setText(tr("Quadro 1/%1").arg(result.frames->frameCount()));
+    }
 
     // Exibir metadados no QPlainTextEdit
     if (ui->metadata) {
-        std::string metadataStr = dicom_viewer_core::getDicomMetadata(medicalImage);
-        QString metadataText = QString::fromStdString(metadataStr);
-        ui->metadata->setPlainText(metadataText);
+        ui->metadata->setPlainText(result.metadata);
+    }
+    showTagTree(result.path);
+
+    const dicom_viewer_core::LoadStats &loadStats = result.stats;
+    if (result.fromCache) {
+        const dicom_viewer_core::CacheCounters cache = this->imageLoader->cacheCounters();
+        statusBar()->showMessage(tr("%1 exibido do cache em %2 ms (cache %3 de %4 MB, %5 acertos, %6 faltas)")
+                                     .arg(QFileInfo(result.path).fileName())
+                                     .arg(loadStats.totalMs, 0, 'f', 1)
+                                     .arg(cache.usedBytes / (1024.0 * 1024.0), 0, 'f', 0)
+                                     .arg(cache.budgetBytes / (1024.0 * 1024.0), 0, 'f', 0)
+                                     .arg(cache.hits)
+                                     .arg(cache.misses));
+    } else {
+        statusBar()->showMessage(tr("Carregado em %1 ms (leitura %2 ms, descompressão %3 ms, imagem %4 ms, pixels %5 ms)")
+                                     .arg(loadStats.totalMs, 0, 'f', 1)
+                                     .arg(loadStats.parseMs, 0, 'f', 1)
+                                     .arg(loadStats.decompressMs, 0, 'f', 1)
+                                     .arg(loadStats.imageMs, 0, 'f', 1)
+                                     .arg(loadStats.outputMs, 0, 'f', 1));
+    }
+    updateNeighborActions();
+    updatePerfOverlay();
+}
+
+/**
+ * @brief Slot chamado ao acionar "Abrir Série" no menu.
+ */
+void MainWindow::on_actionAbrirSerie_triggered()
+{
+    QString directory = QFileDialog::getExistingDirectory(this, tr("Abrir série DICOM"));
+    if (directory.isEmpty()) {
+        return;
+    }
+    this->imageLoader->loadSeries(directory);
+    this->loadProgress->setValue(0);
+    this->loadProgress->setVisible(true);
+    statusBar()->showMessage(tr("Carregando série de %1...").arg(directory));
+}
+
+/**
+ * @brief Slot chamado ao acionar "Abrir Pasta" no menu.
+ */
+void MainWindow::on_actionAbrirPasta_triggered()
+{
+    QString directory = QFileDialog::getExistingDirectory(this, tr("Abrir pasta de estudos"));
+    if (directory.isEmpty()) {
+        return;
+    }
+    this->catalogScanner->scan(directory);
+    this->loadProgress->setValue(0);
+    this->loadProgress->setVisible(true);
+    statusBar()->showMessage(tr("Indexando %1...").arg(directory));
+}
+
+/**
+ * @brief Abre os arquivos e diretórios informados na inicialização e mede o tempo até a primeira imagem.
+ *
+ * Sem nada para abrir, a inicialização termina na primeira volta do laço
+ * de eventos, depois que a janela vazia é desenhada.
+ */
+void MainWindow::openAtStartup(const QStringList &paths, std::chrono::steady_clock::time_point processStart)
+{
+    this->startupPending = true;
+    this->startupStart = processStart;
+    if (!openPaths(paths)) {
+        QTimer::singleShot(0, this, [this]() {
+            finishStartup(false);
+        });
+    }
+}
+
+/**
+ * @brief Abre arquivos e diretórios vindos de fora da interface (linha de comando ou outra execução).
+ * @return true se algum carregamento ou indexação foi iniciado.
+ */
+bool MainWindow::openPaths(const QStringList &paths)
+{
+    QStringList files;
+    QString directory;
+    for (const QString &path : paths) {
+        const QFileInfo info(path);
+        if (info.isDir()) {
+            if (directory.isEmpty()) {
+                directory = info.absoluteFilePath();
+            }
+        } else if (info.isFile()) {
+            files.append(info.absoluteFilePath());
+        }
+    }
+
+    if (!files.isEmpty()) {
+        // Um arquivo navega pelo seu diretório; vários formam a própria lista de navegação
+        this->imageLoader->load(files.front(), files.size() > 1 ? files : QStringList());
+        statusBar()->showMessage(tr("Carregando %1...").arg(QFileInfo(files.front()).fileName()));
+    }
+    if (!directory.isEmpty()) {
+        this->catalogScanner->scan(directory);
+        if (files.isEmpty()) {
+            statusBar()->showMessage(tr("Indexando %1...").arg(directory));
+        }
+    }
+    if (files.isEmpty() && directory.isEmpty()) {
+        if (!paths.isEmpty()) {
+            statusBar()->showMessage(tr("Nenhum arquivo ou diretório encontrado: %1").arg(paths.join(", ")));
+        }
+        return false;
+    }
+    this->loadProgress->setValue(0);
+    this->loadProgress->setVisible(true);
+    return true;
+}
+
+/**
+ * @brief Encerra a medida da inicialização e agenda o que foi adiado para depois da primeira imagem.
+ *
+ * O tempo até a primeira imagem vai para o rastreamento (span "first-image",
+ * categoria "startup") e para o painel de desempenho.
+ */
+void MainWindow::finishStartup(bool imageShown)
+{
+    if (!this->startupPending) {
+        return;
+    }
+    this->startupPending = false;
+    if (imageShown) {
+        this->firstImageMs = dicom_viewer_core::elapsedMs(this->startupStart);
+        DICOM_TRACE_STARTUP("first-image", this->startupStart);
+    } else {
+        DICOM_TRACE_STARTUP("ready", this->startupStart);
+    }
+    // Roda depois que a cena atual chega à tela
+    QTimer::singleShot(0, this, &MainWindow::runDeferredInit);
+}
+
+/**
+ * @brief Registro dos codecs e leitura do catálogo, em segundo plano.
+ *
+ * Nenhum dos dois é necessário para exibir um arquivo não comprimido; feitos
+ * aqui, a primeira imagem não espera por eles e o primeiro arquivo
+ * comprimido ou a primeira "Abrir Pasta" também não.
+ */
+void MainWindow::runDeferredInit()
+{
+    QThreadPool::globalInstance()->start([]() {
+        DICOM_TRACE_SCOPE(traceScope, "codecs", "startup");
+        dicom_viewer_core::ensureCodecsRegistered();
+    });
+    this->catalogScanner->preload();
+}
+
+/**
+ * @brief Slot chamado ao acionar "Reformatação MPR" no menu.
+ *
+ * A janela compartilha o volume já carregado; cada abertura cria a sua própria
+ * cópia em blocos, liberada ao fechar a janela.
+ */
+void MainWindow::on_actionMpr_triggered()
+{
+    if (!this->currentVolume) {
+        return;
+    }
+    dicom_viewer_windows::MprWindow *mprWindow = new dicom_viewer_windows::MprWindow(this->currentVolume, this);
+    mprWindow->setAttribute(Qt::WA_DeleteOnClose);
+    mprWindow->show();
+}
+
+/**
+ * @brief Slot chamado ao acionar "Comparação em Grade" no menu.
+ *
+ * Ao abrir a grade, a série carregada (se houver) ocupa a primeira vista,
+ * compartilhando o volume sem cópia.
+ */
+void MainWindow::on_actionGrade_triggered()
+{
+    bool created = false;
+    dicom_viewer_windows::GridWindow *grid = openGridWindow(&created);
+    if (created && this->currentVolume) {
+        grid->showVolume(this->currentVolume, QString::fromStdString(this->currentVolume->seriesDescription));
+    }
+}
+
+/**
+ * @brief Janela de comparação em grade, criada na primeira chamada.
+ *
+ * A janela é destruída ao ser fechada, liberando os volumes que só ela exibia.
+ *
+ * @param created Recebe true se a janela acabou de ser criada.
+ */
+dicom_viewer_windows::GridWindow *MainWindow::openGridWindow(bool *created)
+{
+    if (created) {
+        *created = !this->gridWindow;
+    }
+    if (!this->gridWindow) {
+        this->gridWindow = new dicom_viewer_windows::GridWindow(this);
+        this->gridWindow->setAttribute(Qt::WA_DeleteOnClose);
+        // A grade só exibe volumes em memória: as séries acima do limite ficam na janela principal
+        dicom_viewer_core::PagedVolumeConfig pagedConfig;
+        this->gridWindow->setInMemorySeriesLimit(seriesStorageSettings(pagedConfig));
+    }
+    this->gridWindow->show();
+    this->gridWindow->raise();
+    this->gridWindow->activateWindow();
+    return this->gridWindow;
+}
+
+/**
+ * @brief Cria o receptor C-STORE (desligado) e os seus temporizadores.
+ *
+ * Os arquivos recebidos ficam no diretório de dados do aplicativo; a
+ * árvore de estudos é atualizada após dois segundos sem novas chegadas.
+ */
+void MainWindow::setupStorageReceiver()
+{
+    this->storageReceiver = new dicom_viewer_windows::StorageReceiver(this);
+    connect(this->storageReceiver, &dicom_viewer_windows::StorageReceiver::instanceStored, this, &MainWindow::onInstanceReceived);
+    // O receptor termina as associações abertas em outra thread; só então pode ser ligado de novo
+    connect(this->storageReceiver, &dicom_viewer_windows::StorageReceiver::stopped, this, [this]() {
+        ui->actionReceber->setEnabled(true);
+        showReceiveStats();
+    });
+    // A porta é aberta depois de start(): ocupada ou sem permissão, o receptor é desligado aqui
+    connect(this->storageReceiver, &dicom_viewer_windows::StorageReceiver::listenFailed, this, [this](const QString &reason) {
+        this->receiveStatsTimer->stop();
+        {
+            const QSignalBlocker blocker(ui->actionReceber);
+            ui->actionReceber->setChecked(false);
+        }
+        ui->actionReceber->setEnabled(false);
+        this->storageReceiver->stop();
+        statusBar()->showMessage(tr("O receptor parou: %1").arg(reason));
+        QMessageBox::warning(this, tr("Erro"), tr("Não foi possível escutar a porta %1:\n%2").arg(kStoragePort).arg(reason));
+    });
+
+    this->receiveScanTimer = new QTimer(this);
+    this->receiveScanTimer->setSingleShot(true);
+    this->receiveScanTimer->setInterval(2000);
+    connect(this->receiveScanTimer, &QTimer::timeout, this, [this]() {
+        this->catalogScanner->scan(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/incoming");
+    });
+
+    this->receiveStatsTimer = new QTimer(this);
+    this->receiveStatsTimer->setInterval(1000);
+    connect(this->receiveStatsTimer, &QTimer::timeout, this, &MainWindow::showReceiveStats);
+}
+
+/**
+ * @brief Liga ou desliga o receptor C-STORE.
+ */
+void MainWindow::on_actionReceber_toggled(bool checked)
+{
+    if (!checked) {
+        this->receiveStatsTimer->stop();
+        ui->actionReceber->setEnabled(false);
+        this->storageReceiver->stop();
+        statusBar()->showMessage(tr("Encerrando o receptor: aguardando as transferências em andamento..."));
+        return;
+    }
+    const QString directory = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/incoming";
+    if (!this->storageReceiver->start(kStoragePort, kStorageAeTitle, directory)) {
+        const QSignalBlocker blocker(ui->actionReceber);
+        ui->actionReceber->setChecked(false);
+        QMessageBox::warning(this, tr("Erro"), tr("Não foi possível iniciar o receptor em %1.").arg(directory));
+        return;
+    }
+    this->receivedSeries.clear();
+    this->receiveStatsTimer->start();
+    statusBar()->showMessage(tr("Recebendo como %1 na porta %2 em %3").arg(kStorageAeTitle).arg(kStoragePort).arg(directory));
+}
+
+/**
+ * @brief Lê das preferências se o cache de imagens decodificadas está ligado e o aplica.
+ *
+ * O cache guarda pixels de pacientes em disco: fica desligado até o usuário
+ * ligá-lo. O limite vem de decodedCache/budgetMegabytes nas preferências.
+ */
+void MainWindow::setupDecodedCache()
+{
+    const bool enabled = QSettings().value(kDecodedCacheEnabledKey, false).toBool();
+    const QSignalBlocker blocker(ui->actionCacheDecodificado);
+    ui->actionCacheDecodificado->setChecked(enabled);
+    applyDecodedCache(enabled);
+}
+
+/**
+ * @brief Liga (com o limite das preferências) ou desliga o cache usado pelo carregamento.
+ */
+void MainWindow::applyDecodedCache(bool enabled)
+{
+    if (!enabled) {
+        dicom_viewer_core::setDecodedCache(nullptr);
+        return;
+    }
+    // Reabrir um estudo comprimido mapeia os pixels já decodificados em vez de descomprimir de novo
+    dicom_viewer_core::setDecodedCache(
+        dicom_viewer_core::DecodedCache::open(decodedCacheDirectory().toStdString(), decodedCacheBudget()));
+}
+
+/**
+ * @brief Liga ou desliga o cache em disco de imagens decodificadas (guardado nas preferências).
+ */
+void MainWindow::on_actionCacheDecodificado_toggled(bool checked)
+{
+    QSettings().setValue(kDecodedCacheEnabledKey, checked);
+    applyDecodedCache(checked);
+    if (checked && !dicom_viewer_core::decodedCache()) {
+        QMessageBox::warning(this, tr("Erro"), tr("Não foi possível criar o cache em %1.").arg(decodedCacheDirectory()));
+        return;
+    }
+    statusBar()->showMessage(checked ? tr("Imagens decodificadas serão guardadas em %1").arg(decodedCacheDirectory())
+                                     : tr("Imagens decodificadas não serão mais guardadas em disco"));
+}
+
+/**
+ * @brief Apaga as imagens decodificadas guardadas em disco.
+ *
+ * Funciona também com o cache desligado, para apagar o que ficou de quando
+ * ele estava ligado. As imagens abertas continuam na tela.
+ */
+void MainWindow::on_actionLimparCacheDecodificado_triggered()
+{
+    std::shared_ptr<dicom_viewer_core::DecodedCache> cache = dicom_viewer_core::decodedCache();
+    if (!cache && QFileInfo::exists(decodedCacheDirectory())) {
+        cache = dicom_viewer_core::DecodedCache::open(decodedCacheDirectory().toStdString(), decodedCacheBudget());
+    }
+    if (!cache) {
+        statusBar()->showMessage(tr("Nenhuma imagem decodificada guardada em disco"));
+        return;
+    }
+    // Apagar milhares de arquivos fica fora da thread da interface
+    QPointer<MainWindow> self(this);
+    QThreadPool::globalInstance()->start([self, cache]() {
+        const bool cleared = cache->clear();
+        QMetaObject::invokeMethod(qApp, [self, cleared]() {
+            if (self) {
+                self->statusBar()->showMessage(cleared ? tr("Imagens decodificadas apagadas")
+                                                       : tr("Algumas imagens decodificadas em uso não puderam ser apagadas"));
+            }
+        }, Qt::QueuedConnection);
+    });
+}
+
+/**
+ * @brief Entrega ao carregador uma instância recebida pela rede.
+ *
+ * A primeira instância recebida é aberta imediatamente, sem esperar o fim
+ * da transferência; as seguintes entram na navegação (Page Up / Page Down)
+ * e na pré-busca à medida que chegam.
+ */
+void MainWindow::onInstanceReceived(const QString &path, const QString &studyInstanceUID, const QString &seriesInstanceUID)
+{
+    Q_UNUSED(studyInstanceUID);
+    this->receiveScanTimer->start();
+    if (this->receivedSeries.isEmpty()) {
+        this->receivedSeries = seriesInstanceUID;
+        this->imageLoader->load(path);
+        this->loadProgress->setValue(0);
+        this->loadProgress->setVisible(true);
+        return;
+    }
+    this->imageLoader->fileAdded(path);
+    updateNeighborActions();
+}
+
+/**
+ * @brief Mostra as taxas do receptor na barra de status.
+ */
+void MainWindow::showReceiveStats()
+{
+    const dicom_viewer_core::StorageStats stats = this->storageReceiver->stats();
+    statusBar()->showMessage(tr("Recebidas %1 instâncias (%2 falhas) · %3 inst/s · %4 MB/s · %5 associações ativas (pico %6)")
+                                 .arg(stats.instancesWritten)
+                                 .arg(stats.instancesFailed)
+                                 .arg(stats.instancesPerSecond, 0, 'f', 1)
+                                 .arg(stats.megabytesPerSecond, 0, 'f', 1)
+                                 .arg(stats.activeAssociations)
+                                 .arg(stats.peakAssociations));
+}
+
+/**
+ * @brief Slot chamado ao acionar "Imagem Anterior" no menu.
+ */
+void MainWindow::on_actionImagemAnterior_triggered()
+{
+    openNeighbor(-1);
+}
+
+/**
+ * @brief Slot chamado ao acionar "Próxima Imagem" no menu.
+ */
+void MainWindow::on_actionProximaImagem_triggered()
+{
+    openNeighbor(1);
+}
+
+/**
+ * @brief Abre o arquivo vizinho do atual, na ordem do diretório ou da série.
+ *
+ * Os vizinhos próximos já foram pré-carregados pelo ImageLoader, então a
+ * navegação normalmente é atendida pelo cache, sem nova decodificação.
+ *
+ * @param offset -1 para o anterior, +1 para o próximo.
+ */
+void MainWindow::openNeighbor(int offset)
+{
+    const QString path = this->imageLoader->neighborPath(offset);
+    if (path.isEmpty() || this->imageLoader->loadNeighbor(offset) == 0) {
+        return;
+    }
+    this->loadProgress->setValue(0);
+    this->loadProgress->setVisible(true);
+    statusBar()->showMessage(tr("Carregando %1...").arg(QFileInfo(path).fileName()));
+}
+
+/**
+ * @brief Habilita a navegação entre vizinhos conforme o arquivo atual.
+ */
+void MainWindow::updateNeighborActions()
+{
+    ui->actionImagemAnterior->setEnabled(!this->imageLoader->neighborPath(-1).isEmpty());
+    ui->actionProximaImagem->setEnabled(!this->imageLoader->neighborPath(1).isEmpty());
+}
+
+/**
+ * @brief Monta a árvore de estudos a partir do catálogo atualizado.
+ *
+ * A árvore vai até o nível de série; as instâncias de cada série ficam
+ * guardadas no item e são carregadas ao ativá-lo.
+ */
+void MainWindow::onCatalogScanned(quint64 requestId, const dicom_viewer_windows::ScannedCatalog &result)
+{
+    if (requestId != this->catalogScanner->currentRequest()) {
+        return;
+    }
+    this->loadProgress->setVisible(false);
+
+    this->studyTree->clear();
+    const std::vector<dicom_viewer_core::CatalogEntry> &entries = result.catalog->entries();
+    for (const dicom_viewer_core::CatalogPatient &patient : result.patients) {
+        QTreeWidgetItem *patientItem = new QTreeWidgetItem(this->studyTree);
+        patientItem->setText(0, tr("%1 (%2)").arg(QString::fromStdString(patient.name), QString::fromStdString(patient.patientID)));
+        for (const dicom_viewer_core::CatalogStudy &study : patient.studies) {
+            QTreeWidgetItem *studyItem = new QTreeWidgetItem(patientItem);
+            studyItem->setText(0, tr("%1 %2").arg(QString::fromStdString(study.date), QString::fromStdString(study.description)));
+            for (const dicom_viewer_core::CatalogSeries &series : study.series) {
+                QStringList files;
+                files.reserve(static_cast<int>(series.instances.size()));
+                for (std::size_t index : series.instances) {
+                    files.append(QString::fromStdString(entries[index].path));
+                }
+                const dicom_viewer_core::CatalogEntry &first = entries[series.instances.front()];
+                QTreeWidgetItem *seriesItem = new QTreeWidgetItem(studyItem);
+                seriesItem->setText(0, tr("#%1 %2 %3").arg(series.seriesNumber)
+                                           .arg(QString::fromStdString(series.modality), QString::fromStdString(series.description)));
+                seriesItem->setText(1, QString::number(files.size()));
+                seriesItem->setData(0, Qt::UserRole, files);
+                seriesItem->setData(1, Qt::UserRole, first.numberOfFrames);
+            }
+        }
+    }
+    this->studyTree->expandToDepth(1);
+    this->studyTree->resizeColumnToContents(0);
+    this->studyDock->setVisible(true);
+    finishStartup(false);
+
+    const dicom_viewer_core::CatalogScanStats &stats = result.stats;
+    statusBar()->showMessage(tr("%1 arquivos em %2 ms (%3 lidos, %4 inalterados, %5 removidos, %6 DICOM, %7 arquivos/s)")
+                                 .arg(stats.filesFound)
+                                 .arg(stats.totalMs, 0, 'f', 1)
+                                 .arg(stats.filesRead)
+                                 .arg(stats.filesReused)
+                                 .arg(stats.filesRemoved)
+                                 .arg(stats.dicomFiles)
+                                 .arg(stats.filesPerSecond, 0, 'f', 0));
+}
+
+/**
+ * @brief Abre a série ou instância escolhida na árvore de estudos.
+ *
+ * Séries com um único arquivo (ou multi-frame) abrem como imagem; as
+ * demais são montadas como volume.
+ */
+void MainWindow::onStudyItemActivated(QTreeWidgetItem *item, int column)
+{
+    Q_UNUSED(column);
+    const QStringList files = item->data(0, Qt::UserRole).toStringList();
+    if (files.isEmpty()) {
+        return;
+    }
+    const int frames = item->data(1, Qt::UserRole).toInt();
+    if (files.size() == 1 || frames > 1) {
+        // As demais instâncias da série servem de vizinhos para a navegação e a pré-busca
+        this->imageLoader->load(files.front(), files.size() > 1 ? files : QStringList());
+    } else {
+        this->imageLoader->loadSeriesFiles(files, item->text(0));
+    }
+    this->loadProgress->setValue(0);
+    this->loadProgress->setVisible(true);
+    statusBar()->showMessage(tr("Carregando %1...").arg(item->text(0)));
+}
+
+/**
+ * @brief Exibe o corte central da série entregue pelo serviço de carregamento.
+ */
+void MainWindow::onSeriesLoaded(quint64 requestId, const dicom_viewer_windows::LoadedSeries &result)
+{
+    if (requestId != this->imageLoader->currentRequest()) {
+        return;
+    }
+    this->loadProgress->setVisible(false);
+    this->currentImage = result.image;
+    this->currentVolume = result.volume;
+    this->currentPagedVolume = result.pagedVolume;
+    const int depth = result.volume ? result.volume->depth : result.pagedVolume ? result.pagedVolume->depth() : 0;
+    ui->actionMpr->setEnabled(result.volume && depth > 1);
+    updateNeighborActions();
+    this->cinePlayAction->setChecked(false);
+    this->cinePlayer->setSource(nullptr);
+    this->cineToolBar->setVisible(false);
+    showImage(result.displayImage);
+    resetWindowLevel();
+    scheduleRegionTables();
+
+    // O corte central exibido corresponde ao modo "Corte" no eixo axial
+    this->projectionToolBar->setVisible(depth > 1);
+    if (depth > 1) {
+        const QSignalBlocker modeBlocker(this->projectionModeCombo);
+        const QSignalBlocker axisBlocker(this->projectionAxisCombo);
+        const QSignalBlocker sliderBlocker(this->projectionSlider);
+        this->projectionModeCombo->setCurrentIndex(0);
+        this->projectionAxisCombo->setCurrentIndex(0);
+        this->projectionThicknessSpin->setEnabled(false);
+        this->projectionSlider->setRange(0, depth - 1);
+        this->projectionSlider->setValue(depth / 2);
+        this->projectionLabel->clear();
+    }
+    // Projeções e os eixos coronal e sagital percorrem o volume inteiro: apenas cortes axiais na série paginada
+    this->projectionModeCombo->setEnabled(!result.pagedVolume);
+    this->projectionAxisCombo->setEnabled(!result.pagedVolume);
+    if (result.pagedVolume) {
+        result.pagedVolume->prefetchAround(depth / 2);
+    }
+
+    if (ui->metadata) {
+        ui->metadata->setPlainText(result.metadata);
     }
+    // O volume não guarda os arquivos de origem: o painel de tags fica vazio para séries
+    showTagTree(QString());
 
-    file.close();
+    const dicom_viewer_core::SeriesLoadStats &stats = result.stats;
+    statusBar()->showMessage(tr("%1 cortes em %2 ms (cabeçalhos %3 ms, %4 cortes/s, volume %5 MB, pico de memória %6 MB)")
+                                 .arg(stats.slicesLoaded)
+                                 .arg(stats.totalMs, 0, 'f', 1)
+                                 .arg(stats.headerMs, 0, 'f', 1)
+                                 .arg(stats.slicesPerSecond, 0, 'f', 1)
+                                 .arg(stats.voxelBytes / (1024.0 * 1024.0), 0, 'f', 1)
+                                 .arg(stats.peakResidentBytes / (1024.0 * 1024.0), 0, 'f', 1)
+                             + (result.pagedVolume ? tr(", paginado em disco") : QString()));
+    updatePerfOverlay();
 }
 
+/**
+ * @brief Substitui o conteúdo da cena pela imagem informada.
+ */
+void MainWindow::showImage(const QImage &image)
+{
+    DICOM_TRACE_SCOPE(traceScope, "scene", "ui");
+    this->sceneMedicalImage->clear();
+    // clear() apaga também a medida anterior
+    this->measureShape = nullptr;
+    this->measureLabel = nullptr;
+    this->measuring = false;
+    this->imageItem = new dicom_viewer_windows::ImageItem();
+    this->imageItem->setImage(image);
+    this->sceneMedicalImage->addItem(this->imageItem);
+    this->sceneMedicalImage->setSceneRect(image.rect());
+    ui->medicalImageView->fitInView(this->imageItem, Qt::KeepAspectRatio);
+    finishStartup(true);
+}
 
+/**
+ * @brief Troca a imagem exibida mantendo o enquadramento atual.
+ */
+void MainWindow::updateImage(const QImage &image)
+{
+    if (!this->imageItem) {
+        showImage(image);
+        return;
+    }
+    this->imageItem->setImage(image);
+}
+
+/**
+ * @brief Exibe um quadro entregue pelo reprodutor cine.
+ */
+void MainWindow::onCineFrame(int index, const QImage &image)
+{
+    updateImage(image);
+    if (!this->cineFrameSlider->isSliderDown()) {
+        this->cineFrameSlider->setValue(index);
+    }
+    if (!this->cinePlayer->isPlaying() && this->cinePlayer->source()) {
+        this->cineStatsLabel->setText(tr("Quadro %1/%2").arg(index + 1).arg(this->cinePlayer->source()->frameCount()));
+    }
+}
+
+/**
+ * @brief Atualiza os contadores de quadros exibidos e descartados.
+ */
+void MainWindow::onCineStats(int presented, int dropped)
+{
+    const std::shared_ptr<dicom_viewer_core::FrameSource> source = this->cinePlayer->source();
+    if (!source) {
+        return;
+    }
+    this->cineStatsLabel->setText(tr("Quadro %1/%2 · exibidos %3 · descartados %4")
+                                      .arg(this->cinePlayer->currentFrame() + 1)
+                                      .arg(source->frameCount())
+                                      .arg(presented)
+                                      .arg(dropped));
+}
+
+/**
+ * @brief Informa ao usuário que o carregamento falhou.
+ */
+void MainWindow::onImageLoadFailed(quint64 requestId, const QString &path, const QString &reason)
+{
+    if (requestId != this->imageLoader->currentRequest()) {
+        return;
+    }
+    Q_UNUSED(path);
+    this->loadProgress->setVisible(false);
+    finishStartup(false);
+    updateNeighborActions();
+    statusBar()->clearMessage();
+    QMessageBox::critical(this, tr("Arquivo inválido"), reason);
+}
+
+/**
+ * @brief Prepara o janelamento interativo para a imagem de precisão total atual.
+ *
+ * A sensibilidade do arraste é proporcional ao intervalo de valores da imagem,
+ * de modo que cerca de mil pixels de movimento percorrem todo o intervalo.
+ */
+void MainWindow::resetWindowLevel()
+{
+    this->windowDragging = false;
+    if (!this->currentImage || !dicom_viewer_core::isFullPrecision(*this->currentImage)) {
+        return;
+    }
+    dicom_viewer_windows::defaultWindow(*this->currentImage, this->windowCenter, this->windowWidth);
+
+    double minValue = 0.0;
+    double maxValue = 0.0;
+    if (dicom_viewer_core::computeValueRange(*this->currentImage, minValue, maxValue,
+                                             dicom_viewer_core::ThreadPool::shared())) {
+        this->windowStep = std::max((maxValue - minValue) / 1024.0, 0.01);
+    } else {
+        this->windowStep = 1.0;
+    }
+}
+
+/**
+ * @brief Reaplica a janela atual à imagem de precisão total e atualiza a exibição.
+ *
+ * O remapeamento ocorre na thread da interface: com a tabela de consulta e o
+ * laço vetorizado distribuído pelo pool, uma imagem de 4096x4096 leva poucos
+ * milissegundos, dentro do orçamento de um quadro.
+ */
+void MainWindow::applyWindowLevel()
+{
+    if (!this->currentImage || !this->imageItem) {
+        return;
+    }
+    // Retirar a imagem do item evita que a escrita desanexe (copie) o buffer exibido
+    QImage target = this->imageItem->takeImage();
+    const bool rendered = dicom_viewer_windows::renderWindowLevel(*this->currentImage, this->windowCenter,
+                                                                  this->windowWidth, target);
+    this->imageItem->setImage(std::move(target));
+    if (!rendered) {
+        return;
+    }
+    statusBar()->showMessage(tr("W/L: largura %1, centro %2")
+                                 .arg(this->windowWidth, 0, 'f', 1)
+                                 .arg(this->windowCenter, 0, 'f', 1));
+}
+
+/**
+ * @brief Trata a roda do mouse (zoom) e o arraste com o botão direito (janelamento).
+ *
+ * No janelamento, movimento horizontal altera a largura e movimento vertical altera o centro.
+ * Imagens multi-frame em reprodução cine não participam, pois seus quadros
+ * chegam já convertidos para 8 bits.
+ */
+bool MainWindow::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched != this->ui->medicalImageView->viewport()) {
+        return QMainWindow::eventFilter(watched, event);
+    }
+    if (event->type() == QEvent::Wheel && this->imageItem) {
+        // Zoom ancorado no cursor; a pirâmide escolhe o nível pela nova escala
+        QWheelEvent *wheelEvent = static_cast<QWheelEvent *>(event);
+        const double factor = std::pow(1.25, wheelEvent->angleDelta().y() / 120.0);
+        ui->medicalImageView->scale(factor, factor);
+        return true;
+    }
+    if (this->measureTool != MeasureTool::None && handleMeasureEvent(event)) {
+        return true;
+    }
+    const bool windowLevelEnabled = this->currentImage && !this->cinePlayer->source() &&
+                                    dicom_viewer_core::isFullPrecision(*this->currentImage);
+    if (!windowLevelEnabled) {
+        return QMainWindow::eventFilter(watched, event);
+    }
+
+    switch (event->type()) {
+    case QEvent::MouseButtonPress: {
+        QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(event);
+        if (mouseEvent->button() != Qt::RightButton) {
+            break;
+        }
+        this->windowDragging = true;
+        this->windowDragOrigin = mouseEvent->position().toPoint();
+        return true;
+    }
+    case QEvent::MouseMove: {
+        if (!this->windowDragging) {
+            break;
+        }
+        QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(event);
+        const QPoint position = mouseEvent->position().toPoint();
+        const QPoint delta = position - this->windowDragOrigin;
+        this->windowDragOrigin = position;
+        this->windowWidth = std::max(1.0, this->windowWidth + delta.x() * this->windowStep);
+        this->windowCenter += delta.y() * this->windowStep;
+        applyWindowLevel();
+        return true;
+    }
+    case QEvent::MouseButtonRelease: {
+        QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(event);
+        if (mouseEvent->button() != Qt::RightButton || !this->windowDragging) {
+            break;
+        }
+        this->windowDragging = false;
+        return true;
+    }
+    case QEvent::ContextMenu:
+        // O botão direito é reservado ao janelamento
+        return true;
+    default:
+        break;
+    }
+    return QMainWindow::eventFilter(watched, event);
+}
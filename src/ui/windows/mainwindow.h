@@ -10,6 +10,35 @@
 
 #include <QMainWindow>
 #include <QGraphicsScene>
+#include <QProgressBar>
+#include <QToolBar>
+#include <QSlider>
+#include <QSpinBox>
+#include <QDoubleSpinBox>
+#include <QComboBox>
+#include <QLabel>
+#include <QDockWidget>
+#include <QTreeWidget>
+#include <QTreeView>
+#include <QListWidget>
+#include <QLineEdit>
+#include <QCheckBox>
+#include <QTimer>
+#include <QGraphicsSimpleTextItem>
+#include <QPointer>
+#include <QStringList>
+
+#include <atomic>
+#include <chrono>
+
+#include "../services/imageloader.h"
+#include "../services/cineplayer.h"
+#include "../services/catalogscanner.h"
+#include "../services/tagtreemodel.h"
+#include "../services/storagereceiver.h"
+#include "imageitem.h"
+#include "gridwindow.h"
+#include "../../core/RegionStatistics.h"
 
 
 QT_BEGIN_NAMESPACE
@@ -34,14 +63,371 @@ public:
      */
     ~MainWindow();
 
+    /**
+     * @brief Abre os arquivos e diretórios informados na inicialização e mede o tempo até a primeira imagem.
+     * @param paths Caminhos da linha de comando (podem estar vazios).
+     * @param processStart Instante de entrada em main(), referência da medida.
+     */
+    void openAtStartup(const QStringList &paths, std::chrono::steady_clock::time_point processStart);
+
+    /**
+     * @brief Abre arquivos e diretórios vindos de fora da interface (linha de comando ou outra execução).
+     *
+     * Um único arquivo abre com os vizinhos do seu diretório; vários arquivos
+     * formam a lista de navegação. Um diretório é indexado como em "Abrir Pasta"
+     * (apenas o primeiro, se vierem vários).
+     *
+     * @return true se algum carregamento ou indexação foi iniciado.
+     */
+    bool openPaths(const QStringList &paths);
+
+protected:
+    /**
+     * @brief Trata a roda do mouse (zoom) e o arraste com o botão direito (janelamento).
+     */
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
 private slots:
     /**
      * @brief Slot chamado ao acionar "Abrir" no menu.
      */
     void on_actionAbrir_triggered();
 
+    /**
+     * @brief Slot chamado ao acionar "Abrir Série" no menu.
+     */
+    void on_actionAbrirSerie_triggered();
+
+    /**
+     * @brief Slot chamado ao acionar "Abrir Pasta" no menu.
+     */
+    void on_actionAbrirPasta_triggered();
+
+    /**
+     * @brief Slot chamado ao acionar "Reformatação MPR" no menu.
+     */
+    void on_actionMpr_triggered();
+
+    /**
+     * @brief Slot chamado ao acionar "Comparação em Grade" no menu.
+     */
+    void on_actionGrade_triggered();
+
+    /**
+     * @brief Liga ou desliga o receptor C-STORE.
+     */
+    void on_actionReceber_toggled(bool checked);
+
+    /**
+     * @brief Liga ou desliga o cache em disco de imagens decodificadas (guardado nas preferências).
+     */
+    void on_actionCacheDecodificado_toggled(bool checked);
+
+    /**
+     * @brief Apaga as imagens decodificadas guardadas em disco.
+     */
+    void on_actionLimparCacheDecodificado_triggered();
+
+    /**
+     * @brief Entrega ao carregador uma instância recebida pela rede.
+     */
+    void onInstanceReceived(const QString &path, const QString &studyInstanceUID, const QString &seriesInstanceUID);
+
+    /**
+     * @brief Slot chamado ao acionar "Imagem Anterior" no menu.
+     */
+    void on_actionImagemAnterior_triggered();
+
+    /**
+     * @brief Slot chamado ao acionar "Próxima Imagem" no menu.
+     */
+    void on_actionProximaImagem_triggered();
+
+    /**
+     * @brief Monta a árvore de estudos a partir do catálogo atualizado.
+     */
+    void onCatalogScanned(quint64 requestId, const dicom_viewer_windows::ScannedCatalog &result);
+
+    /**
+     * @brief Abre a série ou instância escolhida na árvore de estudos.
+     */
+    void onStudyItemActivated(QTreeWidgetItem *item, int column);
+
+    /**
+     * @brief Atualiza a barra de progresso do carregamento em andamento.
+     */
+    void onLoadProgress(quint64 requestId, int percent);
+
+    /**
+     * @brief Exibe a prévia reduzida de um arquivo grande ainda em leitura.
+     */
+    void onImagePreview(quint64 requestId, const QImage &image, int scale);
+
+    /**
+     * @brief Exibe a imagem entregue pelo serviço de carregamento.
+     */
+    void onImageLoaded(quint64 requestId, const dicom_viewer_windows::LoadedImage &result);
+
+    /**
+     * @brief Exibe o corte central da série entregue pelo serviço de carregamento.
+     */
+    void onSeriesLoaded(quint64 requestId, const dicom_viewer_windows::LoadedSeries &result);
+
+    /**
+     * @brief Informa ao usuário que o carregamento falhou.
+     */
+    void onImageLoadFailed(quint64 requestId, const QString &path, const QString &reason);
+
+    /**
+     * @brief Exibe um quadro entregue pelo reprodutor cine.
+     */
+    void onCineFrame(int index, const QImage &image);
+
+    /**
+     * @brief Atualiza os contadores de quadros exibidos e descartados.
+     */
+    void onCineStats(int presented, int dropped);
+
+    /**
+     * @brief Remove as medidas desenhadas sobre a imagem.
+     */
+    void on_actionLimparMedidas_triggered();
+
+    /**
+     * @brief Mostra ou oculta o painel de desempenho sobre a imagem.
+     */
+    void on_actionDesempenho_toggled(bool checked);
+
+    /**
+     * @brief Grava os eventos rastreados no formato Chrome trace-event.
+     */
+    void on_actionExportarTrace_triggered();
+
 private:
     Ui::MainWindow *ui;
     QGraphicsScene* sceneMedicalImage;
+    dicom_viewer_windows::ImageLoader* imageLoader;
+    QProgressBar* loadProgress;
+    std::shared_ptr<const dicom_viewer_core::MedicalImage> currentImage;
+    std::shared_ptr<const dicom_viewer_core::Volume> currentVolume;
+    std::shared_ptr<dicom_viewer_core::PagedVolume> currentPagedVolume; ///< Série aberta fora da memória (currentVolume nulo)
+    dicom_viewer_windows::ImageItem* imageItem = nullptr;
+
+    dicom_viewer_windows::CatalogScanner* catalogScanner;
+    QDockWidget* studyDock;
+    QTreeWidget* studyTree;
+    QPointer<dicom_viewer_windows::GridWindow> gridWindow; ///< Grade de comparação, enquanto aberta
+
+    dicom_viewer_windows::TagTreeModel* tagModel;
+    QDockWidget* tagDock;
+    QTreeView* tagTreeView;
+    QLineEdit* tagSearchEdit;
+    QCheckBox* tagLargeValuesCheck;       ///< A busca também lê os valores grandes e binários
+    QListWidget* tagSearchResults;
+    QLabel* tagSearchLabel;
+    QTimer* tagSearchTimer;               ///< Adia a busca enquanto o usuário digita
+    QString tagFilePath;                  ///< Arquivo cujas tags o painel deve exibir
+    quint64 tagSearchId = 0;              ///< Busca cujas ocorrências estão na lista
+    int tagSearchCount = 0;               ///< Ocorrências recebidas da busca atual
+
+    dicom_viewer_windows::StorageReceiver* storageReceiver;
+    QTimer* receiveScanTimer;             ///< Reindexa os recebidos após uma pausa nas chegadas
+    QTimer* receiveStatsTimer;            ///< Atualiza as taxas de recepção na barra de status
+    QString receivedSeries;               ///< Série recebida aberta automaticamente
+
+    bool startupPending = false;          ///< A primeira imagem (ou a desistência dela) ainda não ocorreu
+    std::chrono::steady_clock::time_point startupStart;
+    double firstImageMs = -1.0;           ///< Da entrada em main() à primeira imagem na cena (-1: não medido)
+
+    dicom_viewer_windows::CinePlayer* cinePlayer;
+    QToolBar* cineToolBar;
+    QAction* cinePlayAction;
+    QSlider* cineFrameSlider;
+    QSpinBox* cineFpsSpin;
+    QLabel* cineStatsLabel;
+
+    QToolBar* projectionToolBar;          ///< Projeções em placa da série carregada
+    QComboBox* projectionModeCombo;
+    QComboBox* projectionAxisCombo;
+    QSlider* projectionSlider;            ///< Centro da placa ao longo do eixo
+    QDoubleSpinBox* projectionThicknessSpin; ///< Espessura da placa, em mm
+    QLabel* projectionLabel;
+
+    QLabel* perfOverlay;                  ///< Painel com os estágios do último carregamento
+    quint64 previewRequest = 0;           ///< Requisição cuja prévia está na cena
+
+    /**
+     * @brief Ferramenta de medida ativa no botão esquerdo.
+     */
+    enum class MeasureTool { None, Rectangle, Ellipse, Distance };
+    MeasureTool measureTool = MeasureTool::None;
+    std::shared_ptr<const dicom_viewer_core::RegionTables> regionTables; ///< Tabelas da imagem atual (nullptr enquanto são construídas)
+    std::shared_ptr<const dicom_viewer_core::MedicalImage> regionTablesImage; ///< Imagem cujas tabelas estão em construção
+    std::shared_ptr<std::atomic<quint64>> regionTablesGeneration;      ///< Invalida construções de imagens substituídas
+    QTimer* regionTablesTimer;            ///< Adia a construção enquanto o corte ou a projeção mudam
+    QGraphicsItem* measureShape = nullptr;            ///< Retângulo, elipse ou linha da medida em edição
+    QGraphicsSimpleTextItem* measureLabel = nullptr;  ///< Resultado da medida em edição
+    QPointF measureOrigin;                ///< Ponto inicial do arraste, em pixels da imagem
+    QPointF measureEnd;                   ///< Ponto atual do arraste, em pixels da imagem
+    bool measuring = false;               ///< true durante o arraste com o botão esquerdo
+
+    double windowCenter = 0.0;            ///< Centro da janela atual
+    double windowWidth = 0.0;             ///< Largura da janela atual
+    double windowStep = 1.0;              ///< Unidades de modalidade por pixel de arraste
+    bool windowDragging = false;          ///< true durante o arraste com o botão direito
+    QPoint windowDragOrigin;              ///< Última posição do cursor durante o arraste
+
+    /**
+     * @brief Cria a barra de ferramentas de reprodução cine.
+     */
+    void setupCineToolBar();
+
+    /**
+     * @brief Cria a barra de ferramentas de projeções (MIP/MinIP/AvgIP).
+     */
+    void setupProjectionToolBar();
+
+    /**
+     * @brief Recalcula a projeção da série atual com os parâmetros da barra.
+     * @param resetView Se true, reinicia o janelamento e o enquadramento (modo ou eixo mudou).
+     */
+    void updateProjection(bool resetView);
+
+    /**
+     * @brief Exibe o corte axial escolhido da série paginada e pede a leitura dos blocos vizinhos.
+     * @param resetView Se true, reinicia o janelamento e o enquadramento.
+     */
+    void updatePagedSlice(bool resetView);
+
+    /**
+     * @brief Exibe currentImage, derivada do volume atual (projeção ou corte).
+     * @param resetView Se true, reinicia o janelamento e o enquadramento.
+     */
+    void showVolumeImage(bool resetView);
+
+    /**
+     * @brief Cria o painel com a árvore de estudos do catálogo.
+     */
+    void setupStudyDock();
+
+    /**
+     * @brief Janela de comparação em grade, criada na primeira chamada.
+     * @param created Recebe true se a janela acabou de ser criada.
+     */
+    dicom_viewer_windows::GridWindow* openGridWindow(bool *created = nullptr);
+
+    /**
+     * @brief Cria o receptor C-STORE (desligado) e os seus temporizadores.
+     */
+    void setupStorageReceiver();
+
+    /**
+     * @brief Mostra as taxas do receptor na barra de status.
+     */
+    void showReceiveStats();
+
+    /**
+     * @brief Lê das preferências se o cache de imagens decodificadas está ligado e o aplica.
+     */
+    void setupDecodedCache();
+
+    /**
+     * @brief Liga (com o limite das preferências) ou desliga o cache usado pelo carregamento.
+     */
+    void applyDecodedCache(bool enabled);
+
+    /**
+     * @brief Cria o painel com a árvore completa de tags do arquivo atual e a busca.
+     */
+    void setupTagDock();
+
+    /**
+     * @brief Define o arquivo do painel de tags; a leitura só ocorre com o painel visível.
+     * @param path Arquivo DICOM, ou vazio para esvaziar o painel.
+     */
+    void showTagTree(const QString &path);
+
+    /**
+     * @brief Reinicia a busca de tags com o texto atual.
+     */
+    void startTagSearch();
+
+    /**
+     * @brief Cria o painel de desempenho sobreposto à imagem.
+     */
+    void setupPerfOverlay();
+
+    /**
+     * @brief Atualiza o painel de desempenho com os estágios do último carregamento.
+     */
+    void updatePerfOverlay();
+
+    /**
+     * @brief Abre o arquivo vizinho do atual, na ordem do diretório ou da série.
+     * @param offset -1 para o anterior, +1 para o próximo.
+     */
+    void openNeighbor(int offset);
+
+    /**
+     * @brief Habilita a navegação entre vizinhos conforme o arquivo atual.
+     */
+    void updateNeighborActions();
+
+    /**
+     * @brief Cria o grupo exclusivo das ferramentas de medida.
+     */
+    void setupMeasureTools();
+
+    /**
+     * @brief Descarta as tabelas da imagem anterior e adia a construção das da imagem atual.
+     */
+    void scheduleRegionTables();
+
+    /**
+     * @brief Constrói em segundo plano as tabelas de estatísticas da imagem atual.
+     */
+    void buildRegionTables();
+
+    /**
+     * @brief Trata o arraste com o botão esquerdo quando uma ferramenta de medida está ativa.
+     * @return true se o evento foi consumido.
+     */
+    bool handleMeasureEvent(QEvent *event);
+
+    /**
+     * @brief Atualiza a forma e o texto da medida em edição.
+     */
+    void updateMeasurement();
+
+    /**
+     * @brief Encerra a medida da inicialização e agenda o que foi adiado para depois da primeira imagem.
+     * @param imageShown true se a inicialização terminou com uma imagem na cena.
+     */
+    void finishStartup(bool imageShown);
+
+    /**
+     * @brief Registro dos codecs e leitura do catálogo, em segundo plano.
+     */
+    void runDeferredInit();
+
+    /**
+     * @brief Substitui o conteúdo da cena pela imagem informada.
+     */
+    void showImage(const QImage &image);
+
+    /**
+     * @brief Troca a imagem exibida mantendo o enquadramento atual.
+     */
+    void updateImage(const QImage &image);
+
+    /**
+     * @brief Prepara o janelamento interativo para a imagem de precisão total atual.
+     */
+    void resetWindowLevel();
+
+    /**
+     * @brief Reaplica a janela atual à imagem de precisão total e atualiza a exibição.
+     */
+    void applyWindowLevel();
 };
 #endif // MAINWINDOW_H
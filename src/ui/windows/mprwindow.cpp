@@ -0,0 +1,317 @@
+/**
+ * DICOM Viewer - Janela de Reformatação Multiplanar
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+/**
+ * @file mprwindow.cpp
+ * @brief Implementação da classe MprWindow.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include <QApplication>
+#include <QGridLayout>
+#include <QHBoxLayout>
+#include <QMouseEvent>
+#include <QPointer>
+#include <QThreadPool>
+#include <QTimer>
+#include <QWheelEvent>
+
+#include "mprwindow.h"
+#include "utils.h"
+#include "../../core/ThreadPool.h"
+#include "../../core/WindowLevel.h"
+
+namespace dicom_viewer_windows {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+}
+
+/**
+ * @brief Construtor da janela. O volume é reorganizado em blocos em segundo plano.
+ * @param volume Volume da série.
+ * @param parent Widget pai (opcional).
+ */
+MprWindow::MprWindow(std::shared_ptr<const dicom_viewer_core::Volume> volume, QWidget *parent)
+    : QWidget(parent, Qt::Window)
+    , volume(std::move(volume))
+{
+    setWindowTitle(tr("Reformatação Multiplanar"));
+    resize(1200, 900);
+
+    QGridLayout *grid = new QGridLayout();
+    const dicom_viewer_core::MprOrientation orientations[3] = {dicom_viewer_core::MprOrientation::Axial,
+                                                               dicom_viewer_core::MprOrientation::Coronal,
+                                                               dicom_viewer_core::MprOrientation::Sagittal};
+    const QColor colors[3] = {QColor(80, 160, 255), QColor(80, 220, 120), QColor(255, 170, 60)};
+    for (int index = 0; index < 3; ++index) {
+        View &view = this->views[index];
+        view.orientation = orientations[index];
+        view.scene = new QGraphicsScene(this);
+        view.scene->setBackgroundBrush(Qt::black);
+        view.view = new QGraphicsView(view.scene, this);
+        view.view->setTransformationAnchor(QGraphicsView::AnchorViewCenter);
+        view.view->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+        view.view->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+        view.view->viewport()->installEventFilter(this);
+        view.item = new ImageItem();
+        view.scene->addItem(view.item);
+        // Cada vista mostra as linhas dos outros dois planos, na cor de cada um
+        view.horizontal = view.scene->addLine(QLineF(), QPen(colors[(index + 1) % 3], 0));
+        view.vertical = view.scene->addLine(QLineF(), QPen(colors[(index + 2) % 3], 0));
+        view.horizontal->setZValue(1);
+        view.vertical->setZValue(1);
+        grid->addWidget(view.view, index / 2, index % 2);
+    }
+
+    this->obliqueSlider = new QSlider(Qt::Horizontal, this);
+    this->obliqueSlider->setRange(-90, 90);
+    this->obliqueSlider->setValue(0);
+    connect(this->obliqueSlider, &QSlider::valueChanged, this, [this](int degrees) {
+        this->obliqueAngle = degrees * kPi / 180.0;
+        this->views[1].dirty = true;
+        this->views[2].dirty = true;
+        scheduleRender();
+    });
+    this->statusLabel = new QLabel(tr("Reorganizando o volume..."), this);
+
+    QWidget *controls = new QWidget(this);
+    QHBoxLayout *controlLayout = new QHBoxLayout(controls);
+    controlLayout->addWidget(new QLabel(tr("Oblíquo"), controls));
+    controlLayout->addWidget(this->obliqueSlider);
+    controlLayout->addWidget(this->statusLabel, 1);
+    grid->addWidget(controls, 1, 1);
+    setLayout(grid);
+
+    // A reorganização em blocos de um volume grande leva centenas de milissegundos
+    QPointer<MprWindow> guard(this);
+    std::shared_ptr<const dicom_viewer_core::Volume> source = this->volume;
+    QThreadPool::globalInstance()->start([guard, source]() {
+        auto bricked = std::make_shared<const dicom_viewer_core::BrickedVolume>(
+            dicom_viewer_core::BrickedVolume::fromVolume(*source, dicom_viewer_core::ThreadPool::shared()));
+        QMetaObject::invokeMethod(qApp, [guard, bricked]() {
+            if (guard) {
+                guard->onVolumeReady(bricked);
+            }
+        }, Qt::QueuedConnection);
+    });
+}
+
+/**
+ * @brief Recebe o volume em blocos e exibe as três vistas.
+ */
+void MprWindow::onVolumeReady(std::shared_ptr<const dicom_viewer_core::BrickedVolume> brickedVolume)
+{
+    if (!brickedVolume || !brickedVolume->isValid()) {
+        this->statusLabel->setText(tr("Volume inválido para MPR."));
+        return;
+    }
+    this->bricked = std::move(brickedVolume);
+    this->cursor = {{(this->bricked->width() - 1) * this->bricked->spacingX() / 2.0,
+                     (this->bricked->height() - 1) * this->bricked->spacingY() / 2.0,
+                     (this->bricked->depth() - 1) * this->bricked->spacingZ() / 2.0}};
+
+    // Janela inicial e sensibilidade do arraste a partir do corte central
+    const dicom_viewer_core::MedicalImage middle = dicom_viewer_core::extractSlice(*this->volume, this->volume->depth / 2);
+    defaultWindow(middle, this->windowCenter, this->windowWidth);
+    double minValue = 0.0;
+    double maxValue = 0.0;
+    if (dicom_viewer_core::computeValueRange(middle, minValue, maxValue, dicom_viewer_core::ThreadPool::shared())) {
+        this->windowStep = std::max((maxValue - minValue) / 1024.0, 0.01);
+    }
+    for (View &view : this->views) {
+        view.dirty = true;
+    }
+    renderViews();
+}
+
+/**
+ * @brief Agenda a atualização das vistas marcadas.
+ *
+ * Vários eventos de mouse entre dois ciclos do laço de eventos resultam em
+ * uma única reformatação.
+ */
+void MprWindow::scheduleRender()
+{
+    if (this->renderPending || !this->bricked) {
+        return;
+    }
+    this->renderPending = true;
+    QTimer::singleShot(0, this, [this]() {
+        this->renderPending = false;
+        renderViews();
+    });
+}
+
+/**
+ * @brief Reformata as vistas marcadas e atualiza os cruzamentos.
+ */
+void MprWindow::renderViews()
+{
+    if (!this->bricked) {
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    int resliced = 0;
+    for (View &view : this->views) {
+        if (view.dirty) {
+            view.plane = dicom_viewer_core::mprPlane(*this->bricked, view.orientation, this->cursor, this->obliqueAngle);
+            view.image = std::make_shared<dicom_viewer_core::MedicalImage>(
+                dicom_viewer_core::reslice(*this->bricked, view.plane, dicom_viewer_core::ThreadPool::shared()));
+            applyWindow(view);
+            view.dirty = false;
+            ++resliced;
+        }
+        updateCrosshair(view);
+    }
+    if (resliced > 0) {
+        const double elapsed = dicom_viewer_core::elapsedMs(start);
+        this->statusLabel->setText(tr("%1 planos em %2 ms · W/L %3/%4")
+                                       .arg(resliced)
+                                       .arg(elapsed, 0, 'f', 1)
+                                       .arg(this->windowWidth, 0, 'f', 0)
+                                       .arg(this->windowCenter, 0, 'f', 0));
+    }
+}
+
+/**
+ * @brief Reaplica a janela às imagens já reformatadas.
+ */
+void MprWindow::applyWindow(View &view)
+{
+    if (!view.image) {
+        return;
+    }
+    QImage target = view.item->takeImage();
+    renderWindowLevel(*view.image, this->windowCenter, this->windowWidth, target);
+    const bool resized = target.size() != view.scene->sceneRect().size().toSize();
+    view.item->setImage(std::move(target));
+    if (resized) {
+        // Planos oblíquos mudam de tamanho com o ângulo
+        view.scene->setSceneRect(view.item->boundingRect());
+        view.view->fitInView(view.item, Qt::KeepAspectRatio);
+    }
+}
+
+/**
+ * @brief Posiciona as linhas do cruzamento de uma vista.
+ *
+ * Nas vistas coronal e sagital os outros planos aparecem como uma linha
+ * vertical e uma horizontal; na axial, como as duas direções giradas pelo
+ * ângulo oblíquo.
+ */
+void MprWindow::updateCrosshair(View &view)
+{
+    const std::array<double, 2> center = view.plane.project(this->cursor);
+    const double reach = std::max(view.plane.width, view.plane.height) * 2.0;
+    if (view.orientation == dicom_viewer_core::MprOrientation::Axial) {
+        const double c = std::cos(this->obliqueAngle);
+        const double s = std::sin(this->obliqueAngle);
+        view.horizontal->setLine(center[0] - c * reach, center[1] - s * reach, center[0] + c * reach, center[1] + s * reach);
+        view.vertical->setLine(center[0] + s * reach, center[1] - c * reach, center[0] - s * reach, center[1] + c * reach);
+    } else {
+        view.horizontal->setLine(-reach, center[1], reach, center[1]);
+        view.vertical->setLine(center[0], -reach, center[0], reach);
+    }
+}
+
+/**
+ * @brief Move o cruzamento para um ponto de uma vista e marca as outras.
+ */
+void MprWindow::moveCursor(View &source, const QPointF &scenePoint)
+{
+    this->cursor = source.plane.pointAt(scenePoint.x(), scenePoint.y());
+    for (View &view : this->views) {
+        if (&view != &source) {
+            view.dirty = true;
+        }
+    }
+    scheduleRender();
+}
+
+MprWindow::View *MprWindow::viewFor(QObject *viewport)
+{
+    for (View &view : this->views) {
+        if (view.view->viewport() == viewport) {
+            return &view;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Trata o mouse sobre as três vistas.
+ */
+bool MprWindow::eventFilter(QObject *watched, QEvent *event)
+{
+    View *view = viewFor(watched);
+    if (!view || !this->bricked) {
+        return QWidget::eventFilter(watched, event);
+    }
+
+    switch (event->type()) {
+    case QEvent::MouseButtonPress: {
+        QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(event);
+        this->dragOrigin = mouseEvent->position().toPoint();
+        if (mouseEvent->button() == Qt::LeftButton) {
+            this->draggingCursor = true;
+            moveCursor(*view, view->view->mapToScene(this->dragOrigin));
+        } else if (mouseEvent->button() == Qt::RightButton) {
+            this->draggingWindow = true;
+        }
+        return true;
+    }
+    case QEvent::MouseMove: {
+        QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(event);
+        const QPoint position = mouseEvent->position().toPoint();
+        if (this->draggingCursor) {
+            moveCursor(*view, view->view->mapToScene(position));
+        } else if (this->draggingWindow) {
+            const QPoint delta = position - this->dragOrigin;
+            this->windowWidth = std::max(1.0, this->windowWidth + delta.x() * this->windowStep);
+            this->windowCenter += delta.y() * this->windowStep;
+            for (View &other : this->views) {
+                applyWindow(other);
+            }
+            this->statusLabel->setText(tr("W/L %1/%2").arg(this->windowWidth, 0, 'f', 0).arg(this->windowCenter, 0, 'f', 0));
+        }
+        this->dragOrigin = position;
+        return true;
+    }
+    case QEvent::MouseButtonRelease:
+        this->draggingCursor = false;
+        this->draggingWindow = false;
+        return true;
+    case QEvent::Wheel: {
+        // Percorre os cortes ao longo da normal do plano da vista
+        QWheelEvent *wheelEvent = static_cast<QWheelEvent *>(event);
+        const int steps = wheelEvent->angleDelta().y() / 120;
+        const std::array<double, 3> &u = view->plane.axisU;
+        const std::array<double, 3> &v = view->plane.axisV;
+        const std::array<double, 3> normal{{u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]}};
+        for (int k = 0; k < 3; ++k) {
+            this->cursor[k] += normal[k] * steps * view->plane.pixelSpacing;
+        }
+        view->dirty = true;
+        scheduleRender();
+        return true;
+    }
+    case QEvent::ContextMenu:
+        return true;
+    default:
+        break;
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+}
@@ -0,0 +1,124 @@
+/**
+ * DICOM Viewer - Janela de Reformatação Multiplanar
+ * Copyright (c) 2026, Augusto Damasceno.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+#ifndef MPRWINDOW_H
+#define MPRWINDOW_H
+
+#include <array>
+#include <memory>
+
+#include <QWidget>
+#include <QGraphicsView>
+#include <QGraphicsScene>
+#include <QGraphicsLineItem>
+#include <QLabel>
+#include <QSlider>
+
+#include "imageitem.h"
+#include "../../core/Volume.h"
+#include "../../core/BrickedVolume.h"
+#include "../../core/Reslicer.h"
+
+namespace dicom_viewer_windows {
+
+/**
+ * @class MprWindow
+ * @brief Três vistas ortogonais ligadas (axial, coronal e sagital) de um volume.
+ *
+ * Arrastar com o botão esquerdo move o cruzamento das três vistas; a roda
+ * percorre os cortes da vista sob o cursor; o botão direito ajusta a janela
+ * de todas as vistas. O controle "Oblíquo" gira os planos coronal e sagital
+ * em torno do eixo dos cortes. Apenas as vistas cujo plano mudou são
+ * reformatadas, em paralelo, e eventos de mouse acumulados são agrupados em
+ * uma única atualização.
+ */
+class MprWindow : public QWidget
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Construtor da janela. O volume é reorganizado em blocos em segundo plano.
+     * @param volume Volume da série.
+     * @param parent Widget pai (opcional).
+     */
+    explicit MprWindow(std::shared_ptr<const dicom_viewer_core::Volume> volume, QWidget *parent = nullptr);
+
+protected:
+    /**
+     * @brief Trata o mouse sobre as três vistas.
+     */
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    /**
+     * @struct View
+     * @brief Estado de uma das três vistas.
+     */
+    struct View {
+        dicom_viewer_core::MprOrientation orientation = dicom_viewer_core::MprOrientation::Axial;
+        QGraphicsView *view = nullptr;
+        QGraphicsScene *scene = nullptr;
+        ImageItem *item = nullptr;
+        QGraphicsLineItem *horizontal = nullptr;
+        QGraphicsLineItem *vertical = nullptr;
+        dicom_viewer_core::ReslicePlane plane;
+        std::shared_ptr<dicom_viewer_core::MedicalImage> image;
+        bool dirty = true;
+    };
+
+    /**
+     * @brief Recebe o volume em blocos e exibe as três vistas.
+     */
+    void onVolumeReady(std::shared_ptr<const dicom_viewer_core::BrickedVolume> bricked);
+
+    /**
+     * @brief Agenda a atualização das vistas marcadas.
+     */
+    void scheduleRender();
+
+    /**
+     * @brief Reformata as vistas marcadas e atualiza os cruzamentos.
+     */
+    void renderViews();
+
+    /**
+     * @brief Reaplica a janela às imagens já reformatadas.
+     */
+    void applyWindow(View &view);
+
+    /**
+     * @brief Posiciona as linhas do cruzamento de uma vista.
+     */
+    void updateCrosshair(View &view);
+
+    /**
+     * @brief Move o cruzamento para um ponto de uma vista e marca as outras.
+     */
+    void moveCursor(View &source, const QPointF &scenePoint);
+
+    View *viewFor(QObject *viewport);
+
+    std::shared_ptr<const dicom_viewer_core::Volume> volume;
+    std::shared_ptr<const dicom_viewer_core::BrickedVolume> bricked;
+    std::array<View, 3> views;
+    std::array<double, 3> cursor{{0.0, 0.0, 0.0}};
+    double obliqueAngle = 0.0;
+    double windowCenter = 0.0;
+    double windowWidth = 1.0;
+    double windowStep = 1.0;
+    bool renderPending = false;
+    bool draggingCursor = false;
+    bool draggingWindow = false;
+    QPoint dragOrigin;
+    QSlider *obliqueSlider = nullptr;
+    QLabel *statusLabel = nullptr;
+};
+
+}
+
+#endif // MPRWINDOW_H
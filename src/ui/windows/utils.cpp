@@ -5,38 +5,23 @@
  *
  * SPDX-License-Identifier: BSD-2-Clause
  */
-#include <QFile>
-#include <QByteArray>
+
+#include <algorithm>
 
 #include "utils.h"
+#include "../../core/WindowLevel.h"
+#include "../../core/ThreadPool.h"
+#include "../../core/Trace.h"
 
 
 namespace dicom_viewer_windows {
-    /**
-     * @brief Verifica se um arquivo possui a assinatura padrão de um arquivo DICOM (Parte 10).
-     *
-     * A função verifica se o arquivo existe, se tem o tamanho mínimo necessário,
-     * pula o preâmbulo de 128 bytes e verifica se os 4 bytes seguintes são "DICM".
-     *
-     * @param filePath O caminho completo para o arquivo a ser verificado.
-     * @return true Se o arquivo for um DICOM válido, false caso contrário.
-     */
-    bool isValidDicomFile(const QString &filePath)
-    {
-        QFile file(filePath);
-        if (!file.open(QIODevice::ReadOnly)) {
-            return false;
-        }
-        if (file.size() < 132) {
-            return false;
+    namespace {
+        /**
+         * @brief Libera a referência ao buffer de pixels mantida por uma QImage.
+         */
+        void releasePixelBuffer(void *info) {
+            delete static_cast<dicom_viewer_core::PixelBuffer*>(info);
         }
-        if (!file.seek(128)) {
-            return false;
-        }
-        if (file.read(4) != "DICM") {
-            return false;
-        }
-        return true;
     }
 
     /**
@@ -46,11 +31,29 @@ namespace dicom_viewer_windows {
      * compatível com Qt para exibição em widgets gráficos. Suporta imagens em escala
      * de cinza (1 amostra por pixel) e RGB (3 amostras por pixel).
      *
+     * Imagens de 8 bits não são copiadas: a QImage embrulha o buffer da
+     * MedicalImage e mantém uma referência a ele até ser destruída. Como o
+     * buffer é passado como constante, uma escrita na QImage (bits())
+     * provoca uma cópia em vez de alterar a imagem de origem.
+     *
      * @param rawImg A imagem DICOM a ser convertida.
      * @return QImage contendo os dados da imagem convertida, ou QImage nula se inválida.
      */
     QImage convertMedicalImage(const dicom_viewer_core::MedicalImage& rawImg) {
         if (!rawImg.isValid()) return QImage();
+        DICOM_TRACE_SCOPE(traceScope, "qimage");
+
+        // Precisão total: aplica a janela inicial
+        if (dicom_viewer_core::isFullPrecision(rawImg)) {
+            double center = 0.0;
+            double width = 0.0;
+            defaultWindow(rawImg, center, width);
+            QImage img;
+            if (!renderWindowLevel(rawImg, center, width, img)) {
+                return QImage();
+            }
+            return img;
+        }
         
         long long width = rawImg.width;
         long long height = rawImg.height;
@@ -74,7 +77,70 @@ namespace dicom_viewer_windows {
             return QImage();
         }
         
-        QImage img(rawImg.buffer.data(), width, height, bytesPerLine, format);
-        return img.copy();
+        // A referência extra é solta por releasePixelBuffer quando a QImage deixa de usar os bytes
+        auto* reference = new dicom_viewer_core::PixelBuffer(rawImg.buffer);
+        const uchar* pixels = reference->data();
+        return QImage(pixels, width, height, bytesPerLine, format, releasePixelBuffer, reference);
+    }
+
+    /**
+     * @brief Janela inicial de uma imagem de precisão total.
+     *
+     * Usa o janelamento do cabeçalho ou, na ausência dele, o intervalo entre
+     * o menor e o maior valor de modalidade da imagem.
+     *
+     * @param rawImg A imagem de precisão total.
+     * @param center Recebe o centro da janela.
+     * @param width Recebe a largura da janela.
+     */
+    void defaultWindow(const dicom_viewer_core::MedicalImage& rawImg, double& center, double& width) {
+        if (rawImg.windowWidth > 1.0) {
+            center = rawImg.windowCenter;
+            width = rawImg.windowWidth;
+            return;
+        }
+        double minValue = 0.0;
+        double maxValue = 0.0;
+        if (!dicom_viewer_core::computeValueRange(rawImg, minValue, maxValue, dicom_viewer_core::ThreadPool::shared())) {
+            center = 127.5;
+            width = 256.0;
+            return;
+        }
+        center = (minValue + maxValue) / 2.0;
+        width = std::max(1.0, maxValue - minValue + 1.0);
+    }
+
+    /**
+     * @brief Aplica o janelamento a uma imagem de precisão total e escreve em target.
+     *
+     * A tabela de consulta é reconstruída a cada chamada (no máximo 65536
+     * entradas) e o remapeamento é distribuído por linhas no pool compartilhado.
+     *
+     * @param rawImg A imagem de precisão total.
+     * @param center Centro da janela, em unidades de modalidade.
+     * @param width Largura da janela, em unidades de modalidade.
+     * @param target QImage em escala de cinza que recebe o resultado.
+     * @return true se a imagem pôde ser janelada.
+     */
+    bool renderWindowLevel(const dicom_viewer_core::MedicalImage& rawImg, double center, double width, QImage& target) {
+        if (!dicom_viewer_core::isFullPrecision(rawImg)) {
+            return false;
+        }
+        // Um buffer ainda compartilhado seria copiado por bits(); como será todo sobrescrito, basta alocar outro
+        if (target.width() != rawImg.width || target.height() != rawImg.height ||
+            target.format() != QImage::Format_Grayscale8 || !target.isDetached()) {
+            target = QImage(rawImg.width, rawImg.height, QImage::Format_Grayscale8);
+            if (target.isNull()) {
+                return false;
+            }
+        }
+        DICOM_TRACE_SCOPE(traceScope, "window");
+        DICOM_TRACE_BYTES(traceScope, target.sizeInBytes());
+        dicom_viewer_core::WindowLut lut;
+        lut.rebuild(rawImg, center, width);
+        // bits() desanexa a QImage de cópias implícitas antes da escrita
+        dicom_viewer_core::applyWindowLevel(rawImg, lut, target.bits(), static_cast<std::size_t>(target.bytesPerLine()),
+                                            dicom_viewer_core::ThreadPool::shared());
+        return true;
     }
 }
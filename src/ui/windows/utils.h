@@ -14,23 +14,40 @@
 
 namespace dicom_viewer_windows {
 	/**
-	 * @brief Verifica se um arquivo possui a assinatura padrão de um arquivo DICOM (Parte 10).
+	 * @brief Converte uma imagem médica DICOM para QImage.
 	 *
-	 * A função verifica se o arquivo existe, se tem o tamanho mínimo necessário,
-	 * pula o preâmbulo de 128 bytes e verifica se os 4 bytes seguintes são "DICM".
+	 * Para imagens de 8 bits a QImage compartilha o buffer da imagem, sem cópia.
 	 *
-	 * @param filePath O caminho completo para o arquivo a ser verificado.
-	 * @return true Se o arquivo for um DICOM válido, false caso contrário.
+	 * @param rawImg A imagem DICOM a ser convertida.
+	 * @return QImage contendo os dados da imagem convertida.
 	 */
-	bool isValidDicomFile(const QString &filePath);
+	QImage convertMedicalImage(const dicom_viewer_core::MedicalImage& rawImg);
 
 	/**
-	 * @brief Converte uma imagem médica DICOM para QImage.
+	 * @brief Janela inicial de uma imagem de precisão total.
 	 *
-	 * @param rawImg A imagem DICOM a ser convertida.
-	 * @return QImage contendo os dados da imagem convertida.
+	 * Usa o janelamento do cabeçalho ou, na ausência dele, o intervalo entre
+	 * o menor e o maior valor de modalidade da imagem.
+	 *
+	 * @param rawImg A imagem de precisão total.
+	 * @param center Recebe o centro da janela.
+	 * @param width Recebe a largura da janela.
 	 */
-	QImage convertMedicalImage(const dicom_viewer_core::MedicalImage& rawImg);
+	void defaultWindow(const dicom_viewer_core::MedicalImage& rawImg, double& center, double& width);
+
+	/**
+	 * @brief Aplica o janelamento a uma imagem de precisão total e escreve em target.
+	 *
+	 * O buffer de target é reaproveitado quando já tem o tamanho e o formato
+	 * corretos, de modo que sucessivas mudanças de janela não alocam memória.
+	 *
+	 * @param rawImg A imagem de precisão total.
+	 * @param center Centro da janela, em unidades de modalidade.
+	 * @param width Largura da janela, em unidades de modalidade.
+	 * @param target QImage em escala de cinza que recebe o resultado.
+	 * @return true se a imagem pôde ser janelada.
+	 */
+	bool renderWindowLevel(const dicom_viewer_core::MedicalImage& rawImg, double center, double width, QImage& target);
 }
 
 #endif // MENUUTILS_H